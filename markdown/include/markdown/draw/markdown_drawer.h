@@ -6,6 +6,7 @@
 #define MARKDOWN_INCLUDE_MARKDOWN_DRAW_MARKDOWN_DRAWER_H_
 
 #include <memory>
+#include <vector>
 
 #include "markdown/draw/markdown_canvas.h"
 #include "markdown/element/markdown_page.h"
@@ -47,6 +48,18 @@ class MarkdownDrawer {
                                       MarkdownTextAttachment* attachment,
                                       int32_t region_char_start,
                                       int32_t region_char_end);
+  // attachments that may overlap a region, from the page's attachment
+  // geometry once it is built
+  static void CollectRegionAttachments(
+      const MarkdownPage& page, uint32_t region_index,
+      std::vector<MarkdownTextAttachment*>* text,
+      std::vector<MarkdownTextAttachment*>* border);
+  // line bounding rects of an attachment over [start_index, end_index),
+  // cached in the page's attachment geometry when the range is the
+  // attachment's own
+  static std::vector<RectF> GetAttachmentRects(
+      const MarkdownPage& page, const MarkdownTextAttachment* attachment,
+      int32_t start_index, int32_t end_index);
 
   tttext::ICanvasHelper* canvas_;
   MarkdownContext* context_;
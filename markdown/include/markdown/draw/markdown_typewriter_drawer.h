@@ -36,6 +36,20 @@ class MarkdownCharTypewriterDrawer : public MarkdownDrawer {
 
   void DrawRegion(const MarkdownPage& page, uint32_t region_index) override;
 
+  // Draws only the text of a paragraph region from |char_start| up to the
+  // typewriter step, its attachments in that range and the cursor. Used on
+  // top of a region drawn up to |char_start| without cursor.
+  void DrawRegionTail(const MarkdownPage& page, uint32_t region_index,
+                      int32_t char_start);
+
+  void SetDrawCursor(bool draw_cursor) { draw_cursor_ = draw_cursor; }
+
+  // Char index at which the fully revealed lines of a paragraph region end
+  // for |max_char_count| revealed chars, -1 if the region is not a paragraph.
+  static int32_t GetRevealedLinesEnd(const MarkdownPage& page,
+                                     uint32_t region_index,
+                                     int32_t max_char_count);
+
  protected:
   std::unique_ptr<tttext::RunDelegate> CreateEllipsis(float text_size,
                                                       uint32_t color);
@@ -67,7 +81,10 @@ class MarkdownCharTypewriterDrawer : public MarkdownDrawer {
 
   int32_t max_char_count_{std::numeric_limits<int32_t>::max()};
   int32_t draw_char_count_{0};
+  // attachments are clipped to start here when drawing a region tail
+  int32_t min_char_index_{0};
   bool draw_cursor_if_complete_{false};
+  bool draw_cursor_{true};
 
   tttext::RunDelegate* typewriter_cursor_{nullptr};
   std::unique_ptr<tttext::RunDelegate> default_typewriter_cursor_{nullptr};
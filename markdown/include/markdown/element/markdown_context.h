@@ -9,6 +9,7 @@
 #include <memory>
 #include <utility>
 
+#include "markdown/style/markdown_style_cache.h"
 #include "markdown/utils/markdown_platform.h"
 
 namespace serval::markdown {
@@ -41,6 +42,9 @@ class MarkdownContext {
     return platform_ == nullptr ? nullptr : platform_->GetTextLayout();
   }
 
+  // Styles read from the style maps of the views on this context.
+  MarkdownStyleCache& GetStyleCache() { return style_cache_; }
+
   MarkdownCanvasExtend* GetMarkdownCanvasExtend(
       tttext::ICanvasHelper* canvas) const {
     return platform_ == nullptr ? nullptr
@@ -51,6 +55,7 @@ class MarkdownContext {
   HexColorFormat hash_hex_color_format_{HexColorFormat::kRGBA};
   bool harmony_shaper_force_low_api_{true};
   std::unique_ptr<MarkdownPlatform> platform_;
+  MarkdownStyleCache style_cache_;
 };
 
 }  // namespace serval::markdown
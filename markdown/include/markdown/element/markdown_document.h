@@ -103,8 +103,15 @@ class L_EXPORT MarkdownDocument {
     event_ = event;
   }
   MarkdownEventListener* GetMarkdownEventListener() const { return event_; }
-  void SetStyle(const MarkdownStyle& style) { style_ = style; }
-  const MarkdownStyle& GetStyle() const { return style_; }
+  void SetStyle(const MarkdownStyle& style) {
+    style_ = std::make_shared<const MarkdownStyle>(style);
+  }
+  // Shares |style| without copying it; a null style resets to the default.
+  void SetStyle(std::shared_ptr<const MarkdownStyle> style);
+  const MarkdownStyle& GetStyle() const { return *style_; }
+  const std::shared_ptr<const MarkdownStyle>& GetSharedStyle() const {
+    return style_;
+  }
   std::pair<float, float> GetInlineViewOrigin(const char* idSelector);
   std::vector<std::pair<std::string, PointF>> GetAllInlineViewOrigin();
   std::vector<std::string> GetAllInlineViewId();
@@ -213,7 +220,9 @@ class L_EXPORT MarkdownDocument {
   // TODO(zhouchaoying): temporarily fix quote border, will be removed next
   // commit
   std::vector<Range> quote_range_;
-  MarkdownStyle style_{};
+
+  static const std::shared_ptr<const MarkdownStyle>& GetDefaultStyle();
+  std::shared_ptr<const MarkdownStyle> style_{GetDefaultStyle()};
 
   std::shared_ptr<MarkdownContext> context_{nullptr};
   MarkdownResourceLoader* loader_{nullptr};
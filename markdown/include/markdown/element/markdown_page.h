@@ -12,6 +12,8 @@
 #include "markdown/element/markdown_attachments.h"
 #include "markdown/element/markdown_drawable.h"
 #include "markdown/element/markdown_region.h"
+#include "markdown/layout/markdown_attachment_geometry.h"
+#include "markdown/layout/markdown_page_line_index.h"
 #include "markdown/utils/markdown_definition.h"
 #include "markdown/utils/markdown_marco.h"
 #include "markdown/utils/markdown_textlayout_headers.h"
@@ -63,12 +65,16 @@ class L_EXPORT MarkdownPage {
   }
   uint32_t GetExtraBorderCount() const { return quote_borders_.size(); }
 
-  void ClearAttachments() { attachments_.clear(); }
+  void ClearAttachments() {
+    attachments_.clear();
+    attachment_geometry_.Clear();
+  }
   void AddTextAttachments(
       std::vector<std::unique_ptr<MarkdownTextAttachment>> attachment) {
     for (auto& value : attachment) {
       attachments_.emplace_back(std::move(value));
     }
+    attachment_geometry_.Clear();
   }
   const std::vector<std::unique_ptr<MarkdownTextAttachment>>&
   GetTextAttachments() const {
@@ -77,16 +83,27 @@ class L_EXPORT MarkdownPage {
   void SetBorderAttachments(
       std::vector<std::unique_ptr<MarkdownTextAttachment>>&& attachments) {
     border_attachments_ = std::move(attachments);
+    attachment_geometry_.Clear();
   }
   const std::vector<std::unique_ptr<MarkdownTextAttachment>>&
   GetBorderAttachments() const {
     return border_attachments_;
   }
+  // resolves attachment rects after layout or an attachment update; drawing
+  // falls back to resolving them per draw until then
+  void UpdateAttachmentGeometry() { attachment_geometry_.Build(*this); }
+  const MarkdownAttachmentGeometry& GetAttachmentGeometry() const {
+    return attachment_geometry_;
+  }
   std::vector<ScrollState> GetScrollState() const;
   void ApplyScrollState(const std::vector<ScrollState>& states);
   void AddRegion(std::unique_ptr<MarkdownPageRegion> region) {
     regions_.emplace_back(std::move(region));
+    line_index_.Clear();
+    attachment_geometry_.Clear();
   }
+  // built by MarkdownLayout, empty for pages assembled with AddRegion
+  const MarkdownPageLineIndex& GetLineIndex() const { return line_index_; }
 
  private:
   std::vector<std::shared_ptr<MarkdownElement>> elements_;
@@ -100,6 +117,8 @@ class L_EXPORT MarkdownPage {
   float max_width_{};
   float max_height_{};
   std::shared_ptr<MarkdownDrawable> custom_typewriter_cursor_{nullptr};
+  MarkdownPageLineIndex line_index_;
+  MarkdownAttachmentGeometry attachment_geometry_;
   // TODO(zhouchaoying): temporarily fix quote border, will be removed next
   // commit
   std::vector<std::unique_ptr<MarkdownQuoteBorder>> quote_borders_;
@@ -0,0 +1,66 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef MARKDOWN_INCLUDE_MARKDOWN_LAYOUT_MARKDOWN_ATTACHMENT_GEOMETRY_H_
+#define MARKDOWN_INCLUDE_MARKDOWN_LAYOUT_MARKDOWN_ATTACHMENT_GEOMETRY_H_
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "markdown/utils/markdown_definition.h"
+#include "markdown/utils/markdown_marco.h"
+
+namespace serval::markdown {
+class MarkdownPage;
+class MarkdownTextAttachment;
+
+/**
+ * Line bounding rects of the text and border attachments of a laid out page,
+ * resolved once per layout and attachment update, with an index from each
+ * page region to the attachments overlapping it. Attachments indexed from the
+ * typewriter step (negative indices) move with the animation; they are not
+ * cached and are listed for every region.
+ */
+class L_EXPORT MarkdownAttachmentGeometry {
+ public:
+  void Build(const MarkdownPage& page);
+  void Clear();
+  bool IsBuilt() const { return built_; }
+
+  // rects as MarkdownSelection::GetSelectionRectByCharPos() gives them with
+  // RectType::kLineBounding, current horizontal scroll applied; false if the
+  // attachment is not cached
+  bool GetRects(const MarkdownPage& page,
+                const MarkdownTextAttachment* attachment,
+                std::vector<RectF>* rects) const;
+  // text and border attachments that may overlap a region, each in page order
+  void GetRegionAttachments(
+      uint32_t region_index, std::vector<MarkdownTextAttachment*>* text,
+      std::vector<MarkdownTextAttachment*>* border) const;
+
+ private:
+  struct CachedRect {
+    uint32_t region_index_;
+    // horizontal scroll of the region when the rect was resolved
+    float scroll_x_offset_;
+    RectF rect_;
+  };
+
+  // text attachments followed by border attachments
+  std::vector<MarkdownTextAttachment*> attachments_;
+  uint32_t text_attachment_count_{0};
+  std::unordered_map<const MarkdownTextAttachment*, uint32_t>
+      attachment_index_;
+  // rects of attachment i are rects_[rect_begin_[i], rect_begin_[i + 1])
+  std::vector<uint32_t> rect_begin_;
+  std::vector<CachedRect> rects_;
+  // attachments of region r are
+  // region_attachments_[region_begin_[r], region_begin_[r + 1]), ascending
+  std::vector<uint32_t> region_begin_;
+  std::vector<uint32_t> region_attachments_;
+  std::vector<uint32_t> step_relative_attachments_;
+  bool built_{false};
+};
+}  // namespace serval::markdown
+#endif  // MARKDOWN_INCLUDE_MARKDOWN_LAYOUT_MARKDOWN_ATTACHMENT_GEOMETRY_H_
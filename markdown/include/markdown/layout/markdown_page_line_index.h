@@ -0,0 +1,93 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef MARKDOWN_INCLUDE_MARKDOWN_LAYOUT_MARKDOWN_PAGE_LINE_INDEX_H_
+#define MARKDOWN_INCLUDE_MARKDOWN_LAYOUT_MARKDOWN_PAGE_LINE_INDEX_H_
+#include <cstdint>
+#include <vector>
+
+#include "markdown/utils/markdown_definition.h"
+#include "markdown/utils/markdown_marco.h"
+#include "markdown/utils/markdown_textlayout_headers.h"
+
+namespace serval::markdown {
+class MarkdownPage;
+
+// Text region and line holding one char of a page.
+struct MarkdownTypewriterStep {
+  uint32_t page_region_index_{0};
+  tttext::LayoutRegion* region_{nullptr};
+  int32_t char_pos_offset_{0};
+  // origin of region_ in page coordinates, horizontal scroll included
+  PointF offset_;
+  // bottom of the table row for table cells, -1 for paragraphs
+  float row_bottom_{-1.f};
+  // null if region_ has no lines
+  tttext::TextLine* line_{nullptr};
+};
+
+/**
+ * Char-indexed tables over the regions, lines and table cells of a laid out
+ * page, built once per layout. MarkdownSelection starts its char range and
+ * line queries at a binary-searched region or line instead of walking the
+ * page from the first region. FindStep() gives the region and line that
+ * MarkdownSelection::GetSelectionRegionsByCharRange() would pick for a one
+ * char range, so the typewriter cursor can be placed for any animation step
+ * without walking the page.
+ */
+class L_EXPORT MarkdownPageLineIndex {
+ public:
+  void Build(const MarkdownPage& page);
+  void Clear();
+  bool IsBuilt() const { return built_; }
+
+  // first region whose element does not end before |char_pos|, the region
+  // count if none
+  uint32_t FindFirstRegionEndingAtOrAfter(int32_t char_pos) const;
+  // page char index at which each line ends; table rows count as lines
+  const std::vector<int32_t>& GetLineEndCharIndices() const {
+    return line_end_char_indices_;
+  }
+  // first line ending at or after |char_index|, -1 if none
+  int32_t FindFirstLineEndingAtOrAfter(int32_t char_index) const;
+
+  int32_t GetPageCharCount() const { return page_char_count_; }
+  bool FindStep(const MarkdownPage& page, int32_t char_index,
+                MarkdownTypewriterStep* step) const;
+
+ private:
+  // paragraph or table cell, in page order
+  struct StepEntry {
+    int32_t char_start_;
+    // last char index answered by this entry, inclusive
+    int32_t char_last_;
+    // closest earlier entry with a larger char_last_, -1 if none
+    int32_t prev_wider_;
+    uint32_t page_region_index_;
+    // table cell position, -1 for paragraphs
+    int32_t row_;
+    int32_t column_;
+    tttext::LayoutRegion* region_;
+    uint32_t line_begin_;
+    uint32_t line_count_;
+  };
+
+  void AddStepEntry(int32_t char_start, int32_t char_last,
+                    uint32_t page_region_index, int32_t row, int32_t column,
+                    tttext::LayoutRegion* region);
+
+  // largest element char end among the regions up to each region
+  std::vector<int32_t> region_char_end_max_;
+  std::vector<int32_t> line_end_char_indices_;
+  // largest line end up to each line; rows of tables without columns never
+  // answer a char lookup and count as the minimum
+  std::vector<int32_t> line_end_char_max_;
+  std::vector<StepEntry> step_entries_;
+  // line ends of each step entry's region, relative to the region
+  std::vector<uint32_t> step_line_end_char_pos_;
+  int32_t page_char_count_{0};
+  bool built_{false};
+};
+}  // namespace serval::markdown
+#endif  // MARKDOWN_INCLUDE_MARKDOWN_LAYOUT_MARKDOWN_PAGE_LINE_INDEX_H_
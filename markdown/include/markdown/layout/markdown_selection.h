@@ -43,6 +43,12 @@ class L_EXPORT MarkdownSelection {
       const MarkdownPage* page, int32_t char_pos_start, int32_t char_pos_end,
       RectType type = RectType::kSelection,
       RectCoordinate coordinate = RectCoordinate::kAbsolute);
+  // the part of GetSelectionRectByCharPos() that falls in one page region
+  static void GetRegionSelectionRectByCharPos(
+      const MarkdownPage* page, uint32_t region_index, int32_t char_pos_start,
+      int32_t char_pos_end, std::vector<RectF>* rects,
+      RectType type = RectType::kSelection,
+      RectCoordinate coordinate = RectCoordinate::kAbsolute);
   static RectF GetSelectionClosedRectByCharPos(
       const MarkdownPage* page, int32_t char_pos_start, int32_t char_pos_end,
       RectType type = RectType::kSelection,
@@ -4,6 +4,7 @@
 
 #ifndef MARKDOWN_INCLUDE_MARKDOWN_PARSER_EMBED_MARKDOWN_PARSER_EMBED_H_
 #define MARKDOWN_INCLUDE_MARKDOWN_PARSER_EMBED_MARKDOWN_PARSER_EMBED_H_
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <string>
@@ -55,6 +56,44 @@ struct MarkdownParseContext {
   std::vector<int32_t> lines_offset_;
   uint32_t line_index_{0};
 };
+// Discount callbacks of one parse, in order, with copies of the lines passed
+// to the text callbacks. Replaying them generates the elements again, under
+// the current document style, without running the block parser.
+struct MarkdownBlockEvents {
+  enum class Type : uint8_t {
+    kParagraphStart,
+    kParagraphText,
+    kHeaderNumber,
+    kParagraphAlign,
+    kListCheck,
+    kListIndex,
+    kListExtraLevel,
+    kParagraphEnd,
+  };
+  struct Event {
+    Type type_;
+    // callback argument, or the first entry in lines_ for text events
+    int32_t value_;
+    uint32_t line_count_;
+  };
+  struct Line {
+    // offset of the null terminated line text in text_
+    uint32_t text_offset_;
+    int32_t size_;
+    int32_t dle_;
+    int32_t markdown_offset_;
+  };
+  void Clear() {
+    events_.clear();
+    lines_.clear();
+    text_.clear();
+  }
+  bool IsEmpty() const { return events_.empty(); }
+
+  std::vector<Event> events_;
+  std::vector<Line> lines_;
+  std::string text_;
+};
 class MarkdownParserEmbed {
  public:
   explicit MarkdownParserEmbed(MarkdownDocument* document)
@@ -64,35 +103,68 @@ class MarkdownParserEmbed {
       const char* src, int size, int32_t markdown_start = 0,
       int32_t markdown_end = std::numeric_limits<int32_t>::max(),
       float width = -1);
+  // Same as Parse(), generating the elements from block events recorded by an
+  // earlier parse of the same source.
+  L_EXPORT void Replay(
+      const MarkdownBlockEvents& events, const char* src, int size,
+      int32_t markdown_start = 0,
+      int32_t markdown_end = std::numeric_limits<int32_t>::max(),
+      float width = -1);
   L_EXPORT void ParsePlainText(const char* src, int size);
+  // The next Parse() appends its block events to |events|.
+  void RecordBlockEvents(MarkdownBlockEvents* events) {
+    recorded_events_ = events;
+  }
 
  private:
   static void OnParagraphStart(int type, void* ud) {
-    reinterpret_cast<MarkdownParserEmbed*>(ud)->OnParagraphStart(type);
+    auto* parser = reinterpret_cast<MarkdownParserEmbed*>(ud);
+    parser->RecordEvent(MarkdownBlockEvents::Type::kParagraphStart, type);
+    parser->OnParagraphStart(type);
   }
   static void OnParagraphText(line* line, void* ud) {
-    reinterpret_cast<MarkdownParserEmbed*>(ud)->OnParagraphText(line);
+    auto* parser = reinterpret_cast<MarkdownParserEmbed*>(ud);
+    parser->RecordText(line);
+    parser->OnParagraphText(line);
   }
   static void OnHeaderNumber(int hn, void* ud) {
-    reinterpret_cast<MarkdownParserEmbed*>(ud)->OnHeaderNumber(hn);
+    auto* parser = reinterpret_cast<MarkdownParserEmbed*>(ud);
+    parser->RecordEvent(MarkdownBlockEvents::Type::kHeaderNumber, hn);
+    parser->OnHeaderNumber(hn);
   }
   static void OnParagraphAlign(int align_type, void* ud) {
-    reinterpret_cast<MarkdownParserEmbed*>(ud)->OnParagraphAlign(align_type);
+    auto* parser = reinterpret_cast<MarkdownParserEmbed*>(ud);
+    parser->RecordEvent(MarkdownBlockEvents::Type::kParagraphAlign,
+                        align_type);
+    parser->OnParagraphAlign(align_type);
   }
   static void OnListCheck(int checked, void* ud) {
-    reinterpret_cast<MarkdownParserEmbed*>(ud)->OnListCheck(checked);
+    auto* parser = reinterpret_cast<MarkdownParserEmbed*>(ud);
+    parser->RecordEvent(MarkdownBlockEvents::Type::kListCheck, checked);
+    parser->OnListCheck(checked);
   }
   static void OnParagraphEnd(void* ud) {
-    reinterpret_cast<MarkdownParserEmbed*>(ud)->OnParagraphEnd();
+    auto* parser = reinterpret_cast<MarkdownParserEmbed*>(ud);
+    parser->RecordEvent(MarkdownBlockEvents::Type::kParagraphEnd, 0);
+    parser->OnParagraphEnd();
   }
   static void OnListIndex(int list_index, void* ud) {
-    reinterpret_cast<MarkdownParserEmbed*>(ud)->OnListIndex(list_index);
+    auto* parser = reinterpret_cast<MarkdownParserEmbed*>(ud);
+    parser->RecordEvent(MarkdownBlockEvents::Type::kListIndex, list_index);
+    parser->OnListIndex(list_index);
   }
   static void OnListExtraLevel(int list_level, void* ud) {
-    reinterpret_cast<MarkdownParserEmbed*>(ud)->OnListExtraLevel(list_level);
+    auto* parser = reinterpret_cast<MarkdownParserEmbed*>(ud);
+    parser->RecordEvent(MarkdownBlockEvents::Type::kListExtraLevel,
+                        list_level);
+    parser->OnListExtraLevel(list_level);
   }
 
  private:
+  void BeginParse(const char* src, int size, int32_t markdown_start,
+                  int32_t markdown_end, float width);
+  void RecordEvent(MarkdownBlockEvents::Type type, int value);
+  void RecordText(line* text_line);
   void OnParagraphStart(int type);
   void OnParagraphText(line* line);
   void OnHeaderNumber(int hn);
@@ -138,19 +210,17 @@ class MarkdownParserEmbed {
                                  uint32_t char_offset,
                                  uint32_t markdown_offset);
 
-  static void AppendInlineBorderLeft(const MarkdownBlockStylePart& block,
-                                     const MarkdownBorderStylePart& border,
-                                     MarkdownBackgroundStylePart* background,
-                                     tttext::Paragraph* para,
-                                     tttext::Style* style);
-  static void AppendInlineBorderRight(MarkdownDocument* document,
-                                      const MarkdownBaseStylePart& base,
-                                      const MarkdownBlockStylePart& block,
-                                      const MarkdownBorderStylePart& border,
-                                      MarkdownBackgroundStylePart* background,
-                                      tttext::Paragraph* para,
-                                      uint32_t char_offset_start,
-                                      uint32_t char_offset_end);
+  static void AppendInlineBorderLeft(
+      const MarkdownBlockStylePart& block,
+      const MarkdownBorderStylePart& border,
+      const MarkdownBackgroundStylePart* background, tttext::Paragraph* para,
+      tttext::Style* style);
+  static void AppendInlineBorderRight(
+      MarkdownDocument* document, const MarkdownBaseStylePart& base,
+      const MarkdownBlockStylePart& block,
+      const MarkdownBorderStylePart& border,
+      const MarkdownBackgroundStylePart* background, tttext::Paragraph* para,
+      uint32_t char_offset_start, uint32_t char_offset_end);
 
   std::vector<std::string_view> Split(const std::string_view& content,
                                       char split);
@@ -201,13 +271,12 @@ class MarkdownParserEmbed {
   std::pair<uint32_t, uint32_t> GetTextLineByteRangeByMarkdownRange(
       uint32_t line_offset, uint32_t line_length);
   int32_t MarkdownSourceByteIndexToCharIndex(int32_t byte_index) const;
-  static std::vector<int32_t> CalculateByteIndexToCharIndexMap(
-      std::string_view string);
 
   MarkdownParseContext context_{};
-  MarkdownStyle style_{};
+  std::shared_ptr<const MarkdownStyle> style_;
   MarkdownResourceLoader* loader_{nullptr};
   MarkdownDocument* document_{nullptr};
+  MarkdownBlockEvents* recorded_events_{nullptr};
   friend class MarkdownLayout;
   friend class MarkdownDocument;
   friend class MarkdownConverter;
@@ -9,10 +9,18 @@
 namespace serval::markdown {
 class MarkdownDocument;
 class MarkdownDomNode;
+struct MarkdownBlockEvents;
 class L_EXPORT MarkdownParserImpl {
  public:
+  // |block_events| receives the block events of the embedded parser, and is
+  // left empty when a parser provider handles the document.
   static void ParseMarkdown(const std::string& parser_name,
-                            MarkdownDocument* document, void* ud = nullptr);
+                            MarkdownDocument* document, void* ud = nullptr,
+                            MarkdownBlockEvents* block_events = nullptr);
+  // Generates the elements of |document| with its current style from the
+  // block events of an earlier parse of the same content.
+  static void ReplayMarkdown(MarkdownDocument* document,
+                             const MarkdownBlockEvents& block_events);
   static void ParsePlainText(MarkdownDocument* document);
 
  protected:
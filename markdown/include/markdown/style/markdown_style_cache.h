@@ -0,0 +1,49 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef MARKDOWN_INCLUDE_MARKDOWN_STYLE_MARKDOWN_STYLE_CACHE_H_
+#define MARKDOWN_INCLUDE_MARKDOWN_STYLE_MARKDOWN_STYLE_CACHE_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "markdown/style/markdown_style.h"
+#include "markdown/utils/markdown_value.h"
+
+namespace serval::markdown {
+
+class MarkdownContext;
+class MarkdownResourceLoader;
+
+// Styles read from style maps, one per distinct map and resource loader, so
+// that views of one context given equal themes share a single MarkdownStyle
+// and a single copy of the map. The least recently read entry is dropped
+// first. Used from the thread that owns the context, like its text layout.
+class MarkdownStyleCache {
+ public:
+  static constexpr size_t kMaxEntries = 16;
+
+  // Style read from |style_map| through |resource_loader|, reading it only
+  // if no equal map was read through the same loader.
+  std::shared_ptr<const MarkdownStyle> GetStyle(
+      const ValueMap& style_map, MarkdownResourceLoader* resource_loader,
+      MarkdownContext* context);
+  // Drops the styles read through |resource_loader|, which may be destroyed
+  // once detached, so a later loader at its address reads them again.
+  void DropResourceLoader(MarkdownResourceLoader* resource_loader);
+
+ private:
+  struct Entry {
+    ValueMap style_map_;
+    MarkdownResourceLoader* resource_loader_{nullptr};
+    std::shared_ptr<const MarkdownStyle> style_;
+  };
+  // oldest first
+  std::vector<Entry> entries_;
+};
+
+}  // namespace serval::markdown
+
+#endif  // MARKDOWN_INCLUDE_MARKDOWN_STYLE_MARKDOWN_STYLE_CACHE_H_
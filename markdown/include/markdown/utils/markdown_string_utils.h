@@ -71,6 +71,12 @@ std::string ToLower(std::string_view value);
 size_t FindMatchingParenthesis(std::string_view value, size_t open_index);
 std::vector<std::string_view> SplitTopLevel(std::string_view value, char split);
 
+// Char index of every byte of |utf8|, followed by the char count. Any byte
+// that is not a continuation byte (10xxxxxx) starts a char, so malformed
+// input is counted the same way as by IsUtf8StartByte(). Scans 16 bytes at a
+// time with SSE2 or NEON where available.
+std::vector<int32_t> UTF8ByteIndexToCharIndexMap(std::string_view utf8);
+
 std::u16string U8StringToU16(std::string_view u8_string);
 std::string U32StringToU8(std::u32string_view u32_string);
 
@@ -0,0 +1,36 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef MARKDOWN_INCLUDE_MARKDOWN_UTILS_MARKDOWN_TRACE_H_
+#define MARKDOWN_INCLUDE_MARKDOWN_UTILS_MARKDOWN_TRACE_H_
+#include <cstdint>
+
+#include "base/trace/native/trace_event.h"
+
+namespace serval::markdown {
+inline constexpr const char* kMarkdownTraceCategory = "markdown";
+}  // namespace serval::markdown
+
+#if ENABLE_TRACE_PERFETTO || ENABLE_TRACE_SYSTRACE
+// scoped slice in the markdown category, with up to two "key", value args
+#define MARKDOWN_TRACE_EVENT(name, ...) \
+  TRACE_EVENT(::serval::markdown::kMarkdownTraceCategory, name, ##__VA_ARGS__)
+// value of the counter track "markdown.<track>", dropped by the systrace
+// backend; |track| must be a string literal
+#define MARKDOWN_TRACE_COUNTER(track, value)                    \
+  TRACE_COUNTER(::serval::markdown::kMarkdownTraceCategory,     \
+                "markdown." track, static_cast<uint64_t>(value))
+// evaluates expression inside its own slice, for platform loader calls
+#define MARKDOWN_TRACE_CALL(name, expression) \
+  ([&]() -> decltype(auto) {                  \
+    MARKDOWN_TRACE_EVENT(name);               \
+    return expression;                        \
+  }())
+#else
+#define MARKDOWN_TRACE_EVENT(name, ...)
+#define MARKDOWN_TRACE_COUNTER(track, value)
+#define MARKDOWN_TRACE_CALL(name, expression) (expression)
+#endif
+
+#endif  // MARKDOWN_INCLUDE_MARKDOWN_UTILS_MARKDOWN_TRACE_H_
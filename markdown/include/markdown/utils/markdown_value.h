@@ -54,6 +54,13 @@ class L_EXPORT Value {
   Value* GetByIndex(uint32_t index);
   Value* GetByKey(const std::string& key);
 
+  // Deep copy and deep comparison; values of different types never compare
+  // equal, so an int and a double holding the same number differ.
+  std::unique_ptr<Value> Clone() const;
+  bool Equals(const Value& other) const;
+  static ValueMap CloneMap(const ValueMap& map);
+  static bool MapEquals(const ValueMap& first, const ValueMap& second);
+
  protected:
   explicit Value(ValueType type) : type_(type) {}
   void SetType(ValueType type) { type_ = type; }
@@ -12,6 +12,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "markdown/draw/markdown_canvas.h"
@@ -28,6 +29,9 @@
 #include "markdown/view/markdown_view_measure_host.h"
 #include "markdown/view/markdown_view_measurer.h"
 #include "markdown_view_renderer.h"
+namespace lynx::fml {
+class BasicTaskRunner;
+}  // namespace lynx::fml
 namespace serval::markdown {
 class MarkdownEventListener;
 class MarkdownExposureListener;
@@ -50,6 +54,21 @@ class L_EXPORT MarkdownView final : public MarkdownDrawable {
   void SetResourceLoader(MarkdownResourceLoader* loader);
   MarkdownResourceLoader* GetResourceLoader() const;
   void SetEventListener(MarkdownEventListener* listener);
+  using LayoutContextFactory =
+      std::function<std::shared_ptr<MarkdownContext>()>;
+  // Parses and lays out on |runner| instead of in OnMeasure(). Each layout
+  // gets a context of its own from |create_context|, called here, so no
+  // text layout is used by two threads. A finished layout is reported on
+  // |owner_runner|, the thread that changes and measures the view, which
+  // then requests the measure that adopts it. The last layout stays drawn
+  // and measured until then, and a view without any layout measures to an
+  // estimate. The resource loader and parser data are used on |runner|;
+  // the destructor waits for a layout already running. If any of them is
+  // null, lays out in OnMeasure().
+  void SetLayoutTaskRunner(
+      std::shared_ptr<lynx::fml::BasicTaskRunner> runner,
+      std::shared_ptr<lynx::fml::BasicTaskRunner> owner_runner,
+      LayoutContextFactory create_context);
   void SetExposureListener(MarkdownExposureListener* listener);
 
   void SetContent(std::string_view content);
@@ -60,11 +79,16 @@ class L_EXPORT MarkdownView final : public MarkdownDrawable {
   void SetSourceType(SourceType type);
 
   void SetStyle(const ValueMap& style_map);
+  // Style shared between views; setting the current style again is free.
+  void SetStyle(std::shared_ptr<const MarkdownStyle> style);
   void ApplyStyleInRange(const ValueMap& style_map, int32_t char_start,
                          int32_t char_end);
   void SetTextMaxLines(int32_t max_lines);
   void SetEnableBreakAroundPunctuation(bool allow);
   void SetEnableRegionView(bool enable);
+  // Keeps revealed typewriter lines drawn in their region views and redraws
+  // only the last line on each step. Needs region views.
+  void SetIncrementalTypewriter(bool enable);
   void SetTextAttachments(std::unique_ptr<Value> attachments);
   void SetMarkdownEffect(std::unique_ptr<Value> effect);
 
@@ -152,6 +176,9 @@ class L_EXPORT MarkdownView final : public MarkdownDrawable {
   void SetContentRangeStart(int32_t start);
   void SetContentRangeEnd(int32_t end);
   MeasureResult OnMeasure(MeasureSpec spec) override;
+  SizeF MeasureOffThread(MeasureSpec spec);
+  void AdoptFinishedLayout();
+  void CancelLayoutTask();
   int32_t GetCharCount() const;
   float CalculateHeightByAnimationStep();
   float CalculateHeightByAnimationStep(int32_t animation_step,
@@ -220,6 +247,22 @@ class L_EXPORT MarkdownView final : public MarkdownDrawable {
     std::unordered_set<ExposureKey, ExposureKey::Hash> exposure_images_;
   };
 
+  // measurer forked for one layout on the task runner
+  struct LayoutTask {
+    LayoutTask(MarkdownView* view, MarkdownViewMeasurer measurer)
+        : view_(view), measurer_(std::move(measurer)) {}
+    MarkdownView* view_;
+    MarkdownViewMeasurer measurer_;
+    MeasureSpec spec_{};
+    // held through the layout, so cancelling waits for a running one
+    std::mutex mutex_{};
+    // written on the owner thread under mutex_
+    bool cancelled_{false};
+    // only touched on the owner thread
+    bool done_{false};
+  };
+  void OnLayoutTaskDone(const LayoutTask* task);
+
   LayoutData layout_data_{};
   RendererData renderer_data_{};
   std::mutex renderer_bundle_mutex_{};
@@ -227,6 +270,11 @@ class L_EXPORT MarkdownView final : public MarkdownDrawable {
 
   std::shared_ptr<MarkdownContext> context_{nullptr};
   MarkdownViewMeasurer measurer_;
+  std::shared_ptr<lynx::fml::BasicTaskRunner> layout_task_runner_{nullptr};
+  std::shared_ptr<lynx::fml::BasicTaskRunner> owner_task_runner_{nullptr};
+  LayoutContextFactory create_layout_context_{};
+  std::shared_ptr<LayoutTask> layout_task_{nullptr};
+  bool measuring_off_thread_{false};
   MarkdownViewAnimator animator_;
   MarkdownViewRenderer renderer_;
   MarkdownViewGesture gesture_;
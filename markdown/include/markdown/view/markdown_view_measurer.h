@@ -9,9 +9,12 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 #include "markdown/element/markdown_context.h"
 #include "markdown/element/markdown_document.h"
 #include "markdown/element/markdown_drawable.h"
+#include "markdown/parser/embed/markdown_parser_embed.h"
 #include "markdown/parser/markdown_resource_loader.h"
 #include "markdown/utils/markdown_value.h"
 namespace serval::markdown {
@@ -27,6 +30,8 @@ class MarkdownViewMeasurer {
   explicit MarkdownViewMeasurer(
       std::shared_ptr<MarkdownContext> context,
       MarkdownResourceLoader* resource_loader = nullptr);
+  MarkdownViewMeasurer(const MarkdownViewMeasurer&) = default;
+  MarkdownViewMeasurer(MarkdownViewMeasurer&&) = default;
   ~MarkdownViewMeasurer() = default;
 
   void SetResourceLoader(MarkdownResourceLoader* resource_loader);
@@ -40,8 +45,17 @@ class MarkdownViewMeasurer {
   void SetParserType(std::string_view parser_type, void* parser_ud = nullptr);
   void SetSourceType(SourceType type);
 
-  void SetStyle(const ValueMap& style_map);
+  // Takes the style of |style_map| from the context's style cache, which
+  // reads it only once for every equal map. Returns whether the style
+  // changed.
+  bool SetStyle(const ValueMap& style_map);
   void SetStyle(const MarkdownStyle& style);
+  // Shares |style| with every document measured from now on. Returns false
+  // and keeps the current layout if it is null or already the current style.
+  bool SetStyle(std::shared_ptr<const MarkdownStyle> style);
+  const std::shared_ptr<const MarkdownStyle>& GetStyle() const {
+    return style_;
+  }
   void ApplyStyleInRange(const ValueMap& style_map, int32_t char_start,
                          int32_t char_end);
 
@@ -50,15 +64,40 @@ class MarkdownViewMeasurer {
   void SetTrimParagraphSpaces(bool trim);
   void SetPaddings(Paddings paddings);
 
+  // Style and size changes only need a measure, which regenerates the
+  // elements from the block events of the last parse. Changing the source
+  // needs a parse.
   void NeedsMeasure();
+  void NeedsParse();
 
   SizeF Measure(MeasureSpec spec);
+  // Measure() in two steps, for a layout run away from the owning thread.
+  // PrepareMeasure() normalizes |spec| and returns whether a layout is
+  // needed; LayoutDocument() parses and lays out the current document.
+  bool PrepareMeasure(MeasureSpec* spec);
+  void LayoutDocument(const MeasureSpec& spec);
+  // Copies the measurer with a fresh document on |context|, to be laid out
+  // on another thread that then is the only user of |context|. The copy
+  // reports no events and this measurer no longer needs a layout until it
+  // is changed again.
+  MarkdownViewMeasurer ForkLayout(std::shared_ptr<MarkdownContext> context);
+  // Takes the document and size from a fork that finished LayoutDocument(),
+  // keeps the scroll state and the range styles applied since the fork,
+  // then reports the parse to the event listener.
+  void AdoptLayout(MarkdownViewMeasurer&& fork);
+  // Forgets a fork that will not be adopted, so the next measure lays out
+  // from the source again.
+  void DropForkedLayout();
+  // Size guessed from the line count of the source and the normal text
+  // style, for a view measured before its first layout is done.
+  SizeF EstimateSize(MeasureSpec spec) const;
   SizeF GetMeasuredSize() const { return {measured_width_, measured_height_}; }
 
   void Align();
 
   void InitialDocument();
   bool DidLayoutInLastMeasure() const { return did_layout_in_last_measure_; }
+  bool DidParseInLastMeasure() const { return did_parse_in_last_measure_; }
 
   std::shared_ptr<MarkdownDocument> GetDocument();
 
@@ -67,7 +106,7 @@ class MarkdownViewMeasurer {
   std::string content_;
   std::string content_id_;
   bool content_complete_{true};
-  MarkdownStyle style_{};
+  std::shared_ptr<const MarkdownStyle> style_;
   int32_t text_max_lines_{-1};
   int32_t content_start_{0};
   int32_t content_end_{std::numeric_limits<int32_t>::max()};
@@ -83,6 +122,13 @@ class MarkdownViewMeasurer {
   float measured_height_{0};
   bool needs_measure_{true};
   bool did_layout_in_last_measure_{false};
+  bool needs_parse_{true};
+  bool did_parse_in_last_measure_{false};
+  MarkdownBlockEvents block_events_;
+  // range styles applied while a fork is laid out, which started from the
+  // source without them
+  bool has_forked_layout_{false};
+  std::vector<std::pair<MarkdownBaseStylePart, Range>> forked_range_styles_;
 
   Paddings paddings_{};
   std::shared_ptr<MarkdownContext> context_{nullptr};
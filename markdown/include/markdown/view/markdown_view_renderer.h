@@ -15,6 +15,17 @@ namespace serval::markdown {
 class MarkdownPlatformView;
 class MarkdownViewContainerHandle;
 
+// Fully revealed lines of the typewriter's active paragraph region. In
+// incremental typewriter mode the region view keeps them drawn while a tail
+// view on top redraws only the rest of the region each step.
+// The page is held weakly, so a page relaid out at a freed page's address is
+// never taken for the retained one.
+struct MarkdownTypewriterRetention {
+  std::weak_ptr<MarkdownPage> page_;
+  int32_t region_index_{-1};
+  int32_t char_end_{0};
+};
+
 class MarkdownViewRenderer {
  public:
   explicit MarkdownViewRenderer(MarkdownPlatformView* main_view = nullptr)
@@ -30,6 +41,7 @@ class MarkdownViewRenderer {
   void SetMarkdownAnimationStep(int32_t step);
   void SetContentComplete(bool complete);
   void SetEnableRegionView(bool enable);
+  void SetIncrementalTypewriter(bool enable);
   void OnNextFrame();
   void RequestDrawRegion(uint32_t region_index);
 
@@ -50,6 +62,10 @@ class MarkdownViewRenderer {
   void UpdateRegionViewsByViewRect();
   void UpdateRegionViewsByAnimationStep(int32_t previous_step);
   void UpdateTypewriterCursorBounds();
+  bool NeedRetainTypewriterRegion(const MarkdownPage& page) const;
+  void UpdateTypewriterRetention();
+  void AttachTypewriterTailDrawable();
+  void RemoveTypewriterTailView();
   void UpdateVisibleRegionViews(RectF view_rect);
   void ClearRegionViewPool();
 
@@ -63,11 +79,16 @@ class MarkdownViewRenderer {
       border_views_;
   std::vector<std::shared_ptr<MarkdownPlatformView>> region_view_pool_;
   std::vector<std::shared_ptr<MarkdownPlatformView>> scroll_x_region_view_pool_;
+  std::shared_ptr<MarkdownPlatformView> typewriter_tail_view_;
+  MarkdownTypewriterRetention typewriter_retention_;
+  // page typewriter_retention_ was last computed for
+  std::weak_ptr<MarkdownPage> retention_source_page_;
   bool region_views_dirty_{true};
   bool full_redraw_required_{true};
   bool has_last_view_rect_{false};
   bool content_complete_{true};
   bool enable_region_view_{true};
+  bool incremental_typewriter_{false};
   RectF last_view_rect_{};
 };
 }  // namespace serval::markdown
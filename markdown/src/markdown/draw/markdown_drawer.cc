@@ -10,9 +10,12 @@
 #include "markdown/element/markdown_table.h"
 #include "markdown/layout/markdown_selection.h"
 #include "markdown/utils/markdown_platform.h"
+#include "markdown/utils/markdown_trace.h"
 namespace serval::markdown {
 
 void MarkdownDrawer::DrawPage(const serval::markdown::MarkdownPage& page) {
+  MARKDOWN_TRACE_EVENT("MarkdownDrawer::DrawPage", "region_count",
+                       page.GetRegionCount());
   tttext::LayoutDrawer drawer(canvas_);
   canvas_->Save();
   canvas_->ClipRect(0, 0, std::min(page.GetLayoutWidth(), page.max_width_),
@@ -78,14 +81,17 @@ void MarkdownDrawer::DrawRegion(const MarkdownPage& page,
   }
   int32_t region_start = region->element_->GetCharStart();
   int32_t region_end = region->element_->GetCharCount() + region_start;
-  const auto& attachments = page.GetTextAttachments();
-  for (const auto& attachment : attachments) {
+  std::vector<MarkdownTextAttachment*> attachments;
+  std::vector<MarkdownTextAttachment*> border_attachments;
+  CollectRegionAttachments(page, region_index, &attachments,
+                           &border_attachments);
+  for (auto* attachment : attachments) {
     if (attachment->attachment_layer_ == AttachmentLayer::kBackground) {
-      DrawAttachmentOnRegion(page, attachment.get(), region_start, region_end);
+      DrawAttachmentOnRegion(page, attachment, region_start, region_end);
     }
   }
-  for (const auto& attachment : page.GetBorderAttachments()) {
-    DrawAttachmentOnRegion(page, attachment.get(), region_start, region_end);
+  for (auto* attachment : border_attachments) {
+    DrawAttachmentOnRegion(page, attachment, region_start, region_end);
   }
   canvas_->Save();
   if (region->scroll_x_) {
@@ -96,9 +102,9 @@ void MarkdownDrawer::DrawRegion(const MarkdownPage& page,
   }
   DrawRegion(*region, &drawer);
   canvas_->Restore();
-  for (const auto& attachment : attachments) {
+  for (auto* attachment : attachments) {
     if (attachment->attachment_layer_ == AttachmentLayer::kForeGround) {
-      DrawAttachmentOnRegion(page, attachment.get(), region_start, region_end);
+      DrawAttachmentOnRegion(page, attachment, region_start, region_end);
     }
   }
   canvas_->Restore();
@@ -393,9 +399,9 @@ void MarkdownDrawer::DrawTextRegion(tttext::LayoutRegion* page,
 
 void MarkdownDrawer::DrawAttachment(const MarkdownPage& page,
                                     MarkdownTextAttachment* attachment) {
-  const auto rects = MarkdownSelection::GetSelectionRectByCharPos(
-      &page, attachment->start_index_, attachment->end_index_,
-      MarkdownSelection::RectType::kLineBounding);
+  const auto rects = GetAttachmentRects(page, attachment,
+                                        attachment->start_index_,
+                                        attachment->end_index_);
   attachment->DrawOnMultiLines(canvas_, rects, 0, context_);
 }
 
@@ -410,4 +416,37 @@ void MarkdownDrawer::DrawAttachmentOnRegion(const MarkdownPage& page,
   DrawAttachment(page, attachment);
 }
 
+void MarkdownDrawer::CollectRegionAttachments(
+    const MarkdownPage& page, uint32_t region_index,
+    std::vector<MarkdownTextAttachment*>* text,
+    std::vector<MarkdownTextAttachment*>* border) {
+  const auto& geometry = page.GetAttachmentGeometry();
+  if (geometry.IsBuilt()) {
+    geometry.GetRegionAttachments(region_index, text, border);
+    return;
+  }
+  text->clear();
+  border->clear();
+  for (const auto& attachment : page.GetTextAttachments()) {
+    text->emplace_back(attachment.get());
+  }
+  for (const auto& attachment : page.GetBorderAttachments()) {
+    border->emplace_back(attachment.get());
+  }
+}
+
+std::vector<RectF> MarkdownDrawer::GetAttachmentRects(
+    const MarkdownPage& page, const MarkdownTextAttachment* attachment,
+    int32_t start_index, int32_t end_index) {
+  std::vector<RectF> rects;
+  if (start_index == attachment->start_index_ &&
+      end_index == attachment->end_index_ &&
+      page.GetAttachmentGeometry().GetRects(page, attachment, &rects)) {
+    return rects;
+  }
+  return MarkdownSelection::GetSelectionRectByCharPos(
+      &page, start_index, end_index,
+      MarkdownSelection::RectType::kLineBounding);
+}
+
 }  // namespace serval::markdown
@@ -79,8 +79,11 @@ void MarkdownCharTypewriterDrawer::DrawPage(const MarkdownPage& page) {
 
 void MarkdownCharTypewriterDrawer::DrawTypewriterCursor() {
   cursor_position_ = CalculateCursorPosition(page_);
+  const auto& steps = page_->GetLineIndex();
   bool typewriter_complete =
-      max_char_count_ >= MarkdownSelection::GetPageCharCount(page_);
+      max_char_count_ >= (steps.IsBuilt()
+                              ? steps.GetPageCharCount()
+                              : MarkdownSelection::GetPageCharCount(page_));
   if (typewriter_cursor_ != nullptr &&
       (!typewriter_complete || draw_cursor_if_complete_)) {
     canvas_->Save();
@@ -127,13 +130,116 @@ void MarkdownCharTypewriterDrawer::DrawRegion(const MarkdownPage& page,
     return;
   draw_char_count_ = char_start;
   MarkdownDrawer::DrawRegion(page, region_index);
-  if (char_end >= max_char_count_) {
+  if (draw_cursor_ && char_end >= max_char_count_) {
     canvas_->Save();
     DrawTypewriterCursor();
     canvas_->Restore();
   }
 }
 
+void MarkdownCharTypewriterDrawer::DrawRegionTail(const MarkdownPage& page,
+                                                  uint32_t region_index,
+                                                  int32_t char_start) {
+  const auto* region = page.GetRegion(region_index);
+  if (region == nullptr ||
+      region->element_->GetType() != MarkdownElementType::kParagraph) {
+    return;
+  }
+  page_ = &page;
+  const int32_t region_start = region->element_->GetCharStart();
+  const int32_t region_end = region_start + region->element_->GetCharCount();
+  char_start = std::max(char_start, region_start);
+  if (char_start < max_char_count_) {
+    canvas_->Save();
+    const auto region_rect = page.GetRegionRect(region_index);
+    canvas_->ClipRect(region_rect.GetLeft(), region_rect.GetTop(),
+                      region_rect.GetRight(), region_rect.GetBottom(), false);
+    if (region->scroll_x_) {
+      canvas_->ClipRect(region->scroll_x_view_rect_.GetLeft(),
+                        region->scroll_x_view_rect_.GetTop(),
+                        region->scroll_x_view_rect_.GetRight(),
+                        region->scroll_x_view_rect_.GetBottom(), true);
+    }
+    min_char_index_ = char_start;
+    std::vector<MarkdownTextAttachment*> attachments;
+    std::vector<MarkdownTextAttachment*> border_attachments;
+    CollectRegionAttachments(page, region_index, &attachments,
+                             &border_attachments);
+    for (auto* attachment : attachments) {
+      if (attachment->attachment_layer_ == AttachmentLayer::kBackground) {
+        DrawAttachmentOnRegion(page, attachment, char_start, region_end);
+      }
+    }
+    for (auto* attachment : border_attachments) {
+      DrawAttachmentOnRegion(page, attachment, char_start, region_end);
+    }
+    canvas_->Save();
+    if (region->scroll_x_) {
+      canvas_->Translate(region->scroll_x_offset_, 0);
+    }
+    canvas_->Translate(region->rect_.GetLeft(), region->rect_.GetTop());
+    auto* layout_region =
+        static_cast<const MarkdownPageParagraphRegion*>(region)->region_.get();
+    if (layout_region != nullptr) {
+      tttext::LayoutDrawer drawer(canvas_);
+      int32_t line_start = region_start;
+      for (uint32_t i = 0; i < layout_region->GetLineCount(); i++) {
+        auto* line = layout_region->GetLine(i);
+        const auto line_char_count = static_cast<int32_t>(line->GetCharCount());
+        const int32_t line_end = line_start + line_char_count;
+        if (line_end > char_start) {
+          drawer.DrawTextLine(
+              line, std::max(0, char_start - line_start),
+              std::min(line_char_count, max_char_count_ - line_start));
+        }
+        if (line_end >= max_char_count_) {
+          break;
+        }
+        line_start = line_end;
+      }
+    }
+    canvas_->Restore();
+    for (auto* attachment : attachments) {
+      if (attachment->attachment_layer_ == AttachmentLayer::kForeGround) {
+        DrawAttachmentOnRegion(page, attachment, char_start, region_end);
+      }
+    }
+    min_char_index_ = 0;
+    canvas_->Restore();
+  }
+  if (draw_cursor_ && region_end >= max_char_count_) {
+    canvas_->Save();
+    DrawTypewriterCursor();
+    canvas_->Restore();
+  }
+}
+
+int32_t MarkdownCharTypewriterDrawer::GetRevealedLinesEnd(
+    const MarkdownPage& page, uint32_t region_index, int32_t max_char_count) {
+  const auto* region = page.GetRegion(region_index);
+  if (region == nullptr ||
+      region->element_->GetType() != MarkdownElementType::kParagraph) {
+    return -1;
+  }
+  int32_t revealed_end = region->element_->GetCharStart();
+  auto* layout_region =
+      static_cast<const MarkdownPageParagraphRegion*>(region)->region_.get();
+  if (layout_region == nullptr) {
+    return revealed_end;
+  }
+  // same per line char counts as DrawTextRegion()
+  for (uint32_t i = 0; i < layout_region->GetLineCount(); i++) {
+    const int32_t line_end =
+        revealed_end +
+        static_cast<int32_t>(layout_region->GetLine(i)->GetCharCount());
+    if (line_end > max_char_count) {
+      break;
+    }
+    revealed_end = line_end;
+  }
+  return revealed_end;
+}
+
 PointF MarkdownCharTypewriterDrawer::CalculateCursorPosition(
     const MarkdownPage* page) {
   page_ = page;
@@ -142,35 +248,31 @@ PointF MarkdownCharTypewriterDrawer::CalculateCursorPosition(
     max_draw_height_ = 0;
     return {0, 0};
   }
-  auto page_char_count = MarkdownSelection::GetPageCharCount(page_);
-  max_char_count = std::min(page_char_count, max_char_count) - 1;
+  MarkdownPageLineIndex local_steps;
+  const auto* steps = &page_->GetLineIndex();
+  if (!steps->IsBuilt()) {
+    local_steps.Build(*page_);
+    steps = &local_steps;
+  }
+  max_char_count = std::min(steps->GetPageCharCount(), max_char_count) - 1;
   if (max_char_count < 0) {
     max_draw_height_ = 0;
     return {0, 0};
   }
-  auto region_infos = MarkdownSelection::GetSelectionRegionsByCharRange(
-      page, max_char_count, max_char_count + 1);
-  if (region_infos.empty()) {
+  MarkdownTypewriterStep step;
+  if (!steps->FindStep(*page_, max_char_count, &step)) {
     return {0, 0};
   }
-  auto& region_info = region_infos.back();
-  auto* region = region_info.region_;
-  if (region->GetLineCount() == 0) {
-    max_draw_height_ = region_info.row_bottom_ >= 0 ? region_info.row_bottom_
-                                                    : region_info.offset_.y_;
-    return region_info.offset_;
+  if (step.line_ == nullptr) {
+    max_draw_height_ =
+        step.row_bottom_ >= 0 ? step.row_bottom_ : step.offset_.y_;
+    return step.offset_;
   }
-  auto char_index_in_region = max_char_count - region_info.char_pos_offset_;
-  tttext::TextLine* line = nullptr;
-  for (uint32_t i = 0; i < region->GetLineCount(); i++) {
-    line = region->GetLine(i);
-    if (static_cast<int32_t>(line->GetEndCharPos()) > char_index_in_region) {
-      break;
-    }
-  }
-  max_draw_height_ = region_info.row_bottom_ >= 0
-                         ? region_info.row_bottom_
-                         : region_info.offset_.y_ + line->GetLineBottom();
+  auto char_index_in_region = max_char_count - step.char_pos_offset_;
+  auto* line = step.line_;
+  max_draw_height_ = step.row_bottom_ >= 0
+                         ? step.row_bottom_
+                         : step.offset_.y_ + line->GetLineBottom();
   float bounding_rect[4];
   line->GetCharBoundingRect(bounding_rect, char_index_in_region);
   auto [left, top, width, height] = bounding_rect;
@@ -180,11 +282,11 @@ PointF MarkdownCharTypewriterDrawer::CalculateCursorPosition(
   auto cursor_x = left + width;
   auto cursor_y = line->GetLineBaseLine();
   auto cursor_position = CalculateCursorPosition(
-      line, {cursor_x, cursor_y}, region_info.offset_, typewriter_cursor_,
+      line, {cursor_x, cursor_y}, step.offset_, typewriter_cursor_,
       page_->GetMaxWidth(),
       style_ != nullptr ? style_->typewriter_cursor_.vertical_align_
                         : MarkdownVerticalAlign::kBaseline);
-  cursor_position += region_info.offset_;
+  cursor_position += step.offset_;
   max_draw_height_ = std::max(
       max_draw_height_, cursor_position.y_ + typewriter_cursor_->GetDescent() -
                             typewriter_cursor_->GetAscent());
@@ -260,15 +362,18 @@ void MarkdownCharTypewriterDrawer::DrawAttachmentOnRegion(
   if (max_char_count_ <= start_index) {
     return;
   }
-  const auto rects_origin = MarkdownSelection::GetSelectionRectByCharPos(
-      &page, start_index, end_index,
-      MarkdownSelection::RectType::kLineBounding);
+  if (min_char_index_ >= end_index) {
+    return;
+  }
+  const auto rects_origin =
+      GetAttachmentRects(page, attachment, start_index, end_index);
   float total_width = 0;
   for (auto& r : rects_origin) {
     total_width += r.GetWidth();
   }
-  if (max_char_count_ < end_index) {
-    end_index = max_char_count_;
+  if (max_char_count_ < end_index || min_char_index_ > start_index) {
+    end_index = std::min(end_index, max_char_count_);
+    start_index = std::max(start_index, min_char_index_);
     const auto rects = MarkdownSelection::GetSelectionRectByCharPos(
         &page, start_index, end_index,
         MarkdownSelection::RectType::kLineBounding);
@@ -8,6 +8,7 @@
 #include "markdown/layout/markdown_selection.h"
 #include "markdown/parser/embed/markdown_parser_embed.h"
 #include "markdown/utils/markdown_string_utils.h"
+#include "markdown/utils/markdown_trace.h"
 
 namespace {
 
@@ -26,6 +27,17 @@ void TrimLineBreaks(std::string* text) {
 }  // namespace
 
 namespace serval::markdown {
+const std::shared_ptr<const MarkdownStyle>&
+MarkdownDocument::GetDefaultStyle() {
+  static const auto* style = new std::shared_ptr<const MarkdownStyle>(
+      std::make_shared<const MarkdownStyle>());
+  return *style;
+}
+
+void MarkdownDocument::SetStyle(std::shared_ptr<const MarkdownStyle> style) {
+  style_ = style == nullptr ? GetDefaultStyle() : std::move(style);
+}
+
 const MarkdownLink* MarkdownDocument::GetLinkByTouchPosition(PointF point) {
   if (links_.empty()) {
     return nullptr;
@@ -148,7 +160,7 @@ std::pair<float, float> MarkdownDocument::GetInlineViewOrigin(
   }
 
   if (truncation_delegate_ != nullptr &&
-      style_.truncation_.truncation_.content_ == idSelector) {
+      style_->truncation_.truncation_.content_ == idSelector) {
     // is truncation view
     auto pos = GetTruncationOrigin();
     return std::make_pair(pos.x_, pos.y_);
@@ -169,7 +181,7 @@ MarkdownDocument::GetAllInlineViewOrigin() {
     // is truncation view
     auto pos = GetTruncationOrigin();
     if (pos != PointF{0, 0}) {
-      inline_views.emplace_back(style_.truncation_.truncation_.content_, pos);
+      inline_views.emplace_back(style_->truncation_.truncation_.content_, pos);
     }
   }
   return inline_views;
@@ -183,7 +195,7 @@ std::vector<std::string> MarkdownDocument::GetAllInlineViewId() {
   }
   if (truncation_delegate_ != nullptr) {
     // is truncation view
-    inline_views.emplace_back(style_.truncation_.truncation_.content_);
+    inline_views.emplace_back(style_->truncation_.truncation_.content_);
   }
   return inline_views;
 }
@@ -265,14 +277,16 @@ void MarkdownDocument::ClearForParse() {
 }
 
 void MarkdownDocument::UpdateTruncation(float width) {
-  if (style_.truncation_.truncation_.truncation_type_ ==
+  if (style_->truncation_.truncation_.truncation_type_ ==
       MarkdownTruncationType::kText) {
-    truncation_text_ = U8StringToU16(style_.truncation_.truncation_.content_);
+    truncation_text_ = U8StringToU16(style_->truncation_.truncation_.content_);
     truncation_delegate_ = nullptr;
-  } else if (style_.truncation_.truncation_.truncation_type_ ==
+  } else if (style_->truncation_.truncation_.truncation_type_ ==
              MarkdownTruncationType::kView) {
-    truncation_delegate_ = loader_->LoadInlineView(
-        style_.truncation_.truncation_.content_.c_str(), width, 1e5);
+    truncation_delegate_ = MARKDOWN_TRACE_CALL(
+        "MarkdownResourceLoader::LoadInlineView",
+        loader_->LoadInlineView(
+            style_->truncation_.truncation_.content_.c_str(), width, 1e5));
     truncation_text_.clear();
   }
 }
@@ -618,7 +632,8 @@ std::vector<std::string> MarkdownDocument::GetVisibleInlineViews(
       result.emplace_back(id);
     }
   }
-  auto& cursor_id = style_.typewriter_cursor_.typewriter_cursor_.custom_cursor_;
+  const auto& cursor_id =
+      style_->typewriter_cursor_.typewriter_cursor_.custom_cursor_;
   if (!cursor_id.empty()) {
     if (!content_complete || animation_step < char_count) {
       result.emplace_back(cursor_id);
@@ -628,7 +643,7 @@ std::vector<std::string> MarkdownDocument::GetVisibleInlineViews(
       (static_cast<uint32_t>(char_count) <
        para_vec_.back()->GetCharStart() + para_vec_.back()->GetCharCount()) &&
       (truncation_delegate_ != nullptr)) {
-    result.emplace_back(style_.truncation_.truncation_.content_);
+    result.emplace_back(style_->truncation_.truncation_.content_);
   }
   return result;
 }
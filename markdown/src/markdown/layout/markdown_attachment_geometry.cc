@@ -0,0 +1,140 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "markdown/layout/markdown_attachment_geometry.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "markdown/element/markdown_attachments.h"
+#include "markdown/element/markdown_page.h"
+#include "markdown/layout/markdown_selection.h"
+namespace serval::markdown {
+void MarkdownAttachmentGeometry::Build(const MarkdownPage& page) {
+  Clear();
+  for (const auto& attachment : page.GetTextAttachments()) {
+    attachments_.emplace_back(attachment.get());
+  }
+  text_attachment_count_ = static_cast<uint32_t>(attachments_.size());
+  for (const auto& attachment : page.GetBorderAttachments()) {
+    attachments_.emplace_back(attachment.get());
+  }
+  const auto region_count = page.GetRegionCount();
+  const auto& line_index = page.GetLineIndex();
+  std::vector<std::vector<uint32_t>> attachments_by_region(region_count);
+  std::vector<RectF> region_rects;
+  rect_begin_.reserve(attachments_.size() + 1);
+  for (uint32_t index = 0; index < attachments_.size(); index++) {
+    auto* attachment = attachments_[index];
+    attachment_index_.emplace(attachment, index);
+    rect_begin_.emplace_back(static_cast<uint32_t>(rects_.size()));
+    const int32_t start = attachment->start_index_;
+    const int32_t end = attachment->end_index_;
+    if (start < 0 || end < 0) {
+      step_relative_attachments_.emplace_back(index);
+      continue;
+    }
+    uint32_t region_index =
+        line_index.IsBuilt() ? line_index.FindFirstRegionEndingAtOrAfter(start)
+                             : 0;
+    for (; region_index < region_count; region_index++) {
+      auto* region = page.GetRegion(region_index);
+      const auto region_start =
+          static_cast<int32_t>(region->element_->GetCharStart());
+      const auto region_end =
+          region_start + static_cast<int32_t>(region->element_->GetCharCount());
+      if (region_start > end) {
+        break;
+      }
+      // the regions GetSelectionRectByCharPos() takes rects from
+      if (region_end >= start && region_start < end) {
+        region_rects.clear();
+        MarkdownSelection::GetRegionSelectionRectByCharPos(
+            &page, region_index, start, end, &region_rects,
+            MarkdownSelection::RectType::kLineBounding);
+        for (const auto& rect : region_rects) {
+          rects_.emplace_back(
+              CachedRect{region_index, region->scroll_x_offset_, rect});
+        }
+      }
+      // the regions MarkdownDrawer::DrawAttachmentOnRegion() draws on
+      if (region_end > start) {
+        attachments_by_region[region_index].emplace_back(index);
+      }
+    }
+  }
+  rect_begin_.emplace_back(static_cast<uint32_t>(rects_.size()));
+  region_begin_.reserve(region_count + 1);
+  for (const auto& attachments : attachments_by_region) {
+    region_begin_.emplace_back(
+        static_cast<uint32_t>(region_attachments_.size()));
+    region_attachments_.insert(region_attachments_.end(), attachments.begin(),
+                               attachments.end());
+  }
+  region_begin_.emplace_back(static_cast<uint32_t>(region_attachments_.size()));
+  built_ = true;
+}
+
+void MarkdownAttachmentGeometry::Clear() {
+  attachments_.clear();
+  text_attachment_count_ = 0;
+  attachment_index_.clear();
+  rect_begin_.clear();
+  rects_.clear();
+  region_begin_.clear();
+  region_attachments_.clear();
+  step_relative_attachments_.clear();
+  built_ = false;
+}
+
+bool MarkdownAttachmentGeometry::GetRects(
+    const MarkdownPage& page, const MarkdownTextAttachment* attachment,
+    std::vector<RectF>* rects) const {
+  if (attachment->start_index_ < 0 || attachment->end_index_ < 0) {
+    return false;
+  }
+  const auto iter = attachment_index_.find(attachment);
+  if (iter == attachment_index_.end()) {
+    return false;
+  }
+  const auto begin = rect_begin_[iter->second];
+  const auto end = rect_begin_[iter->second + 1];
+  rects->clear();
+  rects->reserve(end - begin);
+  for (auto i = begin; i < end; i++) {
+    const auto& cached = rects_[i];
+    auto rect = cached.rect_;
+    auto* region = page.GetRegion(cached.region_index_);
+    if (region != nullptr && region->scroll_x_ &&
+        region->scroll_x_offset_ != cached.scroll_x_offset_) {
+      rect.Offset(region->scroll_x_offset_ - cached.scroll_x_offset_, 0);
+    }
+    rects->emplace_back(rect);
+  }
+  return true;
+}
+
+void MarkdownAttachmentGeometry::GetRegionAttachments(
+    uint32_t region_index, std::vector<MarkdownTextAttachment*>* text,
+    std::vector<MarkdownTextAttachment*>* border) const {
+  text->clear();
+  border->clear();
+  if (region_index + 1 >= region_begin_.size()) {
+    return;
+  }
+  const auto region_first =
+      region_attachments_.begin() + region_begin_[region_index];
+  const auto region_last =
+      region_attachments_.begin() + region_begin_[region_index + 1];
+  std::vector<uint32_t> indices;
+  indices.reserve((region_last - region_first) +
+                  step_relative_attachments_.size());
+  std::merge(region_first, region_last, step_relative_attachments_.begin(),
+             step_relative_attachments_.end(), std::back_inserter(indices));
+  for (const auto index : indices) {
+    (index < text_attachment_count_ ? text : border)
+        ->emplace_back(attachments_[index]);
+  }
+}
+}  // namespace serval::markdown
@@ -13,6 +13,7 @@
 #include "markdown/layout/markdown_selection.h"
 #include "markdown/parser/embed/markdown_parser_embed.h"
 #include "markdown/utils/markdown_platform.h"
+#include "markdown/utils/markdown_trace.h"
 namespace serval::markdown {
 MarkdownLayout::MarkdownLayout(MarkdownDocument* document)
     : document_(document),
@@ -24,6 +25,8 @@ std::pair<float, float> MarkdownLayout::Layout(float width, float height,
                                                int text_max_lines) {
   if (document_ == nullptr)
     return {0, 0};
+  MARKDOWN_TRACE_EVENT("MarkdownLayout::Layout", "element_count",
+                       document_->GetParagraphs().size());
   current_layout_bottom_ = paddings_.bottom_;
   max_width_ = width;
   max_height_ = height - paddings_.top_ - paddings_.bottom_;
@@ -48,13 +51,14 @@ std::pair<float, float> MarkdownLayout::Layout(float width, float height,
   page_->SetElements(document_->para_vec_);
   auto& attachments = document_->border_attachments_;
   page_->SetBorderAttachments(std::move(attachments));
+  const auto& style = document_->GetStyle();
   if (document_->loader_ != nullptr &&
-      !document_->GetStyle()
-           .typewriter_cursor_.typewriter_cursor_.custom_cursor_.empty()) {
-    auto custom_typewriter_cursor = document_->loader_->LoadInlineView(
-        document_->style_.typewriter_cursor_.typewriter_cursor_.custom_cursor_
-            .c_str(),
-        width, height);
+      !style.typewriter_cursor_.typewriter_cursor_.custom_cursor_.empty()) {
+    auto custom_typewriter_cursor = MARKDOWN_TRACE_CALL(
+        "MarkdownResourceLoader::LoadInlineView",
+        document_->loader_->LoadInlineView(
+            style.typewriter_cursor_.typewriter_cursor_.custom_cursor_.c_str(),
+            width, height));
     if (custom_typewriter_cursor != nullptr) {
       page_->SetCustomTypewriterCursor(std::move(custom_typewriter_cursor));
     }
@@ -81,21 +85,22 @@ std::pair<float, float> MarkdownLayout::Layout(float width, float height,
     } else {
       bottom = end_para->border_->rect_.GetBottom();
     }
-    auto border_left = document_->style_.quote_.block_.margin_left_ +
-                       document_->style_.quote_.border_.border_width_ / 2;
-    auto border_right = max_width_ -
-                        document_->style_.quote_.block_.margin_right_ -
-                        document_->style_.quote_.border_.border_width_ / 2;
+    auto border_left = style.quote_.block_.margin_left_ +
+                       style.quote_.border_.border_width_ / 2;
+    auto border_right = max_width_ - style.quote_.block_.margin_right_ -
+                        style.quote_.border_.border_width_ / 2;
     auto border = std::make_unique<MarkdownQuoteBorder>();
     border->rect_ =
         RectF(border_left, top, border_right - border_left, bottom - top);
-    border->line_style_ = document_->style_.quote_border_line_;
+    border->line_style_ = style.quote_border_line_;
     page_->quote_borders_.emplace_back(std::move(border));
   }
   if (!document_->inherited_scroll_state_.empty()) {
     page_->ApplyScrollState(document_->inherited_scroll_state_);
     document_->inherited_scroll_state_.clear();
   }
+  page_->line_index_.Build(*page_);
+  page_->UpdateAttachmentGeometry();
   document_->SetPage(page_);
   return std::make_pair(page_->GetLayoutWidth(), page_->GetLayoutHeight());
 }
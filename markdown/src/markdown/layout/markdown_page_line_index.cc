@@ -0,0 +1,226 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "markdown/layout/markdown_page_line_index.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "markdown/element/markdown_page.h"
+#include "markdown/element/markdown_table.h"
+#include "markdown/layout/markdown_selection.h"
+namespace serval::markdown {
+void MarkdownPageLineIndex::Build(const MarkdownPage& page) {
+  Clear();
+  page_char_count_ = MarkdownSelection::GetPageCharCount(&page);
+  region_char_end_max_.reserve(page.GetRegionCount());
+  line_end_char_indices_.reserve(std::max(0, page.GetLineCount()));
+  int32_t region_end_max = std::numeric_limits<int32_t>::min();
+  int32_t line_end_max = std::numeric_limits<int32_t>::min();
+  const auto add_line = [this, &line_end_max](int32_t line_end,
+                                              bool searchable) {
+    line_end_char_indices_.emplace_back(line_end);
+    if (searchable) {
+      line_end_max = std::max(line_end_max, line_end);
+    }
+    line_end_char_max_.emplace_back(line_end_max);
+  };
+  for (uint32_t index = 0; index < page.GetRegionCount(); index++) {
+    auto* region = page.GetRegion(index);
+    auto* element = region->element_.get();
+    if (element == nullptr) {
+      region_char_end_max_.emplace_back(region_end_max);
+      continue;
+    }
+    const auto element_char_start =
+        static_cast<int32_t>(element->GetCharStart());
+    const auto element_char_end =
+        element_char_start + static_cast<int32_t>(element->GetCharCount());
+    region_end_max = std::max(region_end_max, element_char_end);
+    region_char_end_max_.emplace_back(region_end_max);
+    if (element->GetType() == MarkdownElementType::kParagraph) {
+      auto* layout_region =
+          static_cast<MarkdownPageParagraphRegion*>(region)->region_.get();
+      // a paragraph still answers for the char right after its end
+      AddStepEntry(element_char_start, element_char_end, index, -1, -1,
+                   layout_region);
+      if (layout_region == nullptr || layout_region->IsEmpty()) {
+        continue;
+      }
+      for (uint32_t line = 0; line < layout_region->GetLineCount(); line++) {
+        add_line(element_char_start + static_cast<int32_t>(
+                                          layout_region->GetLine(line)
+                                              ->GetEndCharPos()),
+                 true);
+      }
+    } else if (element->GetType() == MarkdownElementType::kTable) {
+      auto* table_region =
+          static_cast<MarkdownPageTableRegion*>(region)->table_.get();
+      auto* table = static_cast<MarkdownTableElement*>(element)->GetTable();
+      if (table_region == nullptr || table == nullptr) {
+        continue;
+      }
+      const int row_count = table_region->GetRowCount();
+      const int col_count = table->GetColumnCount();
+      for (int row = 0; row < row_count; row++) {
+        uint32_t row_end = 0;
+        if (col_count <= 0) {
+          row_end = 0;
+        } else if (row + 1 < row_count) {
+          row_end = table->GetCell(row + 1, 0).char_start_;
+        } else {
+          row_end = static_cast<uint32_t>(table->GetCharCount());
+        }
+        add_line(element_char_start + static_cast<int32_t>(row_end),
+                 col_count > 0);
+        for (int col = 0; col < table_region->GetColumnCount(); col++) {
+          auto& region_cell = table_region->GetCell(row, col);
+          if (region_cell.region_ == nullptr) {
+            continue;
+          }
+          auto& cell = table->GetCell(row, col);
+          const auto cell_start =
+              element_char_start + static_cast<int32_t>(cell.char_start_);
+          const auto cell_last = std::min(
+              element_char_end,
+              cell_start + static_cast<int32_t>(cell.char_count_) - 1);
+          if (cell_last < cell_start) {
+            continue;
+          }
+          AddStepEntry(cell_start, cell_last, index, row, col,
+                       region_cell.region_.get());
+        }
+      }
+    }
+  }
+  // prev_wider_ lets FindStep() skip back over entries ending too early
+  std::vector<int32_t> stack;
+  for (size_t i = 0; i < step_entries_.size(); i++) {
+    while (!stack.empty() && step_entries_[stack.back()].char_last_ <=
+                                 step_entries_[i].char_last_) {
+      stack.pop_back();
+    }
+    step_entries_[i].prev_wider_ = stack.empty() ? -1 : stack.back();
+    stack.emplace_back(static_cast<int32_t>(i));
+  }
+  built_ = true;
+}
+
+void MarkdownPageLineIndex::AddStepEntry(int32_t char_start,
+                                         int32_t char_last,
+                                         uint32_t page_region_index,
+                                         int32_t row, int32_t column,
+                                         tttext::LayoutRegion* region) {
+  StepEntry entry{char_start,
+                  char_last,
+                  -1,
+                  page_region_index,
+                  row,
+                  column,
+                  region,
+                  static_cast<uint32_t>(step_line_end_char_pos_.size()),
+                  0};
+  if (region != nullptr) {
+    for (uint32_t i = 0; i < region->GetLineCount(); i++) {
+      step_line_end_char_pos_.emplace_back(
+          region->GetLine(i)->GetEndCharPos());
+    }
+    entry.line_count_ = static_cast<uint32_t>(step_line_end_char_pos_.size()) -
+                        entry.line_begin_;
+  }
+  step_entries_.emplace_back(entry);
+}
+
+void MarkdownPageLineIndex::Clear() {
+  region_char_end_max_.clear();
+  line_end_char_indices_.clear();
+  line_end_char_max_.clear();
+  step_entries_.clear();
+  step_line_end_char_pos_.clear();
+  page_char_count_ = 0;
+  built_ = false;
+}
+
+uint32_t MarkdownPageLineIndex::FindFirstRegionEndingAtOrAfter(
+    int32_t char_pos) const {
+  return static_cast<uint32_t>(
+      std::lower_bound(region_char_end_max_.begin(),
+                       region_char_end_max_.end(), char_pos) -
+      region_char_end_max_.begin());
+}
+
+int32_t MarkdownPageLineIndex::FindFirstLineEndingAtOrAfter(
+    int32_t char_index) const {
+  auto iter = std::lower_bound(line_end_char_max_.begin(),
+                               line_end_char_max_.end(), char_index);
+  if (iter == line_end_char_max_.end()) {
+    return -1;
+  }
+  return static_cast<int32_t>(iter - line_end_char_max_.begin());
+}
+
+bool MarkdownPageLineIndex::FindStep(const MarkdownPage& page,
+                                     int32_t char_index,
+                                     MarkdownTypewriterStep* step) const {
+  // the last entry in page order covering the char, as the selection scan
+  // returns it
+  auto iter = std::upper_bound(
+      step_entries_.begin(), step_entries_.end(), char_index,
+      [](int32_t char_pos, const StepEntry& entry) {
+        return char_pos < entry.char_start_;
+      });
+  int32_t index = static_cast<int32_t>(iter - step_entries_.begin()) - 1;
+  while (index >= 0 && step_entries_[index].char_last_ < char_index) {
+    index = step_entries_[index].prev_wider_;
+  }
+  if (index < 0) {
+    return false;
+  }
+  const auto& entry = step_entries_[index];
+  auto* page_region = page.GetRegion(entry.page_region_index_);
+  if (page_region == nullptr) {
+    return false;
+  }
+  float x_offset = 0;
+  if (page_region->scroll_x_) {
+    x_offset = page_region->scroll_x_offset_;
+  }
+  step->page_region_index_ = entry.page_region_index_;
+  step->region_ = entry.region_;
+  step->char_pos_offset_ = entry.char_start_;
+  if (entry.row_ < 0) {
+    step->offset_ = PointF{page_region->rect_.GetLeft() + x_offset,
+                           page_region->rect_.GetTop()};
+    step->row_bottom_ = -1.f;
+  } else {
+    auto& region_cell = static_cast<MarkdownPageTableRegion*>(page_region)
+                            ->table_->GetCell(entry.row_, entry.column_);
+    step->offset_ = PointF{region_cell.cell_rect_.GetLeft(),
+                           region_cell.cell_rect_.GetTop()} +
+                    region_cell.region_offset_ +
+                    PointF{page_region->rect_.GetLeft() + x_offset,
+                           page_region->rect_.GetTop()};
+    step->row_bottom_ =
+        page_region->rect_.GetTop() + region_cell.cell_rect_.GetBottom();
+  }
+  step->line_ = nullptr;
+  if (entry.line_count_ > 0) {
+    // first line ending after the char, or the last line
+    const auto line_begin = step_line_end_char_pos_.begin() + entry.line_begin_;
+    const auto line_end = line_begin + entry.line_count_;
+    const auto char_index_in_region = char_index - entry.char_start_;
+    auto line_iter = std::upper_bound(
+        line_begin, line_end, char_index_in_region,
+        [](int32_t char_pos, uint32_t line_end_char_pos) {
+          return char_pos < static_cast<int32_t>(line_end_char_pos);
+        });
+    if (line_iter == line_end) {
+      line_iter--;
+    }
+    step->line_ = entry.region_->GetLine(
+        static_cast<uint32_t>(line_iter - line_begin));
+  }
+  return true;
+}
+}  // namespace serval::markdown
@@ -9,6 +9,21 @@
 #include "markdown/element/markdown_table.h"
 #include "markdown/utils/markdown_string_utils.h"
 namespace serval::markdown {
+namespace {
+// pages laid out by MarkdownLayout carry their index, pages assembled by hand
+// get a temporary one
+template <typename Query>
+auto QueryLineIndex(const MarkdownPage* page, Query query) {
+  const auto& index = page->GetLineIndex();
+  if (index.IsBuilt()) {
+    return query(index);
+  }
+  MarkdownPageLineIndex local_index;
+  local_index.Build(*page);
+  return query(local_index);
+}
+}  // namespace
+
 Range MarkdownSelection::GetCharRangeByPoint(
     const serval::markdown::MarkdownPage* page, PointF point,
     CharRangeType type) {
@@ -190,7 +205,12 @@ std::vector<RectF> MarkdownSelection::GetSelectionRectByCharPos(
     const MarkdownPage* page, int32_t char_pos_start, int32_t char_pos_end,
     RectType type, RectCoordinate coordinate) {
   std::vector<RectF> rect_vec;
-  for (auto& region : page->regions_) {
+  const auto first_region =
+      QueryLineIndex(page, [char_pos_start](const auto& index) {
+        return index.FindFirstRegionEndingAtOrAfter(char_pos_start);
+      });
+  for (auto i = first_region; i < page->regions_.size(); i++) {
+    auto& region = page->regions_[i];
     auto region_start = static_cast<int32_t>(region->element_->GetCharStart());
     auto region_count = region->element_->GetCharCount();
     int32_t region_end = region_start + region_count;
@@ -210,6 +230,21 @@ std::vector<RectF> MarkdownSelection::GetSelectionRectByCharPos(
   return rect_vec;
 }
 
+void MarkdownSelection::GetRegionSelectionRectByCharPos(
+    const MarkdownPage* page, uint32_t region_index, int32_t char_pos_start,
+    int32_t char_pos_end, std::vector<RectF>* rects, RectType type,
+    RectCoordinate coordinate) {
+  auto* region = page->GetRegion(region_index);
+  if (region == nullptr) {
+    return;
+  }
+  auto region_start = static_cast<int32_t>(region->element_->GetCharStart());
+  GetPageRegionSelectionRectByCharPos(
+      region, char_pos_start - region_start, char_pos_end - region_start,
+      rects, PointF{region->rect_.GetLeft(), region->rect_.GetTop()}, type,
+      coordinate);
+}
+
 RectF MarkdownSelection::GetSelectionClosedRectByCharPos(
     const MarkdownPage* page, int32_t char_pos_start, int32_t char_pos_end,
     RectType type, RectCoordinate coordinate) {
@@ -255,57 +290,12 @@ int MarkdownSelection::GetLineCount(const MarkdownPage* page) {
 
 std::vector<int32_t> MarkdownSelection::GetLineEndCharIndices(
     const MarkdownPage* page) {
-  std::vector<int32_t> line_end_char_indices;
   if (page == nullptr || page->regions_.empty()) {
-    return line_end_char_indices;
-  }
-
-  line_end_char_indices.reserve(static_cast<size_t>(GetLineCount(page)));
-  for (auto& region : page->regions_) {
-    auto* element = region->element_.get();
-    if (element == nullptr) {
-      continue;
-    }
-    const uint32_t element_char_start = element->GetCharStart();
-    if (element->GetType() == MarkdownElementType::kParagraph) {
-      auto* para_region =
-          static_cast<MarkdownPageParagraphRegion*>(region.get());
-      if (para_region->region_ == nullptr || para_region->region_->IsEmpty()) {
-        continue;
-      }
-      auto* layout_region = para_region->region_.get();
-      for (int line_index = 0; line_index < layout_region->GetLineCount();
-           ++line_index) {
-        auto* line = layout_region->GetLine(line_index);
-        line_end_char_indices.emplace_back(
-            static_cast<int32_t>(element_char_start + line->GetEndCharPos()));
-      }
-      continue;
-    }
-    if (element->GetType() == MarkdownElementType::kTable) {
-      auto* table_region = static_cast<MarkdownPageTableRegion*>(region.get());
-      auto* table_element = static_cast<MarkdownTableElement*>(element);
-      auto* table = table_element->GetTable();
-      if (table_region->table_ == nullptr || table == nullptr) {
-        continue;
-      }
-      const int row_count = table_region->table_->GetRowCount();
-      const int col_count = table->GetColumnCount();
-      for (int row = 0; row < row_count; ++row) {
-        uint32_t row_end = 0;
-        if (col_count <= 0) {
-          row_end = 0;
-        } else if (row + 1 < row_count) {
-          row_end = table->GetCell(row + 1, 0).char_start_;
-        } else {
-          row_end = static_cast<uint32_t>(table->GetCharCount());
-        }
-        line_end_char_indices.emplace_back(
-            static_cast<int32_t>(element_char_start + row_end));
-      }
-    }
+    return {};
   }
-  return line_end_char_indices;
+  return QueryLineIndex(page, [](const MarkdownPageLineIndex& index) {
+    return index.GetLineEndCharIndices();
+  });
 }
 
 int MarkdownSelection::GetCharIndexByLineIndex(const MarkdownPage* page,
@@ -321,56 +311,14 @@ int MarkdownSelection::GetCharIndexByLineIndex(const MarkdownPage* page,
     return GetPageCharCount(page);
   }
 
-  int current_line_index = 0;
-  for (auto& region : page->regions_) {
-    auto* element = region->element_.get();
-    if (element == nullptr) {
-      continue;
-    }
-    const uint32_t element_char_start = element->GetCharStart();
-    if (element->GetType() == MarkdownElementType::kParagraph) {
-      auto* para_region =
-          static_cast<MarkdownPageParagraphRegion*>(region.get());
-      if (para_region->region_ == nullptr || para_region->region_->IsEmpty()) {
-        continue;
-      }
-      auto* layout_region = para_region->region_.get();
-      const int region_line_count = layout_region->GetLineCount();
-      if (line_index >= current_line_index + region_line_count) {
-        current_line_index += region_line_count;
-        continue;
-      }
-      const int target_line = line_index - current_line_index;
-      auto* line = layout_region->GetLine(target_line);
-      return static_cast<int>(element_char_start + line->GetEndCharPos());
-    }
-    if (element->GetType() == MarkdownElementType::kTable) {
-      auto* table_region = static_cast<MarkdownPageTableRegion*>(region.get());
-      auto* table_element = static_cast<MarkdownTableElement*>(element);
-      auto* table = table_element->GetTable();
-      if (table_region->table_ == nullptr || table == nullptr) {
-        continue;
-      }
-      const int row_count = table_region->table_->GetRowCount();
-      if (line_index >= current_line_index + row_count) {
-        current_line_index += row_count;
-        continue;
-      }
-      const int target_row = line_index - current_line_index;
-      const int col_count = table->GetColumnCount();
-      if (col_count <= 0) {
-        return static_cast<int>(element_char_start);
-      }
-      uint32_t row_end = 0;
-      if (target_row + 1 < row_count) {
-        row_end = table->GetCell(target_row + 1, 0).char_start_;
-      } else {
-        row_end = static_cast<uint32_t>(table->GetCharCount());
-      }
-      return static_cast<int>(element_char_start + row_end);
-    }
-  }
-  return GetPageCharCount(page);
+  return QueryLineIndex(
+      page, [page, line_index](const MarkdownPageLineIndex& index) {
+        const auto& line_ends = index.GetLineEndCharIndices();
+        if (line_index < static_cast<int32_t>(line_ends.size())) {
+          return static_cast<int>(line_ends[line_index]);
+        }
+        return GetPageCharCount(page);
+      });
 }
 
 int MarkdownSelection::GetLineIndexByCharIndex(const MarkdownPage* page,
@@ -386,70 +334,11 @@ int MarkdownSelection::GetLineIndexByCharIndex(const MarkdownPage* page,
     return GetLineCount(page);
   }
 
-  int current_line_index = 0;
-  for (auto& region : page->regions_) {
-    auto* element = region->element_.get();
-    if (element == nullptr) {
-      continue;
-    }
-    const uint32_t element_char_start = element->GetCharStart();
-    if (element->GetType() == MarkdownElementType::kParagraph) {
-      auto* para_region =
-          static_cast<MarkdownPageParagraphRegion*>(region.get());
-      if (para_region->region_ == nullptr || para_region->region_->IsEmpty()) {
-        continue;
-      }
-      auto* layout_region = para_region->region_.get();
-      const int region_line_count = layout_region->GetLineCount();
-      auto* last_line = layout_region->GetLine(region_line_count - 1);
-      const uint32_t region_end =
-          element_char_start +
-          static_cast<uint32_t>(last_line->GetEndCharPos());
-      if (static_cast<uint32_t>(char_index) > region_end) {
-        current_line_index += region_line_count;
-        continue;
-      }
-      for (int line_index = 0; line_index < region_line_count; ++line_index) {
-        auto* line = layout_region->GetLine(line_index);
-        const uint32_t line_end =
-            element_char_start + static_cast<uint32_t>(line->GetEndCharPos());
-        if (line_end >= static_cast<uint32_t>(char_index)) {
-          return current_line_index + line_index;
-        }
-      }
-      current_line_index += region_line_count;
-      continue;
-    }
-    if (element->GetType() == MarkdownElementType::kTable) {
-      auto* table_region = static_cast<MarkdownPageTableRegion*>(region.get());
-      auto* table_element = static_cast<MarkdownTableElement*>(element);
-      auto* table = table_element->GetTable();
-      if (table_region->table_ == nullptr || table == nullptr) {
-        continue;
-      }
-      const int row_count = table_region->table_->GetRowCount();
-      const int col_count = table->GetColumnCount();
-      const uint32_t table_end =
-          element_char_start + static_cast<uint32_t>(table->GetCharCount());
-      if (static_cast<uint32_t>(char_index) > table_end || col_count <= 0) {
-        current_line_index += row_count;
-        continue;
-      }
-      for (int row = 0; row < row_count; ++row) {
-        uint32_t row_end = 0;
-        if (row + 1 < row_count) {
-          row_end = table->GetCell(row + 1, 0).char_start_;
-        } else {
-          row_end = static_cast<uint32_t>(table->GetCharCount());
-        }
-        if (element_char_start + row_end >= static_cast<uint32_t>(char_index)) {
-          return current_line_index + row;
-        }
-      }
-      current_line_index += row_count;
-    }
-  }
-  return GetLineCount(page);
+  const auto line_index =
+      QueryLineIndex(page, [char_index](const MarkdownPageLineIndex& index) {
+        return index.FindFirstLineEndingAtOrAfter(char_index);
+      });
+  return line_index < 0 ? GetLineCount(page) : line_index;
 }
 
 void MarkdownSelection::GetPageRegionSelectionRectByCharPos(
@@ -558,7 +447,12 @@ std::string MarkdownSelection::GetContentByCharPos(
     int32_t char_pos_end,
     std::vector<std::pair<uint32_t, std::string>>* inline_element_alt_strings) {
   std::string content;
-  for (auto& region : page->regions_) {
+  const auto first_region =
+      QueryLineIndex(page, [char_pos_start](const auto& index) {
+        return index.FindFirstRegionEndingAtOrAfter(char_pos_start);
+      });
+  for (auto i = first_region; i < page->regions_.size(); i++) {
+    auto& region = page->regions_[i];
     if (static_cast<int32_t>(region->element_->GetCharStart() +
                              region->element_->GetCharCount()) <
         char_pos_start) {
@@ -674,13 +568,10 @@ std::vector<MarkdownSelectionRegion>
 MarkdownSelection::GetSelectionRegionsByCharRange(
     const serval::markdown::MarkdownPage* page, int32_t char_pos_start,
     int32_t char_pos_end) {
-  auto iter_begin = std::lower_bound(
-      page->regions_.begin(), page->regions_.end(), char_pos_start,
-      [](const std::unique_ptr<MarkdownPageRegion>& region_l,
-         int32_t char_pos) -> bool {
-        return static_cast<int32_t>(region_l->element_->GetCharStart() +
-                                    region_l->element_->GetCharCount()) <
-               char_pos;
+  auto iter_begin =
+      page->regions_.begin() +
+      QueryLineIndex(page, [char_pos_start](const auto& index) {
+        return index.FindFirstRegionEndingAtOrAfter(char_pos_start);
       });
   if (iter_begin == page->regions_.end()) {
     return {};
@@ -5,6 +5,7 @@
 #include "markdown/parser/embed/markdown_parser_embed.h"
 
 #include <limits>
+#include <vector>
 
 #include "markdown/element/markdown_document.h"
 #include "markdown/element/markdown_paragraph.h"
@@ -22,6 +23,7 @@
 #include "markdown/utils/markdown_screen_metrics.h"
 #include "markdown/utils/markdown_string_utils.h"
 #include "markdown/utils/markdown_textlayout_headers.h"
+#include "markdown/utils/markdown_trace.h"
 extern "C" {
 #include "discount/discount_lite/markdown.h"
 }
@@ -55,8 +57,6 @@ void MarkdownParserEmbed::Parse(const char* src, int size,
                                 float width) {
   if (document_ == nullptr)
     return;
-  markdown_start = UTF8IndexToCIndex(src, size, markdown_start);
-  markdown_end = UTF8IndexToCIndex(src, size, markdown_end);
   auto* doc = mkd_string(src, size, 0);
   doc->cb.ud = this;
   doc->cb.paragraph_start = &MarkdownParserEmbed::OnParagraphStart;
@@ -68,20 +68,110 @@ void MarkdownParserEmbed::Parse(const char* src, int size,
   doc->cb.list_index = &MarkdownParserEmbed::OnListIndex;
   doc->cb.list_extra_level = &MarkdownParserEmbed::OnListExtraLevel;
   mkd_initialize();
+  BeginParse(src, size, markdown_start, markdown_end, width);
+  mkd_compile(doc, 0);
+  mkd_cleanup(doc);
+  recorded_events_ = nullptr;
+}
+
+void MarkdownParserEmbed::Replay(const MarkdownBlockEvents& events,
+                                 const char* src, int size,
+                                 int32_t markdown_start, int32_t markdown_end,
+                                 float width) {
+  if (document_ == nullptr)
+    return;
+  recorded_events_ = nullptr;
+  BeginParse(src, size, markdown_start, markdown_end, width);
+  std::vector<line> lines;
+  for (const auto& event : events.events_) {
+    switch (event.type_) {
+      case MarkdownBlockEvents::Type::kParagraphStart:
+        OnParagraphStart(event.value_);
+        break;
+      case MarkdownBlockEvents::Type::kParagraphText: {
+        // rebuild the list discount passed, pointing into the recorded text
+        lines.assign(event.line_count_, line{});
+        for (uint32_t i = 0; i < event.line_count_; i++) {
+          const auto& recorded = events.lines_[event.value_ + i];
+          auto& text_line = lines[i];
+          text_line.text.text =
+              const_cast<char*>(events.text_.data() + recorded.text_offset_);
+          text_line.text.size = recorded.size_;
+          text_line.text.alloc = recorded.size_;
+          text_line.dle = recorded.dle_;
+          text_line.markdown_offset = recorded.markdown_offset_;
+          text_line.next = i + 1 < event.line_count_ ? &lines[i + 1] : nullptr;
+        }
+        OnParagraphText(lines.empty() ? nullptr : lines.data());
+        break;
+      }
+      case MarkdownBlockEvents::Type::kHeaderNumber:
+        OnHeaderNumber(event.value_);
+        break;
+      case MarkdownBlockEvents::Type::kParagraphAlign:
+        OnParagraphAlign(event.value_);
+        break;
+      case MarkdownBlockEvents::Type::kListCheck:
+        OnListCheck(event.value_);
+        break;
+      case MarkdownBlockEvents::Type::kListIndex:
+        OnListIndex(event.value_);
+        break;
+      case MarkdownBlockEvents::Type::kListExtraLevel:
+        OnListExtraLevel(event.value_);
+        break;
+      case MarkdownBlockEvents::Type::kParagraphEnd:
+        OnParagraphEnd();
+        break;
+    }
+  }
+}
+
+void MarkdownParserEmbed::BeginParse(const char* src, int size,
+                                     int32_t markdown_start,
+                                     int32_t markdown_end, float width) {
+  markdown_start = UTF8IndexToCIndex(src, size, markdown_start);
+  markdown_end = UTF8IndexToCIndex(src, size, markdown_end);
   context_.char_offset_ = 0;
   context_.markdown_source_ = std::string_view(src, size);
   context_.byte_index_to_char_index_ =
-      CalculateByteIndexToCharIndexMap(context_.markdown_source_);
+      UTF8ByteIndexToCharIndexMap(context_.markdown_source_);
   context_.markdown_start_ = markdown_start;
   context_.markdown_end_ = markdown_end;
   context_.max_width_ = width;
   context_.indent_ = 0;
   document_->ClearForParse();
-  style_ = document_->GetStyle();
+  style_ = document_->GetSharedStyle();
   loader_ = document_->GetResourceLoader();
   document_->UpdateTruncation(width);
-  mkd_compile(doc, 0);
-  mkd_cleanup(doc);
+}
+
+void MarkdownParserEmbed::RecordEvent(MarkdownBlockEvents::Type type,
+                                      int value) {
+  if (recorded_events_ == nullptr) {
+    return;
+  }
+  recorded_events_->events_.push_back({type, value, 0});
+}
+
+void MarkdownParserEmbed::RecordText(line* text_line) {
+  if (recorded_events_ == nullptr) {
+    return;
+  }
+  auto& events = *recorded_events_;
+  MarkdownBlockEvents::Event event{
+      MarkdownBlockEvents::Type::kParagraphText,
+      static_cast<int32_t>(events.lines_.size()), 0};
+  for (auto* tmp = text_line; tmp != nullptr; tmp = tmp->next) {
+    events.lines_.push_back({static_cast<uint32_t>(events.text_.size()),
+                             tmp->text.size, tmp->dle, tmp->markdown_offset});
+    if (tmp->text.size > 0) {
+      events.text_.append(tmp->text.text, tmp->text.size);
+    }
+    events.text_.push_back('\0');
+    event.line_count_++;
+  }
+  events.events_.push_back(event);
 }
 
 void MarkdownParserEmbed::OnParagraphStart(int type) {
@@ -97,7 +187,7 @@ void MarkdownParserEmbed::OnParagraphStart(int type) {
         context_.current_paragraph_ = tttext::Paragraph::Create();
         context_.current_table_ = nullptr;
       }
-      context_.text_size_ = style_.normal_text_.base_.font_size_;
+      context_.text_size_ = style_->normal_text_.base_.font_size_;
       context_.have_normal_text_ = false;
       context_.line_height_rule_ = tttext::RulerType::kExact;
       MarkdownStyleInitializer::ResetBlockStyle(&context_.block_style_);
@@ -109,12 +199,12 @@ void MarkdownParserEmbed::OnParagraphStart(int type) {
     float quote_indent = 0;
     if (context_.quote_level_ > 0) {
       context_.border_type_ = MarkdownBorder::kLeft;
-      context_.block_style_ = style_.quote_.block_;
-      context_.border_style_ = style_.quote_.border_;
+      context_.block_style_ = style_->quote_.block_;
+      context_.border_style_ = style_->quote_.border_;
       context_.border_style_.border_color_ =
-          style_.quote_border_line_.line_.color_;
+          style_->quote_border_line_.line_.color_;
       context_.border_style_.border_width_ =
-          style_.quote_border_line_.line_.width_;
+          style_->quote_border_line_.line_.width_;
       // TODO(zhouchaoying): temporarily fix quote border, will be removed next
       // commit
       if (context_.quote_level_ == 1) {
@@ -122,7 +212,7 @@ void MarkdownParserEmbed::OnParagraphStart(int type) {
       }
 
       context_.block_style_.margin_left_ +=
-          (context_.quote_level_ - 1) * style_.quote_.indent_.indent_;
+          (context_.quote_level_ - 1) * style_->quote_.indent_.indent_;
       quote_indent = context_.block_style_.margin_left_ +
                      context_.border_style_.border_width_ +
                      context_.block_style_.padding_left_;
@@ -131,13 +221,14 @@ void MarkdownParserEmbed::OnParagraphStart(int type) {
         !context_.list_index_stack_.empty()) {
       context_.list_index_stack_.back()++;
       int list_type = context_.para_stack_[context_.para_stack_.size() - 2];
-      context_.block_style_ = style_.list_item_.block_;
+      context_.block_style_ = style_->list_item_.block_;
       if (list_type == UL) {
         float indent =
-            style_.unordered_list_.indent_.indent_ >= 0
-                ? style_.unordered_list_.indent_.indent_
-                : style_.unordered_list_.unordered_list_.mark_size_ +
-                      style_.unordered_list_.unordered_list_.mark_margin_right_;
+            style_->unordered_list_.indent_.indent_ >= 0
+                ? style_->unordered_list_.indent_.indent_
+                : style_->unordered_list_.unordered_list_.mark_size_ +
+                      style_->unordered_list_.unordered_list_
+                          .mark_margin_right_;
         context_.block_style_.margin_left_ +=
             (context_.list_level_ - 1) * indent;
         AppendUnorderedListMark();
@@ -148,17 +239,17 @@ void MarkdownParserEmbed::OnParagraphStart(int type) {
           // if is the first paragraph in list, add list margin top to
           // paragraph.
           context_.block_style_.margin_top_ +=
-              style_.unordered_list_.block_.margin_top_;
+              style_->unordered_list_.block_.margin_top_;
           context_.block_style_.padding_top_ +=
-              style_.unordered_list_.block_.padding_top_;
+              style_->unordered_list_.block_.padding_top_;
         }
       } else if (list_type == OL) {
         float indent =
-            style_.ordered_list_.indent_.indent_ >= 0
-                ? style_.ordered_list_.indent_.indent_
-                : style_.ordered_list_number_.block_.margin_left_ +
-                      style_.ordered_list_number_.block_.margin_left_ +
-                      style_.ordered_list_.ordered_list_.number_font_size_;
+            style_->ordered_list_.indent_.indent_ >= 0
+                ? style_->ordered_list_.indent_.indent_
+                : style_->ordered_list_number_.block_.margin_left_ +
+                      style_->ordered_list_number_.block_.margin_left_ +
+                      style_->ordered_list_.ordered_list_.number_font_size_;
         context_.block_style_.margin_left_ +=
             (context_.list_level_ - 1) * indent;
         AppendOrderedListNumber();
@@ -167,29 +258,29 @@ void MarkdownParserEmbed::OnParagraphStart(int type) {
         if (context_.list_index_stack_.back() == context_.list_start_index_ &&
             context_.list_level_ == 1) {
           context_.block_style_.margin_top_ +=
-              style_.ordered_list_.block_.margin_top_;
+              style_->ordered_list_.block_.margin_top_;
           context_.block_style_.padding_top_ +=
-              style_.ordered_list_.block_.padding_top_;
+              style_->ordered_list_.block_.padding_top_;
         }
       }
     } else if (type == CODE) {
       context_.border_type_ = MarkdownBorder::kRect;
-      context_.block_style_ = style_.code_block_.block_;
-      context_.border_style_ = style_.code_block_.border_;
+      context_.block_style_ = style_->code_block_.block_;
+      context_.border_style_ = style_->code_block_.border_;
       context_.block_style_.margin_left_ += quote_indent;
     } else if (type == TABLE) {
-      context_.block_style_ = style_.table_.block_;
-      context_.border_style_ = style_.table_.border_;
+      context_.block_style_ = style_->table_.block_;
+      context_.border_style_ = style_->table_.border_;
       context_.border_type_ = MarkdownBorder::kNone;
       context_.block_style_.margin_left_ += quote_indent;
     } else if (type == HDR) {
-      context_.block_style_ = GetHNBlockStyle(style_, context_.hn_);
+      context_.block_style_ = GetHNBlockStyle(*style_, context_.hn_);
       context_.block_style_.margin_left_ += quote_indent;
     } else {
       auto parent_type = context_.para_stack_[context_.para_stack_.size() - 2];
       if (parent_type == SOURCE) {
         // not in other block node
-        context_.block_style_ = style_.normal_text_.block_;
+        context_.block_style_ = style_->normal_text_.block_;
       } else if (context_.list_level_ > 0 &&
                  (context_.current_paragraph_ == nullptr ||
                   context_.current_paragraph_->GetRunCount() == 0)) {
@@ -269,11 +360,11 @@ void MarkdownParserEmbed::OnParagraphEnd() {
         context_.list_level_ == 1) {
       // if list has at least one paragraph, add list margin bottom to the last
       // paragraph.
-      MarkdownBlockStylePart* list_block_style = nullptr;
+      const MarkdownBlockStylePart* list_block_style = nullptr;
       if (type == OL) {
-        list_block_style = &style_.ordered_list_.block_;
+        list_block_style = &style_->ordered_list_.block_;
       } else if (type == UL) {
-        list_block_style = &style_.unordered_list_.block_;
+        list_block_style = &style_->unordered_list_.block_;
       }
       if (list_block_style != nullptr && !document_->GetParagraphs().empty()) {
         auto& last_para = document_->GetParagraphs().back();
@@ -297,11 +388,11 @@ void MarkdownParserEmbed::OnParagraphEnd() {
         context_.processed_markdown_length_ < context_.markdown_end_) {
       MarkdownStyleInitializer::ResetBlockStyle(&context_.block_style_);
       MarkdownStyleInitializer::ResetBorderStyle(&context_.border_style_);
-      context_.border_style_ = style_.split_.border_;
-      context_.block_style_ = style_.split_.block_;
+      context_.border_style_ = style_->split_.border_;
+      context_.block_style_ = style_->split_.block_;
       context_.border_type_ = MarkdownBorder::kTop;
       auto para = std::make_shared<MarkdownElement>(MarkdownElementType::kNone);
-      para->SetSpaceAfter(style_.normal_text_.base_.paragraph_space_);
+      para->SetSpaceAfter(style_->normal_text_.base_.paragraph_space_);
       GenerateElement(para.get());
       document_->AddParagraph(std::move(para));
     }
@@ -390,8 +481,10 @@ void MarkdownParserEmbed::SetTTStyleByMarkdownBaseStyle(
       (!base_style_part.font_.empty() ||
        (base_style_part.font_weight_ != MarkdownFontWeight::kNormal &&
         base_style_part.font_weight_ != MarkdownFontWeight::kBold))) {
-    auto font = loader->LoadFont(base_style_part.font_.c_str(),
-                                 base_style_part.font_weight_);
+    auto font = MARKDOWN_TRACE_CALL(
+        "MarkdownResourceLoader::LoadFont",
+        loader->LoadFont(base_style_part.font_.c_str(),
+                         base_style_part.font_weight_));
     style->SetFontDescriptor(
         {{}, tttext::FontStyle::Normal(), reinterpret_cast<uint64_t>(font)});
   }
@@ -574,7 +667,7 @@ void MarkdownParserEmbed::OnParagraphText(line* text_line) {
       char* content = text_line->text.text + line_start;
       int len = line_end - line_start;
       tttext::Style run_style;
-      SetTTStyleByMarkdownBaseStyle(style_.code_block_.base_, &run_style);
+      SetTTStyleByMarkdownBaseStyle(style_->code_block_.base_, &run_style);
       int32_t char_start =
           context_.current_paragraph_->GetCharCount() + context_.char_offset_;
       context_.current_paragraph_->AddTextRun(&run_style, content, len);
@@ -604,7 +697,7 @@ void MarkdownParserEmbed::OnParagraphText(line* text_line) {
     tttext::Style run_style;
     if (context_.hn_ <= 0 || context_.hn_ > 6) {
       if (context_.quote_level_ > 0) {
-        SetTTStyleByMarkdownBaseStyle(style_.quote_.base_, &run_style);
+        SetTTStyleByMarkdownBaseStyle(style_->quote_.base_, &run_style);
       } else if (context_.list_level_ > 0) {
         int list_type =
             context_.para_stack_.size() < 3
@@ -626,16 +719,17 @@ void MarkdownParserEmbed::OnParagraphText(line* text_line) {
           }
         }
         if (list_type == OL) {
-          SetTTStyleByMarkdownBaseStyle(style_.ordered_list_.base_, &run_style);
+          SetTTStyleByMarkdownBaseStyle(style_->ordered_list_.base_,
+                                        &run_style);
         } else if (list_type == UL) {
-          SetTTStyleByMarkdownBaseStyle(style_.unordered_list_.base_,
+          SetTTStyleByMarkdownBaseStyle(style_->unordered_list_.base_,
                                         &run_style);
         }
       } else {
-        SetTTStyleByMarkdownBaseStyle(style_.normal_text_.base_, &run_style);
+        SetTTStyleByMarkdownBaseStyle(style_->normal_text_.base_, &run_style);
       }
     } else {
-      SetTTStyleByMarkdownBaseStyle(GetHNStyle(style_, context_.hn_),
+      SetTTStyleByMarkdownBaseStyle(GetHNStyle(*style_, context_.hn_),
                                     &run_style);
     }
     std::string content = "";
@@ -682,32 +776,32 @@ void MarkdownParserEmbed::GenerateElement(
 void MarkdownParserEmbed::GenerateParagraph(
     int type, serval::markdown::MarkdownParagraphElement* para) {
   if (context_.quote_level_ > 0) {
-    SetParagraphStyle(style_.quote_.base_,
+    SetParagraphStyle(style_->quote_.base_,
                       &context_.current_paragraph_->GetParagraphStyle(), para);
   } else if (context_.list_level_ > 0) {
     int list_type = context_.para_stack_[context_.para_stack_.size() - 2];
     if (list_type == UL) {
-      SetParagraphStyle(style_.unordered_list_.base_,
+      SetParagraphStyle(style_->unordered_list_.base_,
                         &context_.current_paragraph_->GetParagraphStyle(),
                         para);
     } else if (list_type == OL) {
-      SetParagraphStyle(style_.ordered_list_.base_,
+      SetParagraphStyle(style_->ordered_list_.base_,
                         &context_.current_paragraph_->GetParagraphStyle(),
                         para);
     }
   } else if (type == CODE) {
-    SetParagraphStyle(style_.code_block_.base_,
+    SetParagraphStyle(style_->code_block_.base_,
                       &context_.current_paragraph_->GetParagraphStyle(), para);
   } else if (context_.hn_ > 0) {
-    SetParagraphStyle(GetHNStyle(style_, context_.hn_),
+    SetParagraphStyle(GetHNStyle(*style_, context_.hn_),
                       &context_.current_paragraph_->GetParagraphStyle(), para);
   } else {
-    SetParagraphStyle(style_.normal_text_.base_,
+    SetParagraphStyle(style_->normal_text_.base_,
                       &context_.current_paragraph_->GetParagraphStyle(), para);
   }
   if (!context_.extra_class_.empty()) {
-    const auto style = style_.span_styles_.find(context_.extra_class_);
-    if (style != style_.span_styles_.end()) {
+    const auto style = style_->span_styles_.find(context_.extra_class_);
+    if (style != style_->span_styles_.end()) {
       SetParagraphStyle(style->second.base_,
                         &context_.current_paragraph_->GetParagraphStyle(),
                         para);
@@ -731,79 +825,80 @@ void MarkdownParserEmbed::GenerateParagraph(
   context_.char_offset_ += char_count;
   para->SetParagraph(std::move(context_.current_paragraph_));
   if (type == CODE) {
-    para->SetScrollX(style_.code_block_.scroll_.scroll_x_);
+    para->SetScrollX(style_->code_block_.scroll_.scroll_x_);
   }
 }
 
 void MarkdownParserEmbed::GenerateTable(
     serval::markdown::MarkdownTableElement* table) {
   GenerateElement(table);
-  context_.current_table_->SetCellStyle(style_.table_cell_.block_);
+  context_.current_table_->SetCellStyle(style_->table_cell_.block_);
   context_.current_table_->SetCellBackground(
-      style_.table_cell_.base_.background_color_);
-  context_.current_table_->SetHeaderStyle(style_.table_header_.block_);
+      style_->table_cell_.base_.background_color_);
+  context_.current_table_->SetHeaderStyle(style_->table_header_.block_);
   context_.current_table_->SetHeaderBackground(
-      style_.table_header_.base_.background_color_);
-  context_.current_table_->SetTableStyle(style_.table_.table_);
+      style_->table_header_.base_.background_color_);
+  context_.current_table_->SetTableStyle(style_->table_.table_);
   table->SetCharCount(context_.current_table_->GetCharCount());
   context_.char_offset_ += context_.current_table_->GetCharCount();
   table->SetTable(std::move(context_.current_table_));
   table->SetSpaceAfter(0);
-  table->SetTextOverflow(style_.table_cell_.base_.text_overflow_);
-  table->SetScrollX(style_.table_.scroll_.scroll_x_);
+  table->SetTextOverflow(style_->table_cell_.base_.text_overflow_);
+  table->SetScrollX(style_->table_.scroll_.scroll_x_);
 }
 
 void MarkdownParserEmbed::AppendUnorderedListMark() {
-  MarkdownMarkType mark_type = style_.unordered_list_marker_.marker_.mark_type_;
+  MarkdownMarkType mark_type =
+      style_->unordered_list_marker_.marker_.mark_type_;
   if (mark_type == MarkdownMarkType::kMixed) {
     mark_type = static_cast<MarkdownMarkType>(
         (context_.list_level_ - 1) %
         (static_cast<int>(MarkdownMarkType::kMixed)));
   }
   auto mark = std::make_unique<MarkdownUnorderedListMarkDelegate>(
-      mark_type, style_.unordered_list_marker_);
+      mark_type, style_->unordered_list_marker_);
   context_.indent_ = mark->GetAdvance();
   context_.current_paragraph_->GetParagraphStyle().SetHangingIndentInPx(
       mark->GetAdvance());
   tttext::Style style;
   style.SetVerticalAlignment(ConvertVerticalAlign(
-      style_.unordered_list_marker_.align_.vertical_align_));
+      style_->unordered_list_marker_.align_.vertical_align_));
   context_.current_paragraph_->AddShapeRun(&style, std::move(mark), false);
 }
 
 void MarkdownParserEmbed::AppendOrderedListNumber() {
   MarkdownNumberType number_type =
-      style_.ordered_list_.ordered_list_.number_type_;
+      style_->ordered_list_.ordered_list_.number_type_;
   if (number_type == MarkdownNumberType::kMixed) {
     number_type = static_cast<MarkdownNumberType>(
         (context_.list_level_ - 1) %
         (static_cast<int>(MarkdownNumberType::kMixed)));
   }
   tttext::Style number_style;
-  SetTTStyleByMarkdownBaseStyle(style_.ordered_list_number_.base_,
+  SetTTStyleByMarkdownBaseStyle(style_->ordered_list_number_.base_,
                                 &number_style);
   auto number_str = MarkdownNumberTypeToString(
                         number_type, context_.list_index_stack_.back()) +
                     ".";
   auto tmp_para = tttext::Paragraph::Create();
-  if (style_.ordered_list_number_.block_.margin_left_ > 0) {
+  if (style_->ordered_list_number_.block_.margin_left_ > 0) {
     context_.current_paragraph_->AddGhostShapeRun(
         nullptr, std::make_unique<MarkdownEmptySpaceDelegate>(
-                     style_.ordered_list_number_.block_.margin_left_));
+                     style_->ordered_list_number_.block_.margin_left_));
   }
   context_.current_paragraph_->AddTextRun(&number_style, number_str.c_str(),
                                           number_str.length());
-  if (style_.ordered_list_number_.block_.margin_right_ > 0) {
+  if (style_->ordered_list_number_.block_.margin_right_ > 0) {
     context_.current_paragraph_->AddGhostShapeRun(
         nullptr, std::make_unique<MarkdownEmptySpaceDelegate>(
-                     style_.ordered_list_number_.block_.margin_right_));
+                     style_->ordered_list_number_.block_.margin_right_));
   }
   tmp_para->AddTextRun(&number_style, number_str.c_str(), number_str.length());
   auto [width, _] = MarkdownLayout::MeasureParagraph(
       document_->GetContextPtr(), tmp_para.get(),
       std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), -1);
-  auto indent = width + style_.ordered_list_number_.block_.margin_left_ +
-                style_.ordered_list_number_.block_.margin_right_;
+  auto indent = width + style_->ordered_list_number_.block_.margin_left_ +
+                style_->ordered_list_number_.block_.margin_right_;
   context_.indent_ = indent;
   context_.current_paragraph_->GetParagraphStyle().SetHangingIndentInPx(indent);
 }
@@ -819,7 +914,7 @@ void MarkdownParserEmbed::HandleTableLines(line* text_line) {
   // remove align line
   line_count -= 1;
 
-  auto cell_base = style_.table_cell_.base_;
+  auto cell_base = style_->table_cell_.base_;
   tttext::ParagraphStyle paragraph_style;
   SetParagraphStyle(cell_base, &paragraph_style, nullptr);
   tttext::Style run_style;
@@ -848,14 +943,14 @@ void MarkdownParserEmbed::HandleTableLines(line* text_line) {
     MarkdownTableCell cell{
         .paragraph_ = nullptr,
         .alignment_ = align[col],
-        .vertical_alignment_ = style_.table_header_.align_.vertical_align_,
+        .vertical_alignment_ = style_->table_header_.align_.vertical_align_,
         .char_start_ = char_offset,
         .char_count_ = 0,
     };
     if (!str.empty()) {
       auto para = tttext::Paragraph::Create();
       auto header_style = run_style;
-      auto header_base = style_.table_header_.base_;
+      auto header_base = style_->table_header_.base_;
       header_base.background_color_ = 0;
       SetTTStyleByMarkdownBaseStyle(header_base, &header_style);
       para->SetParagraphStyle(&paragraph_style);
@@ -883,7 +978,7 @@ void MarkdownParserEmbed::HandleTableLines(line* text_line) {
       MarkdownTableCell cell{
           .paragraph_ = nullptr,
           .alignment_ = align[col],
-          .vertical_alignment_ = style_.table_cell_.align_.vertical_align_,
+          .vertical_alignment_ = style_->table_cell_.align_.vertical_align_,
           .char_start_ = char_offset,
           .char_count_ = 0,
       };
@@ -1069,13 +1164,13 @@ void MarkdownParserEmbed::AppendLinkToParagraph(MarkdownLinkNode* node,
                                                 uint32_t char_offset,
                                                 uint32_t markdown_offset) {
   tttext::Style new_style = base_style;
-  SetTTStyleByMarkdownBaseStyle(style_.link_.base_, &new_style);
+  SetTTStyleByMarkdownBaseStyle(style_->link_.base_, &new_style);
   uint32_t count_before = para->GetCharCount();
   AppendChildrenToParagraph(node, para, new_style, char_offset,
                             markdown_offset);
   uint32_t count_after = para->GetCharCount();
   tttext::Style decoration_style;
-  SetDecorationStyle(style_.link_.decoration_, &decoration_style);
+  SetDecorationStyle(style_->link_.decoration_, &decoration_style);
   para->ApplyStyleInRange(decoration_style, count_before,
                           count_after - count_before);
   if (char_offset != static_cast<uint32_t>(-1)) {
@@ -1114,8 +1209,10 @@ void MarkdownParserEmbed::AppendImgToParagraph(MarkdownImageNode* node,
                                      ? url.substr(strlen(kInlineViewSchema))
                                      : url.substr(strlen(kBlockViewSchema));
     if (!inline_view_id.empty() && loader_ != nullptr) {
-      auto delegate = loader_->LoadInlineView(inline_view_id.c_str(), max_width,
-                                              max_height);
+      auto delegate = MARKDOWN_TRACE_CALL(
+          "MarkdownResourceLoader::LoadInlineView",
+          loader_->LoadInlineView(inline_view_id.c_str(), max_width,
+                                  max_height));
       if (delegate != nullptr) {
         document_->AddInlineView(MarkdownInlineView{
             .id_ = inline_view_id,
@@ -1136,8 +1233,8 @@ void MarkdownParserEmbed::AppendImgToParagraph(MarkdownImageNode* node,
     }
   } else {
     // img
-    float width = style_.image_.size_.width_;
-    float height = style_.image_.size_.height_;
+    float width = style_->image_.size_.width_;
+    float height = style_->image_.size_.height_;
     if (node->GetWidth() > 0) {
       width = MarkdownScreenMetrics::DPToPx(node->GetWidth());
     }
@@ -1146,13 +1243,16 @@ void MarkdownParserEmbed::AppendImgToParagraph(MarkdownImageNode* node,
     }
     bool need_alt_text = false;
     if (loader_ != nullptr) {
-      auto delegate =
+      auto delegate = MARKDOWN_TRACE_CALL(
+          "MarkdownResourceLoader::LoadImage",
           loader_->LoadImage(url.c_str(), width, height, max_width, max_height,
-                             style_.image_.image_.radius_);
-      if (delegate == nullptr && !(style_.image_.image_.alt_image_.empty())) {
-        delegate = loader_->LoadImage(style_.image_.image_.alt_image_.c_str(),
-                                      width, height, max_width, max_height,
-                                      style_.image_.image_.radius_);
+                             style_->image_.image_.radius_));
+      if (delegate == nullptr && !(style_->image_.image_.alt_image_.empty())) {
+        delegate = MARKDOWN_TRACE_CALL(
+            "MarkdownResourceLoader::LoadImage",
+            loader_->LoadImage(style_->image_.image_.alt_image_.c_str(), width,
+                               height, max_width, max_height,
+                               style_->image_.image_.radius_));
       }
       if (delegate != nullptr) {
         document_->AddImage(MarkdownImage{
@@ -1164,8 +1264,8 @@ void MarkdownParserEmbed::AppendImgToParagraph(MarkdownImageNode* node,
         if (!node->GetCaption().empty()) {
           auto caption = tttext::Paragraph::Create();
           auto style = base_style;
-          SetTTStyleByMarkdownBaseStyle(style_.image_caption_.base_, &style);
-          SetParagraphStyle(style_.image_caption_.base_,
+          SetTTStyleByMarkdownBaseStyle(style_->image_caption_.base_, &style);
+          SetParagraphStyle(style_->image_caption_.base_,
                             &(caption->GetParagraphStyle()), nullptr);
           caption->AddTextRun(&style, node->GetCaption().data(),
                               node->GetCaption().length());
@@ -1173,17 +1273,17 @@ void MarkdownParserEmbed::AppendImgToParagraph(MarkdownImageNode* node,
               document_->GetContextPtr(),
               std::static_pointer_cast<MarkdownDrawable>(std::move(delegate)),
               std::move(caption), max_width,
-              style_.image_caption_.image_caption_.caption_position_,
-              style_.image_caption_.base_.text_align_);
+              style_->image_caption_.image_caption_.caption_position_,
+              style_->image_caption_.base_.text_align_);
         }
         document_->SetShapeRunAltString(char_offset + para->GetCharCount(),
                                         node->GetAltText());
         para->AddShapeRun(&base_style, std::move(delegate), false);
       } else {
-        need_alt_text = style_.image_.image_.enable_alt_text_;
+        need_alt_text = style_->image_.image_.enable_alt_text_;
       }
     } else {
-      need_alt_text = style_.image_.image_.enable_alt_text_;
+      need_alt_text = style_->image_.image_.enable_alt_text_;
     }
 
     if (need_alt_text && !node->GetAltText().empty()) {
@@ -1219,7 +1319,7 @@ void MarkdownParserEmbed::AppendImgToParagraph(MarkdownImageNode* node,
 
 void MarkdownParserEmbed::AppendInlineBorderLeft(
     const MarkdownBlockStylePart& block, const MarkdownBorderStylePart& border,
-    MarkdownBackgroundStylePart* background, tttext::Paragraph* para,
+    const MarkdownBackgroundStylePart* background, tttext::Paragraph* para,
     tttext::Style* style) {
   float left_empty =
       block.margin_left_ + block.padding_left_ + border.border_width_;
@@ -1237,7 +1337,7 @@ void MarkdownParserEmbed::AppendInlineBorderLeft(
 void MarkdownParserEmbed::AppendInlineBorderRight(
     MarkdownDocument* document, const MarkdownBaseStylePart& base,
     const MarkdownBlockStylePart& block, const MarkdownBorderStylePart& border,
-    MarkdownBackgroundStylePart* background, tttext::Paragraph* para,
+    const MarkdownBackgroundStylePart* background, tttext::Paragraph* para,
     uint32_t char_offset, uint32_t char_offset_end) {
   float right_empty =
       block.margin_right_ + block.padding_right_ + border.border_width_;
@@ -1291,17 +1391,17 @@ void MarkdownParserEmbed::AppendInlineCode(MarkdownInlineNode* node,
   if (node->Children().empty())
     return;
   auto new_style = base_style;
-  SetTTStyleByMarkdownBaseStyle(style_.inline_code_.base_, &new_style);
-  AppendInlineBorderLeft(style_.inline_code_.block_,
-                         style_.inline_code_.border_, nullptr, para,
+  SetTTStyleByMarkdownBaseStyle(style_->inline_code_.base_, &new_style);
+  AppendInlineBorderLeft(style_->inline_code_.block_,
+                         style_->inline_code_.border_, nullptr, para,
                          &new_style);
   auto char_start = char_offset + para->GetCharCount();
   AppendChildrenToParagraph(node, para, new_style, char_offset,
                             markdown_offset);
   auto char_end = char_offset + para->GetCharCount();
   AppendInlineBorderRight(
-      document_, style_.inline_code_.base_, style_.inline_code_.block_,
-      style_.inline_code_.border_, nullptr, para, char_start, char_end);
+      document_, style_->inline_code_.base_, style_->inline_code_.block_,
+      style_->inline_code_.border_, nullptr, para, char_start, char_end);
 }
 
 void MarkdownParserEmbed::AppendRawText(MarkdownInlineNode* node,
@@ -1364,20 +1464,20 @@ void MarkdownParserEmbed::AppendInlineHtml(MarkdownInlineHtmlTag* node,
   if (node->GetTag() == "br") {
     para->AddTextRun(&base_style, "\n");
   } else if (node->GetTag() == "mark") {
-    SetTTStyleByMarkdownBaseStyle(style_.mark_.base_, &new_style);
-    AppendInlineBorderLeft(style_.mark_.block_, style_.mark_.border_,
-                           &style_.mark_.background_, para, &new_style);
+    SetTTStyleByMarkdownBaseStyle(style_->mark_.base_, &new_style);
+    AppendInlineBorderLeft(style_->mark_.block_, style_->mark_.border_,
+                           &style_->mark_.background_, para, &new_style);
     auto start = char_offset + para->GetCharCount();
     AppendChildrenToParagraph(node, para, new_style, char_offset,
                               markdown_offset);
     auto end = char_offset + para->GetCharCount();
-    AppendInlineBorderRight(document_, style_.mark_.base_, style_.mark_.block_,
-                            style_.mark_.border_, &style_.mark_.background_,
-                            para, start, end);
+    AppendInlineBorderRight(document_, style_->mark_.base_,
+                            style_->mark_.block_, style_->mark_.border_,
+                            &style_->mark_.background_, para, start, end);
   } else if (node->GetTag() == "span") {
     const auto cls = std::string(node->GetClass());
-    const auto iter = style_.span_styles_.find(cls);
-    if (iter == style_.span_styles_.end()) {
+    const auto iter = style_->span_styles_.find(cls);
+    if (iter == style_->span_styles_.end()) {
       AppendChildrenToParagraph(node, para, new_style, char_offset,
                                 markdown_offset);
     } else {
@@ -1411,21 +1511,23 @@ void MarkdownParserEmbed::AppendDoubleBraces(MarkdownInlineNode* node,
                                              uint32_t char_offset,
                                              uint32_t markdown_offset) {
   auto new_style = base_style;
-  context_.block_style_.margin_top_ += style_.double_braces_.block_.margin_top_;
+  context_.block_style_.margin_top_ +=
+      style_->double_braces_.block_.margin_top_;
   context_.block_style_.margin_bottom_ +=
-      style_.double_braces_.block_.margin_bottom_;
-  SetTTStyleByMarkdownBaseStyle(style_.double_braces_.base_, &new_style);
-  AppendInlineBorderLeft(style_.double_braces_.block_,
-                         style_.double_braces_.border_,
-                         &style_.double_braces_.background_, para, &new_style);
+      style_->double_braces_.block_.margin_bottom_;
+  SetTTStyleByMarkdownBaseStyle(style_->double_braces_.base_, &new_style);
+  AppendInlineBorderLeft(style_->double_braces_.block_,
+                         style_->double_braces_.border_,
+                         &style_->double_braces_.background_, para, &new_style);
   auto start = para->GetCharCount() + char_offset;
   AppendChildrenToParagraph(node, para, new_style, char_offset,
                             markdown_offset);
   auto end = char_offset + para->GetCharCount();
-  AppendInlineBorderRight(document_, style_.double_braces_.base_,
-                          style_.double_braces_.block_,
-                          style_.double_braces_.border_,
-                          &style_.double_braces_.background_, para, start, end);
+  AppendInlineBorderRight(document_, style_->double_braces_.base_,
+                          style_->double_braces_.block_,
+                          style_->double_braces_.border_,
+                          &style_->double_braces_.background_, para, start,
+                          end);
 }
 
 void MarkdownParserEmbed::AppendDoubleSquareBracket(
@@ -1433,14 +1535,14 @@ void MarkdownParserEmbed::AppendDoubleSquareBracket(
     const tttext::Style& base_style, uint32_t char_offset,
     uint32_t markdown_offset) {
   auto new_style = base_style;
-  const auto& ref_style = style_.ref_;
+  const auto& ref_style = style_->ref_;
   SetTTStyleByMarkdownBaseStyle(ref_style.base_, &new_style);
   new_style.SetBackgroundColor(tttext::TTColor(0));
   auto new_para = tttext::Paragraph::Create();
   AppendChildrenToParagraph(node, new_para.get(), new_style, char_offset,
                             markdown_offset);
   auto delegate = std::make_unique<MarkdownRefDelegate>(
-      document_->GetContextPtr(), std::move(new_para), style_.ref_,
+      document_->GetContextPtr(), std::move(new_para), style_->ref_,
       base_style.GetTextSize());
   para->AddGhostShapeRun(&new_style, std::move(delegate));
 }
@@ -1479,12 +1581,12 @@ void MarkdownParserEmbed::AppendNodeToParagraph(MarkdownInlineNode* node,
   } else {
     tttext::Style new_style = base_style;
     if (node->GetSyntax() == MarkdownInlineSyntax::kBold) {
-      SetTTStyleByMarkdownBaseStyle(style_.bold_.base_, &new_style);
+      SetTTStyleByMarkdownBaseStyle(style_->bold_.base_, &new_style);
     } else if (node->GetSyntax() == MarkdownInlineSyntax::kBoldItalic) {
-      SetTTStyleByMarkdownBaseStyle(style_.bold_.base_, &new_style);
-      SetTTStyleByMarkdownBaseStyle(style_.italic_.base_, &new_style);
+      SetTTStyleByMarkdownBaseStyle(style_->bold_.base_, &new_style);
+      SetTTStyleByMarkdownBaseStyle(style_->italic_.base_, &new_style);
     } else if (node->GetSyntax() == MarkdownInlineSyntax::kItalic) {
-      SetTTStyleByMarkdownBaseStyle(style_.italic_.base_, &new_style);
+      SetTTStyleByMarkdownBaseStyle(style_->italic_.base_, &new_style);
     } else if (node->GetSyntax() == MarkdownInlineSyntax::kDelete) {
       new_style.SetDecorationType(tttext::DecorationType::kLineThrough);
       new_style.SetDecorationStyle(tttext::LineType::kSolid);
@@ -1517,20 +1619,6 @@ int32_t MarkdownParserEmbed::MarkdownSourceByteIndexToCharIndex(
   return map[byte_index];
 }
 
-std::vector<int32_t> MarkdownParserEmbed::CalculateByteIndexToCharIndexMap(
-    const std::string_view string) {
-  int32_t char_index = 0;
-  std::vector<int32_t> result;
-  result.reserve(string.size() + 1);
-  for (const auto c : string) {
-    result.emplace_back(char_index);
-    if (IsUtf8StartByte(c)) {
-      char_index++;
-    }
-  }
-  result.emplace_back(char_index);
-  return result;
-}
 std::vector<std::string_view> SplitLines(std::string_view content) {
   std::vector<std::string_view> result;
   uint32_t last_index = 0;
@@ -17,6 +17,7 @@
 #include "markdown/parser/embed/markdown_parser_embed.h"
 #include "markdown/parser/impl/markdown_parser_impl.h"
 #include "markdown/parser/markdown_dom_node.h"
+#include "markdown/utils/markdown_trace.h"
 namespace serval::markdown {
 
 #if MARKDOWN_ENABLE_PARSER_PROVIDER
@@ -56,7 +57,10 @@ void MarkdownParserProvider::RegisterParserProvider(
 }
 
 void MarkdownParserImpl::ParseMarkdown(const std::string& parser_name,
-                                       MarkdownDocument* document, void* ud) {
+                                       MarkdownDocument* document, void* ud,
+                                       MarkdownBlockEvents* block_events) {
+  MARKDOWN_TRACE_EVENT("MarkdownParser::ParseMarkdown", "content_length",
+                       document->GetMarkdownContent().length());
 #if MARKDOWN_ENABLE_PARSER_PROVIDER
   if (!parser_name.empty()) {
     if (const auto provider = GetParserMap().GetParserProvider(parser_name);
@@ -75,11 +79,27 @@ void MarkdownParserImpl::ParseMarkdown(const std::string& parser_name,
   auto& content = document->GetMarkdownContent();
   auto range = document->GetMarkdownContentRange();
   auto width = document->GetMaxWidth();
+  discount_parser.RecordBlockEvents(block_events);
   discount_parser.Parse(content.c_str(), static_cast<int32_t>(content.length()),
                         range.start_, range.end_, width);
 }
 
+void MarkdownParserImpl::ReplayMarkdown(
+    MarkdownDocument* document, const MarkdownBlockEvents& block_events) {
+  MARKDOWN_TRACE_EVENT("MarkdownParser::ReplayMarkdown", "block_event_count",
+                       block_events.events_.size());
+  MarkdownParserEmbed discount_parser(document);
+  auto& content = document->GetMarkdownContent();
+  auto range = document->GetMarkdownContentRange();
+  auto width = document->GetMaxWidth();
+  discount_parser.Replay(block_events, content.c_str(),
+                         static_cast<int32_t>(content.length()), range.start_,
+                         range.end_, width);
+}
+
 void MarkdownParserImpl::ParsePlainText(MarkdownDocument* document) {
+  MARKDOWN_TRACE_EVENT("MarkdownParser::ParsePlainText", "content_length",
+                       document->GetMarkdownContent().length());
   MarkdownParserEmbed discount_parser(document);
   auto& content = document->GetMarkdownContent();
   discount_parser.ParsePlainText(content.c_str(),
@@ -225,9 +245,11 @@ std::unique_ptr<MarkdownElement> MarkdownConverter::ReplaceBlockNode(
   }
   auto id = std::to_string(context_.node_id_);
   float max_width = context_.max_width_stack_.back();
-  auto replacement = document_->GetResourceLoader()->LoadReplacementView(
-      replacement_data, context_.node_id_, max_width,
-      document_->GetMaxHeight());
+  auto replacement = MARKDOWN_TRACE_CALL(
+      "MarkdownResourceLoader::LoadReplacementView",
+      document_->GetResourceLoader()->LoadReplacementView(
+          replacement_data, context_.node_id_, max_width,
+          document_->GetMaxHeight()));
   auto view = std::move(replacement.view_);
   if (view != nullptr) {
     document_->AddInlineView(MarkdownInlineView{
@@ -452,9 +474,12 @@ void MarkdownConverter::ConvertImage(MarkdownDomNode* node) {
   std::shared_ptr<MarkdownDrawable> image;
   if (auto* loader = document_->GetResourceLoader();
       loader != nullptr && !url.empty()) {
-    image = loader->LoadImage(
-        url.c_str(), image_node->GetWidth(), image_node->GetHeight(), max_width,
-        document_->GetMaxHeight(), document_->GetStyle().image_.image_.radius_);
+    image = MARKDOWN_TRACE_CALL(
+        "MarkdownResourceLoader::LoadImage",
+        loader->LoadImage(url.c_str(), image_node->GetWidth(),
+                          image_node->GetHeight(), max_width,
+                          document_->GetMaxHeight(),
+                          document_->GetStyle().image_.image_.radius_));
   }
   if (image != nullptr) {
     auto para = context_.GetParagraph();
@@ -485,9 +510,11 @@ void MarkdownConverter::ReplaceInlineNode(MarkdownDomNode* node) {
   }
   auto id = std::to_string(context_.node_id_);
   float max_width = context_.max_width_stack_.back();
-  auto replacement = document_->GetResourceLoader()->LoadReplacementView(
-      replacement_data, context_.node_id_, max_width,
-      document_->GetMaxHeight());
+  auto replacement = MARKDOWN_TRACE_CALL(
+      "MarkdownResourceLoader::LoadReplacementView",
+      document_->GetResourceLoader()->LoadReplacementView(
+          replacement_data, context_.node_id_, max_width,
+          document_->GetMaxHeight()));
   auto view = std::move(replacement.view_);
   if (view != nullptr) {
     tttext::Style style = context_.GetCurrentState().run_style_;
@@ -1060,6 +1087,7 @@ void MarkdownConverter::MakeElementPlain(
 
 void MarkdownParserImpl::ConvertDomTree(MarkdownDocument* document,
                                         MarkdownDomNode* root) {
+  MARKDOWN_TRACE_EVENT("MarkdownParser::ConvertDomTree");
   MarkdownConverter converter;
   converter.Convert(document, root);
 }
@@ -17,6 +17,7 @@
 #include "markdown/parser/markdown_resource_loader.h"
 #include "markdown/style/markdown_color.h"
 #include "markdown/utils/markdown_string_utils.h"
+#include "markdown/utils/markdown_trace.h"
 
 namespace serval::markdown {
 
@@ -553,8 +554,9 @@ std::shared_ptr<MarkdownDrawable> MarkdownBackgroundImageDrawable::EnsureImage(
   if (loader_ == nullptr || url_.empty()) {
     return image_;
   }
-  auto image =
-      loader_->LoadImage(url_.c_str(), width, height, width, height, 0);
+  auto image = MARKDOWN_TRACE_CALL(
+      "MarkdownResourceLoader::LoadImage",
+      loader_->LoadImage(url_.c_str(), width, height, width, height, 0));
   if (image == nullptr) {
     return image_;
   }
@@ -0,0 +1,50 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "markdown/style/markdown_style_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "markdown/style/markdown_style_reader.h"
+
+namespace serval::markdown {
+
+std::shared_ptr<const MarkdownStyle> MarkdownStyleCache::GetStyle(
+    const ValueMap& style_map, MarkdownResourceLoader* resource_loader,
+    MarkdownContext* context) {
+  auto iter = std::find_if(
+      entries_.begin(), entries_.end(),
+      [&style_map, resource_loader](const Entry& entry) {
+        return entry.resource_loader_ == resource_loader &&
+               Value::MapEquals(entry.style_map_, style_map);
+      });
+  if (iter != entries_.end()) {
+    std::rotate(iter, iter + 1, entries_.end());
+    return entries_.back().style_;
+  }
+  if (entries_.size() >= kMaxEntries) {
+    entries_.erase(entries_.begin());
+  }
+  entries_.push_back(
+      {Value::CloneMap(style_map), resource_loader,
+       std::make_shared<const MarkdownStyle>(MarkdownStyleReader::ReadStyle(
+           style_map, resource_loader, context))});
+  return entries_.back().style_;
+}
+
+void MarkdownStyleCache::DropResourceLoader(
+    MarkdownResourceLoader* resource_loader) {
+  if (resource_loader == nullptr) {
+    return;
+  }
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [resource_loader](const Entry& entry) {
+                                  return entry.resource_loader_ ==
+                                         resource_loader;
+                                }),
+                 entries_.end());
+}
+
+}  // namespace serval::markdown
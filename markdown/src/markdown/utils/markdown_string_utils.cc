@@ -10,10 +10,86 @@
 #include <cmath>
 #include <cstdlib>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MARKDOWN_UTF8_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MARKDOWN_UTF8_NEON 1
+#endif
+
 namespace serval::markdown {
 
 namespace {
 
+constexpr size_t kUTF8BlockSize = 16;
+
+// Writes the char index of the 16 bytes at |bytes| to |out|, given the char
+// index of the first one, and returns the char index after the block.
+int32_t MapUTF8Block(const char* bytes, int32_t char_index, int32_t* out) {
+#if defined(MARKDOWN_UTF8_SSE2)
+  const __m128i block =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+  const __m128i high_bits =
+      _mm_and_si128(block, _mm_set1_epi8(static_cast<char>(0xC0)));
+  const __m128i continuation =
+      _mm_cmpeq_epi8(high_bits, _mm_set1_epi8(static_cast<char>(0x80)));
+  const __m128i starts = _mm_andnot_si128(continuation, _mm_set1_epi8(1));
+  // inclusive prefix sum of the start flags, at most 16 per lane
+  __m128i sum = _mm_add_epi8(starts, _mm_slli_si128(starts, 1));
+  sum = _mm_add_epi8(sum, _mm_slli_si128(sum, 2));
+  sum = _mm_add_epi8(sum, _mm_slli_si128(sum, 4));
+  sum = _mm_add_epi8(sum, _mm_slli_si128(sum, 8));
+  const __m128i before = _mm_sub_epi8(sum, starts);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i base = _mm_set1_epi32(char_index);
+  const __m128i low = _mm_unpacklo_epi8(before, zero);
+  const __m128i high = _mm_unpackhi_epi8(before, zero);
+  auto* dst = reinterpret_cast<__m128i*>(out);
+  _mm_storeu_si128(dst, _mm_add_epi32(_mm_unpacklo_epi16(low, zero), base));
+  _mm_storeu_si128(dst + 1,
+                   _mm_add_epi32(_mm_unpackhi_epi16(low, zero), base));
+  _mm_storeu_si128(dst + 2,
+                   _mm_add_epi32(_mm_unpacklo_epi16(high, zero), base));
+  _mm_storeu_si128(dst + 3,
+                   _mm_add_epi32(_mm_unpackhi_epi16(high, zero), base));
+  return char_index + (_mm_extract_epi16(sum, 7) >> 8);
+#elif defined(MARKDOWN_UTF8_NEON)
+  const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(bytes));
+  const uint8x16_t continuation =
+      vceqq_u8(vandq_u8(block, vdupq_n_u8(0xC0)), vdupq_n_u8(0x80));
+  const uint8x16_t starts = vbicq_u8(vdupq_n_u8(1), continuation);
+  // inclusive prefix sum of the start flags, at most 16 per lane
+  const uint8x16_t zero = vdupq_n_u8(0);
+  uint8x16_t sum = vaddq_u8(starts, vextq_u8(zero, starts, 15));
+  sum = vaddq_u8(sum, vextq_u8(zero, sum, 14));
+  sum = vaddq_u8(sum, vextq_u8(zero, sum, 12));
+  sum = vaddq_u8(sum, vextq_u8(zero, sum, 8));
+  const uint8x16_t before = vsubq_u8(sum, starts);
+  const uint32x4_t base = vdupq_n_u32(static_cast<uint32_t>(char_index));
+  const uint16x8_t low = vmovl_u8(vget_low_u8(before));
+  const uint16x8_t high = vmovl_u8(vget_high_u8(before));
+  vst1q_s32(out, vreinterpretq_s32_u32(
+                     vaddq_u32(vmovl_u16(vget_low_u16(low)), base)));
+  vst1q_s32(out + 4, vreinterpretq_s32_u32(
+                         vaddq_u32(vmovl_u16(vget_high_u16(low)), base)));
+  vst1q_s32(out + 8, vreinterpretq_s32_u32(
+                         vaddq_u32(vmovl_u16(vget_low_u16(high)), base)));
+  vst1q_s32(out + 12, vreinterpretq_s32_u32(
+                          vaddq_u32(vmovl_u16(vget_high_u16(high)), base)));
+  return char_index + vgetq_lane_u8(sum, 15);
+#else
+  for (size_t i = 0; i < kUTF8BlockSize; i++) {
+    out[i] = char_index;
+    if ((bytes[i] & 0xC0) != 0x80) {
+      char_index++;
+    }
+  }
+  return char_index;
+#endif
+}
+
 std::u32string U8StringToU32(std::string_view u8_string) {
   const size_t length = u8_string.length();
   std::u32string u32;
@@ -191,6 +267,25 @@ std::vector<std::string_view> SplitTopLevel(std::string_view value,
   return result;
 }
 
+std::vector<int32_t> UTF8ByteIndexToCharIndexMap(std::string_view utf8) {
+  std::vector<int32_t> result(utf8.size() + 1);
+  const char* bytes = utf8.data();
+  int32_t* out = result.data();
+  int32_t char_index = 0;
+  size_t i = 0;
+  for (; i + kUTF8BlockSize <= utf8.size(); i += kUTF8BlockSize) {
+    char_index = MapUTF8Block(bytes + i, char_index, out + i);
+  }
+  for (; i < utf8.size(); i++) {
+    out[i] = char_index;
+    if ((bytes[i] & 0xC0) != 0x80) {
+      char_index++;
+    }
+  }
+  out[utf8.size()] = char_index;
+  return result;
+}
+
 std::u16string U8StringToU16(std::string_view u8_string) {
   return U32StringToU16(U8StringToU32(u8_string));
 }
@@ -25,6 +25,20 @@ using IntValue = ValueTemplate<int32_t, ValueType::kInt>;
 using LongValue = ValueTemplate<int64_t, ValueType::kLong>;
 using DoubleValue = ValueTemplate<double, ValueType::kDouble>;
 using StringValue = ValueTemplate<std::string, ValueType::kString>;
+namespace {
+template <typename T>
+const auto& ContentOf(const Value& value) {
+  return static_cast<const T&>(value).content_;
+}
+
+bool ValueEquals(const Value* first, const Value* second) {
+  if (first == nullptr || second == nullptr) {
+    return first == second;
+  }
+  return first->Equals(*second);
+}
+}  // namespace
+
 Value::~Value() = default;
 std::unique_ptr<Value> Value::MakeNull() {
   return std::make_unique<NullValue>();
@@ -164,6 +178,92 @@ std::string Value::GetString() {
       return "";
   }
 }
+std::unique_ptr<Value> Value::Clone() const {
+  switch (GetType()) {
+    case ValueType::kNull:
+      return MakeNull();
+    case ValueType::kMap:
+      return MakeMap(CloneMap(ContentOf<MapValue>(*this)));
+    case ValueType::kArray: {
+      const auto& array = ContentOf<ArrayValue>(*this);
+      ValueArray copy;
+      copy.reserve(array.size());
+      for (const auto& item : array) {
+        copy.emplace_back(item == nullptr ? nullptr : item->Clone());
+      }
+      return MakeArray(std::move(copy));
+    }
+    case ValueType::kBool:
+      return MakeBool(ContentOf<BoolValue>(*this));
+    case ValueType::kInt:
+      return MakeInt(ContentOf<IntValue>(*this));
+    case ValueType::kLong:
+      return MakeLong(ContentOf<LongValue>(*this));
+    case ValueType::kDouble:
+      return MakeDouble(ContentOf<DoubleValue>(*this));
+    case ValueType::kString:
+      return MakeString(std::string(ContentOf<StringValue>(*this)));
+  }
+}
+
+bool Value::Equals(const Value& other) const {
+  if (GetType() != other.GetType()) {
+    return false;
+  }
+  switch (GetType()) {
+    case ValueType::kNull:
+      return true;
+    case ValueType::kMap:
+      return MapEquals(ContentOf<MapValue>(*this), ContentOf<MapValue>(other));
+    case ValueType::kArray: {
+      const auto& first = ContentOf<ArrayValue>(*this);
+      const auto& second = ContentOf<ArrayValue>(other);
+      if (first.size() != second.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < first.size(); ++i) {
+        if (!ValueEquals(first[i].get(), second[i].get())) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case ValueType::kBool:
+      return ContentOf<BoolValue>(*this) == ContentOf<BoolValue>(other);
+    case ValueType::kInt:
+      return ContentOf<IntValue>(*this) == ContentOf<IntValue>(other);
+    case ValueType::kLong:
+      return ContentOf<LongValue>(*this) == ContentOf<LongValue>(other);
+    case ValueType::kDouble:
+      return ContentOf<DoubleValue>(*this) == ContentOf<DoubleValue>(other);
+    case ValueType::kString:
+      return ContentOf<StringValue>(*this) == ContentOf<StringValue>(other);
+  }
+}
+
+ValueMap Value::CloneMap(const ValueMap& map) {
+  ValueMap copy;
+  copy.reserve(map.size());
+  for (const auto& [key, value] : map) {
+    copy.emplace(key, value == nullptr ? nullptr : value->Clone());
+  }
+  return copy;
+}
+
+bool Value::MapEquals(const ValueMap& first, const ValueMap& second) {
+  if (first.size() != second.size()) {
+    return false;
+  }
+  for (const auto& [key, value] : first) {
+    auto other = second.find(key);
+    if (other == second.end() ||
+        !ValueEquals(value.get(), other->second.get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Value* Value::GetByIndex(uint32_t index) {
   if (GetType() != ValueType::kArray)
     return nullptr;
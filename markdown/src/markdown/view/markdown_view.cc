@@ -6,12 +6,14 @@
 
 #include <utility>
 
+#include "base/include/fml/task_runner.h"
 #include "markdown/draw/markdown_typewriter_drawer.h"
 #include "markdown/layout/markdown_layout.h"
 #include "markdown/layout/markdown_selection.h"
 #include "markdown/markdown_event_listener.h"
 #include "markdown/markdown_exposure_listener.h"
 #include "markdown/style/markdown_style_reader.h"
+#include "markdown/utils/markdown_trace.h"
 #include "markdown/view/markdown_platform_view.h"
 #include "markdown/view/markdown_view_animator.h"
 namespace serval::markdown {
@@ -56,6 +58,7 @@ MarkdownView::MarkdownView(MarkdownPlatformView* view,
   renderer_.SetViewContainerHandle(handle_);
 }
 MarkdownView::~MarkdownView() {
+  CancelLayoutTask();
   gesture_.SetRenderer(nullptr);
 }
 void MarkdownView::SetView(MarkdownPlatformView* view) {
@@ -75,6 +78,8 @@ MarkdownContext* MarkdownView::GetMarkdownContext() const {
   return context_.get();
 }
 void MarkdownView::SetResourceLoader(MarkdownResourceLoader* loader) {
+  // the layout in flight may use the loader being replaced
+  CancelLayoutTask();
   resource_loader_ = loader;
   measurer_.SetResourceLoader(loader);
   NeedsMeasure();
@@ -88,6 +93,22 @@ void MarkdownView::SetEventListener(MarkdownEventListener* listener) {
   animator_.SetEventListener(listener);
   gesture_.SetEventListener(listener);
 }
+void MarkdownView::SetLayoutTaskRunner(
+    std::shared_ptr<lynx::fml::BasicTaskRunner> runner,
+    std::shared_ptr<lynx::fml::BasicTaskRunner> owner_runner,
+    LayoutContextFactory create_context) {
+  if (runner == nullptr || owner_runner == nullptr ||
+      create_context == nullptr) {
+    CancelLayoutTask();
+    runner = nullptr;
+    owner_runner = nullptr;
+    create_context = nullptr;
+  }
+  layout_task_runner_ = std::move(runner);
+  owner_task_runner_ = std::move(owner_runner);
+  create_layout_context_ = std::move(create_context);
+  NeedsMeasure();
+}
 void MarkdownView::SetExposureListener(MarkdownExposureListener* listener) {
   exposure_listener_ = listener;
 }
@@ -113,8 +134,14 @@ void MarkdownView::SetContentRangeEnd(int32_t end) {
   SetContentRange({measurer_.GetContentStart(), end});
 }
 void MarkdownView::SetStyle(const ValueMap& style_map) {
-  measurer_.SetStyle(style_map);
-  NeedsMeasure();
+  if (measurer_.SetStyle(style_map)) {
+    NeedsMeasure();
+  }
+}
+void MarkdownView::SetStyle(std::shared_ptr<const MarkdownStyle> style) {
+  if (measurer_.SetStyle(std::move(style))) {
+    NeedsMeasure();
+  }
 }
 void MarkdownView::ApplyStyleInRange(const ValueMap& style_map,
                                      int32_t char_start, int32_t char_end) {
@@ -134,6 +161,12 @@ void MarkdownView::SetEnableRegionView(bool enable) {
     view_->RequestDraw();
   }
 }
+void MarkdownView::SetIncrementalTypewriter(bool enable) {
+  renderer_.SetIncrementalTypewriter(enable);
+  if (view_ != nullptr) {
+    view_->RequestDraw();
+  }
+}
 void MarkdownView::SetTextAttachments(std::unique_ptr<Value> attachments) {
   attachments_ = std::move(attachments);
   NeedsMeasure();
@@ -176,6 +209,7 @@ void MarkdownView::SetInitialAnimationStep(int32_t step) {
 }
 void MarkdownView::SetParserType(std::string_view parser_type,
                                  void* parser_ud) {
+  CancelLayoutTask();
   measurer_.SetParserType(parser_type, parser_ud);
   NeedsMeasure();
 }
@@ -199,7 +233,9 @@ void MarkdownView::SetSelectionHighlightColor(uint32_t color) {
   gesture_.SetSelectionHighlightColor(color);
 }
 MeasureResult MarkdownView::OnMeasure(MeasureSpec spec) {
-  measurer_.Measure(spec);
+  const auto measured = layout_task_runner_ != nullptr
+                            ? MeasureOffThread(spec)
+                            : measurer_.Measure(spec);
   if (measurer_.DidLayoutInLastMeasure()) {
     auto before_views = GetInlineViews();
     layout_data_.document_ = measurer_.GetDocument();
@@ -211,7 +247,6 @@ MeasureResult MarkdownView::OnMeasure(MeasureSpec spec) {
     animator_.SetLineExpandLineEndSteps(GetLineExpandAnimationSteps());
   }
 
-  const auto measured = measurer_.GetMeasuredSize();
   float result_width = measured.width_;
   float result_height = measured.height_;
   float transition_target_height = result_height;
@@ -234,6 +269,78 @@ MeasureResult MarkdownView::OnMeasure(MeasureSpec spec) {
           .height_ = result_height,
           .baseline_ = result_height};
 }
+SizeF MarkdownView::MeasureOffThread(MeasureSpec spec) {
+  const bool needs_layout = measurer_.PrepareMeasure(&spec);
+  AdoptFinishedLayout();
+  if (needs_layout && layout_task_ == nullptr) {
+    auto context = create_layout_context_();
+    if (context == nullptr) {
+      // never share the context of the view with the task runner
+      measurer_.InitialDocument();
+      measurer_.LayoutDocument(spec);
+      return measurer_.GetMeasuredSize();
+    }
+    context->SetHashHexColorFormat(context_->GetHashHexColorFormat());
+    context->SetHarmonyShaperForceLowAPI(
+        context_->IsHarmonyShaperForceLowAPI());
+    auto task = std::make_shared<LayoutTask>(
+        this, measurer_.ForkLayout(std::move(context)));
+    task->spec_ = spec;
+    layout_task_ = task;
+    measuring_off_thread_ = true;
+    layout_task_runner_->PostTask([task, owner = owner_task_runner_]() {
+      {
+        std::lock_guard<std::mutex> lock(task->mutex_);
+        if (task->cancelled_) {
+          return;
+        }
+        task->measurer_.LayoutDocument(task->spec_);
+      }
+      owner->PostTask([task]() {
+        // cancelled on this thread, before the view can go away
+        if (!task->cancelled_) {
+          task->view_->OnLayoutTaskDone(task.get());
+        }
+      });
+    });
+    measuring_off_thread_ = false;
+    // synchronous runners have finished already
+    AdoptFinishedLayout();
+  }
+  if (measurer_.GetDocument() == nullptr) {
+    return measurer_.EstimateSize(spec);
+  }
+  return measurer_.GetMeasuredSize();
+}
+void MarkdownView::AdoptFinishedLayout() {
+  if (layout_task_ == nullptr || !layout_task_->done_) {
+    return;
+  }
+  measurer_.AdoptLayout(std::move(layout_task_->measurer_));
+  layout_task_ = nullptr;
+}
+void MarkdownView::OnLayoutTaskDone(const LayoutTask* task) {
+  if (task != layout_task_.get()) {
+    return;
+  }
+  layout_task_->done_ = true;
+  // adopted by the measure, which then also updates the drawn layout
+  if (!measuring_off_thread_) {
+    measure_host_->RequestMeasure();
+  }
+}
+void MarkdownView::CancelLayoutTask() {
+  if (layout_task_ == nullptr) {
+    return;
+  }
+  {
+    // the running layout uses the resource loader and parser data
+    std::lock_guard<std::mutex> lock(layout_task_->mutex_);
+    layout_task_->cancelled_ = true;
+  }
+  layout_task_ = nullptr;
+  measurer_.DropForkedLayout();
+}
 void MarkdownView::Align(float x, float y) {
   measurer_.Align();
   if (layout_data_.document_ == nullptr ||
@@ -285,6 +392,7 @@ void MarkdownView::UpdateTextAttachments() {
         effect_.get(), layout_data_.document_.get());
     page->AddTextAttachments(std::move(effect));
   }
+  page->UpdateAttachmentGeometry();
 }
 void MarkdownView::OnLayoutFrame(int64_t timestamp) {
   animator_.UpdateCurrentTime(timestamp);
@@ -392,6 +500,7 @@ void MarkdownView::UpdateExposure() {
   if (exposure_skip_counter_++ % kExposureSkipInterval != 0) {
     return;
   }
+  MARKDOWN_TRACE_EVENT("MarkdownView::UpdateExposure");
   auto rect_in_screen = handle_->GetViewRectInScreen();
   auto images = renderer_data_.document_->GetImageByViewRect(rect_in_screen);
   std::unordered_set<ExposureKey, ExposureKey::Hash> current_images;
@@ -3,10 +3,13 @@
 // LICENSE file in the root directory of this source tree.
 #include "markdown/view/markdown_view_measurer.h"
 
+#include <algorithm>
+
 #include "markdown/layout/markdown_layout.h"
 #include "markdown/parser/impl/markdown_parser_impl.h"
 #include "markdown/style/markdown_style_reader.h"
 #include "markdown/utils/markdown_float_comparison.h"
+#include "markdown/utils/markdown_trace.h"
 #include "markdown/view/markdown_platform_view.h"
 
 namespace serval::markdown {
@@ -15,12 +18,16 @@ MarkdownViewMeasurer::MarkdownViewMeasurer(
     std::shared_ptr<MarkdownContext> context,
     MarkdownResourceLoader* resource_loader)
     : context_(std::move(context)), resource_loader_(resource_loader) {
-  style_ = MarkdownStyleReader::ReadStyle(ValueMap{}, resource_loader_,
-                                          context_.get());
+  style_ = context_->GetStyleCache().GetStyle(ValueMap{}, resource_loader_,
+                                              context_.get());
 }
 
 void MarkdownViewMeasurer::SetResourceLoader(
     MarkdownResourceLoader* resource_loader) {
+  if (resource_loader != resource_loader_) {
+    // styles are read through the loader; equal maps are read again
+    context_->GetStyleCache().DropResourceLoader(resource_loader_);
+  }
   resource_loader_ = resource_loader;
   NeedsMeasure();
 }
@@ -34,7 +41,7 @@ void MarkdownViewMeasurer::SetContent(std::string_view content) {
   if (document_ != nullptr) {
     document_->SetMarkdownContent(content_);
   }
-  NeedsMeasure();
+  NeedsParse();
 }
 
 void MarkdownViewMeasurer::SetContentID(std::string_view id) {
@@ -57,34 +64,49 @@ void MarkdownViewMeasurer::SetParserType(std::string_view parser_type,
                                          void* parser_ud) {
   parser_type_ = parser_type;
   parser_ud_ = parser_ud;
-  NeedsMeasure();
+  NeedsParse();
 }
 
 void MarkdownViewMeasurer::SetSourceType(SourceType type) {
   source_type_ = type;
-  NeedsMeasure();
+  NeedsParse();
 }
 
-void MarkdownViewMeasurer::SetStyle(const ValueMap& style_map) {
-  style_ = MarkdownStyleReader::ReadStyle(style_map, resource_loader_,
-                                          context_.get());
-  NeedsMeasure();
+bool MarkdownViewMeasurer::SetStyle(const ValueMap& style_map) {
+  // Platform bridges pass the whole theme again on every property update.
+  // Comparing maps is far cheaper than reading the style out of one.
+  return SetStyle(context_->GetStyleCache().GetStyle(
+      style_map, resource_loader_, context_.get()));
 }
 
 void MarkdownViewMeasurer::SetStyle(const MarkdownStyle& style) {
-  style_ = style;
+  SetStyle(std::make_shared<const MarkdownStyle>(style));
+}
+
+bool MarkdownViewMeasurer::SetStyle(
+    std::shared_ptr<const MarkdownStyle> style) {
+  if (style == nullptr || style == style_) {
+    return false;
+  }
+  style_ = std::move(style);
   NeedsMeasure();
+  return true;
 }
 
 void MarkdownViewMeasurer::ApplyStyleInRange(const ValueMap& style_map,
                                              int32_t char_start,
                                              int32_t char_end) {
-  if (document_ == nullptr) {
+  if (document_ == nullptr && !has_forked_layout_) {
     return;
   }
   const auto base_style = MarkdownStyleReader::ReadBaseStyle(
       style_map, resource_loader_, context_.get());
-  document_->ApplyStyleInRange(base_style, {char_start, char_end});
+  if (document_ != nullptr) {
+    document_->ApplyStyleInRange(base_style, {char_start, char_end});
+  }
+  if (has_forked_layout_) {
+    forked_range_styles_.emplace_back(base_style, Range{char_start, char_end});
+  }
 }
 
 void MarkdownViewMeasurer::SetTextMaxLines(int32_t max_lines) {
@@ -121,56 +143,153 @@ void MarkdownViewMeasurer::InitialDocument() {
 }
 
 SizeF MarkdownViewMeasurer::Measure(MeasureSpec spec) {
+  if (PrepareMeasure(&spec)) {
+    InitialDocument();
+    LayoutDocument(spec);
+  }
+  return {measured_width_, measured_height_};
+}
+
+bool MarkdownViewMeasurer::PrepareMeasure(MeasureSpec* spec) {
   did_layout_in_last_measure_ = false;
+  did_parse_in_last_measure_ = false;
 
-  if (spec.width_mode_ == tttext::LayoutMode::kIndefinite && spec.width_ <= 0) {
-    spec.width_ = MeasureSpec::LAYOUT_MAX_SIZE;
+  if (spec->width_mode_ == tttext::LayoutMode::kIndefinite &&
+      spec->width_ <= 0) {
+    spec->width_ = MeasureSpec::LAYOUT_MAX_SIZE;
   }
-  if (spec.height_mode_ == tttext::LayoutMode::kIndefinite) {
-    spec.height_ = MeasureSpec::LAYOUT_MAX_SIZE;
+  if (spec->height_mode_ == tttext::LayoutMode::kIndefinite) {
+    spec->height_ = MeasureSpec::LAYOUT_MAX_SIZE;
   }
 
-  if (FloatsNotEqual(spec.width_, last_measure_spec_.width_)) {
+  if (FloatsNotEqual(spec->width_, last_measure_spec_.width_)) {
     needs_measure_ = true;
   }
-  if (FloatsNotEqual(spec.height_, last_measure_spec_.height_)) {
+  if (FloatsNotEqual(spec->height_, last_measure_spec_.height_)) {
     needs_measure_ = true;
   }
-  last_measure_spec_ = spec;
+  last_measure_spec_ = *spec;
+  return needs_measure_;
+}
 
-  if (needs_measure_) {
-    InitialDocument();
-    document_->SetMaxSize(spec.width_, spec.height_);
-    document_->ClearForParse();
+void MarkdownViewMeasurer::LayoutDocument(const MeasureSpec& spec) {
+  MARKDOWN_TRACE_EVENT("MarkdownViewMeasurer::Measure", "content_length",
+                       content_.length());
+  document_->SetMaxSize(spec.width_, spec.height_);
+  document_->ClearForParse();
+  if (!needs_parse_ && !block_events_.IsEmpty()) {
+    // the source is unchanged, only regenerate the elements
+    MarkdownParserImpl::ReplayMarkdown(document_.get(), block_events_);
+  } else {
+    block_events_.Clear();
     if (source_type_ == SourceType::kMarkdown) {
       MarkdownParserImpl::ParseMarkdown(parser_type_, document_.get(),
-                                        parser_ud_);
+                                        parser_ud_, &block_events_);
     } else {
       MarkdownParserImpl::ParsePlainText(document_.get());
     }
-    if (trim_paragraph_spaces_) {
-      document_->TrimParagraphSpaces();
-    }
-    if (event_listener_) {
-      event_listener_->OnParseEnd();
-    }
-    MarkdownLayout layout(document_.get());
-    layout.SetPaddings(paddings_);
-    layout.Layout(spec.width_, spec.height_,
-                  text_max_lines_ > 0 ? text_max_lines_ : -1);
-    auto page = document_->GetPage();
-    if (page != nullptr) {
-      measured_width_ = page->GetLayoutWidth();
-      measured_height_ = page->GetLayoutHeight();
-    } else {
-      measured_width_ = 0;
-      measured_height_ = 0;
-    }
-    needs_measure_ = false;
-    did_layout_in_last_measure_ = true;
+    needs_parse_ = false;
+    did_parse_in_last_measure_ = true;
+  }
+  if (trim_paragraph_spaces_) {
+    document_->TrimParagraphSpaces();
   }
+  MARKDOWN_TRACE_COUNTER("element_count", document_->GetParagraphs().size());
+  if (event_listener_) {
+    event_listener_->OnParseEnd();
+  }
+  MarkdownLayout layout(document_.get());
+  layout.SetPaddings(paddings_);
+  layout.Layout(spec.width_, spec.height_,
+                text_max_lines_ > 0 ? text_max_lines_ : -1);
+  auto page = document_->GetPage();
+  if (page != nullptr) {
+    MARKDOWN_TRACE_COUNTER("region_count", page->GetRegionCount());
+    measured_width_ = page->GetLayoutWidth();
+    measured_height_ = page->GetLayoutHeight();
+  } else {
+    measured_width_ = 0;
+    measured_height_ = 0;
+  }
+  needs_measure_ = false;
+  did_layout_in_last_measure_ = true;
+}
 
-  return {measured_width_, measured_height_};
+MarkdownViewMeasurer MarkdownViewMeasurer::ForkLayout(
+    std::shared_ptr<MarkdownContext> context) {
+  forked_range_styles_.clear();
+  MarkdownViewMeasurer fork(*this);
+  has_forked_layout_ = true;
+  fork.context_ = std::move(context);
+  // the listener is told on adoption, on the thread that owns it
+  fork.event_listener_ = nullptr;
+  fork.InitialDocument();
+  needs_measure_ = false;
+  needs_parse_ = false;
+  return fork;
+}
+
+void MarkdownViewMeasurer::AdoptLayout(MarkdownViewMeasurer&& fork) {
+  // the fork inherited the scroll state of when it was made
+  const auto old_page = document_ == nullptr ? nullptr : document_->GetPage();
+  document_ = std::move(fork.document_);
+  document_->SetMarkdownEventListener(event_listener_);
+  const auto page = document_->GetPage();
+  if (old_page != nullptr && page != nullptr) {
+    page->ApplyScrollState(old_page->GetScrollState());
+  }
+  for (const auto& [style, range] : forked_range_styles_) {
+    document_->ApplyStyleInRange(style, range);
+  }
+  forked_range_styles_.clear();
+  has_forked_layout_ = false;
+  // stale if the source changed since the fork, then the next measure parses
+  block_events_ = std::move(fork.block_events_);
+  measured_width_ = fork.measured_width_;
+  measured_height_ = fork.measured_height_;
+  did_layout_in_last_measure_ = fork.did_layout_in_last_measure_;
+  did_parse_in_last_measure_ = fork.did_parse_in_last_measure_;
+  if (did_parse_in_last_measure_ && event_listener_) {
+    event_listener_->OnParseEnd();
+  }
+}
+
+SizeF MarkdownViewMeasurer::EstimateSize(MeasureSpec spec) const {
+  const auto& base = style_->normal_text_.base_;
+  const float font_size = std::max(base.font_size_, 1.f);
+  const float line_height =
+      base.line_height_ > 0 ? base.line_height_ : font_size * 1.5f;
+  // half an em per byte, which is close for latin text and safe for CJK
+  const float char_width = font_size * 0.5f;
+  const float available =
+      std::max(spec.width_ - paddings_.left_ - paddings_.right_, char_width);
+  const auto chars_per_line =
+      std::max<size_t>(static_cast<size_t>(available / char_width), 1);
+  size_t lines = 0;
+  size_t longest = 0;
+  size_t line_start = 0;
+  while (line_start <= content_.size()) {
+    auto line_end = content_.find('\n', line_start);
+    if (line_end == std::string::npos) {
+      line_end = content_.size();
+    }
+    const auto length = line_end - line_start;
+    lines += std::max<size_t>((length + chars_per_line - 1) / chars_per_line,
+                              1);
+    longest = std::max(longest, length);
+    line_start = line_end + 1;
+  }
+  float width = spec.width_;
+  if (spec.width_mode_ != tttext::LayoutMode::kDefinite) {
+    width = std::min(spec.width_, static_cast<float>(longest) * char_width +
+                                      paddings_.left_ + paddings_.right_);
+  }
+  float height = static_cast<float>(lines) * line_height + paddings_.top_ +
+                 paddings_.bottom_;
+  if (spec.height_mode_ != tttext::LayoutMode::kIndefinite) {
+    height = std::min(height, spec.height_);
+  }
+  return {width, height};
 }
 
 void MarkdownViewMeasurer::Align() {
@@ -200,5 +319,14 @@ std::shared_ptr<MarkdownDocument> MarkdownViewMeasurer::GetDocument() {
 void MarkdownViewMeasurer::NeedsMeasure() {
   needs_measure_ = true;
 }
+void MarkdownViewMeasurer::DropForkedLayout() {
+  forked_range_styles_.clear();
+  has_forked_layout_ = false;
+  NeedsParse();
+}
+void MarkdownViewMeasurer::NeedsParse() {
+  needs_parse_ = true;
+  needs_measure_ = true;
+}
 
 }  // namespace serval::markdown
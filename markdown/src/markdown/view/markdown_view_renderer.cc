@@ -7,12 +7,14 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <utility>
 
 #include "markdown/draw/markdown_drawer.h"
 #include "markdown/draw/markdown_typewriter_drawer.h"
 #include "markdown/element/markdown_document.h"
 #include "markdown/layout/markdown_selection.h"
+#include "markdown/utils/markdown_trace.h"
 #include "markdown/view/markdown_platform_view.h"
 #include "markdown/view/markdown_view_measurer.h"
 
@@ -21,6 +23,12 @@ namespace {
 constexpr float kViewVisibilityTolerant = 5.f;
 constexpr size_t kRegionViewPoolCapacity = 16;
 
+// Compares pages by ownership, so an expired page matches no live one.
+bool IsSamePage(const std::weak_ptr<MarkdownPage>& lhs,
+                const std::weak_ptr<MarkdownPage>& rhs) {
+  return !lhs.owner_before(rhs) && !rhs.owner_before(lhs);
+}
+
 class MarkdownRegionPlaceholderDrawable final : public MarkdownDrawable {
  public:
   ~MarkdownRegionPlaceholderDrawable() override = default;
@@ -35,11 +43,13 @@ class MarkdownRegionDrawable final : public MarkdownDrawable {
   MarkdownRegionDrawable(std::shared_ptr<MarkdownDocument> document,
                          uint32_t region_index,
                          const MarkdownAnimationType* animation_type,
-                         const int32_t* animation_step)
+                         const int32_t* animation_step,
+                         const MarkdownTypewriterRetention* retention)
       : document_(std::move(document)),
         region_index_(region_index),
         animation_type_(animation_type),
-        animation_step_(animation_step) {}
+        animation_step_(animation_step),
+        retention_(retention) {}
   ~MarkdownRegionDrawable() override = default;
 
   void Draw(tttext::ICanvasHelper* canvas, float x, float y) override {
@@ -56,13 +66,20 @@ class MarkdownRegionDrawable final : public MarkdownDrawable {
     if (animation_type_ != nullptr &&
         (*animation_type_ == MarkdownAnimationType::kTypewriter ||
          *animation_type_ == MarkdownAnimationType::kLineExpand)) {
+      // a retained region stops at its revealed lines, the tail view draws
+      // the rest
+      const bool retained =
+          retention_ != nullptr && IsSamePage(retention_->page_, page) &&
+          retention_->region_index_ == static_cast<int32_t>(region_index_);
       const auto cursor = page->GetCustomTypewriterCursor();
       MarkdownCharTypewriterDrawer drawer(
           document_->GetContextPtr(), canvas,
-          animation_step_ == nullptr ? 0 : *animation_step_,
+          retained ? retention_->char_end_
+                   : (animation_step_ == nullptr ? 0 : *animation_step_),
           document_->GetResourceLoader(),
           document_->GetStyle().typewriter_cursor_, !content_complete_,
           cursor == nullptr ? nullptr : cursor.get());
+      drawer.SetDrawCursor(!retained);
       drawer.DrawRegion(*page, region_index_);
     } else {
       MarkdownDrawer drawer(canvas, document_->GetContextPtr());
@@ -92,6 +109,66 @@ class MarkdownRegionDrawable final : public MarkdownDrawable {
   uint32_t region_index_{0};
   const MarkdownAnimationType* animation_type_{nullptr};
   const int32_t* animation_step_{nullptr};
+  const MarkdownTypewriterRetention* retention_{nullptr};
+  bool content_complete_{true};
+};
+
+class MarkdownTypewriterTailDrawable final : public MarkdownDrawable {
+ public:
+  MarkdownTypewriterTailDrawable(std::shared_ptr<MarkdownDocument> document,
+                                 const int32_t* animation_step,
+                                 const MarkdownTypewriterRetention* retention)
+      : document_(std::move(document)),
+        animation_step_(animation_step),
+        retention_(retention) {}
+  ~MarkdownTypewriterTailDrawable() override = default;
+
+  void Draw(tttext::ICanvasHelper* canvas, float x, float y) override {
+    if (document_ == nullptr || canvas == nullptr || retention_ == nullptr) {
+      return;
+    }
+    auto page = document_->GetPage();
+    if (page == nullptr || !IsSamePage(retention_->page_, page) ||
+        retention_->region_index_ < 0) {
+      return;
+    }
+    const auto region_index = static_cast<uint32_t>(retention_->region_index_);
+    const auto region_rect = page->GetRegionRect(region_index);
+    canvas->Save();
+    canvas->Translate(-region_rect.GetLeft(), -region_rect.GetTop());
+    const auto cursor = page->GetCustomTypewriterCursor();
+    MarkdownCharTypewriterDrawer drawer(
+        document_->GetContextPtr(), canvas,
+        animation_step_ == nullptr ? 0 : *animation_step_,
+        document_->GetResourceLoader(),
+        document_->GetStyle().typewriter_cursor_, !content_complete_,
+        cursor == nullptr ? nullptr : cursor.get());
+    drawer.DrawRegionTail(*page, region_index, retention_->char_end_);
+    canvas->Restore();
+  }
+  void SetContentComplete(bool complete) { content_complete_ = complete; }
+
+ private:
+  MeasureResult OnMeasure(MeasureSpec spec) override {
+    if (document_ == nullptr || retention_ == nullptr ||
+        retention_->region_index_ < 0) {
+      return {};
+    }
+    auto page = document_->GetPage();
+    if (page == nullptr) {
+      return {};
+    }
+    auto rect =
+        page->GetRegionRect(static_cast<uint32_t>(retention_->region_index_));
+    const float width = rect.GetWidth();
+    const float height = rect.GetHeight();
+    return {.width_ = width, .height_ = height, .baseline_ = height};
+  }
+
+ private:
+  std::shared_ptr<MarkdownDocument> document_;
+  const int32_t* animation_step_{nullptr};
+  const MarkdownTypewriterRetention* retention_{nullptr};
   bool content_complete_{true};
 };
 
@@ -146,6 +223,13 @@ void MarkdownViewRenderer::SetDocument(
   document_ = std::move(document);
   if (document_changed) {
     RebindRegionViews();
+    AttachTypewriterTailDrawable();
+  }
+  // a consumed bundle mostly carries the page already shown, whose revealed
+  // lines only move with the animation step
+  auto page = document_ == nullptr ? nullptr : document_->GetPage();
+  if (document_changed || !IsSamePage(retention_source_page_, page)) {
+    UpdateTypewriterRetention();
   }
   region_views_dirty_ = true;
   full_redraw_required_ = true;
@@ -163,6 +247,7 @@ void MarkdownViewRenderer::SetViewContainerHandle(
   }
   RemoveAllRegionViews();
   handle_ = handle;
+  UpdateTypewriterRetention();
   region_views_dirty_ = true;
   has_last_view_rect_ = false;
 }
@@ -174,6 +259,7 @@ void MarkdownViewRenderer::SetMarkdownAnimationType(
   }
   animation_type_ = type;
   UpdateTypewriterCursorBounds();
+  UpdateTypewriterRetention();
   region_views_dirty_ = true;
   full_redraw_required_ = true;
 }
@@ -195,6 +281,12 @@ void MarkdownViewRenderer::SetContentComplete(bool complete) {
         ->SetContentComplete(content_complete_);
     region.second.view_->RequestDraw();
   }
+  if (typewriter_tail_view_ != nullptr) {
+    static_cast<MarkdownTypewriterTailDrawable*>(
+        typewriter_tail_view_->GetCustomViewHandle()->GetDrawable())
+        ->SetContentComplete(content_complete_);
+    typewriter_tail_view_->RequestDraw();
+  }
 }
 void MarkdownViewRenderer::SetEnableRegionView(bool enable) {
   if (enable_region_view_ == enable) {
@@ -202,10 +294,18 @@ void MarkdownViewRenderer::SetEnableRegionView(bool enable) {
   }
   enable_region_view_ = enable;
   RemoveAllRegionViews();
+  UpdateTypewriterRetention();
   region_views_dirty_ = true;
   full_redraw_required_ = true;
   has_last_view_rect_ = false;
 }
+void MarkdownViewRenderer::SetIncrementalTypewriter(bool enable) {
+  if (incremental_typewriter_ == enable) {
+    return;
+  }
+  incremental_typewriter_ = enable;
+  UpdateTypewriterRetention();
+}
 void MarkdownViewRenderer::RequestDrawRegion(uint32_t region_index) {
   if (!NeedUseRegionView()) {
     full_redraw_required_ = true;
@@ -255,7 +355,8 @@ void MarkdownViewRenderer::AttachRegionDrawable(MarkdownPlatformView* view,
     return;
   }
   auto drawable = std::make_shared<MarkdownRegionDrawable>(
-      document_, region_index, &animation_type_, &animation_step_);
+      document_, region_index, &animation_type_, &animation_step_,
+      &typewriter_retention_);
   drawable->SetContentComplete(content_complete_);
   view->GetCustomViewHandle()->AttachDrawable(std::move(drawable));
 }
@@ -374,6 +475,7 @@ bool MarkdownViewRenderer::NeedUpdateVisibleRegionViews(
 }
 
 void MarkdownViewRenderer::RemoveAllRegionViews() {
+  RemoveTypewriterTailView();
   if (handle_ != nullptr) {
     for (const auto& pair : region_views_) {
       handle_->RemoveSubView(pair.second.view_.get());
@@ -396,6 +498,8 @@ void MarkdownViewRenderer::UpdateVisibleRegionViews(RectF view_rect) {
     RemoveAllRegionViews();
     return;
   }
+  MARKDOWN_TRACE_EVENT("MarkdownViewRenderer::UpdateVisibleRegionViews",
+                       "region_count", page->GetRegionCount());
   const float visible_top = view_rect.GetTop() - kViewVisibilityTolerant;
   const float visible_bottom = view_rect.GetBottom() + kViewVisibilityTolerant;
 
@@ -500,6 +604,7 @@ void MarkdownViewRenderer::UpdateVisibleRegionViews(RectF view_rect) {
       ++iter;
     }
   }
+  MARKDOWN_TRACE_COUNTER("region_view_count", region_views_.size());
 }
 
 void MarkdownViewRenderer::UpdateRegionViewsByViewRect() {
@@ -536,15 +641,117 @@ void MarkdownViewRenderer::UpdateRegionViewsByAnimationStep(
   if (previous_step == animation_step_) {
     return;
   }
+  UpdateTypewriterRetention();
   const auto range = document_->GetChangedRegionsWhenAnimationUpdated(
       std::max(0, previous_step - 1), animation_step_);
   for (auto& [index, view] : region_views_) {
-    if (index >= range.start_ && index <= range.end_) {
+    // the retained region was redrawn above if its revealed lines changed
+    if (index >= range.start_ && index <= range.end_ &&
+        index != typewriter_retention_.region_index_) {
       view.view_->RequestDraw();
     }
   }
 }
 
+bool MarkdownViewRenderer::NeedRetainTypewriterRegion(
+    const MarkdownPage& page) const {
+  if (!incremental_typewriter_ || !NeedUseRegionView()) {
+    return false;
+  }
+  if (animation_type_ != MarkdownAnimationType::kTypewriter &&
+      animation_type_ != MarkdownAnimationType::kLineExpand) {
+    return false;
+  }
+  if (!page.GetLineIndex().IsBuilt()) {
+    return false;
+  }
+  // attachments indexed from the step move on every step and would leave
+  // stale drawing in the retained lines
+  const auto follows_step = [](const auto& attachment) {
+    return attachment->start_index_ < 0 || attachment->end_index_ < 0;
+  };
+  return std::none_of(page.GetTextAttachments().begin(),
+                      page.GetTextAttachments().end(), follows_step) &&
+         std::none_of(page.GetBorderAttachments().begin(),
+                      page.GetBorderAttachments().end(), follows_step);
+}
+
+void MarkdownViewRenderer::UpdateTypewriterRetention() {
+  MarkdownTypewriterRetention retention;
+  auto page = document_ == nullptr ? nullptr : document_->GetPage();
+  retention_source_page_ = page;
+  if (page != nullptr && NeedRetainTypewriterRegion(*page)) {
+    const auto& steps = page->GetLineIndex();
+    const int32_t revealed =
+        std::min(animation_step_, steps.GetPageCharCount());
+    MarkdownTypewriterStep step;
+    if (revealed > 0 && steps.FindStep(*page, revealed - 1, &step)) {
+      const int32_t char_end =
+          MarkdownCharTypewriterDrawer::GetRevealedLinesEnd(
+              *page, step.page_region_index_, animation_step_);
+      const auto* region = page->GetRegion(step.page_region_index_);
+      // until its first line is revealed the region is drawn as usual
+      if (char_end > static_cast<int32_t>(region->element_->GetCharStart())) {
+        retention.page_ = page;
+        retention.region_index_ = static_cast<int32_t>(step.page_region_index_);
+        retention.char_end_ = char_end;
+      }
+    }
+  }
+  if (retention.region_index_ >= 0 && typewriter_tail_view_ == nullptr) {
+    typewriter_tail_view_ = handle_->CreateCustomSubView();
+    if (typewriter_tail_view_ != nullptr &&
+        typewriter_tail_view_->GetCustomViewHandle() != nullptr) {
+      AttachTypewriterTailDrawable();
+    } else {
+      RemoveTypewriterTailView();
+      retention = {};
+    }
+  }
+  const auto previous = typewriter_retention_;
+  typewriter_retention_ = retention;
+  if (typewriter_tail_view_ != nullptr) {
+    typewriter_tail_view_->SetVisibility(retention.region_index_ >= 0);
+    if (retention.region_index_ >= 0) {
+      UpdateSubViewRect(
+          typewriter_tail_view_.get(),
+          page->GetRegionRect(static_cast<uint32_t>(retention.region_index_)));
+      typewriter_tail_view_->RequestDraw();
+    }
+  }
+  if (IsSamePage(previous.page_, retention.page_) &&
+      previous.region_index_ == retention.region_index_ &&
+      previous.char_end_ == retention.char_end_) {
+    return;
+  }
+  for (const auto index : {previous.region_index_, retention.region_index_}) {
+    const auto iter = region_views_.find(index);
+    if (iter != region_views_.end() && iter->second.view_ != nullptr) {
+      iter->second.view_->RequestDraw();
+    }
+  }
+}
+
+void MarkdownViewRenderer::AttachTypewriterTailDrawable() {
+  if (typewriter_tail_view_ == nullptr || document_ == nullptr ||
+      typewriter_tail_view_->GetCustomViewHandle() == nullptr) {
+    return;
+  }
+  auto drawable = std::make_shared<MarkdownTypewriterTailDrawable>(
+      document_, &animation_step_, &typewriter_retention_);
+  drawable->SetContentComplete(content_complete_);
+  typewriter_tail_view_->GetCustomViewHandle()->AttachDrawable(
+      std::move(drawable));
+}
+
+void MarkdownViewRenderer::RemoveTypewriterTailView() {
+  typewriter_retention_ = {};
+  if (typewriter_tail_view_ != nullptr && handle_ != nullptr) {
+    handle_->RemoveSubView(typewriter_tail_view_.get());
+  }
+  typewriter_tail_view_ = nullptr;
+}
+
 void MarkdownViewRenderer::UpdateTypewriterCursorBounds() {
   if (document_ == nullptr) {
     return;
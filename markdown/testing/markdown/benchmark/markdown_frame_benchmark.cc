@@ -0,0 +1,443 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+// Frame-driven benchmark for MarkdownView on the mock platform.
+//
+//   markdown_frame_benchmark [--sections N] [--frames N] [--width W]
+//                            [--per-frame] [--output PATH]
+//
+// Every scenario builds a fresh MockMarkdownMainView over a generated
+// document of --sections sections (headings, paragraphs, lists, tables, code
+// and quotes), lays it out once, then drives --frames frames through
+// MarkdownFrameDriver. The wall time and the operator new calls of each frame
+// are recorded, including the action applied before the frame. Results are
+// written as JSON to stdout or --output; --per-frame adds the raw samples.
+//
+// Scenarios:
+//   stream      content arrives in equal chunks, one per frame
+//   typewriter  the typewriter animation runs over the whole document
+//   scroll      region views are enabled and the visible rect slides down
+//   selection   a long press selection is dragged down the document
+//   style       the normal text style alternates every frame
+//
+// The "kernels" array then lists the cost per call of queries the scenarios
+// do not isolate, see benchmark/markdown_kernel_benchmark.cc.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+#include "testing/markdown/benchmark/markdown_kernel_benchmark.h"
+#include "testing/markdown/frame_driven_tests/markdown_frame_driver.h"
+#include "testing/markdown/mock_platform/markdown_tests_platform.h"
+#include "testing/markdown/mock_platform/mock_markdown_canvas.h"
+#include "testing/markdown/mock_platform/mock_markdown_platform_view.h"
+#include "testing/markdown/mock_platform/mock_markdown_resource_loader.h"
+
+namespace {
+
+std::atomic<uint64_t> g_allocation_count{0};
+std::atomic<uint64_t> g_allocation_bytes{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  g_allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+  std::free(memory);
+}
+
+namespace serval::markdown::testing {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr float kViewportHeight = 800;
+constexpr float kSelectionStartX = 20;
+constexpr float kSelectionStartY = 20;
+
+struct Options {
+  int32_t sections{200};
+  int32_t frames{120};
+  float width{375};
+  bool per_frame{false};
+  const char* output{nullptr};
+};
+
+struct FrameSample {
+  double ms;
+  uint64_t allocations;
+  uint64_t allocated_bytes;
+};
+
+struct ScenarioResult {
+  std::string name;
+  double setup_ms{0};
+  uint64_t setup_allocations{0};
+  std::vector<FrameSample> frames;
+};
+
+struct Scenario {
+  const char* name;
+  // Configures the view before the first layout.
+  std::function<void(MarkdownView*)> setup;
+  // Applied before frame |index| is flushed.
+  std::function<void(int32_t index, MockMarkdownMainView*)> frame;
+};
+
+std::string GenerateDocument(int32_t sections) {
+  std::string markdown;
+  for (int32_t i = 0; i < sections; i++) {
+    const auto index = std::to_string(i);
+    markdown += "## Section " + index + "\n\n";
+    markdown += "Paragraph " + index +
+                " mixes **strong**, *emphasis*, `inline code` and a "
+                "[link](https://example.com/" +
+                index +
+                ") with enough plain words to wrap over several lines of a "
+                "narrow view, so that layout has real line breaking work to "
+                "do for every section of the document.\n\n";
+    markdown += "- first item of list " + index +
+                "\n- second item with a longer text that wraps\n"
+                "  - nested item\n- third item\n\n";
+    if (i % 4 == 1) {
+      markdown +=
+          "| name | value | note |\n|---|:-:|--:|\n"
+          "| alpha | 1 | short |\n| beta | 22 | a longer cell text |\n"
+          "| gamma | 333 | |\n\n";
+    }
+    if (i % 5 == 2) {
+      markdown +=
+          "```\nfor (int i = 0; i < n; i++) {\n  sum += values[i];\n}\n```"
+          "\n\n";
+    }
+    if (i % 3 == 0) {
+      markdown += "> quoted text of section " + index + "\n\n";
+    }
+  }
+  return markdown;
+}
+
+std::unique_ptr<Value> MakeNormalTextStyle(double font_size) {
+  ValueMap normal_text;
+  normal_text["fontSize"] = Value::MakeDouble(font_size);
+  ValueMap style;
+  style["normalText"] = Value::MakeMap(std::move(normal_text));
+  return Value::MakeMap(std::move(style));
+}
+
+ScenarioResult RunScenario(const Scenario& scenario,
+                           const std::string& markdown,
+                           const Options& options) {
+  ScenarioResult result;
+  result.name = scenario.name;
+  auto context = CreateTestMarkdownSharedContext();
+  MockMarkdownResourceLoader resource_loader;
+  MockMarkdownCanvas canvas(&resource_loader);
+  MockMarkdownMainView main_view(context);
+  auto* view = main_view.GetMarkdownView();
+  view->SetResourceLoader(&resource_loader);
+  resource_loader.SetMainView(&main_view);
+  view->SetContent(markdown);
+  if (scenario.setup) {
+    scenario.setup(view);
+  }
+
+  MarkdownFrameDriver driver(&main_view, &canvas);
+  driver.SetRecordRenders(false);
+  driver.SetMeasureSpec({.width_ = options.width,
+                         .width_mode_ = tttext::LayoutMode::kDefinite,
+                         .height_ = MeasureSpec::LAYOUT_MAX_SIZE,
+                         .height_mode_ = tttext::LayoutMode::kIndefinite});
+  auto allocations = g_allocation_count.load();
+  auto start = Clock::now();
+  driver.RunSteps({});
+  result.setup_ms =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  result.setup_allocations = g_allocation_count.load() - allocations;
+
+  result.frames.reserve(options.frames);
+  for (int32_t i = 0; i < options.frames; i++) {
+    allocations = g_allocation_count.load();
+    const auto bytes = g_allocation_bytes.load();
+    start = Clock::now();
+    if (scenario.frame) {
+      scenario.frame(i, &main_view);
+    }
+    driver.FlushFrame();
+    const auto end = Clock::now();
+    result.frames.push_back(
+        {std::chrono::duration<double, std::milli>(end - start).count(),
+         g_allocation_count.load() - allocations,
+         g_allocation_bytes.load() - bytes});
+  }
+  return result;
+}
+
+std::vector<Scenario> MakeScenarios(const std::string& markdown,
+                                    const Options& options) {
+  std::vector<Scenario> scenarios;
+  const auto frames = static_cast<size_t>(options.frames);
+  const auto chunk = (markdown.size() + frames - 1) / frames;
+  scenarios.push_back(
+      {"stream",
+       [](MarkdownView* view) {
+         view->SetContent("");
+         view->SetContentComplete(false);
+       },
+       [&markdown, chunk](int32_t index, MockMarkdownMainView* main_view) {
+         const auto size =
+             std::min(markdown.size(), chunk * static_cast<size_t>(index + 1));
+         auto* view = main_view->GetMarkdownView();
+         view->SetContent(std::string_view(markdown).substr(0, size));
+         if (size == markdown.size()) {
+           view->SetContentComplete(true);
+         }
+       }});
+
+  // chars per second so that the animation ends with the last frame; the
+  // source length overestimates the char count, which only shortens it
+  const auto velocity = static_cast<float>(markdown.size()) * 1000.f /
+                        (static_cast<float>(options.frames) *
+                         MarkdownFrameDriver::FRAME_INTERVAL);
+  scenarios.push_back({"typewriter",
+                       [velocity](MarkdownView* view) {
+                         view->SetAnimationType(
+                             MarkdownAnimationType::kTypewriter);
+                         view->SetAnimationVelocity(velocity);
+                         view->SetInitialAnimationStep(0);
+                       },
+                       nullptr});
+
+  scenarios.push_back(
+      {"scroll", [](MarkdownView* view) { view->SetEnableRegionView(true); },
+       [&options](int32_t index, MockMarkdownMainView* main_view) {
+         const float content_height =
+             main_view->GetMarkdownView()->GetMeasureHeight();
+         const float range = std::max(content_height - kViewportHeight, 1.f);
+         const float top = std::fmod(static_cast<float>(index) * range /
+                                         static_cast<float>(options.frames),
+                                     range);
+         main_view->SetViewRectInScreen(RectF::MakeLTRB(
+             0, -top, options.width, kViewportHeight - top));
+       }});
+
+  scenarios.push_back(
+      {"selection",
+       [](MarkdownView* view) { view->SetEnableSelection(true); },
+       [](int32_t index, MockMarkdownMainView* main_view) {
+         const PointF motion{static_cast<float>(index % 7) * 10,
+                             static_cast<float>(index + 1) * 24};
+         const PointF position{kSelectionStartX + motion.x_,
+                               kSelectionStartY + motion.y_};
+         if (index == 0) {
+           main_view->OnLongPress({kSelectionStartX, kSelectionStartY},
+                                  GestureEventType::kDown);
+           main_view->OnPan(position, motion, GestureEventType::kDown);
+         }
+         main_view->OnPan(position, motion, GestureEventType::kMove);
+       }});
+
+  scenarios.push_back(
+      {"style", nullptr, [](int32_t index, MockMarkdownMainView* main_view) {
+         auto style = MakeNormalTextStyle(index % 2 == 0 ? 17 : 16);
+         main_view->GetMarkdownView()->SetStyle(style->AsMap());
+       }});
+  return scenarios;
+}
+
+double Percentile(std::vector<double> values, double percentile) {
+  if (values.empty()) {
+    return 0;
+  }
+  const auto index = static_cast<size_t>(
+      percentile * static_cast<double>(values.size() - 1) + 0.5);
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+template <typename Writer>
+void WriteResult(Writer& writer, const ScenarioResult& result,
+                 const Options& options) {
+  std::vector<double> times;
+  double total_ms = 0;
+  uint64_t allocations = 0;
+  uint64_t allocated_bytes = 0;
+  for (const auto& frame : result.frames) {
+    times.push_back(frame.ms);
+    total_ms += frame.ms;
+    allocations += frame.allocations;
+    allocated_bytes += frame.allocated_bytes;
+  }
+  const auto count = static_cast<double>(std::max<size_t>(times.size(), 1));
+  writer.StartObject();
+  writer.Key("name");
+  writer.String(result.name.c_str());
+  writer.Key("setup_ms");
+  writer.Double(result.setup_ms);
+  writer.Key("setup_allocations");
+  writer.Uint64(result.setup_allocations);
+  writer.Key("frames");
+  writer.Uint64(result.frames.size());
+  writer.Key("total_ms");
+  writer.Double(total_ms);
+  writer.Key("mean_ms");
+  writer.Double(total_ms / count);
+  writer.Key("p50_ms");
+  writer.Double(Percentile(times, 0.5));
+  writer.Key("p95_ms");
+  writer.Double(Percentile(times, 0.95));
+  writer.Key("max_ms");
+  writer.Double(times.empty() ? 0 : *std::max_element(times.begin(),
+                                                       times.end()));
+  writer.Key("allocations_per_frame");
+  writer.Double(static_cast<double>(allocations) / count);
+  writer.Key("allocated_bytes_per_frame");
+  writer.Double(static_cast<double>(allocated_bytes) / count);
+  if (options.per_frame) {
+    writer.Key("samples");
+    writer.StartArray();
+    for (const auto& frame : result.frames) {
+      writer.StartArray();
+      writer.Double(frame.ms);
+      writer.Uint64(frame.allocations);
+      writer.Uint64(frame.allocated_bytes);
+      writer.EndArray();
+    }
+    writer.EndArray();
+  }
+  writer.EndObject();
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (strcmp(arg, "--sections") == 0 && has_value) {
+      options->sections = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(arg, "--frames") == 0 && has_value) {
+      options->frames = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(arg, "--width") == 0 && has_value) {
+      options->width = std::max(1.f, static_cast<float>(atof(argv[++i])));
+    } else if (strcmp(arg, "--per-frame") == 0) {
+      options->per_frame = true;
+    } else if (strcmp(arg, "--output") == 0 && has_value) {
+      options->output = argv[++i];
+    } else {
+      fprintf(stderr,
+              "usage: %s [--sections N] [--frames N] [--width W] "
+              "[--per-frame] [--output PATH]\n",
+              argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+}  // namespace serval::markdown::testing
+
+int main(int argc, char** argv) {
+  using namespace serval::markdown::testing;
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    return 1;
+  }
+  const auto markdown = GenerateDocument(options.sections);
+  std::vector<ScenarioResult> results;
+  for (const auto& scenario : MakeScenarios(markdown, options)) {
+    fprintf(stderr, "running %s\n", scenario.name);
+    results.push_back(RunScenario(scenario, markdown, options));
+  }
+  fprintf(stderr, "running kernels\n");
+  const auto kernels = RunKernelBenchmarks();
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+  writer.SetIndent(' ', 2);
+  writer.StartObject();
+  writer.Key("sections");
+  writer.Int(options.sections);
+  writer.Key("document_bytes");
+  writer.Uint64(markdown.size());
+  writer.Key("width");
+  writer.Double(options.width);
+  writer.Key("frame_interval_ms");
+  writer.Int64(MarkdownFrameDriver::FRAME_INTERVAL);
+  writer.Key("scenarios");
+  writer.StartArray();
+  for (const auto& result : results) {
+    WriteResult(writer, result, options);
+  }
+  writer.EndArray();
+  writer.Key("kernels");
+  writer.StartArray();
+  for (const auto& kernel : kernels) {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(kernel.name.c_str());
+    writer.Key("calls");
+    writer.Int64(kernel.calls);
+    writer.Key("ns_per_call");
+    writer.Double(kernel.ns_per_call);
+    if (kernel.baseline_ns_per_call >= 0) {
+      writer.Key("baseline_ns_per_call");
+      writer.Double(kernel.baseline_ns_per_call);
+    }
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+
+  FILE* output = stdout;
+  if (options.output != nullptr) {
+    output = fopen(options.output, "w");
+    if (output == nullptr) {
+      fprintf(stderr, "cannot open %s\n", options.output);
+      return 1;
+    }
+  }
+  fprintf(output, "%s\n", buffer.GetString());
+  if (output != stdout) {
+    fclose(output);
+  }
+  return 0;
+}
@@ -0,0 +1,131 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "testing/markdown/benchmark/markdown_kernel_benchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "markdown/layout/markdown_selection.h"
+#include "markdown/utils/markdown_string_utils.h"
+#include "markdown/view/markdown_view_measurer.h"
+#include "testing/markdown/mock_platform/markdown_tests_platform.h"
+
+namespace serval::markdown::testing {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double NanosecondsPerCall(Clock::duration elapsed, int64_t calls) {
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(calls);
+}
+
+// Selection queries on a 5000 region page. Each query starts at a
+// binary-searched region or line, so the cost should stay flat as the
+// queried char moves from the head to the tail of the page.
+void RunSelectionQueries(std::vector<KernelResult>* results) {
+  constexpr int kRegionCount = 5000;
+  constexpr int64_t kQueries = 2000;
+  auto context = CreateTestMarkdownSharedContext();
+  std::string content;
+  for (int i = 0; i < kRegionCount; i++) {
+    content += "paragraph " + std::to_string(i) + " of a long transcript\n\n";
+  }
+  MarkdownViewMeasurer measurer(context);
+  measurer.SetContent(content);
+  measurer.Measure({.width_ = 160,
+                    .width_mode_ = tttext::LayoutMode::kDefinite,
+                    .height_ = MeasureSpec::LAYOUT_MAX_SIZE,
+                    .height_mode_ = tttext::LayoutMode::kIndefinite});
+  auto page = measurer.GetDocument()->GetPage();
+  if (page == nullptr) {
+    return;
+  }
+  const auto char_count = MarkdownSelection::GetPageCharCount(page.get());
+  const auto time_queries = [&](const char* name, int char_begin) {
+    const auto start = Clock::now();
+    for (int64_t i = 0; i < kQueries; i++) {
+      const int char_index = char_begin + static_cast<int>(i % 64);
+      MarkdownSelection::GetLineIndexByCharIndex(page.get(), char_index);
+      MarkdownSelection::GetSelectionRectByCharPos(page.get(), char_index,
+                                                   char_index + 1);
+    }
+    results->push_back(
+        {name, kQueries, NanosecondsPerCall(Clock::now() - start, kQueries)});
+  };
+  time_queries("selection_query_page_head", 0);
+  time_queries("selection_query_page_tail", char_count - 64);
+}
+
+// the byte to char index map as the parser built it before the 16 byte
+// blocks
+std::vector<int32_t> ScanByteIndexToCharIndexMap(std::string_view utf8) {
+  std::vector<int32_t> result;
+  int32_t char_index = 0;
+  for (const auto c : utf8) {
+    result.emplace_back(char_index);
+    if ((c & 0xC0) != 0x80) {
+      char_index++;
+    }
+  }
+  result.emplace_back(char_index);
+  return result;
+}
+
+std::string RepeatToSize(std::string_view unit, size_t size) {
+  std::string result;
+  while (result.size() < size) {
+    result.append(unit);
+  }
+  return result;
+}
+
+// One call maps a 512KB source, as the parser does once per parse.
+void RunByteIndexToCharIndexMap(std::vector<KernelResult>* results) {
+  constexpr size_t kCorpusSize = 512 * 1024;
+  constexpr int64_t kRounds = 20;
+  const std::vector<std::pair<const char*, std::string>> corpora = {
+      {"byte_to_char_index_map_ascii",
+       RepeatToSize("# Title\n\nSome *markdown* text. ", kCorpusSize)},
+      {"byte_to_char_index_map_cjk",
+       RepeatToSize("中文的段落，混合一些 ascii 文本。\n", kCorpusSize)},
+      {"byte_to_char_index_map_emoji",
+       RepeatToSize("😀 emoji 👍🏽 text 🇨🇳\n", kCorpusSize)},
+  };
+  for (const auto& [name, corpus] : corpora) {
+    size_t checksum = 0;
+    const auto start = Clock::now();
+    for (int64_t i = 0; i < kRounds; i++) {
+      checksum += UTF8ByteIndexToCharIndexMap(corpus).back();
+    }
+    const auto middle = Clock::now();
+    for (int64_t i = 0; i < kRounds; i++) {
+      checksum -= ScanByteIndexToCharIndexMap(corpus).back();
+    }
+    const auto end = Clock::now();
+    if (checksum != 0) {
+      fprintf(stderr, "%s: map differs from the scan\n", name);
+    }
+    results->push_back({name, kRounds,
+                        NanosecondsPerCall(middle - start, kRounds),
+                        NanosecondsPerCall(end - middle, kRounds)});
+  }
+}
+
+}  // namespace
+
+std::vector<KernelResult> RunKernelBenchmarks() {
+  std::vector<KernelResult> results;
+  RunSelectionQueries(&results);
+  RunByteIndexToCharIndexMap(&results);
+  return results;
+}
+
+}  // namespace serval::markdown::testing
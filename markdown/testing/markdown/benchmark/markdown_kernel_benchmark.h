@@ -0,0 +1,27 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef MARKDOWN_TESTING_MARKDOWN_BENCHMARK_MARKDOWN_KERNEL_BENCHMARK_H_
+#define MARKDOWN_TESTING_MARKDOWN_BENCHMARK_MARKDOWN_KERNEL_BENCHMARK_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace serval::markdown::testing {
+
+// Cost of one call of a query the frame scenarios do not isolate. The
+// baseline is the scan the query replaced, or negative if there is none.
+struct KernelResult {
+  std::string name;
+  int64_t calls{0};
+  double ns_per_call{0};
+  double baseline_ns_per_call{-1};
+};
+
+std::vector<KernelResult> RunKernelBenchmarks();
+
+}  // namespace serval::markdown::testing
+
+#endif  // MARKDOWN_TESTING_MARKDOWN_BENCHMARK_MARKDOWN_KERNEL_BENCHMARK_H_
@@ -10,6 +10,8 @@
 #include <utility>
 #include "markdown/utils/markdown_string_utils.h"
 #include "markdown/view/markdown_view.h"
+#include "testing/markdown/mock_platform/markdown_tests_platform.h"
+#include "testing/markdown/mock_platform/mock_markdown_task_runner.h"
 
 namespace serval::markdown::testing {
 namespace fs = std::filesystem;
@@ -277,6 +279,9 @@ void MarkdownCaseBuilder::DecodeAttributes(Value* attributes) {
   if (const auto iter = map.find("enable-text-selection"); iter != map.end()) {
     attributes_.enable_selection = iter->second->AsBool();
   }
+  if (const auto iter = map.find("async-layout"); iter != map.end()) {
+    attributes_.async_layout = iter->second->AsBool();
+  }
 }
 
 void MarkdownCaseBuilder::ApplyAttributes(MarkdownAttributes& attributes,
@@ -304,6 +309,11 @@ void MarkdownCaseBuilder::ApplyAttributes(MarkdownAttributes& attributes,
   markdown_view->SetTypewriterHeightTransitionPrefetch(
       attributes.typewriter_height_transition_prefetch);
   markdown_view->SetEnableSelection(attributes.enable_selection);
+  if (attributes.async_layout) {
+    markdown_view->SetLayoutTaskRunner(std::make_shared<MockSyncTaskRunner>(),
+                                       std::make_shared<MockSyncTaskRunner>(),
+                                       CreateTestMarkdownSharedContext);
+  }
 }
 
 void MarkdownCaseBuilder::UpdateSteps(Value* steps) {
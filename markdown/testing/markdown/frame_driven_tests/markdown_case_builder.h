@@ -79,6 +79,8 @@ struct MarkdownAttributes {
   float typewriter_height_transition_duration{0};
   bool typewriter_height_transition_prefetch{true};
   bool enable_selection{false};
+  // lays out through a synchronous task runner
+  bool async_layout{false};
 };
 
 struct MarkdownCaseEntry {
@@ -84,9 +84,9 @@ void ExpectValue(const std::unique_ptr<Value>& result,
   }
 }
 
-void RunSingleCase(MarkdownCaseEntry& single_case) {
-  SCOPED_TRACE(single_case.name);
-  ASSERT_NE(single_case.attributes.markdown.length(), 0);
+// Drives |single_case| through its frames, writing its ground truth instead
+// when the case asks for it. Returns the frames' result as a value.
+MarkdownCaseValuePtr RunCaseFrames(MarkdownCaseEntry& single_case) {
   auto context = CreateTestMarkdownSharedContext();
   MockMarkdownResourceLoader resource_loader;
   MockMarkdownCanvas canvas(&resource_loader);
@@ -103,8 +103,15 @@ void RunSingleCase(MarkdownCaseEntry& single_case) {
     output << result_json;
     output.flush();
     output.close();
-  } else {
-    auto result_value = MarkdownCaseBuilder::ConvertJson(result);
+  }
+  return MarkdownCaseBuilder::ConvertJson(result);
+}
+
+void RunSingleCase(MarkdownCaseEntry& single_case) {
+  SCOPED_TRACE(single_case.name);
+  ASSERT_NE(single_case.attributes.markdown.length(), 0);
+  auto result_value = RunCaseFrames(single_case);
+  if (!single_case.attributes.generate_ground_truth) {
     ExpectValue(result_value, single_case.attributes.ground_truth);
   }
 }
@@ -114,6 +121,23 @@ void RunSingleCase(const fs::path& directory) {
   RunSingleCase(single_case);
 }
 
+// Layout through a synchronous task runner has to draw the same frames as
+// inline layout, so the typewriter case runs both ways against one truth.
+TEST(MarkdownCaseUnittest, AsyncLayoutTypewriterFrames) {
+  auto sync_case = MarkdownCaseBuilder::LoadSingleCase(CASES_PATH /
+                                                       "typewriter_frames");
+  auto async_case = MarkdownCaseBuilder::LoadSingleCase(CASES_PATH /
+                                                        "typewriter_frames");
+  ASSERT_NE(sync_case.attributes.markdown.length(), 0);
+  ASSERT_FALSE(sync_case.attributes.async_layout);
+  ASSERT_FALSE(sync_case.attributes.generate_ground_truth);
+  async_case.attributes.async_layout = true;
+  const auto sync_result = RunCaseFrames(sync_case);
+  const auto async_result = RunCaseFrames(async_case);
+  ExpectValue(async_result, sync_result);
+  ExpectValue(async_result, async_case.attributes.ground_truth);
+}
+
 TEST(MarkdownCaseUnittest, BasicHeadingsH1H6) {
   RunSingleCase(CASES_PATH / "basic_headings_h1_h6");
 }
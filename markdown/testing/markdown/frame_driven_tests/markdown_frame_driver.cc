@@ -28,7 +28,7 @@ void MarkdownFrameDriver::FlushFrame() {
     main_view_->Draw(canvas_, 0, 0);
     canvas_->EndPaint();
     auto& canvas_result = canvas_->GetJson();
-    if (!canvas_result.Empty()) {
+    if (record_renders_ && !canvas_result.Empty()) {
       rapidjson::Value frame_result;
       frame_result.SetObject();
       frame_result.AddMember("type", "render", result_.GetAllocator());
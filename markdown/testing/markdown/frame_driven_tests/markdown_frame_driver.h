@@ -16,9 +16,9 @@
 namespace serval::markdown::testing {
 
 class MarkdownFrameDriver {
+ public:
   static constexpr int64_t FRAME_INTERVAL = 100;
 
- public:
   MarkdownFrameDriver(MockMarkdownMainView* main_view,
                       MockMarkdownCanvas* canvas)
       : main_view_(main_view), canvas_(canvas) {}
@@ -28,6 +28,9 @@ class MarkdownFrameDriver {
 
   void FlushFrame();
   int64_t CurrentTimestamp() const;
+  // Benchmarks turn this off so frames do not copy the canvas ops into the
+  // result document.
+  void SetRecordRenders(bool record) { record_renders_ = record; }
 
   const rapidjson::Document& RunSteps(
       const std::vector<MarkdownFrameStep>& steps);
@@ -39,6 +42,7 @@ class MarkdownFrameDriver {
 
   MeasureSpec spec_;
   bool spec_changed_{};
+  bool record_renders_{true};
   int64_t current_timestamp_ms_{0};
 
   rapidjson::Document result_;
@@ -0,0 +1,149 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+#include <memory>
+#include <string>
+#include <variant>
+
+#include "gtest/gtest.h"
+#include "markdown/draw/markdown_typewriter_drawer.h"
+#include "markdown/layout/markdown_page_line_index.h"
+#include "markdown/layout/markdown_selection.h"
+#include "markdown/view/markdown_view_measurer.h"
+#include "testing/markdown/frame_driven_tests/markdown_case_builder.h"
+#include "testing/markdown/frame_driven_tests/markdown_frame_driver.h"
+#include "testing/markdown/mock_platform/markdown_tests_platform.h"
+#include "testing/markdown/mock_platform/mock_markdown_canvas.h"
+#include "testing/markdown/mock_platform/mock_markdown_platform_view.h"
+#include "testing/markdown/mock_platform/mock_markdown_resource_loader.h"
+
+// These cases have no recorded ground truth. Every frame is checked against
+// a fresh layout of the source the view holds at that frame instead: the
+// step found through the page's step table must be the one the selection
+// scan finds, and the typewriter height of the view must be the height of
+// the fresh layout, which catches a table left over from an earlier layout.
+namespace serval::markdown::testing {
+namespace fs = std::filesystem;
+namespace {
+const fs::path CASES_PATH = "markdown/testing/markdown/cases";
+constexpr int64_t MAX_TIMESTAMP = 60000;
+
+void ExpectStepMatchesScan(MarkdownPage* page, int32_t char_index) {
+  auto expected = MarkdownSelection::GetSelectionRegionsByCharRange(
+      page, char_index, char_index + 1);
+  MarkdownTypewriterStep step;
+  const bool found =
+      page->GetLineIndex().FindStep(*page, char_index, &step);
+  ASSERT_EQ(found, !expected.empty());
+  if (!found) {
+    return;
+  }
+  const auto& region = expected.back();
+  EXPECT_EQ(step.region_, region.region_);
+  EXPECT_EQ(step.char_pos_offset_, region.char_pos_offset_);
+  EXPECT_EQ(step.offset_.y_, region.offset_.y_);
+  EXPECT_EQ(step.row_bottom_, region.row_bottom_);
+  tttext::TextLine* line = nullptr;
+  for (uint32_t i = 0; i < region.region_->GetLineCount(); i++) {
+    line = region.region_->GetLine(i);
+    if (static_cast<int32_t>(line->GetEndCharPos()) >
+        char_index - region.char_pos_offset_) {
+      break;
+    }
+  }
+  EXPECT_EQ(step.line_, line);
+}
+
+void RunTypewriterCase(const fs::path& directory) {
+  auto single_case = MarkdownCaseBuilder::LoadSingleCase(directory);
+  SCOPED_TRACE(single_case.name);
+  ASSERT_NE(single_case.attributes.markdown.length(), 0);
+  ASSERT_EQ(single_case.attributes.animation_type,
+            MarkdownAnimationType::kTypewriter);
+  auto context = CreateTestMarkdownSharedContext();
+  MockMarkdownResourceLoader resource_loader;
+  MockMarkdownCanvas canvas(&resource_loader);
+  MockMarkdownMainView main_view(context);
+  auto* view = main_view.GetMarkdownView();
+  std::string content = single_case.attributes.markdown;
+  const bool content_complete = single_case.attributes.content_complete;
+  MarkdownCaseBuilder::ApplyAttributes(single_case.attributes, view);
+  // the measured height then follows the animation step
+  view->SetTypewriterDynamicHeight(true);
+  view->SetResourceLoader(&resource_loader);
+  resource_loader.SetMainView(&main_view);
+  MarkdownFrameDriver driver(&main_view, &canvas);
+  driver.SetRecordRenders(false);
+
+  int32_t checked_frames = 0;
+  auto check_frame = [&]() {
+    const int32_t animation_step = view->GetAnimationStep();
+    if (animation_step <= 0) {
+      return;
+    }
+    SCOPED_TRACE(animation_step);
+    MarkdownViewMeasurer reference(context, &resource_loader);
+    reference.SetContent(content);
+    reference.Measure(driver.GetMeasureSpec());
+    auto document = reference.GetDocument();
+    ASSERT_NE(document, nullptr);
+    auto page = document->GetPage();
+    ASSERT_NE(page, nullptr);
+    const auto& steps = page->GetLineIndex();
+    ASSERT_TRUE(steps.IsBuilt());
+    float expected_height = reference.GetMeasuredSize().height_;
+    if (animation_step < steps.GetPageCharCount()) {
+      ExpectStepMatchesScan(page.get(), animation_step - 1);
+      MarkdownCharTypewriterDrawer drawer(
+          context.get(), nullptr, animation_step, &resource_loader,
+          document->GetStyle().typewriter_cursor_, !content_complete,
+          nullptr);
+      drawer.CalculateCursorPosition(page.get());
+      expected_height = drawer.GetMaxDrawHeight();
+    }
+    EXPECT_FLOAT_EQ(view->Measure(driver.GetMeasureSpec()).height_,
+                    expected_height);
+    checked_frames++;
+  };
+  auto flush_frame = [&]() {
+    driver.FlushFrame();
+    check_frame();
+  };
+
+  for (auto& step : single_case.steps) {
+    while (step.timestamp > driver.CurrentTimestamp()) {
+      flush_frame();
+    }
+    for (auto& action : step.actions) {
+      if (action.type == MarkdownActionType::kModifyContent) {
+        content = std::get<std::string>(action.value);
+      }
+      driver.Act(action);
+    }
+  }
+  while (view->GetAnimationStep() <
+             static_cast<int32_t>(content.length()) &&
+         driver.CurrentTimestamp() < MAX_TIMESTAMP) {
+    const int32_t animation_step = view->GetAnimationStep();
+    flush_frame();
+    if (view->GetAnimationStep() == animation_step &&
+        driver.CurrentTimestamp() > single_case.steps.back().timestamp +
+                                        MarkdownFrameDriver::FRAME_INTERVAL) {
+      // the animation reached the last char of the layout
+      break;
+    }
+  }
+  EXPECT_GT(checked_frames, 1);
+}
+
+}  // namespace
+
+TEST(MarkdownTypewriterCaseUnittest, MultiRegionFrames) {
+  RunTypewriterCase(CASES_PATH / "typewriter_multi_region_frames");
+}
+
+TEST(MarkdownTypewriterCaseUnittest, StreamingFrames) {
+  RunTypewriterCase(CASES_PATH / "typewriter_streaming_frames");
+}
+
+}  // namespace serval::markdown::testing
@@ -4,6 +4,7 @@
 
 #include "testing/markdown/mock_platform/markdown_tests_platform.h"
 
+#include "markdown/view/markdown_view_measurer.h"
 #include "testing/markdown/mock_platform/mock_markdown_canvas.h"
 #include "testing/markdown/mock_platform/mock_markdown_shaper.h"
 
@@ -36,5 +37,16 @@ std::shared_ptr<MarkdownContext> CreateTestMarkdownSharedContext() {
   return std::make_shared<MarkdownContext>(CreateTestMarkdownPlatform());
 }
 
+std::shared_ptr<MarkdownDocument> LayoutTestMarkdownDocument(
+    const std::shared_ptr<MarkdownContext>& context, std::string_view content) {
+  MarkdownViewMeasurer measurer(context);
+  measurer.SetContent(content);
+  measurer.Measure({.width_ = 160,
+                    .width_mode_ = tttext::LayoutMode::kDefinite,
+                    .height_ = MeasureSpec::LAYOUT_MAX_SIZE,
+                    .height_mode_ = tttext::LayoutMode::kIndefinite});
+  return measurer.GetDocument();
+}
+
 }  // namespace testing
 }  // namespace serval::markdown
@@ -6,13 +6,28 @@
 #define MARKDOWN_TESTING_MARKDOWN_MOCK_PLATFORM_MARKDOWN_TESTS_PLATFORM_H_
 
 #include <memory>
+#include <string_view>
 
 #include "markdown/element/markdown_context.h"
+#include "markdown/element/markdown_document.h"
 
 namespace serval::markdown::testing {
 
+// A heading, a paragraph wrapping over several lines, a table with an empty
+// cell, a list and a trailing paragraph, for tests that compare a page index
+// against walking the page.
+inline constexpr std::string_view kTestMixedMarkdown =
+    "# heading\n\n"
+    "a paragraph long enough to wrap over several lines of the page\n\n"
+    "| a | b |\n|---|---|\n| cell one | cell two |\n| x | |\n\n"
+    "- item one\n- item two\n\n"
+    "trailing paragraph";
+
 std::unique_ptr<MarkdownPlatform> CreateTestMarkdownPlatform();
 std::shared_ptr<MarkdownContext> CreateTestMarkdownSharedContext();
+// Lays out |content| 160 wide with an unbounded height.
+std::shared_ptr<MarkdownDocument> LayoutTestMarkdownDocument(
+    const std::shared_ptr<MarkdownContext>& context, std::string_view content);
 
 }  // namespace serval::markdown::testing
 
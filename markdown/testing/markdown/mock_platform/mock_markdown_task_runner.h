@@ -0,0 +1,41 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef MARKDOWN_TESTING_MARKDOWN_MOCK_PLATFORM_MOCK_MARKDOWN_TASK_RUNNER_H_
+#define MARKDOWN_TESTING_MARKDOWN_MOCK_PLATFORM_MOCK_MARKDOWN_TASK_RUNNER_H_
+#include <utility>
+#include <vector>
+
+#include "base/include/fml/task_runner.h"
+namespace serval::markdown {
+namespace testing {
+
+// Runs every task inside PostTask(), so off-thread layout stays deterministic.
+class MockSyncTaskRunner : public lynx::fml::BasicTaskRunner {
+ public:
+  void PostTask(lynx::base::closure task) override { task(); }
+};
+
+// Holds the tasks until RunPendingTasks(), to observe a layout in flight.
+class MockDeferredTaskRunner : public lynx::fml::BasicTaskRunner {
+ public:
+  void PostTask(lynx::base::closure task) override {
+    tasks_.emplace_back(std::move(task));
+  }
+  size_t GetPendingTaskCount() const { return tasks_.size(); }
+  void RunPendingTasks() {
+    auto tasks = std::move(tasks_);
+    tasks_.clear();
+    for (auto& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::vector<lynx::base::closure> tasks_;
+};
+
+}  // namespace testing
+}  // namespace serval::markdown
+#endif  // MARKDOWN_TESTING_MARKDOWN_MOCK_PLATFORM_MOCK_MARKDOWN_TASK_RUNNER_H_
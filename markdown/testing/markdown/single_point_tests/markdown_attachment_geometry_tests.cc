@@ -0,0 +1,96 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "markdown/element/markdown_attachments.h"
+#include "markdown/layout/markdown_attachment_geometry.h"
+#include "markdown/layout/markdown_selection.h"
+#include "testing/markdown/mock_platform/markdown_tests_platform.h"
+
+namespace serval::markdown::testing {
+namespace {
+
+std::unique_ptr<MarkdownTextAttachment> MakeAttachment(int32_t start,
+                                                       int32_t end) {
+  auto attachment = std::make_unique<MarkdownTextAttachment>();
+  attachment->start_index_ = start;
+  attachment->end_index_ = end;
+  return attachment;
+}
+
+}  // namespace
+
+TEST(MarkdownAttachmentGeometryTest, MatchesSelectionRectsAndRegions) {
+  auto context = CreateTestMarkdownSharedContext();
+  auto document = LayoutTestMarkdownDocument(context, kTestMixedMarkdown);
+  ASSERT_NE(document, nullptr);
+  auto page = document->GetPage();
+  ASSERT_NE(page, nullptr);
+  const auto char_count = MarkdownSelection::GetPageCharCount(page.get());
+
+  std::vector<std::unique_ptr<MarkdownTextAttachment>> attachments;
+  for (int32_t start = 0; start < char_count; start += 7) {
+    attachments.emplace_back(MakeAttachment(start, start + 23));
+  }
+  attachments.emplace_back(MakeAttachment(-5, -1));
+  std::vector<const MarkdownTextAttachment*> added;
+  for (const auto& attachment : attachments) {
+    added.emplace_back(attachment.get());
+  }
+  page->AddTextAttachments(std::move(attachments));
+  EXPECT_FALSE(page->GetAttachmentGeometry().IsBuilt());
+  page->UpdateAttachmentGeometry();
+  const auto& geometry = page->GetAttachmentGeometry();
+  ASSERT_TRUE(geometry.IsBuilt());
+
+  for (const auto* attachment : added) {
+    std::vector<RectF> rects;
+    if (attachment->start_index_ < 0) {
+      EXPECT_FALSE(geometry.GetRects(*page, attachment, &rects));
+      continue;
+    }
+    ASSERT_TRUE(geometry.GetRects(*page, attachment, &rects));
+    const auto expected = MarkdownSelection::GetSelectionRectByCharPos(
+        page.get(), attachment->start_index_, attachment->end_index_,
+        MarkdownSelection::RectType::kLineBounding);
+    ASSERT_EQ(rects.size(), expected.size());
+    for (size_t i = 0; i < rects.size(); i++) {
+      EXPECT_EQ(rects[i].GetLeft(), expected[i].GetLeft());
+      EXPECT_EQ(rects[i].GetTop(), expected[i].GetTop());
+      EXPECT_EQ(rects[i].GetRight(), expected[i].GetRight());
+      EXPECT_EQ(rects[i].GetBottom(), expected[i].GetBottom());
+    }
+  }
+
+  std::vector<MarkdownTextAttachment*> text;
+  std::vector<MarkdownTextAttachment*> border;
+  for (uint32_t index = 0; index < page->GetRegionCount(); index++) {
+    auto* element = page->GetRegion(index)->element_.get();
+    const auto region_start = static_cast<int32_t>(element->GetCharStart());
+    const auto region_end =
+        region_start + static_cast<int32_t>(element->GetCharCount());
+    std::vector<const MarkdownTextAttachment*> expected;
+    for (const auto* attachment : added) {
+      if (attachment->start_index_ < 0 ||
+          (region_start <= attachment->end_index_ &&
+           region_end > attachment->start_index_)) {
+        expected.emplace_back(attachment);
+      }
+    }
+    geometry.GetRegionAttachments(index, &text, &border);
+    ASSERT_EQ(text.size(), expected.size()) << index;
+    for (size_t i = 0; i < text.size(); i++) {
+      EXPECT_EQ(text[i], expected[i]) << index;
+    }
+  }
+
+  page->ClearAttachments();
+  EXPECT_FALSE(page->GetAttachmentGeometry().IsBuilt());
+}
+
+}  // namespace serval::markdown::testing
@@ -0,0 +1,141 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "markdown/layout/markdown_page_line_index.h"
+#include "markdown/layout/markdown_selection.h"
+#include "testing/markdown/mock_platform/markdown_tests_platform.h"
+
+namespace serval::markdown::testing {
+namespace {
+
+// line lookup by walking every line, as selection did before the index
+int LineIndexByScan(const std::vector<int32_t>& line_ends, int char_index) {
+  for (size_t i = 0; i < line_ends.size(); i++) {
+    if (line_ends[i] >= char_index) {
+      return static_cast<int>(i);
+    }
+  }
+  return static_cast<int>(line_ends.size());
+}
+
+tttext::TextLine* FindLineByScan(tttext::LayoutRegion* region,
+                                 int32_t char_index_in_region) {
+  tttext::TextLine* line = nullptr;
+  for (uint32_t i = 0; i < region->GetLineCount(); i++) {
+    line = region->GetLine(i);
+    if (static_cast<int32_t>(line->GetEndCharPos()) > char_index_in_region) {
+      break;
+    }
+  }
+  return line;
+}
+
+}  // namespace
+
+TEST(MarkdownPageLineIndexTest, MatchesLineScan) {
+  auto context = CreateTestMarkdownSharedContext();
+  auto document = LayoutTestMarkdownDocument(context, kTestMixedMarkdown);
+  ASSERT_NE(document, nullptr);
+  auto page = document->GetPage();
+  ASSERT_NE(page, nullptr);
+  ASSERT_TRUE(page->GetLineIndex().IsBuilt());
+
+  const auto line_ends = MarkdownSelection::GetLineEndCharIndices(page.get());
+  ASSERT_FALSE(line_ends.empty());
+  for (size_t line = 0; line < line_ends.size(); line++) {
+    EXPECT_EQ(MarkdownSelection::GetCharIndexByLineIndex(
+                  page.get(), static_cast<int32_t>(line)),
+              line_ends[line]);
+  }
+  const auto char_count = MarkdownSelection::GetPageCharCount(page.get());
+  for (int char_index = 0; char_index < char_count; char_index++) {
+    EXPECT_EQ(MarkdownSelection::GetLineIndexByCharIndex(page.get(),
+                                                         char_index),
+              LineIndexByScan(line_ends, char_index))
+        << char_index;
+  }
+  EXPECT_EQ(MarkdownSelection::GetLineIndexByCharIndex(page.get(), char_count),
+            MarkdownSelection::GetLineCount(page.get()));
+}
+
+TEST(MarkdownPageLineIndexTest, PagesWithoutIndexGetATemporaryOne) {
+  MarkdownPage page;
+  EXPECT_FALSE(page.GetLineIndex().IsBuilt());
+  EXPECT_TRUE(MarkdownSelection::GetLineEndCharIndices(&page).empty());
+  MarkdownPageLineIndex index;
+  index.Build(page);
+  EXPECT_TRUE(index.IsBuilt());
+  EXPECT_EQ(index.FindFirstRegionEndingAtOrAfter(0), 0u);
+  EXPECT_EQ(index.FindFirstLineEndingAtOrAfter(0), -1);
+  EXPECT_EQ(index.GetPageCharCount(), 0);
+  MarkdownTypewriterStep step;
+  EXPECT_FALSE(index.FindStep(page, 0, &step));
+  EXPECT_FALSE(page.GetLineIndex().IsBuilt());
+}
+
+TEST(MarkdownPageLineIndexTest, FindStepMatchesSelectionScanForEveryChar) {
+  auto context = CreateTestMarkdownSharedContext();
+  auto document = LayoutTestMarkdownDocument(context, kTestMixedMarkdown);
+  ASSERT_NE(document, nullptr);
+  auto page = document->GetPage();
+  ASSERT_NE(page, nullptr);
+  const auto& index = page->GetLineIndex();
+  ASSERT_TRUE(index.IsBuilt());
+  ASSERT_EQ(index.GetPageCharCount(),
+            MarkdownSelection::GetPageCharCount(page.get()));
+
+  for (int32_t char_index = 0; char_index <= index.GetPageCharCount();
+       char_index++) {
+    auto expected = MarkdownSelection::GetSelectionRegionsByCharRange(
+        page.get(), char_index, char_index + 1);
+    MarkdownTypewriterStep step;
+    const bool found = index.FindStep(*page, char_index, &step);
+    ASSERT_EQ(found, !expected.empty()) << char_index;
+    if (!found) {
+      continue;
+    }
+    const auto& region = expected.back();
+    EXPECT_EQ(step.region_, region.region_) << char_index;
+    EXPECT_EQ(step.char_pos_offset_, region.char_pos_offset_) << char_index;
+    EXPECT_EQ(step.offset_.x_, region.offset_.x_) << char_index;
+    EXPECT_EQ(step.offset_.y_, region.offset_.y_) << char_index;
+    EXPECT_EQ(step.row_bottom_, region.row_bottom_) << char_index;
+    EXPECT_EQ(step.line_,
+              FindLineByScan(region.region_,
+                             char_index - region.char_pos_offset_))
+        << char_index;
+  }
+}
+
+TEST(MarkdownPageLineIndexTest, MatchesLineScanOn5000RegionPage) {
+  constexpr int kRegionCount = 5000;
+  auto context = CreateTestMarkdownSharedContext();
+  std::string content;
+  for (int i = 0; i < kRegionCount; i++) {
+    content += "paragraph " + std::to_string(i) + " of a long transcript\n\n";
+  }
+  auto document = LayoutTestMarkdownDocument(context, content);
+  ASSERT_NE(document, nullptr);
+  auto page = document->GetPage();
+  ASSERT_NE(page, nullptr);
+  ASSERT_EQ(page->GetRegionCount(), static_cast<uint32_t>(kRegionCount));
+  const auto char_count = MarkdownSelection::GetPageCharCount(page.get());
+  const auto line_ends = MarkdownSelection::GetLineEndCharIndices(page.get());
+  for (const int char_begin : {0, char_count / 2, char_count - 64}) {
+    for (int char_index = char_begin; char_index < char_begin + 64;
+         char_index++) {
+      EXPECT_EQ(
+          MarkdownSelection::GetLineIndexByCharIndex(page.get(), char_index),
+          LineIndexByScan(line_ends, char_index))
+          << char_index;
+    }
+  }
+}
+
+}  // namespace serval::markdown::testing
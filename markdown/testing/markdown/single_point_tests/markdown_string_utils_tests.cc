@@ -2,10 +2,38 @@
 // Licensed under the Apache License Version 2.0 that can be found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <random>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "markdown/utils/markdown_string_utils.h"
 
 namespace serval::markdown {
+namespace {
+
+std::vector<int32_t> ScanByteIndexToCharIndexMap(std::string_view utf8) {
+  std::vector<int32_t> result;
+  int32_t char_index = 0;
+  for (const auto c : utf8) {
+    result.emplace_back(char_index);
+    if ((c & 0xC0) != 0x80) {
+      char_index++;
+    }
+  }
+  result.emplace_back(char_index);
+  return result;
+}
+
+std::string RepeatToSize(std::string_view unit, size_t size) {
+  std::string result;
+  while (result.size() < size) {
+    result.append(unit);
+  }
+  return result;
+}
+
+}  // namespace
 
 TEST(MarkdownStringUtilsTest, TrimAndToLower) {
   EXPECT_EQ(Trim(" \tHello World\n"), "Hello World");
@@ -39,4 +67,46 @@ TEST(MarkdownStringUtilsTest, SplitTopLevelSkipsNestedDelimiters) {
   EXPECT_TRUE(SplitTopLevel("blue,,red", ',').empty());
 }
 
+TEST(MarkdownStringUtilsTest, ByteIndexToCharIndexMapMatchesScan) {
+  const std::vector<std::string> samples = {
+      "",
+      "plain ascii text that spans more than one block of bytes",
+      "中文段落，包含标点符号。还有更多的中文字符用于测试",
+      "emoji 😀👍🏽 and flags 🇨🇳 mixed with ascii",
+      "\xC3\xA9t\xC3\xA9 caf\xC3\xA9",
+      // truncated and stray continuation bytes, bytes never valid in UTF-8
+      "\x80\x80" "abc\xE4\xB8\xFF\xFE\xC0\xC1\xF8\x88\x80\x80\x80\x80",
+  };
+  for (const auto& sample : samples) {
+    // every length exercises the scalar tail after the 16 byte blocks
+    for (size_t length = 0; length <= sample.size(); length++) {
+      const std::string_view view(sample.data(), length);
+      EXPECT_EQ(UTF8ByteIndexToCharIndexMap(view),
+                ScanByteIndexToCharIndexMap(view))
+          << sample << " " << length;
+    }
+  }
+  std::mt19937 random(7);
+  for (int i = 0; i < 500; i++) {
+    std::string bytes(random() % 100, '\0');
+    for (auto& c : bytes) {
+      c = static_cast<char>(random());
+    }
+    EXPECT_EQ(UTF8ByteIndexToCharIndexMap(bytes),
+              ScanByteIndexToCharIndexMap(bytes));
+  }
+}
+
+TEST(MarkdownStringUtilsTest, ByteIndexToCharIndexMapMatchesScanOnCorpora) {
+  constexpr size_t kCorpusSize = 64 * 1024;
+  for (const char* unit : {"# Title\n\nSome *markdown* text. ",
+                           "中文的段落，混合一些 ascii 文本。\n",
+                           "😀 emoji 👍🏽 text 🇨🇳\n"}) {
+    const auto corpus = RepeatToSize(unit, kCorpusSize);
+    EXPECT_EQ(UTF8ByteIndexToCharIndexMap(corpus),
+              ScanByteIndexToCharIndexMap(corpus))
+        << unit;
+  }
+}
+
 }  // namespace serval::markdown
@@ -0,0 +1,160 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+// Only built into the tests when MARKDOWN_ENABLE_TRACE is on.
+#if ENABLE_TRACE_PERFETTO
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/trace/native/trace_event_utils_perfetto.h"
+#include "gtest/gtest.h"
+#include "markdown/utils/markdown_trace.h"
+#include "markdown/view/markdown_view_measurer.h"
+#include "testing/markdown/mock_platform/markdown_tests_platform.h"
+
+namespace serval::markdown::testing {
+namespace {
+
+struct TraceRecord {
+  lynx::trace::TraceEventType phase;
+  std::string category;
+  std::string name;
+  uint64_t counter;
+};
+
+std::vector<TraceRecord>& Records() {
+  static std::vector<TraceRecord> records;
+  return records;
+}
+
+void Record(const char* category, const char* name,
+            lynx::trace::TraceEventType phase, uint64_t counter = 0) {
+  Records().push_back({phase, category == nullptr ? "" : category,
+                       name == nullptr ? "" : name, counter});
+}
+
+// Slices in the order they began, indented by their depth. Fails if the
+// begin and end events do not pair up.
+std::vector<std::string> RecordedSlices() {
+  std::vector<std::string> slices;
+  int depth = 0;
+  for (const auto& record : Records()) {
+    if (record.phase == lynx::trace::TraceEventType::TYPE_SLICE_BEGIN) {
+      slices.push_back(std::string(2 * depth, ' ') + record.name);
+      depth++;
+    } else if (record.phase == lynx::trace::TraceEventType::TYPE_SLICE_END) {
+      depth--;
+      EXPECT_GE(depth, 0);
+    }
+  }
+  EXPECT_EQ(depth, 0);
+  return slices;
+}
+
+// Whether |expected| appears in |slices| in order, other slices aside.
+bool ContainsInOrder(const std::vector<std::string>& slices,
+                     const std::vector<std::string>& expected) {
+  size_t next = 0;
+  for (const auto& slice : slices) {
+    if (next < expected.size() && slice == expected[next]) {
+      next++;
+    }
+  }
+  return next == expected.size();
+}
+
+size_t CountCounters() {
+  size_t count = 0;
+  for (const auto& record : Records()) {
+    count += record.phase == lynx::trace::TraceEventType::TYPE_COUNTER;
+  }
+  return count;
+}
+
+}  // namespace
+}  // namespace serval::markdown::testing
+
+// Replaces the mock backend of lynx_trace, so the linker leaves its object
+// out, to record what the pipeline emits.
+namespace lynx::trace {
+uint64_t GetFlowId() {
+  return 0;
+}
+uint64_t GetTraceTimeNs() {
+  return 0;
+}
+void TraceEventImplementation(const char* category_name, const char* name,
+                              TraceEventType phase,
+                              const lynx::perfetto::Track* track_id,
+                              const uint64_t& timestamp,
+                              const FuncType& callback) {
+  serval::markdown::testing::Record(category_name, name, phase);
+}
+void TraceEventImplementation(const char* category_name,
+                              const std::string& name, TraceEventType phase,
+                              const lynx::perfetto::Track* track_id,
+                              const uint64_t& timestamp,
+                              const FuncType& callback) {
+  serval::markdown::testing::Record(category_name, name.c_str(), phase);
+}
+void TraceEventImplementation(const char* category_name,
+                              const lynx::perfetto::CounterTrack& counter_track,
+                              TraceEventType phase, const uint64_t& timestamp,
+                              const uint64_t& counter,
+                              const FuncType& callback) {
+  serval::markdown::testing::Record(category_name, nullptr, phase, counter);
+}
+bool TraceEventCategoryEnabled(const char* category) {
+  return true;
+}
+void TraceRuntimeProfile(const std::string& runtime_profile,
+                         const uint64_t track_id, const int32_t profile_id) {}
+}  // namespace lynx::trace
+
+namespace serval::markdown::testing {
+
+TEST(MarkdownTraceTest, MeasureEmitsNestedPhases) {
+  auto context = CreateTestMarkdownSharedContext();
+  MarkdownViewMeasurer measurer(context);
+  measurer.SetContent("# heading\n\nparagraph\n\n- item");
+  const MeasureSpec spec{.width_ = 200,
+                         .width_mode_ = tttext::LayoutMode::kDefinite,
+                         .height_ = MeasureSpec::LAYOUT_MAX_SIZE,
+                         .height_mode_ = tttext::LayoutMode::kIndefinite};
+  Records().clear();
+  measurer.Measure(spec);
+  auto slices = RecordedSlices();
+  EXPECT_TRUE(ContainsInOrder(slices, {"MarkdownViewMeasurer::Measure",
+                                       "  MarkdownParser::ParseMarkdown",
+                                       "  MarkdownLayout::Layout"}));
+  EXPECT_FALSE(ContainsInOrder(slices, {"  MarkdownParser::ReplayMarkdown"}));
+  // element and region counts
+  EXPECT_EQ(CountCounters(), 2u);
+  for (const auto& record : Records()) {
+    EXPECT_EQ(record.category, kMarkdownTraceCategory);
+  }
+
+  // a style change replays the block events instead of parsing
+  auto style = *measurer.GetStyle();
+  style.normal_text_.base_.font_size_ *= 2;
+  measurer.SetStyle(style);
+  Records().clear();
+  measurer.Measure(spec);
+  slices = RecordedSlices();
+  EXPECT_TRUE(ContainsInOrder(slices, {"MarkdownViewMeasurer::Measure",
+                                       "  MarkdownParser::ReplayMarkdown",
+                                       "  MarkdownLayout::Layout"}));
+  EXPECT_FALSE(ContainsInOrder(slices, {"  MarkdownParser::ParseMarkdown"}));
+
+  // nothing is traced when no layout is needed
+  Records().clear();
+  measurer.Measure(spec);
+  EXPECT_TRUE(Records().empty());
+}
+
+}  // namespace serval::markdown::testing
+
+#endif  // ENABLE_TRACE_PERFETTO
@@ -15,4 +15,34 @@ TEST(MarkdownValueTest, HasVirtualDestructor) {
   EXPECT_TRUE(std::has_virtual_destructor<Value>::value);
 }
 
+TEST(MarkdownValueTest, CloneAndEquals) {
+  ValueArray array;
+  array.emplace_back(Value::MakeInt(1));
+  array.emplace_back(Value::MakeDouble(0.5));
+  array.emplace_back(Value::MakeNull());
+  ValueMap nested;
+  nested.emplace("flag", Value::MakeBool(true));
+  nested.emplace("size", Value::MakeLong(1LL << 40));
+  ValueMap map;
+  map.emplace("name", Value::MakeString("theme"));
+  map.emplace("items", Value::MakeArray(std::move(array)));
+  map.emplace("nested", Value::MakeMap(std::move(nested)));
+
+  ValueMap copy = Value::CloneMap(map);
+  EXPECT_TRUE(Value::MapEquals(map, copy));
+  EXPECT_NE(copy["name"].get(), map["name"].get());
+
+  copy["nested"]->AsMap()["flag"]->AsBool() = false;
+  EXPECT_FALSE(Value::MapEquals(map, copy));
+  copy["nested"]->AsMap()["flag"]->AsBool() = true;
+  EXPECT_TRUE(Value::MapEquals(map, copy));
+
+  copy["items"]->AsArray().pop_back();
+  EXPECT_FALSE(Value::MapEquals(map, copy));
+
+  EXPECT_FALSE(Value::MakeInt(1)->Equals(*Value::MakeLong(1)));
+  EXPECT_TRUE(Value::MakeNull()->Equals(*Value::MakeNull()->Clone()));
+  EXPECT_FALSE(Value::MapEquals(map, ValueMap{}));
+}
+
 }  // namespace serval::markdown::testing
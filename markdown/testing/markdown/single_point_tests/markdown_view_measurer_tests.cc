@@ -6,6 +6,7 @@
 
 #include "../mock_platform/markdown_tests_platform.h"
 #include "markdown/layout/markdown_selection.h"
+#include "markdown/style/markdown_style_reader.h"
 #include "markdown/view/markdown_view_measurer.h"
 
 namespace serval::markdown {
@@ -127,4 +128,140 @@ TEST(MarkdownViewMeasurerTest, CharHitPastWrappedLineEndStaysOnCurrentLine) {
   EXPECT_EQ(range.end_, line_end);
 }
 
+TEST(MarkdownViewMeasurerTest, StyleChangeReplaysWithoutParsing) {
+  auto context = testing::CreateTestMarkdownSharedContext();
+  const std::string content =
+      "# heading\n\n"
+      "a paragraph with **bold**, `code` and [a link](url)\n\n"
+      "```\ncode block\n```\n\n"
+      "> quote\n\n"
+      "1. one\n2. two\n\n"
+      "- item\n  - nested\n\n"
+      "| a | b |\n|---|---|\n| cell | cell |\n";
+  MeasureSpec spec;
+  spec.width_ = 200;
+  spec.width_mode_ = tttext::LayoutMode::kDefinite;
+  spec.height_ = MeasureSpec::LAYOUT_MAX_SIZE;
+  spec.height_mode_ = tttext::LayoutMode::kIndefinite;
+
+  MarkdownViewMeasurer measurer(context);
+  measurer.SetContent(content);
+  auto size = measurer.Measure(spec);
+  EXPECT_TRUE(measurer.DidParseInLastMeasure());
+
+  auto style = MarkdownStyleReader::ReadStyle(ValueMap{}, nullptr,
+                                              context.get());
+  style.normal_text_.base_.font_size_ *= 2;
+  measurer.SetStyle(style);
+  auto styled_size = measurer.Measure(spec);
+  EXPECT_FALSE(measurer.DidParseInLastMeasure());
+  EXPECT_TRUE(measurer.DidLayoutInLastMeasure());
+  EXPECT_GT(styled_size.height_, size.height_);
+
+  MarkdownViewMeasurer parsed(context);
+  parsed.SetStyle(style);
+  parsed.SetContent(content);
+  auto parsed_size = parsed.Measure(spec);
+  EXPECT_TRUE(parsed.DidParseInLastMeasure());
+  EXPECT_FLOAT_EQ(styled_size.width_, parsed_size.width_);
+  EXPECT_FLOAT_EQ(styled_size.height_, parsed_size.height_);
+  EXPECT_EQ(measurer.GetDocument()->GetLineTexts(),
+            parsed.GetDocument()->GetLineTexts());
+
+  measurer.SetContent("changed");
+  measurer.Measure(spec);
+  EXPECT_TRUE(measurer.DidParseInLastMeasure());
+}
+
+TEST(MarkdownViewMeasurerTest, SharesOneStyleAcrossMeasurers) {
+  auto context = testing::CreateTestMarkdownSharedContext();
+  auto style = std::make_shared<const MarkdownStyle>(
+      MarkdownStyleReader::ReadStyle(ValueMap{}, nullptr, context.get()));
+  MeasureSpec spec;
+  spec.width_ = 200;
+  spec.width_mode_ = tttext::LayoutMode::kDefinite;
+  spec.height_ = MeasureSpec::LAYOUT_MAX_SIZE;
+  spec.height_mode_ = tttext::LayoutMode::kIndefinite;
+
+  MarkdownViewMeasurer first(context);
+  MarkdownViewMeasurer second(context);
+  EXPECT_TRUE(first.SetStyle(style));
+  EXPECT_TRUE(second.SetStyle(style));
+  first.SetContent("# first");
+  second.SetContent("second");
+  first.Measure(spec);
+  second.Measure(spec);
+  EXPECT_EQ(first.GetDocument()->GetSharedStyle(), style);
+  EXPECT_EQ(second.GetDocument()->GetSharedStyle(), style);
+
+  EXPECT_FALSE(first.SetStyle(style));
+  first.Measure(spec);
+  EXPECT_FALSE(first.DidLayoutInLastMeasure());
+
+  EXPECT_FALSE(first.SetStyle(std::shared_ptr<const MarkdownStyle>()));
+  EXPECT_EQ(first.GetStyle(), style);
+}
+
+TEST(MarkdownViewMeasurerTest, UnchangedStyleMapKeepsStyle) {
+  auto context = testing::CreateTestMarkdownSharedContext();
+  auto make_style_map = [](int32_t font_size) {
+    ValueMap normal_text;
+    normal_text.emplace("fontSize", Value::MakeInt(font_size));
+    ValueMap style_map;
+    style_map.emplace("normalText", Value::MakeMap(std::move(normal_text)));
+    return style_map;
+  };
+  MeasureSpec spec;
+  spec.width_ = 200;
+  spec.width_mode_ = tttext::LayoutMode::kDefinite;
+  spec.height_ = MeasureSpec::LAYOUT_MAX_SIZE;
+  spec.height_mode_ = tttext::LayoutMode::kIndefinite;
+
+  MarkdownViewMeasurer measurer(context);
+  measurer.SetContent("text");
+  EXPECT_TRUE(measurer.SetStyle(make_style_map(20)));
+  const auto style = measurer.GetStyle();
+  measurer.Measure(spec);
+  EXPECT_TRUE(measurer.DidLayoutInLastMeasure());
+
+  EXPECT_FALSE(measurer.SetStyle(make_style_map(20)));
+  EXPECT_EQ(measurer.GetStyle(), style);
+  measurer.Measure(spec);
+  EXPECT_FALSE(measurer.DidLayoutInLastMeasure());
+
+  EXPECT_TRUE(measurer.SetStyle(make_style_map(24)));
+  EXPECT_NE(measurer.GetStyle(), style);
+  EXPECT_FLOAT_EQ(
+      measurer.GetStyle()->normal_text_.base_.font_size_ * 20,
+      style->normal_text_.base_.font_size_ * 24);
+
+  measurer.SetStyle(*style);
+  EXPECT_TRUE(measurer.SetStyle(make_style_map(24)));
+}
+
+TEST(MarkdownViewMeasurerTest, EqualStyleMapsShareOneStyle) {
+  auto context = testing::CreateTestMarkdownSharedContext();
+  auto make_style_map = [](int32_t font_size) {
+    ValueMap normal_text;
+    normal_text.emplace("fontSize", Value::MakeInt(font_size));
+    ValueMap style_map;
+    style_map.emplace("normalText", Value::MakeMap(std::move(normal_text)));
+    return style_map;
+  };
+  MarkdownViewMeasurer first(context);
+  MarkdownViewMeasurer second(context);
+  EXPECT_EQ(first.GetStyle(), second.GetStyle());
+
+  EXPECT_TRUE(first.SetStyle(make_style_map(20)));
+  EXPECT_TRUE(second.SetStyle(make_style_map(20)));
+  EXPECT_EQ(first.GetStyle(), second.GetStyle());
+
+  EXPECT_TRUE(second.SetStyle(make_style_map(24)));
+  EXPECT_NE(first.GetStyle(), second.GetStyle());
+
+  MarkdownViewMeasurer other(testing::CreateTestMarkdownSharedContext());
+  EXPECT_TRUE(other.SetStyle(make_style_map(20)));
+  EXPECT_NE(other.GetStyle(), first.GetStyle());
+}
+
 }  // namespace serval::markdown
@@ -7,10 +7,15 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "markdown/draw/markdown_typewriter_drawer.h"
+#include "markdown/layout/markdown_page_line_index.h"
+#include "markdown/layout/markdown_selection.h"
 #include "markdown/view/markdown_view_measurer.h"
 #include "markdown/view/markdown_view_renderer.h"
 #include "testing/markdown/mock_platform/markdown_tests_platform.h"
+#include "testing/markdown/mock_platform/mock_markdown_canvas.h"
 #include "testing/markdown/mock_platform/mock_markdown_platform_view.h"
+#include "testing/markdown/mock_platform/mock_markdown_resource_loader.h"
 
 namespace serval::markdown::testing {
 namespace {
@@ -47,6 +52,65 @@ MockMarkdownPlatformView* FindSubviewForRect(MockMarkdownMainView* main_view,
   return nullptr;
 }
 
+size_t CountDrawnGlyphs(const rapidjson::Document& json) {
+  size_t count = 0;
+  for (const auto& view : json.GetArray()) {
+    for (const auto& op : view.GetArray()) {
+      if (op.HasMember("op") && op["op"] == "glyphs") {
+        count += op["text"].GetStringLength();
+      }
+    }
+  }
+  return count;
+}
+
+struct TypewriterDrawCount {
+  size_t per_step_{0};
+  size_t final_frame_{0};
+  // glyphs drawn by each step, step 1 first
+  std::vector<size_t> step_glyphs_;
+};
+
+// Draws every typewriter step of |document| through region views and counts
+// the glyphs sent to the canvas.
+TypewriterDrawCount DrawTypewriterSteps(
+    const std::shared_ptr<MarkdownContext>& context,
+    const std::shared_ptr<MarkdownDocument>& document, bool incremental) {
+  MockMarkdownMainView main_view(context);
+  MarkdownViewRenderer renderer;
+  renderer.SetViewContainerHandle(&main_view);
+  renderer.SetIncrementalTypewriter(incremental);
+  renderer.SetMarkdownAnimationType(MarkdownAnimationType::kTypewriter);
+  renderer.SetDocument(document);
+  main_view.SetViewRectInScreen(RectF::MakeLTRB(0, 0, 240, 10000));
+  renderer.OnNextFrame();
+
+  MockMarkdownResourceLoader loader;
+  MockMarkdownCanvas canvas(&loader);
+  const auto draw = [&canvas, &main_view]() {
+    canvas.StartPaint();
+    main_view.Draw(&canvas, 0, 0);
+    canvas.EndPaint();
+    return CountDrawnGlyphs(canvas.GetJson());
+  };
+  draw();
+  TypewriterDrawCount count;
+  const auto char_count =
+      MarkdownSelection::GetPageCharCount(document->GetPage().get());
+  for (int32_t step = 1; step <= char_count; step++) {
+    renderer.SetMarkdownAnimationStep(step);
+    renderer.OnNextFrame();
+    count.step_glyphs_.push_back(draw());
+    count.per_step_ += count.step_glyphs_.back();
+  }
+  main_view.needs_draw_ = true;
+  for (auto* view : main_view.GetSubviews()) {
+    view->needs_draw_ = true;
+  }
+  count.final_frame_ = draw();
+  return count;
+}
+
 }  // namespace
 
 TEST(MarkdownViewRendererTest, ExtraBorderRangeOutsideViewportIsEmpty) {
@@ -174,4 +238,99 @@ TEST(MarkdownViewRendererTest, RebindsRegionViewsWhenDocumentChanges) {
   }
 }
 
+TEST(MarkdownViewRendererTest, IncrementalTypewriterDrawsOnlyTheLastLine) {
+  auto context = CreateTestMarkdownSharedContext();
+  MarkdownViewMeasurer measurer(context);
+  measurer.SetContent(
+      "a first paragraph that is long enough to wrap over quite a few lines "
+      "when it is laid out in a narrow view\n\n"
+      "a second paragraph that also wraps over more than a single line of "
+      "text\n\n"
+      "| a | b |\n|---|---|\n| cell | cell |");
+  measurer.Measure({.width_ = 240,
+                    .width_mode_ = tttext::LayoutMode::kDefinite,
+                    .height_ = MeasureSpec::LAYOUT_MAX_SIZE,
+                    .height_mode_ = tttext::LayoutMode::kIndefinite});
+  auto document = measurer.GetDocument();
+  ASSERT_NE(document, nullptr);
+  ASSERT_NE(document->GetPage(), nullptr);
+
+  const auto full = DrawTypewriterSteps(context, document, false);
+  const auto incremental = DrawTypewriterSteps(context, document, true);
+  EXPECT_GT(full.per_step_, 0u);
+  EXPECT_LT(incremental.per_step_, full.per_step_);
+  EXPECT_EQ(incremental.final_frame_, full.final_frame_);
+
+  // within a paragraph line only the revealed part of that line is drawn;
+  // a step that completes a line or enters a region redraws the region once
+  const auto page = document->GetPage();
+  const auto& steps = page->GetLineIndex();
+  ASSERT_TRUE(steps.IsBuilt());
+  const auto step_count =
+      static_cast<int32_t>(incremental.step_glyphs_.size());
+  int32_t previous_lines_end = -1;
+  for (int32_t step = 1; step <= step_count; step++) {
+    MarkdownTypewriterStep found;
+    ASSERT_TRUE(steps.FindStep(*page, step - 1, &found));
+    const int32_t lines_end = MarkdownCharTypewriterDrawer::GetRevealedLinesEnd(
+        *page, found.page_region_index_, step);
+    if (lines_end >= 0 && lines_end == previous_lines_end) {
+      EXPECT_LE(incremental.step_glyphs_[step - 1],
+                static_cast<size_t>(step - lines_end))
+          << "step " << step;
+    }
+    previous_lines_end = lines_end;
+  }
+}
+
+TEST(MarkdownViewRendererTest, SameDocumentKeepsTypewriterRetention) {
+  auto context = CreateTestMarkdownSharedContext();
+  MarkdownViewMeasurer measurer(context);
+  measurer.SetContent(
+      "a paragraph that is long enough to wrap over quite a few lines when "
+      "it is laid out in a narrow view");
+  measurer.Measure({.width_ = 240,
+                    .width_mode_ = tttext::LayoutMode::kDefinite,
+                    .height_ = MeasureSpec::LAYOUT_MAX_SIZE,
+                    .height_mode_ = tttext::LayoutMode::kIndefinite});
+  auto document = measurer.GetDocument();
+  ASSERT_NE(document, nullptr);
+  const auto char_count =
+      MarkdownSelection::GetPageCharCount(document->GetPage().get());
+  ASSERT_GT(char_count, 2);
+
+  MockMarkdownMainView main_view(context);
+  MarkdownViewRenderer renderer;
+  renderer.SetViewContainerHandle(&main_view);
+  renderer.SetIncrementalTypewriter(true);
+  renderer.SetMarkdownAnimationType(MarkdownAnimationType::kTypewriter);
+  renderer.SetDocument(document);
+  main_view.SetViewRectInScreen(RectF::MakeLTRB(0, 0, 240, 10000));
+  renderer.OnNextFrame();
+  renderer.SetMarkdownAnimationStep(char_count - 1);
+  renderer.OnNextFrame();
+  const auto clear_draws = [&main_view]() {
+    for (auto* view : main_view.GetSubviews()) {
+      view->needs_draw_ = false;
+    }
+  };
+  const auto count_draws = [&main_view]() {
+    size_t count = 0;
+    for (auto* view : main_view.GetSubviews()) {
+      count += view->needs_draw_ ? 1 : 0;
+    }
+    return count;
+  };
+
+  // a bundle carrying the document already shown asks for no redraw until
+  // the next frame
+  clear_draws();
+  renderer.SetDocument(document);
+  EXPECT_EQ(count_draws(), 0u);
+
+  clear_draws();
+  renderer.SetMarkdownAnimationStep(char_count);
+  EXPECT_GT(count_draws(), 0u);
+}
+
 }  // namespace serval::markdown::testing
@@ -5,7 +5,10 @@
 #include "gtest/gtest.h"
 
 #include "../mock_platform/markdown_tests_platform.h"
+#include "../mock_platform/mock_markdown_canvas.h"
 #include "../mock_platform/mock_markdown_platform_view.h"
+#include "../mock_platform/mock_markdown_resource_loader.h"
+#include "../mock_platform/mock_markdown_task_runner.h"
 #include "markdown/markdown_event_listener.h"
 
 namespace serval::markdown {
@@ -302,4 +305,161 @@ TEST(MarkdownViewTest, EmptyGestureListenersUseDefaultDispatch) {
             view->DoPan({}, {}, GestureEventType::kDown));
 }
 
+TEST(MarkdownViewTest, SyncLayoutTaskRunnerMatchesInlineMeasure) {
+  auto context = testing::CreateTestMarkdownSharedContext();
+  CountingMarkdownViewMeasureHost inline_host;
+  CountingMarkdownViewMeasureHost runner_host;
+  CountingMarkdownEventListener event_listener;
+  int32_t created_contexts = 0;
+  auto inline_view =
+      std::make_shared<MarkdownView>(nullptr, &inline_host, context);
+  auto runner_view =
+      std::make_shared<MarkdownView>(nullptr, &runner_host, context);
+  runner_view->SetLayoutTaskRunner(
+      std::make_shared<testing::MockSyncTaskRunner>(),
+      std::make_shared<testing::MockSyncTaskRunner>(), [&created_contexts]() {
+        created_contexts++;
+        return testing::CreateTestMarkdownSharedContext();
+      });
+  runner_view->SetEventListener(&event_listener);
+  inline_view->SetContent("# title\n\nmarkdown content");
+  runner_view->SetContent("# title\n\nmarkdown content");
+  const auto request_count = runner_host.request_count_;
+
+  const auto inline_size = inline_view->Measure(MakeMeasureSpec());
+  const auto runner_size = runner_view->Measure(MakeMeasureSpec());
+
+  EXPECT_FLOAT_EQ(runner_size.width_, inline_size.width_);
+  EXPECT_FLOAT_EQ(runner_size.height_, inline_size.height_);
+  EXPECT_EQ(event_listener.parse_count_, 1);
+  EXPECT_EQ(created_contexts, 1);
+  // adopted within the measure, so no other measure is needed
+  EXPECT_EQ(runner_host.request_count_, request_count);
+  EXPECT_EQ(runner_view->GetContent(), inline_view->GetContent());
+}
+
+TEST(MarkdownViewTest, DeferredLayoutKeepsLastSizeUntilAdopted) {
+  auto context = testing::CreateTestMarkdownSharedContext();
+  CountingMarkdownViewMeasureHost measure_host;
+  CountingMarkdownEventListener event_listener;
+  auto runner = std::make_shared<testing::MockDeferredTaskRunner>();
+  auto owner_runner = std::make_shared<testing::MockDeferredTaskRunner>();
+  auto view = std::make_shared<MarkdownView>(nullptr, &measure_host, context);
+  view->SetLayoutTaskRunner(runner, owner_runner,
+                            testing::CreateTestMarkdownSharedContext);
+  view->SetEventListener(&event_listener);
+  view->SetContent("markdown content");
+  const auto spec = MakeMeasureSpec();
+
+  const auto estimated_size = view->Measure(spec);
+  EXPECT_FLOAT_EQ(estimated_size.width_, spec.width_);
+  EXPECT_GT(estimated_size.height_, 0);
+  EXPECT_EQ(event_listener.parse_count_, 0);
+  ASSERT_EQ(runner->GetPendingTaskCount(), 1u);
+
+  // a second measure does not start another layout while one is in flight
+  view->Measure(spec);
+  EXPECT_EQ(runner->GetPendingTaskCount(), 1u);
+
+  // the owner thread learns of the layout without a layout frame
+  const auto request_count = measure_host.request_count_;
+  runner->RunPendingTasks();
+  EXPECT_EQ(measure_host.request_count_, request_count);
+  ASSERT_EQ(owner_runner->GetPendingTaskCount(), 1u);
+  owner_runner->RunPendingTasks();
+  EXPECT_EQ(measure_host.request_count_, request_count + 1);
+  const auto first_size = view->Measure(spec);
+  EXPECT_EQ(event_listener.parse_count_, 1);
+  EXPECT_GT(first_size.height_, 0);
+  EXPECT_EQ(runner->GetPendingTaskCount(), 0u);
+
+  view->SetContent("markdown content\n\nsecond paragraph\n\nthird one");
+  const auto stale_size = view->Measure(spec);
+  EXPECT_FLOAT_EQ(stale_size.height_, first_size.height_);
+  ASSERT_EQ(runner->GetPendingTaskCount(), 1u);
+
+  runner->RunPendingTasks();
+  owner_runner->RunPendingTasks();
+  const auto second_size = view->Measure(spec);
+  EXPECT_EQ(event_listener.parse_count_, 2);
+  EXPECT_GT(second_size.height_, first_size.height_);
+}
+
+TEST(MarkdownViewTest, ClearingLayoutTaskRunnerDropsLayoutInFlight) {
+  auto context = testing::CreateTestMarkdownSharedContext();
+  CountingMarkdownViewMeasureHost measure_host;
+  auto runner = std::make_shared<testing::MockDeferredTaskRunner>();
+  auto owner_runner = std::make_shared<testing::MockDeferredTaskRunner>();
+  auto view = std::make_shared<MarkdownView>(nullptr, &measure_host, context);
+  view->SetLayoutTaskRunner(runner, owner_runner,
+                            testing::CreateTestMarkdownSharedContext);
+  view->SetContent("markdown content");
+  view->Measure(MakeMeasureSpec());
+  ASSERT_EQ(runner->GetPendingTaskCount(), 1u);
+
+  view->SetLayoutTaskRunner(nullptr, nullptr, nullptr);
+  const auto size = view->Measure(MakeMeasureSpec());
+  runner->RunPendingTasks();
+
+  EXPECT_GT(size.height_, 0);
+  EXPECT_EQ(owner_runner->GetPendingTaskCount(), 0u);
+  EXPECT_FLOAT_EQ(view->Measure(MakeMeasureSpec()).height_, size.height_);
+}
+
+TEST(MarkdownViewTest, DestroyingViewCancelsLayoutInFlight) {
+  CountingMarkdownViewMeasureHost measure_host;
+  auto runner = std::make_shared<testing::MockDeferredTaskRunner>();
+  auto owner_runner = std::make_shared<testing::MockDeferredTaskRunner>();
+  auto view = std::make_shared<MarkdownView>(
+      nullptr, &measure_host, testing::CreateTestMarkdownSharedContext());
+  view->SetLayoutTaskRunner(runner, owner_runner,
+                            testing::CreateTestMarkdownSharedContext);
+  view->SetContent("markdown content");
+  view->Measure(MakeMeasureSpec());
+  ASSERT_EQ(runner->GetPendingTaskCount(), 1u);
+
+  view = nullptr;
+  runner->RunPendingTasks();
+  EXPECT_EQ(owner_runner->GetPendingTaskCount(), 0u);
+}
+
+TEST(MarkdownViewTest, StyleInRangeAppliedInFlightIsKeptOnAdoption) {
+  auto context = testing::CreateTestMarkdownSharedContext();
+  const std::string content = "first paragraph\n\nsecond paragraph";
+  ValueMap style_map;
+  style_map.emplace("color", Value::MakeString("#ff0000"));
+  const auto draw = [](testing::MockMarkdownMainView* main_view) {
+    testing::MockMarkdownResourceLoader loader;
+    testing::MockMarkdownCanvas canvas(&loader);
+    main_view->GetMarkdownView()->Measure(MakeMeasureSpec());
+    main_view->Align(0, 0);
+    canvas.StartPaint();
+    main_view->Draw(&canvas, 0, 0);
+    canvas.EndPaint();
+    return canvas.GetResult();
+  };
+
+  testing::MockMarkdownMainView inline_view(context);
+  inline_view.GetMarkdownView()->SetContent(content);
+  const auto unstyled = draw(&inline_view);
+  inline_view.GetMarkdownView()->ApplyStyleInRange(style_map, 0, 5);
+  const auto styled = draw(&inline_view);
+  ASSERT_NE(styled, unstyled);
+
+  testing::MockMarkdownMainView runner_view(context);
+  auto runner = std::make_shared<testing::MockDeferredTaskRunner>();
+  auto owner_runner = std::make_shared<testing::MockDeferredTaskRunner>();
+  auto* view = runner_view.GetMarkdownView();
+  view->SetLayoutTaskRunner(runner, owner_runner,
+                            testing::CreateTestMarkdownSharedContext);
+  view->SetContent(content);
+  view->Measure(MakeMeasureSpec());
+  ASSERT_EQ(runner->GetPendingTaskCount(), 1u);
+  // applied to no layout, then replayed on the adopted one
+  view->ApplyStyleInRange(style_map, 0, 5);
+  runner->RunPendingTasks();
+  owner_runner->RunPendingTasks();
+  EXPECT_EQ(draw(&runner_view), styled);
+}
+
 }  // namespace serval::markdown
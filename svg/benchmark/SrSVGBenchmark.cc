@@ -0,0 +1,599 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+// Headless benchmark for the parse, DOM build, binary load and render phases.
+//
+//   serval_svg_benchmark [--iterations N] [--frames N] [--duration S]
+//                        [--size W H] [--chain N] [--images N]
+//                        [--animated N] [--cropped N] [--shapes N]
+//                        [--budgets] [--streaming] [--batch N] [--raster]
+//                        [--csv] [path ...]
+//
+// Every path may be an .svg file or a directory, which is scanned (not
+// recursively) for .svg files. Without paths, svg/test_cases and svg/examples
+// are used. Animated documents are rendered at --frames evenly spaced times
+// across their timeline; indefinite timelines are sampled over --duration
+// seconds. Documents are rendered into a --size viewport (512x512 by
+// default). Rendering goes to SrRecordingCanvas, so reported op counts are the
+// calls the renderer issued, independent of any raster backend.
+//
+// The load phase is SrSVGDOM::makeFromBinary on a blob written once by
+// SrSVGDOM::Serialize. The loaded document is rendered once more and its
+// recorded ops are compared with the text document's ("binary" column).
+// The acquire phase is SrSVGDOMCache::Acquire; after the first iteration it
+// is a cache hit. Cache statistics are printed to stderr at the end.
+//
+// --chain N adds a generated document of N rects whose animations begin at
+// the end of the previous one (begin="aI.end"), which stresses timeline
+// resolution. --images N adds a generated document of N <image> elements
+// with inline data: URIs. --animated N adds a generated document of N rects
+// whose position, size, fill and opacity are animated; every allocation of
+// its render phase is made on the first frame, so the count does not grow
+// with --frames. --cropped N adds a generated document of N by N static
+// tiles of which the 512x512 view box shows only 8 by 8, and one animated
+// rect so that it is rendered at --frames times. Tiles outside the view box
+// are skipped by their cached bounds, so after the first frame its render
+// time follows the visible tiles rather than N * N. --shapes N adds a
+// generated document of N small rects, circles, ellipses, lines, polygons,
+// polylines and paths with animated fills, in translucent clipped groups of
+// seven, so every frame bounds each shape for its group layer and builds the
+// group clip. Without paths, only the generated documents are measured.
+//
+// The "frame_allocs" column is the allocations of one frame after the first,
+// when caches are warm; the render phase "allocs" includes the first frame.
+// The "budgets" column reads "cut" for a document that exceeded one of the
+// default SrSVGBudgets, whose over-budget work was dropped; its diagnostics
+// are printed to stderr. The op counts of such a run are not comparable.
+//
+// --budgets, --streaming, --batch N and --raster are self-checks, described
+// in SrSVGBenchmarkChecks.h; --raster needs a build with
+// SR_SVG_BENCHMARK_SKITY. The generated documents are in
+// SrSVGBenchmarkDocuments.h.
+//
+// Every canvas shares one SrImageCache, so a data: image is decoded once for
+// the whole run; its statistics are printed to stderr with the document
+// cache's. Other hrefs are loaded on every draw, as the default cache does.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/SrSVGBenchmark.h"
+#include "benchmark/SrSVGBenchmarkChecks.h"
+#include "benchmark/SrSVGBenchmarkDocuments.h"
+#include "canvas/SrImageCache.h"
+#include "parser/SrDOM.h"
+#include "parser/SrSVGDOM.h"
+#include "parser/SrSVGDOMCache.h"
+#include "parser/SrXMLParserError.h"
+#include "platform/headless/SrRecordingCanvas.h"
+
+#ifndef SR_SVG_SOURCE_DIR
+#define SR_SVG_SOURCE_DIR "."
+#endif
+
+namespace serval {
+namespace svg {
+namespace benchmark {
+
+std::atomic<uint64_t> g_allocation_count{0};
+std::atomic<uint64_t> g_allocation_bytes{0};
+
+}  // namespace benchmark
+}  // namespace svg
+}  // namespace serval
+
+void* operator new(size_t size) {
+  using serval::svg::benchmark::g_allocation_bytes;
+  using serval::svg::benchmark::g_allocation_count;
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  g_allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+  std::free(memory);
+}
+
+namespace serval {
+namespace svg {
+namespace benchmark {
+
+namespace fs = std::filesystem;
+
+struct FileResult {
+  std::string name;
+  bool ok{false};
+  int frames{0};
+  PhaseResult parse;
+  PhaseResult build;
+  PhaseResult load;
+  PhaseResult acquire;
+  PhaseResult render;
+  // Frames after the first, one sample each.
+  PhaseResult frame;
+  headless::SrRecordingStats stats;
+  bool binary_match{false};
+  // Budget diagnostics of the first iteration, each reported once.
+  std::vector<parser::SrSVGDiagnostic> budget_diagnostics;
+};
+
+bool ReadFile(const std::string& path, std::vector<char>* content) {
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream) {
+    return false;
+  }
+  content->assign(std::istreambuf_iterator<char>(stream),
+                  std::istreambuf_iterator<char>());
+  // The parser expects a nul-terminated buffer, as the platform loaders pass.
+  content->push_back('\0');
+  return true;
+}
+
+std::vector<double> SampleTimes(const parser::SrSVGDOM& dom,
+                                const Options& options) {
+  if (!dom.HasAnimations() || options.frames <= 1) {
+    return {0.0};
+  }
+  double end = dom.AnimationTimelineEndSeconds();
+  if (!std::isfinite(end) || end <= 0.0) {
+    end = options.duration;
+  }
+  std::vector<double> times;
+  times.reserve(options.frames);
+  for (int frame = 0; frame < options.frames; ++frame) {
+    times.push_back(end * frame / (options.frames - 1));
+  }
+  return times;
+}
+
+// Image loads depend on what the image cache already holds, so they are left
+// out when the binary document's ops are compared.
+bool SameRenderOps(const headless::SrRecordingStats& lhs,
+                   const headless::SrRecordingStats& rhs) {
+  using headless::SrRecordedOp;
+  for (size_t op = 0; op < lhs.ops.size(); ++op) {
+    const auto recorded = static_cast<SrRecordedOp>(op);
+    if (recorded == SrRecordedOp::kLoadImage ||
+        recorded == SrRecordedOp::kDecodeImage) {
+      continue;
+    }
+    if (lhs.ops[op] != rhs.ops[op]) {
+      return false;
+    }
+  }
+  return lhs.layer_area == rhs.layer_area;
+}
+
+bool IsBudgetDiagnostic(SrSVGDiagnosticCode code) {
+  return code >= SR_SVG_DIAGNOSTIC_NODE_BUDGET_EXCEEDED &&
+         code <= SR_SVG_DIAGNOSTIC_LAYER_BUDGET_EXCEEDED;
+}
+
+// Appends the budget diagnostics of |dom|'s build and last render that
+// |budget_diagnostics| does not hold yet.
+void CollectBudgetDiagnostics(
+    const parser::SrSVGDOM& dom,
+    std::vector<parser::SrSVGDiagnostic>* budget_diagnostics) {
+  for (const auto& diagnostic : dom.diagnostics()) {
+    if (!IsBudgetDiagnostic(diagnostic.code)) {
+      continue;
+    }
+    const bool seen = std::any_of(
+        budget_diagnostics->begin(), budget_diagnostics->end(),
+        [&diagnostic](const parser::SrSVGDiagnostic& other) {
+          return other.code == diagnostic.code &&
+                 other.subject == diagnostic.subject;
+        });
+    if (!seen) {
+      budget_diagnostics->push_back(diagnostic);
+    }
+  }
+}
+
+FileResult RunDocument(const std::string& name,
+                       const std::vector<char>& content,
+                       const Options& options, parser::SrSVGDOMCache* cache,
+                       canvas::SrImageCache* image_cache) {
+  FileResult result;
+  result.name = name;
+
+  std::vector<uint8_t> binary;
+  {
+    auto dom = parser::SrSVGDOM::make(content.data(), content.size(), nullptr);
+    if (!dom || !dom->Serialize(&binary)) {
+      return result;
+    }
+  }
+
+  for (int iteration = 0; iteration < options.iterations; ++iteration) {
+    // XML parsing alone.
+    PhaseSample parse_sample;
+    {
+      PhaseScope scope(&parse_sample);
+      parser::SrDOM xml_dom;
+      parser::SrXMLParserError error;
+      xml_dom.build(content.data(), content.size(), &error, nullptr);
+    }
+
+    // SrSVGDOM::make parses again before building the element tree, so the
+    // build phase is reported as the difference to the parse phase.
+    PhaseSample make_sample;
+    std::unique_ptr<parser::SrSVGDOM> dom;
+    {
+      PhaseScope scope(&make_sample);
+      dom = parser::SrSVGDOM::make(content.data(), content.size(), nullptr);
+    }
+    if (!dom) {
+      return result;
+    }
+    PhaseSample build_sample;
+    build_sample.micros =
+        std::max(0.0, make_sample.micros - parse_sample.micros);
+    build_sample.allocations =
+        make_sample.allocations > parse_sample.allocations
+            ? make_sample.allocations - parse_sample.allocations
+            : 0;
+    build_sample.bytes = make_sample.bytes > parse_sample.bytes
+                             ? make_sample.bytes - parse_sample.bytes
+                             : 0;
+
+    PhaseSample load_sample;
+    {
+      PhaseScope scope(&load_sample);
+      parser::SrSVGDOM::makeFromBinary(binary.data(), binary.size(), nullptr);
+    }
+
+    PhaseSample acquire_sample;
+    {
+      PhaseScope scope(&acquire_sample);
+      cache->Acquire(content.data(), content.size(), nullptr);
+    }
+
+    // Time sampling and canvas setup stay outside the measured region.
+    const std::vector<double> times = SampleTimes(*dom, options);
+    const SrSVGBox view_port{0.f, 0.f, options.width, options.height};
+    headless::SrRecordingCanvas canvas;
+    canvas.SetImageCache(image_cache);
+    PhaseSample render_sample;
+    {
+      PhaseScope scope(&render_sample);
+      for (size_t frame = 0; frame < times.size(); ++frame) {
+        PhaseSample frame_sample;
+        {
+          PhaseScope frame_scope(&frame_sample);
+          if (dom->HasAnimations()) {
+            dom->RenderAtTime(&canvas, view_port, times[frame]);
+          } else {
+            dom->Render(&canvas, view_port);
+          }
+        }
+        if (frame > 0) {
+          result.frame.Add(frame_sample);
+        }
+        if (iteration == 0) {
+          CollectBudgetDiagnostics(*dom, &result.budget_diagnostics);
+        }
+      }
+    }
+    result.parse.Add(parse_sample);
+    result.build.Add(build_sample);
+    result.load.Add(load_sample);
+    result.acquire.Add(acquire_sample);
+    result.render.Add(render_sample);
+    result.frames = static_cast<int>(times.size());
+    result.stats = canvas.stats();
+  }
+
+  auto loaded =
+      parser::SrSVGDOM::makeFromBinary(binary.data(), binary.size(), nullptr);
+  if (loaded) {
+    const SrSVGBox view_port{0.f, 0.f, options.width, options.height};
+    headless::SrRecordingCanvas canvas;
+    canvas.SetImageCache(image_cache);
+    for (double seconds : SampleTimes(*loaded, options)) {
+      if (loaded->HasAnimations()) {
+        loaded->RenderAtTime(&canvas, view_port, seconds);
+      } else {
+        loaded->Render(&canvas, view_port);
+      }
+    }
+    result.binary_match = SameRenderOps(canvas.stats(), result.stats);
+  }
+  result.ok = true;
+  return result;
+}
+
+FileResult RunFile(const std::string& path, const Options& options,
+                   parser::SrSVGDOMCache* cache,
+                   canvas::SrImageCache* image_cache) {
+  std::vector<char> content;
+  if (!ReadFile(path, &content)) {
+    FileResult result;
+    result.name = fs::path(path).filename().string();
+    return result;
+  }
+  return RunDocument(fs::path(path).filename().string(), content, options,
+                     cache, image_cache);
+}
+
+std::vector<std::string> CollectFiles(const Options& options) {
+  std::vector<std::string> inputs = options.paths;
+  if (inputs.empty() && options.chain == 0 && options.images == 0 &&
+      options.animated == 0 && options.cropped == 0 && options.shapes == 0 &&
+      !options.budgets) {
+    inputs.push_back(std::string(SR_SVG_SOURCE_DIR) + "/test_cases");
+    inputs.push_back(std::string(SR_SVG_SOURCE_DIR) + "/examples");
+  }
+  std::vector<std::string> files;
+  for (const auto& input : inputs) {
+    std::error_code error;
+    if (fs::is_directory(input, error)) {
+      std::vector<std::string> directory_files;
+      for (const auto& entry : fs::directory_iterator(input, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".svg") {
+          directory_files.push_back(entry.path().string());
+        }
+      }
+      std::sort(directory_files.begin(), directory_files.end());
+      files.insert(files.end(), directory_files.begin(),
+                   directory_files.end());
+    } else if (fs::is_regular_file(input, error)) {
+      files.push_back(input);
+    } else {
+      fprintf(stderr, "skip missing input: %s\n", input.c_str());
+    }
+  }
+  return files;
+}
+
+void PrintResults(const std::vector<FileResult>& results, bool csv) {
+  using headless::SrRecordedOp;
+  if (csv) {
+    printf(
+        "file,frames,parse_us,parse_allocs,parse_bytes,build_us,build_allocs,"
+        "build_bytes,load_us,load_allocs,load_bytes,acquire_us,acquire_allocs,"
+        "acquire_bytes,render_us,render_allocs,render_bytes,frame_allocs,ops,"
+        "draws,layers,layer_area,max_depth,binary,budgets");
+    for (size_t op = 0; op < static_cast<size_t>(SrRecordedOp::kCount); ++op) {
+      printf(",%s", headless::SrRecordedOpName(static_cast<SrRecordedOp>(op)));
+    }
+    printf("\n");
+  } else {
+    printf("%-48s %6s %10s %8s %10s %8s %10s %8s %10s %10s %8s %12s %8s %8s "
+           "%12s %6s %7s\n",
+           "file", "frames", "parse_us", "allocs", "build_us", "allocs",
+           "load_us", "allocs", "acquire_us", "render_us", "allocs",
+           "frame_allocs", "ops", "layers", "layer_area", "binary",
+           "budgets");
+  }
+  for (const auto& result : results) {
+    if (!result.ok) {
+      if (csv) {
+        printf("%s,failed\n", result.name.c_str());
+      } else {
+        printf("%-48s failed\n", result.name.c_str());
+      }
+      continue;
+    }
+    const auto& stats = result.stats;
+    const uint64_t layers = stats.Count(SrRecordedOp::kOpacityLayer) +
+                            stats.Count(SrRecordedOp::kFilterLayer) +
+                            stats.Count(SrRecordedOp::kMaskLayer) +
+                            stats.Count(SrRecordedOp::kSaveLayer);
+    const char* budgets = result.budget_diagnostics.empty() ? "ok" : "cut";
+    for (const auto& diagnostic : result.budget_diagnostics) {
+      fprintf(stderr, "%s: %s (%s)\n", result.name.c_str(),
+              diagnostic.message.c_str(), diagnostic.subject.c_str());
+    }
+    if (csv) {
+      printf("%s,%d,%.2f,%llu,%llu,%.2f,%llu,%llu,%.2f,%llu,%llu,%.2f,%llu,"
+             "%llu,%.2f,%llu,%llu,%llu,%llu,%llu,%llu,%.0f,%u,%s,%s",
+             result.name.c_str(), result.frames, result.parse.Median(),
+             (unsigned long long)result.parse.AllocationsPerIteration(),
+             (unsigned long long)result.parse.BytesPerIteration(),
+             result.build.Median(),
+             (unsigned long long)result.build.AllocationsPerIteration(),
+             (unsigned long long)result.build.BytesPerIteration(),
+             result.load.Median(),
+             (unsigned long long)result.load.AllocationsPerIteration(),
+             (unsigned long long)result.load.BytesPerIteration(),
+             result.acquire.Median(),
+             (unsigned long long)result.acquire.AllocationsPerIteration(),
+             (unsigned long long)result.acquire.BytesPerIteration(),
+             result.render.Median(),
+             (unsigned long long)result.render.AllocationsPerIteration(),
+             (unsigned long long)result.render.BytesPerIteration(),
+             (unsigned long long)result.frame.AllocationsPerIteration(),
+             (unsigned long long)stats.Total(),
+             (unsigned long long)stats.DrawCount(), (unsigned long long)layers,
+             stats.layer_area, stats.max_save_depth,
+             result.binary_match ? "match" : "differ", budgets);
+      for (uint64_t count : stats.ops) {
+        printf(",%llu", (unsigned long long)count);
+      }
+      printf("\n");
+    } else {
+      printf("%-48s %6d %10.2f %8llu %10.2f %8llu %10.2f %8llu %10.2f %10.2f "
+             "%8llu %12llu %8llu %8llu %12.0f %6s %7s\n",
+             result.name.c_str(), result.frames, result.parse.Median(),
+             (unsigned long long)result.parse.AllocationsPerIteration(),
+             result.build.Median(),
+             (unsigned long long)result.build.AllocationsPerIteration(),
+             result.load.Median(),
+             (unsigned long long)result.load.AllocationsPerIteration(),
+             result.acquire.Median(), result.render.Median(),
+             (unsigned long long)result.render.AllocationsPerIteration(),
+             (unsigned long long)result.frame.AllocationsPerIteration(),
+             (unsigned long long)stats.Total(), (unsigned long long)layers,
+             stats.layer_area, result.binary_match ? "match" : "differ",
+             budgets);
+    }
+  }
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (strcmp(arg, "--iterations") == 0 && has_value) {
+      options->iterations = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(arg, "--frames") == 0 && has_value) {
+      options->frames = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(arg, "--duration") == 0 && has_value) {
+      options->duration = std::max(0.0, atof(argv[++i]));
+    } else if (strcmp(arg, "--size") == 0 && i + 2 < argc) {
+      options->width = std::max(1.f, static_cast<float>(atof(argv[++i])));
+      options->height = std::max(1.f, static_cast<float>(atof(argv[++i])));
+    } else if (strcmp(arg, "--chain") == 0 && has_value) {
+      options->chain = std::max(0, atoi(argv[++i]));
+    } else if (strcmp(arg, "--images") == 0 && has_value) {
+      options->images = std::max(0, atoi(argv[++i]));
+    } else if (strcmp(arg, "--animated") == 0 && has_value) {
+      options->animated = std::max(0, atoi(argv[++i]));
+    } else if (strcmp(arg, "--cropped") == 0 && has_value) {
+      options->cropped = std::max(0, atoi(argv[++i]));
+    } else if (strcmp(arg, "--shapes") == 0 && has_value) {
+      options->shapes = std::max(0, atoi(argv[++i]));
+    } else if (strcmp(arg, "--budgets") == 0) {
+      options->budgets = true;
+    } else if (strcmp(arg, "--streaming") == 0) {
+      options->streaming = true;
+    } else if (strcmp(arg, "--batch") == 0 && has_value) {
+      options->batch = std::max(0, atoi(argv[++i]));
+    } else if (strcmp(arg, "--raster") == 0) {
+      options->raster = true;
+    } else if (strcmp(arg, "--csv") == 0) {
+      options->csv = true;
+    } else if (arg[0] == '-') {
+      fprintf(stderr,
+              "usage: %s [--iterations N] [--frames N] [--duration S] "
+              "[--size W H] [--chain N] [--images N] [--animated N] "
+              "[--cropped N] [--shapes N] [--budgets] [--streaming] "
+              "[--batch N] [--raster] [--csv] [path ...]\n",
+              argv[0]);
+      return false;
+    } else {
+      options->paths.emplace_back(arg);
+    }
+  }
+  return true;
+}
+
+}  // namespace benchmark
+}  // namespace svg
+}  // namespace serval
+
+int main(int argc, char** argv) {
+  using namespace serval::svg::benchmark;
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    return 1;
+  }
+  const std::vector<std::string> files = CollectFiles(options);
+  if (options.streaming) {
+    return RunStreamingChecks(files) ? 0 : 1;
+  }
+  if (options.batch >= 0) {
+    return RunBatchCheck(files, options) ? 0 : 1;
+  }
+  if (options.raster) {
+#if SR_SVG_BENCHMARK_SKITY
+    return RunRasterChecks(files, options) ? 0 : 1;
+#else
+    fprintf(stderr, "--raster needs a build with SR_SVG_BENCHMARK_SKITY\n");
+    return 1;
+#endif
+  }
+  const bool generated = options.chain > 0 || options.images > 0 ||
+                         options.animated > 0 || options.cropped > 0 ||
+                         options.shapes > 0;
+  if (options.budgets && files.empty() && !generated) {
+    return RunBudgetChecks(options) ? 0 : 1;
+  }
+  if (files.empty() && !generated) {
+    fprintf(stderr, "no svg files found\n");
+    return 1;
+  }
+  const bool budgets_passed = !options.budgets || RunBudgetChecks(options);
+  std::vector<FileResult> results;
+  results.reserve(files.size());
+  serval::svg::parser::SrSVGDOMCache cache;
+  serval::svg::canvas::SrImageCache image_cache;
+  for (const auto& file : files) {
+    results.push_back(RunFile(file, options, &cache, &image_cache));
+  }
+  if (options.chain > 0) {
+    results.push_back(RunDocument(
+        "chain-" + std::to_string(options.chain) + ".svg",
+        MakeChainedDocument(options.chain), options, &cache, &image_cache));
+  }
+  if (options.images > 0) {
+    results.push_back(RunDocument(
+        "images-" + std::to_string(options.images) + ".svg",
+        MakeImageDocument(options.images), options, &cache, &image_cache));
+  }
+  if (options.animated > 0) {
+    results.push_back(RunDocument(
+        "animated-" + std::to_string(options.animated) + ".svg",
+        MakeAnimatedDocument(options.animated), options, &cache,
+        &image_cache));
+  }
+  if (options.cropped > 0) {
+    results.push_back(RunDocument(
+        "cropped-" + std::to_string(options.cropped) + ".svg",
+        MakeCroppedDocument(options.cropped), options, &cache, &image_cache));
+  }
+  if (options.shapes > 0) {
+    results.push_back(RunDocument(
+        "shapes-" + std::to_string(options.shapes) + ".svg",
+        MakeShapesDocument(options.shapes), options, &cache, &image_cache));
+  }
+  PrintResults(results, options.csv);
+  const auto stats = cache.stats();
+  fprintf(stderr,
+          "document cache: %llu hits, %llu misses, %llu evictions, "
+          "%zu entries, %zu of %zu bytes\n",
+          (unsigned long long)stats.hits, (unsigned long long)stats.misses,
+          (unsigned long long)stats.evictions, stats.entries, stats.bytes,
+          stats.capacity_bytes);
+  const auto image_stats = image_cache.stats();
+  fprintf(stderr,
+          "image cache: %llu hits, %llu misses, %llu evictions, %zu entries, "
+          "%zu of %zu bytes\n",
+          (unsigned long long)image_stats.hits,
+          (unsigned long long)image_stats.misses,
+          (unsigned long long)image_stats.evictions, image_stats.entries,
+          image_stats.bytes, image_stats.capacity_bytes);
+  return budgets_passed ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_BENCHMARK_SRSVGBENCHMARK_H_
+#define SVG_BENCHMARK_SRSVGBENCHMARK_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace serval {
+namespace svg {
+namespace benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+// Allocations made through the global operator new since the start.
+extern std::atomic<uint64_t> g_allocation_count;
+extern std::atomic<uint64_t> g_allocation_bytes;
+
+struct Options {
+  int iterations{10};
+  int frames{30};
+  double duration{2.0};
+  float width{512.f};
+  float height{512.f};
+  bool csv{false};
+  int chain{0};
+  int images{0};
+  int animated{0};
+  int cropped{0};
+  int shapes{0};
+  bool budgets{false};
+  bool streaming{false};
+  // Workers of the --batch check; negative skips it.
+  int batch{-1};
+  bool raster{false};
+  std::vector<std::string> paths;
+};
+
+struct PhaseSample {
+  double micros{0.0};
+  uint64_t allocations{0};
+  uint64_t bytes{0};
+};
+
+// Accumulates a phase over iterations; reported values are per iteration.
+struct PhaseResult {
+  std::vector<double> micros;
+  uint64_t allocations{0};
+  uint64_t bytes{0};
+
+  void Add(const PhaseSample& sample) {
+    micros.push_back(sample.micros);
+    allocations += sample.allocations;
+    bytes += sample.bytes;
+  }
+  double Median() const {
+    if (micros.empty()) {
+      return 0.0;
+    }
+    std::vector<double> sorted = micros;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[sorted.size() / 2];
+  }
+  uint64_t AllocationsPerIteration() const {
+    return micros.empty() ? 0 : allocations / micros.size();
+  }
+  uint64_t BytesPerIteration() const {
+    return micros.empty() ? 0 : bytes / micros.size();
+  }
+};
+
+class PhaseScope {
+ public:
+  explicit PhaseScope(PhaseSample* sample)
+      : sample_(sample),
+        start_(Clock::now()),
+        allocations_(g_allocation_count.load(std::memory_order_relaxed)),
+        bytes_(g_allocation_bytes.load(std::memory_order_relaxed)) {}
+  ~PhaseScope() {
+    sample_->micros =
+        std::chrono::duration<double, std::micro>(Clock::now() - start_)
+            .count();
+    sample_->allocations =
+        g_allocation_count.load(std::memory_order_relaxed) - allocations_;
+    sample_->bytes =
+        g_allocation_bytes.load(std::memory_order_relaxed) - bytes_;
+  }
+
+ private:
+  PhaseSample* sample_;
+  Clock::time_point start_;
+  uint64_t allocations_;
+  uint64_t bytes_;
+};
+
+// Reads |path| into |content| with a trailing nul, as the parser expects.
+bool ReadFile(const std::string& path, std::vector<char>* content);
+
+}  // namespace benchmark
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_BENCHMARK_SRSVGBENCHMARK_H_
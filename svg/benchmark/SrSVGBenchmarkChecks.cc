@@ -0,0 +1,277 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "benchmark/SrSVGBenchmarkChecks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <utility>
+
+#include "benchmark/SrSVGBenchmarkDocuments.h"
+#include "platform/headless/SrRecordingCanvas.h"
+
+namespace serval {
+namespace svg {
+namespace benchmark {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr double kBudgetCheckMillis = 2000.0;
+// Node budget of the --budgets check, which the defaults leave off.
+constexpr uint32_t kCheckedMaxNodes = 100000;
+
+// Builds and renders |content| once, returning false unless that reports
+// |code| within kBudgetCheckMillis.
+bool CheckBudget(const char* name, const std::vector<char>& content,
+                 SrSVGDiagnosticCode code,
+                 const parser::SrSVGBudgets& budgets,
+                 const Options& options) {
+  const auto start = Clock::now();
+  auto dom = parser::SrSVGDOM::make(content.data(), content.size(), nullptr,
+                                    budgets);
+  bool reported = false;
+  if (dom) {
+    headless::SrRecordingCanvas canvas;
+    dom->Render(&canvas, SrSVGBox{0.f, 0.f, options.width, options.height});
+    for (const auto& diagnostic : dom->diagnostics()) {
+      reported = reported || diagnostic.code == code;
+    }
+  }
+  const double millis =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  const bool passed = reported && millis <= kBudgetCheckMillis;
+  printf("%-48s %10.2f ms %s\n", name, millis,
+         passed ? "ok" : (reported ? "slow" : "not reported"));
+  return passed;
+}
+
+bool SameDiagnostics(const std::vector<parser::SrSVGDiagnostic>& lhs,
+                     const std::vector<parser::SrSVGDiagnostic>& rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                    [](const parser::SrSVGDiagnostic& a,
+                       const parser::SrSVGDiagnostic& b) {
+                      return a.code == b.code && a.message == b.message &&
+                             a.subject == b.subject && a.fatal == b.fatal;
+                    });
+}
+
+// Serialized form of a build result: the blob of the document, or nothing
+// when the build failed, and the diagnostics either way.
+struct BuildOutcome {
+  bool built{false};
+  std::vector<uint8_t> blob;
+  std::vector<parser::SrSVGDiagnostic> diagnostics;
+
+  bool operator==(const BuildOutcome& other) const {
+    return built == other.built && blob == other.blob &&
+           SameDiagnostics(diagnostics, other.diagnostics);
+  }
+};
+
+BuildOutcome Outcome(std::unique_ptr<parser::SrSVGDOM> dom,
+                     std::vector<parser::SrSVGDiagnostic> diagnostics) {
+  BuildOutcome outcome;
+  outcome.built = dom && dom->Serialize(&outcome.blob);
+  outcome.diagnostics = std::move(diagnostics);
+  return outcome;
+}
+
+// Streams |content| in pieces that end at each offset of |splits|.
+BuildOutcome StreamDocument(const std::vector<char>& content,
+                            const std::vector<size_t>& splits) {
+  parser::SrSVGDOMStream stream;
+  size_t offset = 0;
+  for (size_t split : splits) {
+    stream.Append(content.data() + offset, split - offset);
+    offset = split;
+  }
+  stream.Append(content.data() + offset, content.size() - offset);
+  std::vector<parser::SrSVGDiagnostic> diagnostics;
+  auto dom = stream.Finish(&diagnostics);
+  return Outcome(std::move(dom), std::move(diagnostics));
+}
+
+bool CheckStreaming(const std::string& path) {
+  const std::string name = fs::path(path).filename().string();
+  std::vector<char> content;
+  if (!ReadFile(path, &content)) {
+    printf("%-48s unreadable\n", name.c_str());
+    return false;
+  }
+  std::vector<parser::SrSVGDiagnostic> diagnostics;
+  auto dom =
+      parser::SrSVGDOM::make(content.data(), content.size(), &diagnostics);
+  const BuildOutcome expected = Outcome(std::move(dom), std::move(diagnostics));
+
+  std::vector<size_t> bytes;
+  for (size_t split = 0; split <= content.size(); ++split) {
+    if (!(StreamDocument(content, {split}) == expected)) {
+      printf("%-48s differs when split at byte %zu\n", name.c_str(), split);
+      return false;
+    }
+    if (split > 0) {
+      bytes.push_back(split);
+    }
+  }
+  if (!(StreamDocument(content, bytes) == expected)) {
+    printf("%-48s differs when fed byte by byte\n", name.c_str());
+    return false;
+  }
+  printf("%-48s %8zu splits ok%s\n", name.c_str(), content.size() + 2,
+         expected.built ? "" : " (rejected)");
+  return true;
+}
+
+// Target of the --batch check. A recording canvas has no pixels, so the op
+// counts of the render are read back in their place.
+class RecordingTarget : public renderer::SrSVGRasterTarget {
+ public:
+  canvas::SrCanvas* Canvas() override { return &canvas_; }
+  bool ReadPixels(std::vector<uint8_t>* pixels) override {
+    const headless::SrRecordingStats& stats = canvas_.stats();
+    const auto* ops = reinterpret_cast<const uint8_t*>(stats.ops.data());
+    const auto* area = reinterpret_cast<const uint8_t*>(&stats.layer_area);
+    pixels->assign(ops, ops + sizeof(stats.ops));
+    pixels->insert(pixels->end(), area, area + sizeof(stats.layer_area));
+    return true;
+  }
+
+ private:
+  headless::SrRecordingCanvas canvas_;
+};
+
+// Renders |jobs| options.iterations times and returns the median wall time.
+double TimeBatch(const renderer::SrSVGBatchRenderer& renderer,
+                 const std::vector<renderer::SrSVGRasterJob>& jobs,
+                 const Options& options,
+                 std::vector<renderer::SrSVGRasterResult>* results) {
+  PhaseResult totals;
+  for (int iteration = 0; iteration < options.iterations; ++iteration) {
+    PhaseSample sample;
+    {
+      PhaseScope scope(&sample);
+      *results = renderer.Render(jobs);
+    }
+    totals.Add(sample);
+  }
+  return totals.Median();
+}
+
+}  // namespace
+
+bool RunBudgetChecks(const Options& options) {
+  parser::SrSVGBudgets budgets;
+  budgets.max_nodes = kCheckedMaxNodes;
+  bool passed = true;
+  passed &= CheckBudget("budget-nodes.svg", MakeNodeBudgetDocument(budgets),
+                        SR_SVG_DIAGNOSTIC_NODE_BUDGET_EXCEEDED, budgets,
+                        options);
+  passed &= CheckBudget("budget-path-ops.svg", MakePathBudgetDocument(budgets),
+                        SR_SVG_DIAGNOSTIC_PATH_BUDGET_EXCEEDED, budgets,
+                        options);
+  passed &= CheckBudget("budget-animations.svg",
+                        MakeAnimationBudgetDocument(budgets),
+                        SR_SVG_DIAGNOSTIC_ANIMATION_BUDGET_EXCEEDED, budgets,
+                        options);
+  passed &= CheckBudget("budget-use-depth.svg", MakeUseDepthDocument(budgets),
+                        SR_SVG_DIAGNOSTIC_USE_BUDGET_EXCEEDED, budgets,
+                        options);
+  passed &= CheckBudget("budget-use-fan-out.svg", MakeUseFanOutDocument(),
+                        SR_SVG_DIAGNOSTIC_USE_BUDGET_EXCEEDED, budgets,
+                        options);
+  passed &= CheckBudget("budget-layer-area.svg", MakeLayerAreaDocument(),
+                        SR_SVG_DIAGNOSTIC_LAYER_BUDGET_EXCEEDED, budgets,
+                        options);
+  return passed;
+}
+
+bool RunStreamingChecks(const std::vector<std::string>& files) {
+  bool passed = !files.empty();
+  for (const auto& file : files) {
+    passed &= CheckStreaming(file);
+  }
+  return passed;
+}
+
+bool SameRaster(const renderer::SrSVGRasterResult& lhs,
+                const renderer::SrSVGRasterResult& rhs) {
+  return lhs.ok == rhs.ok && lhs.pixel_width == rhs.pixel_width &&
+         lhs.pixel_height == rhs.pixel_height && lhs.pixels == rhs.pixels &&
+         SameDiagnostics(lhs.diagnostics, rhs.diagnostics);
+}
+
+// The --size viewport at scales 1 and 2 and a 24x24 icon with a default
+// color, for every readable file. The jobs point into |contents|.
+std::vector<renderer::SrSVGRasterJob> MakeBatchJobs(
+    const std::vector<std::string>& files, const Options& options,
+    std::vector<std::vector<char>>* contents) {
+  contents->assign(files.size(), {});
+  std::vector<renderer::SrSVGRasterJob> jobs;
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (!ReadFile(files[i], &(*contents)[i])) {
+      continue;
+    }
+    renderer::SrSVGRasterJob job;
+    job.content = (*contents)[i].data();
+    job.length = (*contents)[i].size();
+    job.width = options.width;
+    job.height = options.height;
+    jobs.push_back(job);
+    job.scale = 2.f;
+    jobs.push_back(job);
+    job.width = job.height = 24.f;
+    job.default_color = 0xff3366ccu;
+    jobs.push_back(job);
+  }
+  return jobs;
+}
+
+bool RunBatchCheck(const std::vector<std::string>& files,
+                   const Options& options) {
+  std::vector<std::vector<char>> contents;
+  const auto jobs = MakeBatchJobs(files, options, &contents);
+  if (jobs.empty()) {
+    fprintf(stderr, "no svg files found\n");
+    return false;
+  }
+
+  auto factory = [](uint32_t, uint32_t) {
+    return std::make_unique<RecordingTarget>();
+  };
+  const renderer::SrSVGBatchRenderer sequential(factory, 1);
+  const renderer::SrSVGBatchRenderer parallel(factory, options.batch);
+  std::vector<renderer::SrSVGRasterResult> expected;
+  std::vector<renderer::SrSVGRasterResult> results;
+  const double sequential_micros =
+      TimeBatch(sequential, jobs, options, &expected);
+  const double parallel_micros = TimeBatch(parallel, jobs, options, &results);
+
+  bool passed = true;
+  double parse_micros = 0.0;
+  double render_micros = 0.0;
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    parse_micros += results[i].parse_micros;
+    render_micros += results[i].render_micros;
+    if (!SameRaster(results[i], expected[i])) {
+      printf("job %zu (%.0fx%.0f @%.0fx) differs from the sequential render\n",
+             i, jobs[i].width, jobs[i].height, jobs[i].scale);
+      passed = false;
+    }
+  }
+  printf("%zu jobs: 1 worker %.2f ms, %u workers %.2f ms "
+         "(parse %.2f ms, render %.2f ms summed over jobs), %s\n",
+         jobs.size(), sequential_micros / 1000.0, parallel.max_workers(),
+         parallel_micros / 1000.0, parse_micros / 1000.0,
+         render_micros / 1000.0, passed ? "outputs match" : "outputs differ");
+  return passed;
+}
+
+}  // namespace benchmark
+}  // namespace svg
+}  // namespace serval
@@ -0,0 +1,66 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_BENCHMARK_SRSVGBENCHMARKCHECKS_H_
+#define SVG_BENCHMARK_SRSVGBENCHMARKCHECKS_H_
+
+#include <string>
+#include <vector>
+
+#include "benchmark/SrSVGBenchmark.h"
+#include "renderer/SrSVGBatchRenderer.h"
+
+// Self-check modes of the benchmark. Each prints one line per document or
+// batch and returns false if any check failed.
+
+namespace serval {
+namespace svg {
+namespace benchmark {
+
+// --budgets: builds and renders one pathological document per SrSVGBudgets
+// limit the recording canvas exercises, and fails unless each one reports
+// its budget diagnostic within kBudgetCheckMillis. The node budget, off by
+// default, is set to kCheckedMaxNodes for the check. Pattern tiles are laid
+// out by the raster backends only and are covered by
+// invalid-budget-pattern-tiles.svg in the examples instead.
+bool RunBudgetChecks(const Options& options);
+
+// --streaming: checks that SrSVGDOMStream builds every file exactly as
+// SrSVGDOM::make does: split in two at each byte boundary, and fed one byte
+// at a time. Documents are compared by their serialized blob and build
+// diagnostics, and a file fails on its first difference.
+bool RunStreamingChecks(const std::vector<std::string>& files);
+
+// --batch N: rasterizes every file through SrSVGBatchRenderer, at the --size
+// viewport at scales 1 and 2 and as a 24x24 icon with a default color, once
+// on one worker and once on N (zero is one per hardware thread). The
+// recorded ops, sizes and diagnostics of each job must match between the two
+// runs; the median wall time of both is printed.
+bool RunBatchCheck(const std::vector<std::string>& files,
+                   const Options& options);
+
+// The --batch jobs for every readable file. The jobs point into |contents|.
+std::vector<renderer::SrSVGRasterJob> MakeBatchJobs(
+    const std::vector<std::string>& files, const Options& options,
+    std::vector<std::vector<char>>* contents);
+
+bool SameRaster(const renderer::SrSVGRasterResult& lhs,
+                const renderer::SrSVGRasterResult& rhs);
+
+#if SR_SVG_BENCHMARK_SKITY
+// --raster: pixel checks through the skity software canvas. Generated blurs,
+// under translations, scales and non-scaling strokes, and every filter-*.svg
+// file are drawn with reduced resolution filter layers and at full
+// resolution; no channel may differ by more than kMaxFilterLevelDifference.
+// Every file is then rasterized by the --batch jobs on one worker and on one
+// per hardware thread, and the pixels must be identical.
+bool RunRasterChecks(const std::vector<std::string>& files,
+                     const Options& options);
+#endif  // SR_SVG_BENCHMARK_SKITY
+
+}  // namespace benchmark
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_BENCHMARK_SRSVGBENCHMARKCHECKS_H_
@@ -0,0 +1,306 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "benchmark/SrSVGBenchmarkDocuments.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace serval {
+namespace svg {
+namespace benchmark {
+
+namespace {
+
+std::string EncodeBase64(const std::vector<uint8_t>& data) {
+  static const char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string encoded;
+  for (size_t i = 0; i < data.size(); i += 3) {
+    uint32_t bits = static_cast<uint32_t>(data[i]) << 16;
+    if (i + 1 < data.size()) {
+      bits |= static_cast<uint32_t>(data[i + 1]) << 8;
+    }
+    if (i + 2 < data.size()) {
+      bits |= data[i + 2];
+    }
+    encoded += kAlphabet[(bits >> 18) & 0x3f];
+    encoded += kAlphabet[(bits >> 12) & 0x3f];
+    encoded += i + 1 < data.size() ? kAlphabet[(bits >> 6) & 0x3f] : '=';
+    encoded += i + 2 < data.size() ? kAlphabet[bits & 0x3f] : '=';
+  }
+  return encoded;
+}
+
+// PNG signature and IHDR chunk, which is all SrRecordingCanvas reads.
+std::vector<uint8_t> MakePNGHeader(uint32_t width, uint32_t height) {
+  std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n',
+                              0,    0,   0,   13,  'I',  'H',  'D',  'R'};
+  for (uint32_t value : {width, height}) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      png.push_back(static_cast<uint8_t>(value >> shift));
+    }
+  }
+  png.insert(png.end(), {8, 6, 0, 0, 0});
+  return png;
+}
+
+}  // namespace
+
+std::vector<char> MakeChainedDocument(int length) {
+  std::string svg =
+      "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 512 512\">";
+  char buffer[256];
+  for (int i = 0; i < length; ++i) {
+    snprintf(buffer, sizeof(buffer),
+             "<rect x=\"%d\" y=\"%d\" width=\"8\" height=\"8\">"
+             "<animate id=\"a%d\" attributeName=\"x\" begin=\"",
+             (i * 8) % 512, (i / 64 * 8) % 512, i);
+    svg += buffer;
+    if (i == 0) {
+      svg += "0s";
+    } else {
+      snprintf(buffer, sizeof(buffer), "a%d.end", i - 1);
+      svg += buffer;
+    }
+    svg += "\" dur=\"1s\" from=\"0\" to=\"504\"/></rect>";
+  }
+  svg += "</svg>";
+  return std::vector<char>(svg.c_str(), svg.c_str() + svg.size() + 1);
+}
+
+std::vector<char> MakeAnimatedDocument(int count) {
+  std::string svg =
+      "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 512 512\">";
+  char buffer[640];
+  for (int i = 0; i < count; ++i) {
+    const int x = (i * 16) % 512;
+    const int y = (i / 32 * 16) % 512;
+    snprintf(buffer, sizeof(buffer),
+             "<rect x=\"%d\" y=\"%d\" width=\"12\" height=\"12\" "
+             "fill=\"#3366cc\">"
+             "<animate attributeName=\"x\" values=\"%d;%d;%d\" dur=\"2s\" "
+             "repeatCount=\"indefinite\"/>"
+             "<animate attributeName=\"width\" from=\"12\" to=\"4\" "
+             "dur=\"1.5s\" repeatCount=\"indefinite\"/>"
+             "<animate attributeName=\"fill\" values=\"#3366cc;#cc3366\" "
+             "dur=\"3s\" repeatCount=\"indefinite\"/>"
+             "<animate attributeName=\"opacity\" to=\"0.2\" dur=\"2.5s\" "
+             "repeatCount=\"indefinite\"/></rect>",
+             x, y, x, x + 4, x);
+    svg += buffer;
+  }
+  svg += "</svg>";
+  return std::vector<char>(svg.c_str(), svg.c_str() + svg.size() + 1);
+}
+
+std::vector<char> MakeCroppedDocument(int tiles) {
+  std::string svg =
+      "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 512 512\">";
+  char buffer[512];
+  for (int row = 0; row < tiles; ++row) {
+    snprintf(buffer, sizeof(buffer), "<g transform=\"translate(0 %d)\">",
+             row * 64);
+    svg += buffer;
+    for (int column = 0; column < tiles; ++column) {
+      snprintf(buffer, sizeof(buffer),
+               "<g transform=\"translate(%d 0)\" stroke=\"#222\">"
+               "<rect x=\"4\" y=\"4\" width=\"56\" height=\"56\" "
+               "fill=\"#e5e7eb\"/>"
+               "<circle cx=\"32\" cy=\"32\" r=\"20\" fill=\"#2563eb\"/>"
+               "<path d=\"M12 52 L32 12 L52 52 Z\" fill=\"none\"/></g>",
+               column * 64);
+      svg += buffer;
+    }
+    svg += "</g>";
+  }
+  svg +=
+      "<rect width=\"16\" height=\"16\" fill=\"#cc3366\">"
+      "<animate attributeName=\"x\" from=\"0\" to=\"496\" dur=\"2s\" "
+      "repeatCount=\"indefinite\"/></rect>";
+  svg += "</svg>";
+  return std::vector<char>(svg.c_str(), svg.c_str() + svg.size() + 1);
+}
+
+std::vector<char> MakeShapesDocument(int count) {
+  static const char* const kKinds[] = {"rect",    "circle",   "ellipse",
+                                       "line",    "polygon",  "polyline",
+                                       "path"};
+  std::string svg =
+      "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 512 512\">"
+      "<defs><clipPath id=\"clip\"><rect width=\"512\" height=\"512\"/>"
+      "</clipPath></defs>";
+  char buffer[256];
+  for (int i = 0; i < count; ++i) {
+    const int kind = i % 7;
+    if (kind == 0) {
+      svg += i > 0 ? "</g>" : "";
+      svg += "<g opacity=\"0.8\" clip-path=\"url(#clip)\">";
+    }
+    const int x = (i * 16) % 512;
+    const int y = (i / 32 * 16) % 512;
+    switch (kind) {
+      case 0:
+        snprintf(buffer, sizeof(buffer),
+                 "<rect x=\"%d\" y=\"%d\" width=\"12\" height=\"12\" "
+                 "rx=\"2\">",
+                 x, y);
+        break;
+      case 1:
+        snprintf(buffer, sizeof(buffer),
+                 "<circle cx=\"%d\" cy=\"%d\" r=\"6\">", x + 6, y + 6);
+        break;
+      case 2:
+        snprintf(buffer, sizeof(buffer),
+                 "<ellipse cx=\"%d\" cy=\"%d\" rx=\"6\" ry=\"4\">", x + 6,
+                 y + 6);
+        break;
+      case 3:
+        snprintf(buffer, sizeof(buffer),
+                 "<line x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\" "
+                 "stroke=\"#222\">",
+                 x, y, x + 12, y + 12);
+        break;
+      case 4:
+        snprintf(buffer, sizeof(buffer),
+                 "<polygon points=\"%d,%d %d,%d %d,%d\">", x, y + 12, x + 6,
+                 y, x + 12, y + 12);
+        break;
+      case 5:
+        snprintf(buffer, sizeof(buffer),
+                 "<polyline points=\"%d,%d %d,%d %d,%d\" stroke=\"#222\">",
+                 x, y, x + 6, y + 12, x + 12, y);
+        break;
+      default:
+        snprintf(buffer, sizeof(buffer),
+                 "<path d=\"M%d %d Q%d %d %d %d Z\">", x, y + 12, x + 6, y,
+                 x + 12, y + 12);
+        break;
+    }
+    svg += buffer;
+    svg +=
+        "<animate attributeName=\"fill\" values=\"#3366cc;#cc3366\" "
+        "dur=\"2s\" repeatCount=\"indefinite\"/></";
+    svg += kKinds[kind];
+    svg += ">";
+  }
+  svg += count > 0 ? "</g></svg>" : "</svg>";
+  return std::vector<char>(svg.c_str(), svg.c_str() + svg.size() + 1);
+}
+
+std::vector<char> MakeImageDocument(int count) {
+  std::string svg =
+      "<svg xmlns=\"http://www.w3.org/2000/svg\" "
+      "xmlns:xlink=\"http://www.w3.org/1999/xlink\" viewBox=\"0 0 512 512\">";
+  char buffer[256];
+  for (int i = 0; i < count; ++i) {
+    snprintf(buffer, sizeof(buffer),
+             "<image id=\"i%d\" x=\"%d\" y=\"%d\" width=\"16\" "
+             "height=\"16\" href=\"data:image/png;base64,",
+             i, (i * 16) % 512, (i / 32 * 16) % 512);
+    svg += buffer;
+    svg += EncodeBase64(MakePNGHeader(16 + i, 16));
+    snprintf(buffer, sizeof(buffer),
+             "\"/><use xlink:href=\"#i%d\" transform=\"translate(0 256)\"/>",
+             i);
+    svg += buffer;
+  }
+  svg += "</svg>";
+  return std::vector<char>(svg.c_str(), svg.c_str() + svg.size() + 1);
+}
+
+std::vector<char> MakeDocument(const std::string& body) {
+  const std::string svg =
+      "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 512 512\">" +
+      body + "</svg>";
+  return std::vector<char>(svg.c_str(), svg.c_str() + svg.size() + 1);
+}
+
+std::vector<char> MakeNodeBudgetDocument(const parser::SrSVGBudgets& budgets) {
+  std::string body;
+  for (uint32_t i = 0; i < budgets.max_nodes; ++i) {
+    body += "<g/>";
+  }
+  return MakeDocument(body);
+}
+
+std::vector<char> MakePathBudgetDocument(const parser::SrSVGBudgets& budgets) {
+  std::string body = "<path d=\"M0 0";
+  for (uint64_t i = 0; i < budgets.max_path_ops; ++i) {
+    body += "h1";
+  }
+  return MakeDocument(body + "\"/>");
+}
+
+std::vector<char> MakeAnimationBudgetDocument(
+    const parser::SrSVGBudgets& budgets) {
+  std::string body = "<rect width=\"8\" height=\"8\">";
+  for (uint32_t i = 0; i <= budgets.max_animations; ++i) {
+    body += "<set attributeName=\"x\" to=\"1\"/>";
+  }
+  return MakeDocument(body + "</rect>");
+}
+
+std::vector<char> MakeUseDepthDocument(const parser::SrSVGBudgets& budgets) {
+  std::string body = "<defs>";
+  for (uint32_t i = 0; i <= budgets.max_use_depth; ++i) {
+    body += "<g id=\"d" + std::to_string(i) + "\"><use href=\"#d" +
+            std::to_string(i + 1) + "\"/></g>";
+  }
+  body += "<rect id=\"d" + std::to_string(budgets.max_use_depth + 1) +
+          "\" width=\"8\" height=\"8\"/></defs><use href=\"#d0\"/>";
+  return MakeDocument(body);
+}
+
+std::vector<char> MakeUseFanOutDocument() {
+  std::string body = "<defs><rect id=\"f0\" width=\"8\" height=\"8\"/>";
+  for (int level = 1; level <= 10; ++level) {
+    body += "<g id=\"f" + std::to_string(level) + "\">";
+    for (int i = 0; i < 10; ++i) {
+      body += "<use href=\"#f" + std::to_string(level - 1) + "\"/>";
+    }
+    body += "</g>";
+  }
+  return MakeDocument(body + "</defs><use href=\"#f10\"/>");
+}
+
+std::vector<char> MakeLayerAreaDocument() {
+  std::string body =
+      "<filter id=\"blur\"><feGaussianBlur stdDeviation=\"2\"/></filter>";
+  for (int i = 0; i < 64; ++i) {
+    body += "<rect width=\"8\" height=\"8\" transform=\"scale(4096)\" "
+            "filter=\"url(#blur)\"/>";
+  }
+  return MakeDocument(body);
+}
+
+std::vector<std::vector<char>> MakeBlurDocuments() {
+  const std::string filters =
+      "<filter id=\"b\" x=\"-50%\" y=\"-50%\" width=\"200%\" "
+      "height=\"200%\"><feGaussianBlur stdDeviation=\"24\"/></filter>"
+      "<filter id=\"o\" x=\"-50%\" y=\"-50%\" width=\"200%\" "
+      "height=\"200%\"><feGaussianBlur stdDeviation=\"16\"/>"
+      "<feOffset dx=\"12\" dy=\"8\"/></filter>";
+  const std::string content =
+      "<rect x=\"40\" y=\"40\" width=\"160\" height=\"120\" "
+      "fill=\"#0080ff\"/><path d=\"M20 200 L240 200\" stroke=\"#ff4000\" "
+      "stroke-width=\"3\" vector-effect=\"non-scaling-stroke\"/>";
+  return {
+      MakeDocument(filters + "<g filter=\"url(#b)\">" + content + "</g>"),
+      MakeDocument(filters + "<g transform=\"translate(130 90)\" "
+                             "filter=\"url(#b)\">" +
+                   content + "</g>"),
+      MakeDocument(filters + "<g transform=\"translate(60 40) scale(1.5)\" "
+                             "filter=\"url(#o)\">" +
+                   content + "</g>"),
+      MakeDocument(filters + "<g transform=\"translate(100 100)\" "
+                             "filter=\"url(#b)\"><g filter=\"url(#o)\">" +
+                   content + "</g><circle cx=\"200\" cy=\"200\" r=\"60\" "
+                             "fill=\"#20a040\"/></g>"),
+  };
+}
+
+}  // namespace benchmark
+}  // namespace svg
+}  // namespace serval
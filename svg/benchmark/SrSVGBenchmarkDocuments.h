@@ -0,0 +1,66 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_BENCHMARK_SRSVGBENCHMARKDOCUMENTS_H_
+#define SVG_BENCHMARK_SRSVGBENCHMARKDOCUMENTS_H_
+
+#include <string>
+#include <vector>
+
+#include "parser/SrSVGDOM.h"
+
+// Generated documents of the benchmark. Each is returned nul-terminated, as
+// the parser expects, and drawn in a 512x512 view box.
+
+namespace serval {
+namespace svg {
+namespace benchmark {
+
+// Wraps |body| in an <svg> element.
+std::vector<char> MakeDocument(const std::string& body);
+
+// Animations chained through syncbase begins; the document's timeline ends
+// after |length| seconds.
+std::vector<char> MakeChainedDocument(int length);
+
+// |count| rects whose position, size, fill and opacity are animated.
+std::vector<char> MakeAnimatedDocument(int count);
+
+// Rows of tiles, 64 units apart, each a group of a few shapes, under a rect
+// moving across the view box.
+std::vector<char> MakeCroppedDocument(int tiles);
+
+// Groups of seven shapes, one of each basic kind, 16 units apart.
+std::vector<char> MakeShapesDocument(int count);
+
+// |count| images with distinct inline payloads, each drawn twice through
+// <use> so repeated draws of one payload are measured as well.
+std::vector<char> MakeImageDocument(int count);
+
+// Element count one past the node budget, counting the root.
+std::vector<char> MakeNodeBudgetDocument(const parser::SrSVGBudgets& budgets);
+
+std::vector<char> MakePathBudgetDocument(const parser::SrSVGBudgets& budgets);
+
+std::vector<char> MakeAnimationBudgetDocument(
+    const parser::SrSVGBudgets& budgets);
+
+// A chain of distinct <use> references one level deeper than the budget.
+std::vector<char> MakeUseDepthDocument(const parser::SrSVGBudgets& budgets);
+
+// Ten levels of ten <use> each, which expands to 10^10 rects unbounded.
+std::vector<char> MakeUseFanOutDocument();
+
+// Blurred rects scaled far past the viewport, each a huge filter layer.
+std::vector<char> MakeLayerAreaDocument();
+
+// Blurs large enough for reduced layers, drawn in translated, scaled and
+// nested groups, with a non-scaling stroke inside the blurred content.
+std::vector<std::vector<char>> MakeBlurDocuments();
+
+}  // namespace benchmark
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_BENCHMARK_SRSVGBENCHMARKDOCUMENTS_H_
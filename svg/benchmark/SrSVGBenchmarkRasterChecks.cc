@@ -0,0 +1,121 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <utility>
+
+#include "benchmark/SrSVGBenchmarkChecks.h"
+#include "benchmark/SrSVGBenchmarkDocuments.h"
+#include "platform/skity/SrSkityRasterTarget.h"
+
+namespace serval {
+namespace svg {
+namespace benchmark {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// Reduced filter layers widen a blur slightly and resample its source; see
+// kSrFilterMinReducedBlurSigma.
+constexpr int kMaxFilterLevelDifference = 2;
+
+// Rasterizes |content| into |pixels| through a skity software canvas.
+bool RasterizeWithSkity(const std::vector<char>& content,
+                        bool reduced_resolution_filters,
+                        const Options& options, std::vector<uint8_t>* pixels) {
+  auto dom = parser::SrSVGDOM::make(content.data(), content.size(), nullptr);
+  auto target = skity::SrSkityRasterTarget::Make(
+      static_cast<uint32_t>(options.width),
+      static_cast<uint32_t>(options.height), nullptr, nullptr);
+  if (!dom || !target) {
+    return false;
+  }
+  auto* canvas = static_cast<skity::SrSkityCanvas*>(target->Canvas());
+  canvas->SetReducedResolutionFilters(reduced_resolution_filters);
+  dom->Render(canvas, SrSVGBox{0.f, 0.f, options.width, options.height});
+  return target->ReadPixels(pixels);
+}
+
+bool RunFilterScaleChecks(const std::vector<std::string>& files,
+                          const Options& options) {
+  std::vector<std::pair<std::string, std::vector<char>>> documents;
+  for (auto& content : MakeBlurDocuments()) {
+    documents.emplace_back("blur-" + std::to_string(documents.size()) + ".svg",
+                           std::move(content));
+  }
+  for (const auto& file : files) {
+    std::string name = fs::path(file).filename().string();
+    std::vector<char> content;
+    if (name.rfind("filter-", 0) == 0 && ReadFile(file, &content)) {
+      documents.emplace_back(std::move(name), std::move(content));
+    }
+  }
+  bool passed = true;
+  for (const auto& [name, content] : documents) {
+    std::vector<uint8_t> reduced;
+    std::vector<uint8_t> full;
+    if (!RasterizeWithSkity(content, true, options, &reduced) ||
+        !RasterizeWithSkity(content, false, options, &full) ||
+        reduced.size() != full.size()) {
+      printf("%-48s not rasterized\n", name.c_str());
+      passed = false;
+      continue;
+    }
+    int max_difference = 0;
+    for (size_t byte = 0; byte < full.size(); ++byte) {
+      max_difference = std::max(max_difference,
+                                std::abs(static_cast<int>(reduced[byte]) -
+                                         static_cast<int>(full[byte])));
+    }
+    const bool ok = max_difference <= kMaxFilterLevelDifference;
+    printf("%-48s %6d levels from full resolution %s\n", name.c_str(),
+           max_difference, ok ? "ok" : "differs");
+    passed &= ok;
+  }
+  return passed;
+}
+
+bool RunBatchPixelChecks(const std::vector<std::string>& files,
+                         const Options& options) {
+  std::vector<std::vector<char>> contents;
+  const auto jobs = MakeBatchJobs(files, options, &contents);
+  if (jobs.empty()) {
+    fprintf(stderr, "no svg files found\n");
+    return false;
+  }
+  auto factory = skity::SrSkityRasterTarget::Factory(nullptr, nullptr);
+  const renderer::SrSVGBatchRenderer sequential(factory, 1);
+  const renderer::SrSVGBatchRenderer parallel(factory);
+  const auto expected = sequential.Render(jobs);
+  // Twice, so the second batch runs on threads kept from the first.
+  bool passed = true;
+  for (int round = 0; round < 2; ++round) {
+    const auto results = parallel.Render(jobs);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      if (!SameRaster(results[i], expected[i])) {
+        printf("job %zu (%.0fx%.0f @%.0fx) differs in pixels\n", i,
+               jobs[i].width, jobs[i].height, jobs[i].scale);
+        passed = false;
+      }
+    }
+  }
+  printf("%zu jobs on %u workers: %s\n", jobs.size(), parallel.max_workers(),
+         passed ? "pixels match" : "pixels differ");
+  return passed;
+}
+
+}  // namespace
+
+bool RunRasterChecks(const std::vector<std::string>& files,
+                     const Options& options) {
+  const bool filters_passed = RunFilterScaleChecks(files, options);
+  return RunBatchPixelChecks(files, options) && filters_passed;
+}
+
+}  // namespace benchmark
+}  // namespace svg
+}  // namespace serval
@@ -475,6 +475,33 @@ public class ExampleInstrumentedTest {
     }
   }
 
+  @Test
+  public void opacityGroupPolyline_isPaintedInsideItsLayer()
+      throws IOException {
+    Context appContext =
+        InstrumentationRegistry.getInstrumentation().getTargetContext();
+    String content =
+        readAssetFile(appContext, "svg/opacity-group-polyline.svg");
+    SVGRender render = new SVGRender();
+    Rect viewPort = new Rect(0, 0, 320, 180);
+
+    try (SVGRender.SVGSession session = render.createSession(content)) {
+      assertTrue("polyline session should be valid", session.isValid());
+      Bitmap frame = renderFrame(session, viewPort, 0.0);
+
+      assertForeground("polyline alone in a group should be painted", frame,
+                       55, 40);
+      assertForeground("polyline corner should be inside the group layer",
+                       frame, 90, 95);
+      assertForeground("polyline past its sibling should not be clipped",
+                       frame, 290, 140);
+      assertForeground("transformed polyline should be painted", frame, 55,
+                       140);
+      assertBackground("group layer should not paint outside the polyline",
+                       frame, 55, 70);
+    }
+  }
+
   private static Bitmap renderFrame(SVGRender.SVGSession session, Rect viewPort,
                                     double seconds) {
     Bitmap bitmap = Bitmap.createBitmap(viewPort.width(), viewPort.height(),
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -120,6 +121,100 @@ inline bool SrSupportsLinearSourceGraphicFilterModel(
   return true;
 }
 
+// Conservative extent of a linear SourceGraphic filter chain applied to content
+// covering |source|. Blurs spread by three standard deviations, offsets shift
+// the content, and a color matrix that adds alpha covers the whole region.
+inline SrSVGBox SrFilterModelOutputBounds(const SrFilterModel& filter,
+                                          const SrSVGBox& source) {
+  float left = source.left;
+  float top = source.top;
+  float right = source.left + source.width;
+  float bottom = source.top + source.height;
+  for (const auto& primitive : filter.primitives) {
+    switch (primitive.type) {
+      case SrFilterPrimitiveType::kGaussianBlur: {
+        const float spread_x = std::fabs(primitive.std_deviation_x) * 3.f;
+        const float spread_y = std::fabs(primitive.std_deviation_y) * 3.f;
+        left -= spread_x;
+        right += spread_x;
+        top -= spread_y;
+        bottom += spread_y;
+        break;
+      }
+      case SrFilterPrimitiveType::kOffset:
+        left += primitive.dx;
+        right += primitive.dx;
+        top += primitive.dy;
+        bottom += primitive.dy;
+        break;
+      case SrFilterPrimitiveType::kColorMatrix:
+        if (primitive.color_matrix_values.size() == 20 &&
+            primitive.color_matrix_values[19] > 0.f) {
+          return filter.region;
+        }
+        break;
+      case SrFilterPrimitiveType::kComposite:
+      case SrFilterPrimitiveType::kBlend:
+      case SrFilterPrimitiveType::kFlood:
+        return filter.region;
+    }
+  }
+  return SrSVGBox{left, top, right - left, bottom - top};
+}
+
+// A filter layer whose chain ends in a blur of at least this many device
+// pixels (times the downscale factor k) is rendered at 1/k resolution and
+// upscaled. The box downsample and bilinear upsample widen the blur by about
+// k/2 pixels in quadrature, so the blur gets under 1% wider and a blurred
+// edge moves by less than one 8-bit level.
+inline constexpr float kSrFilterMinReducedBlurSigma = 4.f;
+inline constexpr float kSrFilterMinLayerScale = 0.25f;
+
+// Resolution scale for the layer of a linear filter chain drawn under the
+// user-to-device |transform|: 1, or a power of two down to
+// kSrFilterMinLayerScale.
+inline float SrFilterLayerResolutionScale(const SrFilterModel& filter,
+                                          const float (&transform)[6]) {
+  // Blurs compose by adding variances. A color matrix after a blur can
+  // sharpen it again (alpha thresholding), so only later blurs count.
+  float variance_x = 0.f;
+  float variance_y = 0.f;
+  for (const auto& primitive : filter.primitives) {
+    switch (primitive.type) {
+      case SrFilterPrimitiveType::kGaussianBlur:
+        variance_x += primitive.std_deviation_x * primitive.std_deviation_x;
+        variance_y += primitive.std_deviation_y * primitive.std_deviation_y;
+        break;
+      case SrFilterPrimitiveType::kOffset:
+        break;
+      case SrFilterPrimitiveType::kColorMatrix:
+        variance_x = 0.f;
+        variance_y = 0.f;
+        break;
+      case SrFilterPrimitiveType::kComposite:
+      case SrFilterPrimitiveType::kBlend:
+      case SrFilterPrimitiveType::kFlood:
+        return 1.f;
+    }
+  }
+  // The smallest singular value of the linear part is the least a user unit
+  // is stretched in any direction.
+  const float a = transform[0], b = transform[1];
+  const float c = transform[2], d = transform[3];
+  const float sum = a * a + b * b + c * c + d * d;
+  const float det = a * d - b * c;
+  const float spread = std::sqrt(std::max(0.f, sum * sum - 4.f * det * det));
+  const float min_stretch = std::sqrt(std::max(0.f, 0.5f * (sum - spread)));
+  const float sigma =
+      std::sqrt(std::min(variance_x, variance_y)) * min_stretch;
+  float scale = 1.f;
+  while (scale * 0.5f >= kSrFilterMinLayerScale &&
+         sigma * scale * 0.5f >= kSrFilterMinReducedBlurSigma) {
+    scale *= 0.5f;
+  }
+  return scale;
+}
+
 class Path {
  public:
   Path() = default;
@@ -158,6 +253,10 @@ class PathFactory {
                                                  SrSVGStrokeCap cap,
                                                  SrSVGStrokeJoin join,
                                                  float miter_limit) = 0;
+  // Hands back a path this factory created once the caller is done with it.
+  // Factories may keep it to back a later Create*() call instead of
+  // allocating new path storage; the default frees it.
+  virtual void Recycle(std::unique_ptr<Path> path) {}
 };
 
 class GradientModel {
@@ -219,6 +318,19 @@ class RadialGradientModel : public GradientModel {
   float fy_{0.f};
 };
 
+// Bitmap decoded by a platform canvas. Shared through SrImageCache by every
+// render of the same href, so it must not depend on the drawing canvas.
+class SrDecodedImage {
+ public:
+  virtual ~SrDecodedImage() = default;
+  virtual float Width() const = 0;
+  virtual float Height() const = 0;
+  // Memory charged against the image cache budget.
+  virtual size_t ByteSize() const = 0;
+};
+
+class SrImageCache;
+
 class SrCanvas {
  public:
   virtual ~SrCanvas() = default;
@@ -256,11 +368,46 @@ class SrCanvas {
                          float height,
                          const SrSVGPreserveAspectRatio& preserve_aspect_radio,
                          float opacity = 1.f) = 0;
+  // Canvases returning a cache get images through LoadImage() and
+  // DecodeImage() once per href, and draw them with DrawDecodedImage().
+  // Without a cache every draw goes through DrawImage().
+  virtual SrImageCache* ImageCache() { return nullptr; }
+  // Image at |href| from the host, or null if it is not available yet.
+  virtual std::shared_ptr<SrDecodedImage> LoadImage(const char* href) {
+    (void)href;
+    return nullptr;
+  }
+  // Image from encoded bytes, such as the payload of a data: URI.
+  virtual std::shared_ptr<SrDecodedImage> DecodeImage(const uint8_t* data,
+                                                      size_t size) {
+    (void)data;
+    (void)size;
+    return nullptr;
+  }
+  virtual void DrawDecodedImage(
+      const SrDecodedImage& image, float x, float y, float width, float height,
+      const SrSVGPreserveAspectRatio& preserve_aspect_radio,
+      float opacity = 1.f) {}
   virtual void Translate(float x, float y) = 0;
   virtual void Transform(const float (&form)[6]) = 0;
   virtual void ClipPath(Path*, SrSVGFillRule clip_rule) = 0;
   virtual void Save() = 0;
   virtual void Restore() = 0;
+  // Current user-to-device transform, used to charge layers to the layer
+  // area budget. Canvases that do not track it return false and layers are
+  // charged in user units.
+  virtual bool GetTotalTransform(float (&xform)[6]) const {
+    (void)xform;
+    return false;
+  }
+  // Conservative bounds of the current clip in the current user space, wide
+  // enough to cover antialiased edges. Containers skip children that fall
+  // outside of it; canvases that do not track their clip return false and
+  // every child is rendered.
+  virtual bool GetLocalClipBounds(SrSVGBox* bounds) const {
+    (void)bounds;
+    return false;
+  }
   virtual bool SupportsFilters() const { return false; }
   virtual void SaveLayer(const SrSVGBox* bounds = nullptr) {
     (void)bounds;
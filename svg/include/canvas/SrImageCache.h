@@ -0,0 +1,59 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_CANVAS_SRIMAGECACHE_H_
+#define SVG_INCLUDE_CANVAS_SRIMAGECACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "canvas/SrCanvas.h"
+#include "utils/SrLRUCache.h"
+
+namespace serval {
+namespace svg {
+namespace canvas {
+
+using SrImageCacheStats = SrLRUCacheStats;
+
+// Size-bounded, thread-safe cache of decoded images keyed by href, owned by
+// a platform canvas type. Images are evicted least recently used first;
+// evicted images stay alive while a draw still holds them.
+//
+// A data: URI names its own pixels, but what another href names is up to
+// the host behind each canvas. Such images are only cached if
+// |cache_host_images| is set, which suits canvases sharing one host.
+class SrImageCache {
+ public:
+  static constexpr size_t kDefaultCapacityBytes = 16 * 1024 * 1024;
+  using Loader = std::function<std::shared_ptr<SrDecodedImage>()>;
+
+  explicit SrImageCache(size_t capacity_bytes = kDefaultCapacityBytes,
+                        bool cache_host_images = false);
+  SrImageCache(const SrImageCache&) = delete;
+  SrImageCache& operator=(const SrImageCache&) = delete;
+
+  // Returns the image cached for |href|, calling |load| only on a miss. Null
+  // results are not cached, so an image the host is still loading is asked
+  // for again on the next draw.
+  std::shared_ptr<SrDecodedImage> Acquire(const std::string& href,
+                                          const Loader& load);
+
+  void SetCapacity(size_t capacity_bytes);
+  void Clear();
+  SrImageCacheStats stats() const;
+  bool cache_host_images() const { return cache_host_images_; }
+
+ private:
+  SrLRUCache<std::shared_ptr<SrDecodedImage>> images_;
+  const bool cache_host_images_;
+};
+
+}  // namespace canvas
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_CANVAS_SRIMAGECACHE_H_
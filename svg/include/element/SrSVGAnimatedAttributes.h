@@ -0,0 +1,117 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_ELEMENT_SRSVGANIMATEDATTRIBUTES_H_
+#define SVG_INCLUDE_ELEMENT_SRSVGANIMATEDATTRIBUTES_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "element/SrSVGTypes.h"
+
+namespace serval {
+namespace svg {
+namespace element {
+
+class SrSVGAnimation;
+class SrSVGNodeBase;
+
+using IDMapper = std::unordered_map<std::string, SrSVGNodeBase*>;
+
+// Value of a numeric or color attribute as an animation produces it. A
+// number keeps the unit its suffix names, so values in different units are
+// never added or interpolated, as with their text.
+struct SrSVGAnimatedValue {
+  enum class Kind : uint8_t {
+    kNone,
+    kNumber,
+    kColor,
+  };
+  Kind kind{Kind::kNone};
+  double number{0.0};
+  SrSVGUnits unit{SR_SVG_UNITS_NUMBER};
+  // Packed like parse_svg_color().
+  uint32_t color{0};
+};
+
+// Storage of an attribute that animations may write as a typed value.
+// Exactly one member is set; an empty field leaves the attribute to its
+// text form.
+struct SrSVGAnimatedField {
+  SrSVGLength* length{nullptr};
+  std::optional<SrSVGLength>* optional_length{nullptr};
+  float* number{nullptr};
+  std::optional<float>* optional_number{nullptr};
+  SrSVGColor* color{nullptr};
+  std::optional<SrSVGColor>* optional_color{nullptr};
+  SrSVGPaint** paint{nullptr};
+
+  SrSVGAnimatedValue::Kind Kind() const;
+};
+
+// Base values and per-frame state of the attributes an element animates.
+// Every targeted attribute gets one slot on the first frame, so frames do
+// not look attributes up by name or build presentation values. Attributes
+// with a typed field, whose animations all have typed keyframes, are
+// written and restored in place without text; the others are applied as
+// text and restored by parsing their base value.
+class SrSVGAnimatedAttributes {
+ public:
+  void StoreBaseValue(const char* name, const char* value);
+  void AddAnimation(SrSVGAnimation* animation);
+  const std::vector<SrSVGAnimation*>& animations() const {
+    return animations_;
+  }
+  void Apply(SrSVGNodeBase* node, double seconds, const IDMapper* id_mapper);
+  void Restore(SrSVGNodeBase* node);
+
+ private:
+  struct Slot {
+    std::string name;
+    // Points into base_values_; null when the source leaves it unset.
+    const std::string* base{nullptr};
+    std::string presentation;
+    SrSVGAnimatedField field;
+    SrSVGAnimatedValue base_value;
+    SrSVGAnimatedValue value;
+    bool typed{false};
+    bool applied{false};
+    // Field content before the frame's first write.
+    SrSVGLength saved_length{};
+    std::optional<SrSVGLength> saved_optional_length;
+    float saved_number{0.f};
+    std::optional<float> saved_optional_number;
+    SrSVGColor saved_color{};
+    std::optional<SrSVGColor> saved_optional_color;
+    SrSVGPaint* saved_paint{nullptr};
+    // Installed in place of the paint while the frame is animated.
+    SrSVGPaint paint{};
+  };
+
+  void BuildSlots(SrSVGNodeBase* node);
+  void ApplyTyped(Slot* slot, const SrSVGAnimation& animation, double seconds,
+                  const IDMapper* id_mapper);
+  void ApplyText(SrSVGNodeBase* node, Slot* slot,
+                 const SrSVGAnimation& animation, double seconds,
+                 const IDMapper* id_mapper);
+  static void SaveField(Slot* slot);
+  static void WriteField(Slot* slot);
+  static void RestoreField(Slot* slot);
+
+  std::unordered_map<std::string, std::string> base_values_;
+  std::vector<SrSVGAnimation*> animations_;
+  std::vector<Slot> slots_;
+  // Slot of each animation, or -1 when it targets no attribute.
+  std::vector<int32_t> animation_slots_;
+  bool slots_built_{false};
+};
+
+}  // namespace element
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_ELEMENT_SRSVGANIMATEDATTRIBUTES_H_
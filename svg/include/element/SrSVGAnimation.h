@@ -35,6 +35,13 @@ struct SrSVGPathPairCache {
   bool compatible{false};
 };
 
+// Window in which an animation can affect its target. |end| is infinite for
+// frozen and indefinite animations.
+struct SrSVGAnimationInterval {
+  double begin{0.0};
+  double end{0.0};
+};
+
 class SrSVGAnimation final : public SrSVGNodeBase {
  public:
   struct Effect {
@@ -70,7 +77,32 @@ class SrSVGAnimation final : public SrSVGNodeBase {
   void AppendChild(SrSVGNodeBase* child) override;
   bool Evaluate(double seconds, const IDMapper* id_mapper,
                 const std::string& underlying, Effect* effect) const;
+  // Parses a typed keyframe: a color parse_svg_color() accepts as written,
+  // or a number whose suffix is empty or a known unit.
+  static bool ParseAnimatedValue(const std::string& text,
+                                 SrSVGAnimatedValue* value);
+  // Kind of the keyframes EvaluateTyped() interpolates, or kNone when only
+  // Evaluate() applies: transforms, motion, set, path data, number lists,
+  // accumulation and keyframes in any other syntax.
+  SrSVGAnimatedValue::Kind TypedKind() const;
+  // Typed counterpart of Evaluate(), with the same timing and keyframe
+  // selection. A to animation starts from |underlying|, or from its to value
+  // when |underlying| is kNone.
+  bool EvaluateTyped(double seconds, const IDMapper* id_mapper,
+                     const SrSVGAnimatedValue& underlying,
+                     SrSVGAnimatedValue* value, bool* additive) const;
   double LastChangeSeconds(const IDMapper* id_mapper) const;
+  // Resolves begin and end times and the accepted intervals once, so frames
+  // do not walk syncbase references again. Animations this one begins or ends
+  // relative to should be resolved first; see SrSVGAnimationTimeline.
+  void ResolveTimeline(const IDMapper* id_mapper);
+  void InvalidateTimeline() { timeline_ = ResolvedTimeline{}; }
+  // Ids of the animations referenced by syncbase begin and end values.
+  void AppendSyncDependencies(std::vector<std::string>* ids) const;
+  // Superset of the times at which Evaluate() can produce an effect. Requires
+  // ResolveTimeline().
+  void AppendEffectIntervals(
+      std::vector<SrSVGAnimationInterval>* intervals) const;
   const std::string& TargetHref() const { return target_href_; }
   std::string TargetAttributeName() const {
     if (Tag() == SrSVGTag::kAnimateMotion) {
@@ -105,6 +137,27 @@ class SrSVGAnimation final : public SrSVGNodeBase {
     std::string sync_id;
     double offset{0.0};
   };
+  struct AcceptedInterval {
+    double begin{0.0};
+    double duration{0.0};
+  };
+  struct TypedKeyframes {
+    bool parsed{false};
+    std::vector<SrSVGAnimatedValue> values;
+    std::vector<double> key_times;
+    std::string calc_mode;
+    // The first keyframe is replaced by the underlying value.
+    bool from_underlying{false};
+    bool additive{false};
+  };
+  struct ResolvedTimeline {
+    bool resolved{false};
+    std::vector<double> begins;
+    std::vector<double> ends;
+    // Intervals that survive restart rules, in begin order.
+    std::vector<AcceptedInterval> intervals;
+    double last_change{0.0};
+  };
 
   std::string MakeValue(const ActiveState& state,
                         const std::string& underlying) const;
@@ -114,6 +167,7 @@ class SrSVGAnimation final : public SrSVGNodeBase {
   bool ActiveStateAt(double seconds, const IDMapper* id_mapper,
                      ActiveState* state) const;
   void ResetCaches() const;
+  const TypedKeyframes& EnsureTypedKeyframes() const;
   void ResetMotionPathCache() const;
   void ResetPathDataCaches() const;
   bool EnsureMotionPathCacheForPathString(const std::string& path) const;
@@ -176,9 +230,11 @@ class SrSVGAnimation final : public SrSVGNodeBase {
   bool accumulate_sum_{false};
   Restart restart_{Restart::kAlways};
   std::vector<BeginSpec> end_specs_;
+  ResolvedTimeline timeline_;
   mutable SrSVGMotionPathCache motion_path_cache_;
   mutable std::vector<SrSVGPathPairCache> path_pair_caches_;
   mutable SrPathData* interpolated_path_cache_{nullptr};
+  mutable TypedKeyframes typed_keyframes_;
 };
 
 }  // namespace element
@@ -0,0 +1,66 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_ELEMENT_SRSVGANIMATIONTIMELINE_H_
+#define SVG_INCLUDE_ELEMENT_SRSVGANIMATIONTIMELINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+#include "element/SrSVGAnimation.h"
+
+namespace serval {
+namespace svg {
+namespace element {
+
+// Resolved SMIL timeline of a document. Build() resolves every animation in
+// syncbase dependency order, so `begin="a.end"` chains are walked once, and
+// indexes the intervals in which each animated node can change. Queries for
+// the nodes to animate at a time cost O(log n + k).
+class SrSVGAnimationTimeline {
+ public:
+  // |animated_nodes| are the nodes that own animations; query results are
+  // indices into it. |nodes| is every node of the document.
+  void Build(const std::vector<SrSVGNodeBase*>& animated_nodes,
+             const std::list<SrSVGNodeBase*>& nodes,
+             const IDMapper* id_mapper);
+  void Clear();
+
+  // Latest time at which any animation changes, infinite if one never
+  // settles.
+  double EndSeconds() const { return end_seconds_; }
+  // Animations in the order they were resolved; an animation comes after
+  // those its begin and end values refer to, except within cycles.
+  const std::vector<SrSVGAnimation*>& DependencyOrder() const {
+    return dependency_order_;
+  }
+  // Indices of the animated nodes with an animation that may be active or
+  // frozen at |seconds|, ascending.
+  void CollectActiveNodes(double seconds, std::vector<uint32_t>* out) const;
+
+ private:
+  struct Entry {
+    double begin;
+    double end;
+    uint32_t node;
+  };
+
+  void CollectActive(size_t lo, size_t hi, double seconds,
+                     std::vector<uint32_t>* out) const;
+
+  std::vector<SrSVGAnimation*> dependency_order_;
+  // Sorted by begin; |max_end_| holds the largest end in the implicit
+  // subtree rooted at each entry.
+  std::vector<Entry> entries_;
+  std::vector<double> max_end_;
+  double end_seconds_{0.0};
+};
+
+}  // namespace element
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_ELEMENT_SRSVGANIMATIONTIMELINE_H_
@@ -18,6 +18,7 @@ class SrSVGCircle : public SrSVGShape {
  public:
   static SrSVGCircle* Make() { return new SrSVGCircle(); }
   bool ParseAndSetAttribute(const char* name, const char* value) override;
+  SrSVGAnimatedField AnimatedField(const char* name) override;
 
  protected:
   void onDraw(canvas::SrCanvas* canvas,
@@ -25,6 +26,8 @@ class SrSVGCircle : public SrSVGShape {
   std::unique_ptr<canvas::Path> AsPath(
       canvas::PathFactory* path_factory, SrSVGRenderContext* context,
       bool include_transform = true) const override;
+  bool GeometryBounds(SrSVGRenderContext* context,
+                      SrSVGBox* bounds) const override;
 
  private:
   SrSVGCircle() : SrSVGShape(SrSVGTag::kCircle) {}
@@ -6,7 +6,9 @@
 #define SVG_INCLUDE_ELEMENT_SRSVGCONTAINER_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "SrSVGNode.h"
@@ -38,11 +40,31 @@ class SrSVGContainer : public SrSVGNode {
   explicit SrSVGContainer(SrSVGTag t) : SrSVGNode(t){};
   ~SrSVGContainer() override;
   void OnRender(canvas::SrCanvas*, SrSVGRenderContext&) override;
+  bool OnComputeRenderBounds(canvas::SrCanvas* canvas,
+                             SrSVGRenderContext& context,
+                             SrSVGBox* bounds) override;
+  // Union of the children render bounds in this container's local space.
+  bool ComputeChildrenBounds(canvas::SrCanvas* canvas,
+                             SrSVGRenderContext& context, SrSVGBox* bounds);
   [[nodiscard]] bool HasChildren() const final;
   void RenderChild(canvas::SrCanvas* canvas, SrSVGRenderContext& context,
                    SrSVGNodeBase* child);
   bool PrepareChild(SrSVGNodeBase* child);
   void RestoreChild(SrSVGNodeBase* child);
+  // Render bounds of the child at |index|; cached across renders when
+  // |use_cache| is set and the child's subtree only holds shapes and groups.
+  bool ChildRenderBounds(canvas::SrCanvas* canvas, SrSVGRenderContext& context,
+                         size_t index, bool use_cache, SrSVGBox* bounds);
+  // False when the child at |index| provably paints nothing inside
+  // |clip_bounds|, or nothing at all when |clip_bounds| is null. Sets
+  // |inside_clip| when everything it paints is inside |clip_bounds|.
+  bool IsChildVisible(canvas::SrCanvas* canvas, SrSVGRenderContext& context,
+                      size_t index, const SrSVGBox* clip_bounds,
+                      bool* inside_clip);
+  // Whether cached child bounds apply to this render, dropping them when
+  // their inputs have changed.
+  bool UseChildBoundsCache(canvas::SrCanvas* canvas,
+                           const SrSVGRenderContext& context);
 
  protected:
   std::vector<SrSVGNodeBase*> children_;
@@ -59,6 +81,50 @@ class SrSVGContainer : public SrSVGNode {
     std::optional<SrSVGColor> color;
   };
   std::vector<ChildRenderState> child_render_state_stack_;
+
+  // Everything besides the static tree that the children's render bounds
+  // depend on: the render context and the state PrepareChild() passes down.
+  struct ChildBoundsKey {
+    float width{0.f};
+    float height{0.f};
+    float dpi{0.f};
+    float font_size{0.f};
+    const void* id_mapper{nullptr};
+    SrSVGBox view_port{0.f, 0.f, 0.f, 0.f};
+    SrSVGBox view_box{0.f, 0.f, 0.f, 0.f};
+    const SrSVGPaint* fill_paint{nullptr};
+    const SrSVGPaint* stroke_paint{nullptr};
+    SrSVGPaintType fill_paint_type{SERVAL_PAINT_NONE};
+    SrSVGPaintType stroke_paint_type{SERVAL_PAINT_NONE};
+    const SrSVGPaint* mask{nullptr};
+    std::optional<SrSVGLength> stroke_width;
+    std::optional<float> fill_opacity;
+    std::optional<float> stroke_opacity;
+    bool supports_filters{false};
+
+    bool operator==(const ChildBoundsKey& other) const;
+  };
+  enum class ChildBoundsState : uint8_t {
+    kUnknown,
+    kBounded,
+    kUnbounded,
+  };
+  struct ChildBounds {
+    SrSVGBox bounds{0.f, 0.f, 0.f, 0.f};
+    ChildBoundsState state{ChildBoundsState::kUnknown};
+  };
+  ChildBoundsKey MakeChildBoundsKey(canvas::SrCanvas* canvas,
+                                    const SrSVGRenderContext& context) const;
+
+  // Per child, whether its bounds are fully determined by the key. Computed
+  // once; the tree and its animations do not change after the build.
+  std::vector<uint8_t> cacheable_children_;
+  bool cacheable_children_built_{false};
+  std::optional<ChildBoundsKey> child_bounds_key_;
+  std::vector<ChildBounds> child_bounds_;
+  // Set by the parent while this group renders entirely inside the clip,
+  // where testing its children would at most find the empty ones.
+  bool children_inside_clip_{false};
 };
 
 }  // namespace element
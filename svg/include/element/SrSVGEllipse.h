@@ -24,9 +24,12 @@ class SrSVGEllipse : public SrSVGShape {
   std::unique_ptr<canvas::Path> AsPath(
       canvas::PathFactory* path_factory, SrSVGRenderContext* context,
       bool include_transform = true) const override;
+  bool GeometryBounds(SrSVGRenderContext* context,
+                      SrSVGBox* bounds) const override;
 
  public:
   bool ParseAndSetAttribute(const char* name, const char* value) override;
+  SrSVGAnimatedField AnimatedField(const char* name) override;
 
  private:
   SrSVGEllipse() : SrSVGShape(SrSVGTag::kEllipse) {}
@@ -9,6 +9,7 @@
 #include <optional>
 #include <string>
 
+#include "canvas/SrImageCache.h"
 #include "element/SrSVGShape.h"
 
 namespace serval {
@@ -33,12 +34,19 @@ class SrSVGImage : public SrSVGShape {
   SrSVGImage()
       : SrSVGShape(SrSVGTag::kImage),
         preserve_aspect_radio_(make_default_preserve_aspect_radio()) {}
+  std::shared_ptr<canvas::SrDecodedImage> AcquireImage(
+      canvas::SrCanvas* canvas, canvas::SrImageCache* image_cache) const;
 
   std::string href_;
   SrSVGLength x_{0}, y_{0};
   std::optional<SrSVGLength> width_;
   std::optional<SrSVGLength> height_;
   SrSVGPreserveAspectRatio preserve_aspect_radio_;
+  // Image last drawn from |image_cache_|, looked up again only once the cache
+  // has dropped it. A data: URI that fails to decode is not retried.
+  mutable std::weak_ptr<canvas::SrDecodedImage> image_;
+  mutable const canvas::SrImageCache* image_cache_{nullptr};
+  mutable bool image_decode_failed_{false};
 };
 
 }  // namespace element
@@ -19,9 +19,12 @@ class SrSVGLine : public SrSVGShape {
  public:
   static SrSVGLine* Make() { return new SrSVGLine(); }
   bool ParseAndSetAttribute(const char* name, const char* value) override;
+  SrSVGAnimatedField AnimatedField(const char* name) override;
   std::unique_ptr<canvas::Path> AsPath(
       canvas::PathFactory* path_factory, SrSVGRenderContext* context,
       bool include_transform = true) const override;
+  bool GeometryBounds(SrSVGRenderContext* context,
+                      SrSVGBox* bounds) const override;
 
  protected:
   void onDraw(canvas::SrCanvas* canvas,
@@ -17,19 +17,14 @@ class SrSVGLinearGradient : public SrSVGContainer {
  public:
   static SrSVGLinearGradient* Make() { return new SrSVGLinearGradient(); }
   bool ParseAndSetAttribute(const char* name, const char* value) override;
+  const char* DefaultAttributeValue(const char* name) const override;
   void OnRender(canvas::SrCanvas*, SrSVGRenderContext&) override;
   SrSVGObjectBoundingBoxUnitType gradient_units() const {
     return gradient_units_;
   }
 
  private:
-  SrSVGLinearGradient() : SrSVGContainer(SrSVGTag::kLinearGradient) {
-    StoreAttribute("x1", "0");
-    StoreAttribute("y1", "0");
-    StoreAttribute("x2", "1");
-    StoreAttribute("y2", "0");
-    StoreAttribute("gradientTransform", "matrix(1 0 0 1 0 0)");
-  }
+  SrSVGLinearGradient() : SrSVGContainer(SrSVGTag::kLinearGradient) {}
   float gradient_transform_[6]{1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
   SrSVGObjectBoundingBoxUnitType gradient_units_{
       SR_SVG_OBB_UNIT_TYPE_OBJECT_BOUNDING_BOX};
@@ -13,6 +13,7 @@
 
 #include "SrSVGTypes.h"
 #include "canvas/SrCanvas.h"
+#include "element/SrSVGAnimatedAttributes.h"
 
 namespace serval::svg {
 
@@ -25,8 +26,6 @@ namespace element {
 class SrSVGAnimation;
 class SrSVGNodeBase;
 
-using IDMapper = std::unordered_map<std::string, SrSVGNodeBase*>;
-
 enum class SrSVGTag {
   kAnimate,
   kAnimateColor,
@@ -81,22 +80,55 @@ class SrSVGNodeBase {
       bool include_transform = true) const {
     return nullptr;
   }
+  // Bounds AsPath(..., false) would report, found without building the path.
+  // Returns false when only the backend path can tell, as for degenerate
+  // geometry the backends treat differently.
+  virtual bool GeometryBounds(SrSVGRenderContext* context,
+                              SrSVGBox* bounds) const {
+    return false;
+  }
   virtual bool IsSVGNode() const { return false; }
   SrSVGTag Tag() const { return tag_; }
   const std::string& Id() const { return id_; }
   bool HasClickEvent() const { return !click_event_.empty(); }
   const std::string& ClickEvent() const { return click_event_; }
+  // Records the base value of an attribute targeted by an animation, so it
+  // can be restored after each animated render.
   virtual void StoreAttribute(const char* name, const char* value) {}
+  // Base value of an attribute the element leaves unset, or null.
+  virtual const char* DefaultAttributeValue(const char* name) const {
+    return nullptr;
+  }
   virtual void AddAnimation(SrSVGAnimation*) {}
   virtual bool HasAnimations() const { return false; }
+  virtual const std::vector<SrSVGAnimation*>* Animations() const {
+    return nullptr;
+  }
   virtual void ApplyAnimations(double, const IDMapper*) {}
   virtual void RestoreAnimatedAttributes() {}
+  // Field that typed animations of an attribute write directly; empty when
+  // the attribute is only set through ParseAndSetAttribute().
+  virtual SrSVGAnimatedField AnimatedField(const char* name) { return {}; }
+  // Resets an animated attribute the source leaves unset.
+  virtual void ClearAnimatedAttribute(const std::string& name) {}
+  // Conservative bounds of everything this node paints, in the user space it
+  // is rendered into, including its own transform and its filter and mask
+  // effects. Returns false when the painted extent cannot be bounded; callers
+  // then fall back to unbounded layers.
+  bool ComputeRenderBounds(canvas::SrCanvas* canvas,
+                           SrSVGRenderContext& context, SrSVGBox* bounds);
 
  protected:
   explicit SrSVGNodeBase(SrSVGTag tag) : tag_(tag) {}
   virtual bool HasChildren() const { return false; }
   virtual void OnRender(canvas::SrCanvas* canvas, SrSVGRenderContext& context) {
   }
+  // Bounds of the node content before filter and mask effects are applied.
+  virtual bool OnComputeRenderBounds(canvas::SrCanvas* canvas,
+                                     SrSVGRenderContext& context,
+                                     SrSVGBox* bounds) {
+    return false;
+  }
   virtual bool OnPrepareToRender(canvas::SrCanvas* canvas,
                                  SrSVGRenderContext& context) const {
     return false;
@@ -144,9 +176,16 @@ class SrSVGNode : public SrSVGNodeBase {
   bool ParseAndSetAttribute(const char* name, const char* value) override;
   void StoreAttribute(const char* name, const char* value) override;
   void AddAnimation(SrSVGAnimation* animation) override;
-  bool HasAnimations() const override { return !animations_.empty(); }
+  bool HasAnimations() const override {
+    return !animated_attributes_.animations().empty();
+  }
+  const std::vector<SrSVGAnimation*>* Animations() const override {
+    return &animated_attributes_.animations();
+  }
   void ApplyAnimations(double seconds, const IDMapper* id_mapper) override;
   void RestoreAnimatedAttributes() override;
+  SrSVGAnimatedField AnimatedField(const char* name) override;
+  void ClearAnimatedAttribute(const std::string& name) override;
   bool HasTransformOrigin() const { return has_transform_origin_; }
   float TransformOriginX() const { return transform_origin_x_; }
   float TransformOriginY() const { return transform_origin_y_; }
@@ -155,6 +194,10 @@ class SrSVGNode : public SrSVGNodeBase {
                               canvas::PathFactory* path_factory) const;
   void ResolvedTransform(float (&xform)[6], const SrSVGRenderContext& context,
                          canvas::PathFactory* path_factory) const;
+  // Distance a stroke painted with this node's stroke state can reach past
+  // the geometry, accounting for miter joins and square caps. Zero when no
+  // stroke is painted.
+  float StrokeOutset(SrSVGRenderContext& context) const;
 
   bool IsSVGNode() const override { return true; }
 
@@ -168,9 +211,6 @@ class SrSVGNode : public SrSVGNodeBase {
   void ParseStrokeDashArray(const char* value);
   void ParseTransformOrigin(const char* value);
   void ParseTransformBox(const char* value);
-  void RestoreAnimatedAttribute(const std::string& name,
-                                const std::optional<std::string>& base_value);
-  void ClearAnimatedAttribute(const std::string& name);
 
  public:
   static const float s_stroke_miter_limit;
@@ -214,10 +254,7 @@ class SrSVGNode : public SrSVGNodeBase {
   float transform_[6]{1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
 
  private:
-  std::unordered_map<std::string, std::string> base_attributes_;
-  std::unordered_map<std::string, std::optional<std::string>>
-      animated_attributes_;
-  std::vector<SrSVGAnimation*> animations_;
+  SrSVGAnimatedAttributes animated_attributes_;
 };
 
 }  // namespace element
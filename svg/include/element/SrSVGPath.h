@@ -30,6 +30,8 @@ class SrSVGPath : public SrSVGShape {
   std::unique_ptr<canvas::Path> AsPath(
       canvas::PathFactory* path_factory, SrSVGRenderContext* context,
       bool include_transform = true) const override;
+  bool GeometryBounds(SrSVGRenderContext* context,
+                      SrSVGBox* bounds) const override;
   void onDraw(canvas::SrCanvas* canvas,
               SrSVGRenderContext& context) const override;
 
@@ -1,6 +1,7 @@
 #ifndef SVG_INCLUDE_ELEMENT_SRSVGPATTERNRESOLVER_H_
 #define SVG_INCLUDE_ELEMENT_SRSVGPATTERNRESOLVER_H_
 
+#include <cstdint>
 #include <string>
 #include <unordered_set>
 
@@ -30,11 +31,26 @@ struct ResolvedPattern {
   float content_transform[6]{1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
 };
 
+// Tiles covering a pattern area in pattern space. Tile (column, row) starts
+// at the origin offset by that many pattern widths and heights.
+struct PatternTileGrid {
+  float origin_x{0.f};
+  float origin_y{0.f};
+  uint32_t columns{0};
+  uint32_t rows{0};
+};
+
 bool IsPatternIri(const char* iri, const SrSVGRenderContext& context);
 bool ResolvePatternFromIri(const char* iri, const SrSVGRenderContext& context,
                            const SrSVGBox& object_bounding_box,
                            const std::unordered_set<std::string>& active_ids,
                            ResolvedPattern* resolved_pattern);
+// Lays out the tiles of |resolved_pattern| covering |pattern_area| and
+// charges them to the render's pattern tile budget. A pattern that does not
+// fit in what is left of the budget gets an empty grid and paints nothing.
+PatternTileGrid LayoutPatternTiles(const ResolvedPattern& resolved_pattern,
+                                   const SrSVGBox& pattern_area,
+                                   const SrSVGRenderContext& context);
 
 }  // namespace element
 }  // namespace svg
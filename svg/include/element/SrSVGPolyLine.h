@@ -23,6 +23,8 @@ class SrSVGPolyLine : public SrSVGShape {
   std::unique_ptr<canvas::Path> AsPath(
       canvas::PathFactory* path_factory, SrSVGRenderContext* context,
       bool include_transform = true) const override;
+  bool GeometryBounds(SrSVGRenderContext* context,
+                      SrSVGBox* bounds) const override;
 
  public:
   bool ParseAndSetAttribute(const char* name, const char* value) override;
@@ -17,18 +17,14 @@ class SrSVGRadialGradient : public SrSVGContainer {
  public:
   static SrSVGRadialGradient* Make() { return new SrSVGRadialGradient(); }
   bool ParseAndSetAttribute(const char* name, const char* value) override;
+  const char* DefaultAttributeValue(const char* name) const override;
   void OnRender(canvas::SrCanvas*, SrSVGRenderContext&) override;
   SrSVGObjectBoundingBoxUnitType gradient_units() const {
     return gradient_units_;
   }
 
  private:
-  SrSVGRadialGradient() : SrSVGContainer(SrSVGTag::kRadialGradient) {
-    StoreAttribute("cx", "0.5");
-    StoreAttribute("cy", "0.5");
-    StoreAttribute("r", "0.5");
-    StoreAttribute("gradientTransform", "matrix(1 0 0 1 0 0)");
-  }
+  SrSVGRadialGradient() : SrSVGContainer(SrSVGTag::kRadialGradient) {}
   float gradient_transform_[6]{1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
   SrSVGLength r_{0.5, SR_SVG_UNITS_NUMBER};
   SrSVGLength cx_{0.5, SR_SVG_UNITS_NUMBER};
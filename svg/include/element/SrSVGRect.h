@@ -18,6 +18,7 @@ class SrSVGRect : public SrSVGShape {
  public:
   static SrSVGRect* Make() { return new SrSVGRect(); }
   bool ParseAndSetAttribute(const char* name, const char* value) override;
+  SrSVGAnimatedField AnimatedField(const char* name) override;
 
  protected:
   void onDraw(canvas::SrCanvas* const canvas,
@@ -25,6 +26,8 @@ class SrSVGRect : public SrSVGShape {
   std::unique_ptr<canvas::Path> AsPath(
       canvas::PathFactory* path_factory, SrSVGRenderContext* context,
       bool include_transform = true) const override;
+  bool GeometryBounds(SrSVGRenderContext* context,
+                      SrSVGBox* bounds) const override;
 
  private:
   SrSVGRect() : SrSVGShape(SrSVGTag::kRect) {}
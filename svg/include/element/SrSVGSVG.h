@@ -36,6 +36,9 @@ class SrSVGSVG : public SrSVGContainer {
   bool OnPrepareToRender(canvas::SrCanvas* canvas,
                          SrSVGRenderContext& context) const override;
   void OnRender(canvas::SrCanvas* canvas, SrSVGRenderContext& context) override;
+  bool OnComputeRenderBounds(canvas::SrCanvas* canvas,
+                             SrSVGRenderContext& context,
+                             SrSVGBox* bounds) override;
 
  private:
   //  void calculateViewBoxTransform(const SrSVGBox& view_port, float* xform) const;
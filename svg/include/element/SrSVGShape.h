@@ -26,7 +26,13 @@ class SrSVGShape : public SrSVGNode {
  protected:
   void OnRender(canvas::SrCanvas* canvas, SrSVGRenderContext& context) final;
   explicit SrSVGShape(SrSVGTag t) : SrSVGNode(t){};
+  bool OnComputeRenderBounds(canvas::SrCanvas* canvas,
+                             SrSVGRenderContext& context,
+                             SrSVGBox* bounds) override;
   virtual void onDraw(canvas::SrCanvas*, SrSVGRenderContext& context) const = 0;
+  // False when neither fill nor stroke can leave any coverage, so the shape
+  // paints nothing whatever its geometry.
+  bool PaintsAnything(float stroke_outset) const;
   bool HasEffectiveFill() const {
     return render_state_.fill &&
            render_state_.fill->type != SERVAL_PAINT_NONE &&
@@ -22,9 +22,16 @@ class SrSVGStop : public SrSVGNodeBase {
   bool ParseAndSetAttribute(const char* name, const char* value) override;
   void StoreAttribute(const char* name, const char* value) override;
   void AddAnimation(SrSVGAnimation* animation) override;
-  bool HasAnimations() const override { return !animations_.empty(); }
+  bool HasAnimations() const override {
+    return !animated_attributes_.animations().empty();
+  }
+  const std::vector<SrSVGAnimation*>* Animations() const override {
+    return &animated_attributes_.animations();
+  }
   void ApplyAnimations(double seconds, const IDMapper* id_mapper) override;
   void RestoreAnimatedAttributes() override;
+  SrSVGAnimatedField AnimatedField(const char* name) override;
+  void ClearAnimatedAttribute(const std::string& name) override;
   float offset(SrSVGRenderContext& context) const;
   float opacity(SrSVGRenderContext& context) const;
 
@@ -37,18 +44,12 @@ class SrSVGStop : public SrSVGNodeBase {
     stop_.offset = (SrSVGLength){.value = 0.f, .unit = SR_SVG_UNITS_NUMBER};
     stop_.stopColor = make_serval_color("black");
   }
-  void RestoreAnimatedAttribute(const std::string& name,
-                                const std::optional<std::string>& base_value);
-  void ClearAnimatedAttribute(const std::string& name);
 
  public:
   SrStop stop_;
 
  private:
-  std::unordered_map<std::string, std::string> base_attributes_;
-  std::unordered_map<std::string, std::optional<std::string>>
-      animated_attributes_;
-  std::vector<SrSVGAnimation*> animations_;
+  SrSVGAnimatedAttributes animated_attributes_;
 };
 
 }  // namespace element
@@ -96,6 +96,12 @@ typedef enum SrSVGDiagnosticCode {
   SR_SVG_DIAGNOSTIC_USE_REFERENCE_CYCLE = 4,
   SR_SVG_DIAGNOSTIC_XML_BUILD_FAILED = 5,
   SR_SVG_DIAGNOSTIC_NATIVE_LIBRARY_LOAD_FAILED = 6,
+  SR_SVG_DIAGNOSTIC_NODE_BUDGET_EXCEEDED = 7,
+  SR_SVG_DIAGNOSTIC_PATH_BUDGET_EXCEEDED = 8,
+  SR_SVG_DIAGNOSTIC_ANIMATION_BUDGET_EXCEEDED = 9,
+  SR_SVG_DIAGNOSTIC_USE_BUDGET_EXCEEDED = 10,
+  SR_SVG_DIAGNOSTIC_PATTERN_BUDGET_EXCEEDED = 11,
+  SR_SVG_DIAGNOSTIC_LAYER_BUDGET_EXCEEDED = 12,
 } SrSVGDiagnosticCode;
 
 typedef struct SrSVGDiagnosticSink {
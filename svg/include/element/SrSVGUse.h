@@ -6,7 +6,9 @@
 #define SVG_INCLUDE_ELEMENT_SRSVGUSE_H_
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "SrSVGShape.h"
 
@@ -33,9 +35,36 @@ class SrSVGUse : public SrSVGNode {
   const SrSVGLength& width() const { return width_; }
   const SrSVGLength& height() const { return height_; }
 
+ protected:
+  bool OnComputeRenderBounds(canvas::SrCanvas* canvas,
+                             SrSVGRenderContext& context,
+                             SrSVGBox* bounds) override;
+
  private:
+  // Inherited presentation state of the referenced node that is overridden
+  // while it renders as this use instance.
+  struct ReferencedNodeState {
+    SrSVGPaint* fill_paint{nullptr};
+    SrSVGPaint* stroke_paint{nullptr};
+    SrSVGPaint* clip_path{nullptr};
+    SrSVGPaint* mask{nullptr};
+    std::optional<SrSVGLength> stroke_width;
+    std::optional<float> fill_opacity;
+    std::optional<float> stroke_opacity;
+    std::optional<SrSVGColor> color;
+    SrSVGStrokeCap stroke_cap{SR_SVG_STROKE_CAP_BUTT};
+    SrSVGStrokeJoin stroke_join{SR_SVG_STROKE_JOIN_MITER};
+    float stroke_miter_limit{0.f};
+    float stroke_dash_offset{0.f};
+    std::vector<float> stroke_dash_array;
+  };
+
   void renderRealNode(SrSVGNodeBase* node, canvas::SrCanvas* canvas,
                       SrSVGRenderContext& context);
+  void ApplyToReferencedNode(SrSVGNode* node,
+                             ReferencedNodeState* saved) const;
+  static void RestoreReferencedNode(SrSVGNode* node,
+                                    const ReferencedNodeState& saved);
 
  private:
   SrSVGUse() : SrSVGNode(SrSVGTag::kUse) {}
@@ -35,6 +35,15 @@ class SrDOMParser;
 class SrXMLParser;
 class SrXMLParserError;
 
+// Contiguous backing store for a tree that was not produced by SrDOMParser,
+// e.g. one loaded from a serialized document. Node and attribute names point
+// into |strings|.
+struct SrDOMStorage {
+  std::vector<SrDOMNode> nodes;
+  std::vector<SrDOMAttr> attrs;
+  std::vector<char> strings;
+};
+
 class SrDOM {
  public:
   SrDOM();
@@ -49,11 +58,21 @@ class SrDOM {
                            SrXMLParserError* error,
                            const SrSVGDiagnosticSink* diagnostic_sink);
   const Node* Copy(const SrDOM& dom, const Node* node);
+  /** Takes ownership of |storage|; |root| must be one of its nodes.
+   */
+  const Node* Adopt(std::unique_ptr<SrDOMStorage> storage, Node* root);
 
   [[nodiscard]] const Node* GetRootNode() const;
 
-  SrXMLParser* BeginParsing();
-  const Node* FinishParsing();
+  /** Incremental build(): feed the document to the returned parser with
+   *  parseChunk(), or element by element, then call FinishParsing(). Nodes
+   *  are added to the tree as their tags are parsed.
+   */
+  SrXMLParser* BeginParsing(
+      const SrSVGDiagnosticSink* diagnostic_sink = nullptr);
+  /** Returns null on failure, like build()
+   */
+  const Node* FinishParsing(SrXMLParserError* error = nullptr);
 
   enum Type { kElement_Type, kText_Type };
   Type GetType(const Node*) const;
@@ -80,6 +99,7 @@ class SrDOM {
  private:
   Node* fRoot;
   std::unique_ptr<SrDOMParser> fParser;
+  std::unique_ptr<SrDOMStorage> fStorage;
 };
 
 }  // namespace parser
@@ -0,0 +1,53 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_PARSER_SRDOMBINARY_H_
+#define SVG_INCLUDE_PARSER_SRDOMBINARY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "parser/SrDOM.h"
+#include "parser/SrSVGDOM.h"
+
+namespace serval {
+namespace svg {
+namespace parser {
+
+// Binary layout, all integers little endian:
+//
+//   header   magic "SRSB", u16 version, u16 reserved,
+//            u32 string bytes, u32 node count, u32 attribute count,
+//            u32 path count, u32 diagnostic count
+//   strings  nul-terminated strings, referenced by byte offset
+//   nodes    pre-order: u8 type, u32 name, u16 attribute count,
+//            u32 child count, then (u32 name, u32 value) per attribute
+//   paths    u32 attribute index, u32 op count, u32 arg count,
+//            op bytes, f32 args
+//   diags    u32 code, u8 fatal, u32 message, u32 subject
+constexpr uint8_t kSrDOMBinaryMagic[4] = {'S', 'R', 'S', 'B'};
+
+struct SrDOMBinaryContent {
+  std::shared_ptr<SrDOM> dom;
+  SrPreparsedPaths paths;
+  std::vector<SrSVGDiagnostic> diagnostics;
+  // Backing store for |paths|; only valid while this content is alive.
+  std::vector<SrPathData> path_data;
+  std::vector<uint8_t> path_ops;
+  std::vector<float> path_args;
+};
+
+bool EncodeDOMBinary(const SrDOM& dom,
+                     const std::vector<SrSVGDiagnostic>& diagnostics,
+                     uint16_t version, std::vector<uint8_t>* out);
+bool DecodeDOMBinary(const uint8_t* data, size_t len, uint16_t version,
+                     SrDOMBinaryContent* out);
+
+}  // namespace parser
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_PARSER_SRDOMBINARY_H_
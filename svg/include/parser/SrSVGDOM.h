@@ -6,6 +6,7 @@
 #define SVG_INCLUDE_PARSER_SRSVGDOM_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <optional>
@@ -15,6 +16,7 @@
 #include <vector>
 
 #include "canvas/SrCanvas.h"
+#include "element/SrSVGAnimationTimeline.h"
 #include "element/SrSVGSVG.h"
 #include "parser/SrDOM.h"
 
@@ -29,10 +31,52 @@ struct SrSVGDiagnostic {
   bool fatal{false};
 };
 
+// Upper bounds on the work one document may cost, so that hostile input
+// cannot stall a frame. Zero disables a limit. Nodes, path ops and
+// animations are charged while building; the rest on every render. Work over
+// a budget is dropped in document order and reported once, so the degraded
+// output is the same on every run.
+struct SrSVGBudgets {
+  // Off by default: the node count grows only with the input length, which
+  // the host already controls, and large drawings legitimately exceed any
+  // fixed limit. Hosts rendering untrusted input should set one.
+  uint32_t max_nodes{0};
+  uint64_t max_path_ops{1000000};
+  uint32_t max_animations{4096};
+  uint32_t max_use_depth{64};
+  uint32_t max_use_expansions{20000};
+  uint32_t max_pattern_tiles{16384};
+  // Device pixels, summed over the filter and mask layers of a render.
+  double max_layer_area{64.0 * 2048.0 * 2048.0};
+};
+
+// Path data parsed ahead of time for `d` attributes, keyed by the attribute
+// value pointer of the XML tree it was parsed from.
+using SrPreparsedPaths = std::unordered_map<const char*, const SrPathData*>;
+
+class SrXMLParser;
+class SrXMLParserError;
+struct SrSVGTraversalState;
+
 class SrSVGDOM {
  public:
+  // Version of the blob written by Serialize(). Blobs with another version are
+  // rejected by makeFromBinary() and should be regenerated from source.
+  static constexpr uint16_t kBinaryFormatVersion = 1;
+
   static std::unique_ptr<SrSVGDOM> make(const char*, size_t,
                                         std::vector<SrSVGDiagnostic>*);
+  static std::unique_ptr<SrSVGDOM> make(const char*, size_t,
+                                        std::vector<SrSVGDiagnostic>*,
+                                        const SrSVGBudgets& budgets);
+  // Loads a document written by Serialize() without running the XML parser or
+  // the path data parser. Returns null if the blob is malformed or was written
+  // by a different format version.
+  static std::unique_ptr<SrSVGDOM> makeFromBinary(
+      const uint8_t* data, size_t len, std::vector<SrSVGDiagnostic>*);
+  static std::unique_ptr<SrSVGDOM> makeFromBinary(
+      const uint8_t* data, size_t len, std::vector<SrSVGDiagnostic>*,
+      const SrSVGBudgets& budgets);
   ~SrSVGDOM();
   explicit SrSVGDOM(element::SrSVGSVG* root, element::IDMapper* id_mapper,
                     std::list<element::SrSVGNodeBase*>&& holder,
@@ -52,6 +96,10 @@ class SrSVGDOM {
   void RenderAtTime(canvas::SrCanvas* canvas, SrSVGBox view_port,
                     double seconds) const;
   bool HasAnimations() const;
+  // Render budgets apply from the next render; build budgets are fixed by
+  // make().
+  void SetBudgets(const SrSVGBudgets& budgets) { budgets_ = budgets; }
+  const SrSVGBudgets& budgets() const { return budgets_; }
   double AnimationTimelineEndSeconds() const;
   const std::vector<SrSVGDiagnostic>& diagnostics() const {
     return diagnostics_;
@@ -61,9 +109,30 @@ class SrSVGDOM {
   void ReplaceRuntimeDiagnostics(
       std::vector<SrSVGDiagnostic> diagnostics) const;
   void BindTargetAnimations();
+  // Writes the parsed document tree, pre-parsed path data and build
+  // diagnostics as a compact binary blob for makeFromBinary().
+  bool Serialize(std::vector<uint8_t>* out) const;
+  // Rough heap footprint of the element and XML trees, for cache accounting.
+  size_t ApproximateMemoryBytes() const;
 
  private:
+  friend class SrSVGDOMStream;
+
+  // Builds the element tree once |xml_dom| has been parsed; |parsed| is the
+  // parse result and |build_state| holds what the parse reported.
+  static std::unique_ptr<SrSVGDOM> MakeFromParse(
+      std::shared_ptr<SrDOM> xml_dom, bool parsed,
+      const SrXMLParserError& parser_error, SrSVGTraversalState* build_state,
+      const SrSVGBudgets& budgets, std::vector<SrSVGDiagnostic>* diagnostics);
+  static std::unique_ptr<SrSVGDOM> MakeFromXMLDOM(
+      std::shared_ptr<SrDOM> xml_dom, const SrPreparsedPaths* preparsed_paths,
+      const SrSVGBudgets& budgets,
+      std::vector<SrSVGDiagnostic> build_diagnostics,
+      std::vector<SrSVGDiagnostic>* diagnostics);
   const std::vector<element::SrSVGNodeBase*>& AnimatedNodes() const;
+  // Animated nodes with an animation active or frozen at |seconds|.
+  const std::vector<element::SrSVGNodeBase*>& ActiveNodesAt(
+      double seconds) const;
   void InvalidateAnimationCache() const;
 
   element::SrSVGSVG* root_;
@@ -71,10 +140,40 @@ class SrSVGDOM {
   std::list<element::SrSVGNodeBase*> nodes_;
   //release SrDOM after rendering is complete
   std::shared_ptr<SrDOM> xml_dom_;
+  SrSVGBudgets budgets_;
   mutable std::vector<SrSVGDiagnostic> diagnostics_;
   mutable size_t static_diagnostic_count_{0};
   mutable bool animated_nodes_valid_{false};
   mutable std::vector<element::SrSVGNodeBase*> animated_nodes_;
+  element::SrSVGAnimationTimeline timeline_;
+  mutable std::vector<uint32_t> active_node_indices_;
+  mutable std::vector<element::SrSVGNodeBase*> active_nodes_;
+};
+
+// Builds an SrSVGDOM from a document that arrives in pieces, such as a
+// network stream or the output of a decompressor, without holding its whole
+// text. XML nodes are created as soon as their tags are complete; Finish()
+// builds the element tree and resolves references. The result, diagnostics
+// included, is what SrSVGDOM::make() returns for the concatenated input.
+class SrSVGDOMStream {
+ public:
+  explicit SrSVGDOMStream(const SrSVGBudgets& budgets = SrSVGBudgets());
+  ~SrSVGDOMStream();
+  SrSVGDOMStream(const SrSVGDOMStream&) = delete;
+  SrSVGDOMStream& operator=(const SrSVGDOMStream&) = delete;
+
+  // Returns false once the input is malformed; later chunks are ignored and
+  // Finish() reports the error.
+  bool Append(const char* data, size_t len);
+  // Returns null on failure, like make(). The stream is spent afterwards.
+  std::unique_ptr<SrSVGDOM> Finish(std::vector<SrSVGDiagnostic>* diagnostics);
+
+ private:
+  SrSVGBudgets budgets_;
+  std::unique_ptr<SrSVGTraversalState> build_state_;
+  SrSVGDiagnosticSink build_sink_{};
+  std::shared_ptr<SrDOM> xml_dom_;
+  SrXMLParser* parser_{nullptr};
 };
 
 }  // namespace parser
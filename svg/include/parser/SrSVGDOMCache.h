@@ -0,0 +1,95 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_PARSER_SRSVGDOMCACHE_H_
+#define SVG_INCLUDE_PARSER_SRSVGDOMCACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "parser/SrSVGDOM.h"
+#include "utils/SrLRUCache.h"
+
+namespace serval {
+namespace svg {
+namespace parser {
+
+// A parsed document shared by every instance created from the same content.
+// Rendering temporarily mutates node state (animations, default color), so
+// renders of one document are serialized by |render_mutex|.
+struct SrSVGSharedDOM {
+  std::unique_ptr<SrSVGDOM> dom;
+  std::vector<SrSVGDiagnostic> build_diagnostics;
+  bool has_animations{false};
+  double animation_timeline_end_seconds{0.0};
+  size_t memory_bytes{0};
+  std::mutex render_mutex;
+};
+
+// Per-drawable view of a shared document. Default color, dpi and the
+// diagnostics of the last render belong to the instance.
+class SrSVGDOMInstance {
+ public:
+  explicit SrSVGDOMInstance(std::shared_ptr<SrSVGSharedDOM> document);
+
+  float dpi_{0.f};
+  void SetDefaultColor(uint32_t color);
+  void ResetDefaultColor();
+  void Render(canvas::SrCanvas* canvas, SrSVGBox view_port);
+  void RenderAtTime(canvas::SrCanvas* canvas, SrSVGBox view_port,
+                    double seconds);
+  bool HasAnimations() const;
+  double AnimationTimelineEndSeconds() const;
+  const std::vector<SrSVGDiagnostic>& diagnostics() const {
+    return diagnostics_;
+  }
+  const std::shared_ptr<SrSVGSharedDOM>& document() const { return document_; }
+
+ private:
+  void RenderLocked(canvas::SrCanvas* canvas, SrSVGBox view_port,
+                    const double* seconds);
+
+  std::shared_ptr<SrSVGSharedDOM> document_;
+  std::optional<uint32_t> default_color_;
+  std::vector<SrSVGDiagnostic> diagnostics_;
+};
+
+using SrSVGDOMCacheStats = SrLRUCacheStats;
+
+// Size-bounded, thread-safe cache of parsed documents keyed by content.
+// Documents are evicted least recently used first; evicted documents stay
+// alive while instances still reference them.
+class SrSVGDOMCache {
+ public:
+  static constexpr size_t kDefaultCapacityBytes = 4 * 1024 * 1024;
+
+  static SrSVGDOMCache& Shared();
+
+  explicit SrSVGDOMCache(size_t capacity_bytes = kDefaultCapacityBytes);
+  SrSVGDOMCache(const SrSVGDOMCache&) = delete;
+  SrSVGDOMCache& operator=(const SrSVGDOMCache&) = delete;
+
+  // Returns a new instance of the document parsed from |doc|, parsing it only
+  // if no identical content is cached. Returns null if parsing fails; failed
+  // documents are not cached.
+  std::unique_ptr<SrSVGDOMInstance> Acquire(
+      const char* doc, size_t len, std::vector<SrSVGDiagnostic>* diagnostics);
+
+  void SetCapacity(size_t capacity_bytes);
+  void Clear();
+  SrSVGDOMCacheStats stats() const;
+
+ private:
+  SrLRUCache<std::shared_ptr<SrSVGSharedDOM>> documents_;
+};
+
+}  // namespace parser
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_PARSER_SRSVGDOMCACHE_H_
@@ -5,6 +5,7 @@
 #ifndef SVG_INCLUDE_PARSER_SRSVGTRAVERSALSTATE_H_
 #define SVG_INCLUDE_PARSER_SRSVGTRAVERSALSTATE_H_
 
+#include <cstdint>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -19,6 +20,34 @@ namespace parser {
 struct SrSVGTraversalState {
   std::unordered_set<std::string> active_use_ids;
   std::vector<SrSVGDiagnostic> diagnostics;
+  // Limits this build or render is charged against; null is unbounded.
+  const SrSVGBudgets* budgets{nullptr};
+  uint64_t nodes{0};
+  uint64_t path_ops{0};
+  uint64_t animations{0};
+  uint64_t use_depth{0};
+  uint64_t use_expansions{0};
+  uint64_t pattern_tiles{0};
+  double layer_area{0.0};
+  uint32_t exceeded_budgets{0};
+
+  // Adds |amount| to |used| unless the sum passes |limit|, zero being no
+  // limit. The first refusal for |code| is reported; later work is refused
+  // silently so a pathological document cannot flood the diagnostics.
+  template <typename T>
+  bool Charge(T* used, T amount, T limit, ::SrSVGDiagnosticCode code,
+              const char* message, const char* subject) {
+    if (limit == T(0) || *used + amount <= limit) {
+      *used += amount;
+      return true;
+    }
+    const uint32_t bit = 1u << static_cast<uint32_t>(code);
+    if (!(exceeded_budgets & bit)) {
+      exceeded_budgets |= bit;
+      Report(code, message, subject, false);
+    }
+    return false;
+  }
 
   void Report(::SrSVGDiagnosticCode code, const char* message,
               const char* subject, bool fatal) {
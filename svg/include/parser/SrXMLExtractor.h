@@ -28,6 +28,28 @@ typedef bool (*SrSVGContentCb)(void* ud, const char* s, size_t len);
 
 bool SrXMLParseContent(const char* s, size_t len, SrSVGContentCb content,
                        void* context);
+
+// Resumable form of SrXMLParseXML() for input that arrives in pieces.
+typedef struct SrXMLScanner {
+  int state;
+  char quote;
+  // Where scanning resumes, relative to the first unconsumed byte.
+  size_t cursor;
+} SrXMLScanner;
+
+void SrXMLScannerInit(SrXMLScanner* scanner);
+// Dispatches every tag and text run of |input| that is complete. |input|
+// starts with the bytes the previous call left unconsumed, followed by new
+// data. |*consumed| is set to the length of the dispatched prefix. Returns
+// false if a callback stopped parsing or a tag is malformed.
+bool SrXMLScanChunk(SrXMLScanner* scanner, const char* input, size_t len,
+                    SrSVGStartElementCb start_element,
+                    SrSVGEndElementCb end_element, SrSVGContentCb content,
+                    void* context, size_t* consumed);
+// Ends the input with the unconsumed |input| of the last SrXMLScanChunk().
+// Returns false if it ends inside a tag.
+bool SrXMLScanFinish(SrXMLScanner* scanner, const char* input, size_t len,
+                     SrSVGContentCb content, void* context);
 bool SrXMLParseElement(const char* s, size_t len,
                        SrSVGStartElementCb start_element,
                        SrSVGEndElementCb end_element, void* context);
@@ -5,6 +5,7 @@
 #ifndef SVG_INCLUDE_PARSER_SRXMLPARSER_H_
 #define SVG_INCLUDE_PARSER_SRXMLPARSER_H_
 
+#include <memory>
 #include <string>
 
 #include "parser/SrXMLParserError.h"
@@ -26,6 +27,16 @@ class SrXMLParser {
   bool parse(const char doc[], size_t len);
   // bool parse(const SrDOM&, const SrDOMNode*);
 
+  /** Push-style parse(): call parseChunk() with consecutive pieces of the
+   *  document, then finishChunks(). Each element is reported as soon as its
+   *  tag is complete, and only an unfinished tag or text run is buffered.
+   *  The callbacks and the result are those of parse() on the whole
+   *  document, wherever it is split. Returns false once parsing failed.
+   */
+  bool parseChunk(const char chunk[], size_t len);
+  bool finishChunks();
+  bool hasChunks() const { return fChunks != nullptr; }
+
   static void GetNativeErrorString(int nativeErrorCode, std::string* str);
 
  protected:
@@ -52,7 +63,13 @@ class SrXMLParser {
   SrXMLParserError* fError;
 
  private:
+  struct ChunkState;
+
   void ReportError(void* parser);
+  void ReportEmptyFile();
+  void ReportMalformedXML();
+
+  std::unique_ptr<ChunkState> fChunks;
 };
 
 }  // namespace parser
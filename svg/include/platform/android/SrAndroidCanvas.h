@@ -40,6 +40,7 @@ class SrAndroidCanvas : public canvas::SrCanvas {
   void SetViewBox(float x, float y, float width, float height) override;
   void Save() override;
   void Restore() override;
+  bool GetTotalTransform(float (&xform)[6]) const override;
   void Translate(float x, float y) override;
   void Transform(const float (&form)[6]) override;
   void DrawRect(const char* id, float x, float y, float rx, float ry,
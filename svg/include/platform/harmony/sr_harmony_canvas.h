@@ -46,6 +46,7 @@ class SrHarmonyCanvas : public canvas::SrCanvas {
   ~SrHarmonyCanvas() override;
   void Save() override;
   void Restore() override;
+  bool GetTotalTransform(float (&xform)[6]) const override;
   void SetAntiAlias(bool anti_alias);
   void SetImageProvider(ImageProvider provider) {
     image_provider_ = std::move(provider);
@@ -0,0 +1,241 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_PLATFORM_HEADLESS_SRRECORDINGCANVAS_H_
+#define SVG_INCLUDE_PLATFORM_HEADLESS_SRRECORDINGCANVAS_H_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "canvas/SrCanvas.h"
+
+namespace serval {
+namespace svg {
+namespace headless {
+
+// Operations issued by the renderer against a canvas or its path factory.
+enum class SrRecordedOp : uint8_t {
+  kSetViewBox = 0,
+  kDrawRect,
+  kDrawCircle,
+  kDrawEllipse,
+  kDrawLine,
+  kDrawPolygon,
+  kDrawPolyline,
+  kDrawPath,
+  kDrawImage,
+  kDrawUse,
+  kDrawText,
+  kUpdateGradient,
+  kSave,
+  kRestore,
+  kTransform,
+  kClipPath,
+  kOpacityLayer,
+  kFilterLayer,
+  kMaskLayer,
+  kSaveLayer,
+  kCreatePath,
+  kPathOp,
+  kStrokePath,
+  kLoadImage,
+  kDecodeImage,
+  kCount,
+};
+
+const char* SrRecordedOpName(SrRecordedOp op);
+
+struct SrRecordingStats {
+  std::array<uint64_t, static_cast<size_t>(SrRecordedOp::kCount)> ops{};
+  // Device-space area of every layer requested through the layer API;
+  // unbounded layers are charged the view box area. Filter layers that the
+  // skity backend renders at reduced resolution are charged that area.
+  double layer_area{0.0};
+  uint32_t max_save_depth{0};
+
+  uint64_t Count(SrRecordedOp op) const {
+    return ops[static_cast<size_t>(op)];
+  }
+  uint64_t DrawCount() const;
+  uint64_t Total() const;
+  void Reset() { *this = SrRecordingStats(); }
+};
+
+// Path that only tracks conservative bounds. Geometry is never flattened, so
+// the cost measured through it is the renderer's, not the backend's.
+class SrRecordingPath : public canvas::Path {
+ public:
+  SrRecordingPath() = default;
+  explicit SrRecordingPath(const SrSVGBox& bounds)
+      : bounds_(bounds), has_bounds_(true) {}
+  ~SrRecordingPath() override = default;
+
+  SrSVGBox GetBounds() const override;
+  void Transform(const float (&xform)[6]) override;
+  std::unique_ptr<canvas::Path> CreateTransformCopy(
+      const float (&xform)[6]) const override;
+  void AddPath(canvas::Path* path) override;
+  void SetFillType(SrSVGFillRule rule) override { fill_rule_ = rule; }
+
+  void AddBounds(const SrSVGBox& bounds);
+  bool HasBounds() const { return has_bounds_; }
+  void Reset(const SrSVGBox* bounds);
+
+ private:
+  SrSVGBox bounds_{0.f, 0.f, 0.f, 0.f};
+  bool has_bounds_{false};
+  SrSVGFillRule fill_rule_{SR_SVG_FILL};
+};
+
+class SrRecordingPathFactory : public canvas::PathFactory {
+ public:
+  explicit SrRecordingPathFactory(SrRecordingStats* stats) : stats_(stats) {}
+
+  std::unique_ptr<canvas::Path> CreateCircle(float cx, float cy,
+                                             float r) override;
+  std::unique_ptr<canvas::Path> CreateRect(float x, float y, float rx, float ry,
+                                           float width, float height) override;
+  std::unique_ptr<canvas::Path> CreateLine(float start_x, float start_y,
+                                           float end_x, float end_y) override;
+  std::unique_ptr<canvas::Path> CreateEllipse(float center_x, float center_y,
+                                              float radius_x,
+                                              float radius_y) override;
+  std::unique_ptr<canvas::Path> CreatePolygon(float points[],
+                                              uint32_t n_points) override;
+  std::unique_ptr<canvas::Path> CreatePolyline(float points[],
+                                               uint32_t n_points) override;
+  std::unique_ptr<canvas::Path> CreateMutable() override;
+  std::unique_ptr<canvas::Path> CreatePath(uint8_t ops[], uint64_t n_ops,
+                                           float args[],
+                                           uint64_t n_args) override;
+  void Op(canvas::Path* path1, canvas::Path* path2, canvas::OP type) override;
+  std::unique_ptr<canvas::Path> CreateStrokePath(const canvas::Path* path,
+                                                 float width,
+                                                 SrSVGStrokeCap cap,
+                                                 SrSVGStrokeJoin join,
+                                                 float miter_limit) override;
+  void Recycle(std::unique_ptr<canvas::Path> path) override;
+
+  static SrSVGBox PathDataBounds(const uint8_t ops[], uint64_t n_ops,
+                                 const float args[], uint64_t n_args);
+
+ private:
+  static constexpr size_t kMaxFreePaths = 16;
+
+  std::unique_ptr<canvas::Path> Record(SrRecordedOp op, const SrSVGBox& box);
+  // A path with |bounds|, or none when null, reusing a recycled one.
+  std::unique_ptr<SrRecordingPath> TakePath(const SrSVGBox* bounds);
+
+  SrRecordingStats* stats_;
+  std::vector<std::unique_ptr<SrRecordingPath>> free_paths_;
+};
+
+// Headless canvas that counts every operation instead of rasterizing. It
+// reports filter support for the same filter graphs as the skity backend so
+// that filter and mask layer paths are exercised.
+class SrRecordingCanvas : public canvas::SrCanvas {
+ public:
+  SrRecordingCanvas();
+  ~SrRecordingCanvas() override = default;
+
+  const SrRecordingStats& stats() const { return stats_; }
+  void ResetStats();
+  void RecordText() { Record(SrRecordedOp::kDrawText); }
+  // Images are only loaded through the cache once one is set; null keeps
+  // DrawImage() as the single recorded op per image draw.
+  void SetImageCache(canvas::SrImageCache* image_cache) {
+    image_cache_ = image_cache;
+  }
+
+  void SetViewBox(float x, float y, float width, float height) override;
+  void DrawRect(const char* id, float x, float y, float rx, float ry,
+                float width, float height,
+                const SrSVGRenderState& render_state) override;
+  void DrawCircle(const char* id, float cx, float cy, float r,
+                  const SrSVGRenderState& render_state) override;
+  void DrawPolygon(const char* id, float points[], uint32_t n_points,
+                   const SrSVGRenderState& render_state) override;
+  void DrawPolyline(const char* id, float points[], uint32_t n_points,
+                    const SrSVGRenderState& render_state) override;
+  void DrawLine(const char* id, float start_x, float start_y, float end_x,
+                float end_y, const SrSVGRenderState& render_state) override;
+  void DrawPath(const char* id, uint8_t ops[], uint32_t n_ops, float args[],
+                uint32_t n_args, const SrSVGRenderState& render_state) override;
+  void DrawEllipse(const char* id, float center_x, float center_y,
+                   float radius_x, float radius_y,
+                   const SrSVGRenderState& render_state) override;
+  void UpdateLinearGradient(const char* id, const float (&form)[6],
+                            GradientSpread spread, float x1, float x2, float y1,
+                            float y2, const std::vector<SrStop>& stops,
+                            SrSVGObjectBoundingBoxUnitType obb_type) override;
+  void UpdateRadialGradient(
+      const char* id, const float (&form)[6], GradientSpread spread, float cx,
+      float cy, float fr, float fx, float fy, const std::vector<SrStop>& stops,
+      SrSVGObjectBoundingBoxUnitType bounding_box_type) override;
+  void DrawUse(const char* href, float x, float y, float width,
+               float height) override;
+  void DrawImage(const char* url, float x, float y, float width, float height,
+                 const SrSVGPreserveAspectRatio& preserve_aspect_radio,
+                 float opacity = 1.f) override;
+  canvas::SrImageCache* ImageCache() override { return image_cache_; }
+  std::shared_ptr<canvas::SrDecodedImage> LoadImage(const char* href) override;
+  std::shared_ptr<canvas::SrDecodedImage> DecodeImage(const uint8_t* data,
+                                                      size_t size) override;
+  void DrawDecodedImage(const canvas::SrDecodedImage& image, float x, float y,
+                        float width, float height,
+                        const SrSVGPreserveAspectRatio& preserve_aspect_radio,
+                        float opacity = 1.f) override;
+  void Translate(float x, float y) override;
+  void Transform(const float (&form)[6]) override;
+  void ClipPath(canvas::Path* path, SrSVGFillRule clip_rule) override;
+  void Save() override;
+  void Restore() override;
+  bool GetTotalTransform(float (&xform)[6]) const override;
+  bool GetLocalClipBounds(SrSVGBox* bounds) const override;
+  bool SupportsFilters() const override { return true; }
+  bool SupportsFilterModel(const canvas::SrFilterModel& filter) const override;
+  void SaveLayer(const SrSVGBox* bounds = nullptr) override;
+  void RestoreLayer() override;
+  void BeginOpacityLayer(const SrSVGBox* bounds, float opacity) override;
+  void BeginFilterLayer(const SrSVGBox* bounds,
+                        const canvas::SrFilterModel& filter) override;
+  void BeginMaskLayer(const SrSVGBox* bounds, bool is_luminance) override;
+  canvas::PathFactory* PathFactory() override { return &path_factory_; }
+
+ private:
+  void Record(SrRecordedOp op) {
+    ++stats_.ops[static_cast<size_t>(op)];
+  }
+  void RecordLayer(SrRecordedOp op, const SrSVGBox* bounds,
+                   float resolution_scale = 1.f);
+  void PushState();
+  void PopState();
+
+  SrRecordingStats stats_;
+  SrRecordingPathFactory path_factory_;
+  canvas::SrImageCache* image_cache_{nullptr};
+  SrSVGBox view_box_{0.f, 0.f, 0.f, 0.f};
+  // The first view box set after a reset stands for the target surface. It
+  // is mapped to device space, as hosts may scale the canvas beforehand.
+  SrSVGBox surface_{0.f, 0.f, 0.f, 0.f};
+  bool has_surface_{false};
+  struct State {
+    std::array<float, 6> transform;
+    // Device-space bounds of the clips applied so far.
+    SrSVGBox clip;
+    bool has_clip;
+  };
+  std::array<float, 6> transform_{1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
+  SrSVGBox clip_{0.f, 0.f, 0.f, 0.f};
+  bool has_clip_{false};
+  std::vector<State> state_stack_;
+};
+
+}  // namespace headless
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_PLATFORM_HEADLESS_SRRECORDINGCANVAS_H_
@@ -0,0 +1,58 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_PLATFORM_HEADLESS_SRRECORDINGPARAGRAPH_H_
+#define SVG_INCLUDE_PLATFORM_HEADLESS_SRRECORDINGPARAGRAPH_H_
+
+#include <memory>
+#include <string>
+
+#include "canvas/SrParagraph.h"
+#include "platform/headless/SrRecordingCanvas.h"
+
+namespace serval {
+namespace svg {
+namespace headless {
+
+// Paragraph that records a single text draw on the recording canvas.
+class SrRecordingParagraph : public canvas::Paragraph {
+ public:
+  SrRecordingParagraph() = default;
+  ~SrRecordingParagraph() override = default;
+  void Layout(float max_width) override {}
+  void Draw(canvas::SrCanvas* canvas, float x, float y) override {
+    if (canvas) {
+      static_cast<SrRecordingCanvas*>(canvas)->RecordText();
+    }
+  }
+};
+
+class SrRecordingParagraphFactory : public canvas::ParagraphFactory {
+ public:
+  SrRecordingParagraphFactory() = default;
+  ~SrRecordingParagraphFactory() override = default;
+
+  std::unique_ptr<canvas::Paragraph> CreateParagraph() override {
+    if (text_length_ == 0) {
+      return nullptr;
+    }
+    return std::make_unique<SrRecordingParagraph>();
+  }
+  void PushTextStyle(const SrTextStyle& style) override {}
+  void PopTextStyle() override {}
+  void SetParagraphStyle(SrParagraphStyle&& style) override {}
+  void AddText(const std::string& text) override {
+    text_length_ += text.size();
+  }
+  void Reset() override { text_length_ = 0; }
+
+ private:
+  size_t text_length_{0};
+};
+
+}  // namespace headless
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_PLATFORM_HEADLESS_SRRECORDINGPARAGRAPH_H_
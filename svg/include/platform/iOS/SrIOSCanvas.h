@@ -169,6 +169,7 @@ class SrIOSCanvas : public canvas::SrCanvas {
   CGPathRef CreateStrokeClipPath(CGPathRef cgPath,
                                  const SrSVGRenderState& render_state);
   void ApplyLuminanceMaskToAlpha();
+  void BeginTransparencyLayer(const SrSVGBox* bounds);
 
   // Todo: add more drawing methods as needed
  private:
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "canvas/SrCanvas.h"
+#include "canvas/SrImageCache.h"
 #include "element/SrSVGPatternResolver.h"
 #include "skity/effect/image_filter.hpp"
 #include "skity/render/canvas.hpp"
@@ -72,6 +73,29 @@ class SrPathFactorySkity : public canvas::PathFactory {
                                               uint32_t n_points) override;
   std::unique_ptr<canvas::Path> CreatePolyline(float points[],
                                                uint32_t n_points) override;
+  void Recycle(std::unique_ptr<canvas::Path> path) override;
+
+ private:
+  // Recycled paths kept for reuse; a frame rarely has more live at once.
+  static constexpr size_t kMaxFreePaths = 16;
+
+  // An empty path, reusing recycled storage when there is some.
+  std::unique_ptr<SrWinPath> TakePath();
+
+  std::vector<std::unique_ptr<SrWinPath>> free_paths_;
+};
+
+class SrSkityImage : public canvas::SrDecodedImage {
+ public:
+  explicit SrSkityImage(std::shared_ptr<::skity::Image> image)
+      : image_(std::move(image)) {}
+  float Width() const override;
+  float Height() const override;
+  size_t ByteSize() const override;
+  const std::shared_ptr<::skity::Image>& image() const { return image_; }
+
+ private:
+  std::shared_ptr<::skity::Image> image_;
 };
 
 class SrSkityCanvas : public canvas::SrCanvas {
@@ -80,6 +104,30 @@ class SrSkityCanvas : public canvas::SrCanvas {
       std::function<std::shared_ptr<::skity::Image>(std::string)>;
   explicit SrSkityCanvas(::skity::Canvas* canvas, ImageCallback callback);
 
+  // Cache shared by skity canvases that keep the default image cache. It
+  // holds decoded data: URIs only; other hrefs go to each canvas' callback
+  // through its host image memo.
+  static canvas::SrImageCache& SharedImageCache();
+  // A cache made with |cache_host_images| keys the callback's images by
+  // href, so only canvases sharing one callback and GPU context should share
+  // it. Null draws every image through DrawImage().
+  void SetImageCache(canvas::SrImageCache* image_cache) {
+    image_cache_ = image_cache;
+  }
+  // Images the callback returned, by href, so a host image is asked for once
+  // instead of on every draw. A canvas keeps its own memo; canvases sharing
+  // one callback may share one that outlives each of them. Null asks the
+  // callback on every draw, for hosts whose hrefs change what they name.
+  void SetHostImageMemo(std::shared_ptr<canvas::SrImageCache> memo) {
+    host_images_ = std::move(memo);
+  }
+  // On renders large blurs into reduced resolution layers. Off by default:
+  // the reduced layers are checked against full resolution by the
+  // benchmark's --raster mode, whose results are not yet recorded.
+  void SetReducedResolutionFilters(bool enabled) {
+    reduced_resolution_filters_ = enabled;
+  }
+
   void SetRenderContext(const SrSVGRenderContext* context) override {
     current_render_context_ = context;
   }
@@ -87,6 +135,8 @@ class SrSkityCanvas : public canvas::SrCanvas {
   ~SrSkityCanvas() override;
   void Save() override;
   void Restore() override;
+  bool GetTotalTransform(float (&xform)[6]) const override;
+  bool GetLocalClipBounds(SrSVGBox* bounds) const override;
   void SetAntiAlias(bool anti_alias);
   void DrawLine(const char*, float x1, float y1, float x2, float y2,
                 const SrSVGRenderState& render_state) override;
@@ -120,6 +170,14 @@ class SrSkityCanvas : public canvas::SrCanvas {
   void DrawImage(const char* url, float x, float y, float width, float height,
                  const SrSVGPreserveAspectRatio& preserve_aspect_radio,
                  float opacity = 1.f) override;
+  canvas::SrImageCache* ImageCache() override { return image_cache_; }
+  std::shared_ptr<canvas::SrDecodedImage> LoadImage(const char* href) override;
+  std::shared_ptr<canvas::SrDecodedImage> DecodeImage(const uint8_t* data,
+                                                      size_t size) override;
+  void DrawDecodedImage(const canvas::SrDecodedImage& image, float x, float y,
+                        float width, float height,
+                        const SrSVGPreserveAspectRatio& preserve_aspect_radio,
+                        float opacity = 1.f) override;
 
   void DrawEllipse(const char*, float center_x, float center_y, float radius_x,
                    float radius_y,
@@ -162,19 +220,40 @@ class SrSkityCanvas : public canvas::SrCanvas {
   void PushTransformState();
   void PopTransformState();
 
+  // Path a Draw*() call builds its geometry in, kept across calls so its
+  // storage is reused. Pattern tiles are drawn while the path they fill is
+  // still in use, so each nesting level has a path of its own.
+  class ScratchPath {
+   public:
+    explicit ScratchPath(SrSkityCanvas* canvas);
+    ~ScratchPath() { --canvas_->scratch_depth_; }
+    ::skity::Path& path() { return *path_; }
+
+   private:
+    SrSkityCanvas* canvas_;
+    ::skity::Path* path_;
+  };
+
  private:
   ::skity::Canvas* canvas_{nullptr};
   ImageCallback image_callback_;
+  canvas::SrImageCache* image_cache_{&SharedImageCache()};
+  std::shared_ptr<canvas::SrImageCache> host_images_;
   std::unique_ptr<SrPathFactorySkity> path_factory_;
   std::unordered_map<std::string, canvas::LinearGradientModel> lg_models_;
   std::unordered_map<std::string, canvas::RadialGradientModel> rg_models_;
   std::optional<::skity::BlendMode> blend_mode_override_;
   bool mask_is_luminance_{false};
   bool dst_in_layer_active_{false};
+  bool reduced_resolution_filters_{false};
+  // Resolution scale of every open filter layer, innermost last.
+  std::vector<float> filter_layer_scales_;
   const SrSVGRenderContext* current_render_context_{nullptr};
   std::unordered_set<std::string> active_pattern_ids_;
   std::array<float, 6> current_transform_{1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
   std::vector<std::array<float, 6>> transform_stack_;
+  std::vector<std::unique_ptr<::skity::Path>> scratch_paths_;
+  size_t scratch_depth_{0};
 };
 
 }  // namespace skity
@@ -0,0 +1,53 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_PLATFORM_SKITY_SRSKITYRASTERTARGET_H_
+#define SVG_INCLUDE_PLATFORM_SKITY_SRSKITYRASTERTARGET_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "canvas/SrImageCache.h"
+#include "platform/skity/SrSkityCanvas.h"
+#include "renderer/SrSVGBatchRenderer.h"
+#include "skity/skity.hpp"
+
+namespace serval {
+namespace svg {
+namespace skity {
+
+// Software bitmap for SrSVGBatchRenderer. Pixels are read back as
+// premultiplied RGBA, four bytes each, in packed rows.
+class SrSkityRasterTarget : public renderer::SrSVGRasterTarget {
+ public:
+  // Returns null if skity cannot make a canvas for the bitmap. A null
+  // |host_images| leaves the canvas its own memo of the callback's images.
+  static std::unique_ptr<SrSkityRasterTarget> Make(
+      uint32_t width, uint32_t height, SrSkityCanvas::ImageCallback callback,
+      canvas::SrImageCache* image_cache,
+      std::shared_ptr<canvas::SrImageCache> host_images = nullptr);
+  // Every worker shares |callback|, which must be thread-safe, and
+  // |image_cache|, which is. The targets also share one memo of the
+  // callback's images, so each href is asked for once per factory.
+  static renderer::SrSVGRasterTargetFactory Factory(
+      SrSkityCanvas::ImageCallback callback,
+      canvas::SrImageCache* image_cache = &SrSkityCanvas::SharedImageCache());
+
+  canvas::SrCanvas* Canvas() override { return sr_canvas_.get(); }
+  bool ReadPixels(std::vector<uint8_t>* pixels) override;
+
+ private:
+  SrSkityRasterTarget() = default;
+
+  std::unique_ptr<::skity::Bitmap> bitmap_;
+  std::unique_ptr<::skity::Canvas> canvas_;
+  std::unique_ptr<SrSkityCanvas> sr_canvas_;
+};
+
+}  // namespace skity
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_PLATFORM_SKITY_SRSKITYRASTERTARGET_H_
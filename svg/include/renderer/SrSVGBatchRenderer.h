@@ -0,0 +1,103 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_RENDERER_SRSVGBATCHRENDERER_H_
+#define SVG_INCLUDE_RENDERER_SRSVGBATCHRENDERER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "canvas/SrCanvas.h"
+#include "parser/SrSVGDOM.h"
+
+namespace serval {
+namespace svg {
+namespace renderer {
+
+// One document to rasterize at one size.
+struct SrSVGRasterJob {
+  // Document text; it must stay valid until Render() returns.
+  const char* content{nullptr};
+  size_t length{0};
+  // Viewport in user units. The image is width * scale by height * scale
+  // pixels, rounded up.
+  float width{0.f};
+  float height{0.f};
+  float scale{1.f};
+  std::optional<uint32_t> default_color;
+  // Time animated documents are rendered at.
+  double seconds{0.0};
+};
+
+struct SrSVGRasterResult {
+  bool ok{false};
+  uint32_t pixel_width{0};
+  uint32_t pixel_height{0};
+  // Layout is the target's; see SrSVGRasterTarget::ReadPixels().
+  std::vector<uint8_t> pixels;
+  // Build diagnostics followed by those of the render.
+  std::vector<parser::SrSVGDiagnostic> diagnostics;
+  double parse_micros{0.0};
+  // Drawing and reading the pixels back.
+  double render_micros{0.0};
+};
+
+// Pixel surface of one job, created and used on the worker running it.
+class SrSVGRasterTarget {
+ public:
+  virtual ~SrSVGRasterTarget() = default;
+  virtual canvas::SrCanvas* Canvas() = 0;
+  // Copies the rendered image into |pixels|.
+  virtual bool ReadPixels(std::vector<uint8_t>* pixels) = 0;
+};
+
+// Creates a transparent target of the given pixel size, or null. Workers
+// call it concurrently.
+using SrSVGRasterTargetFactory =
+    std::function<std::unique_ptr<SrSVGRasterTarget>(uint32_t width,
+                                                     uint32_t height)>;
+
+// Rasterizes batches of documents on a bounded number of threads. Every job
+// builds its own SrSVGDOM, as rendering updates state inside the document,
+// so jobs share nothing but the target factory. Results are in job order and
+// do not depend on the number of workers. Worker threads are started on the
+// first batch that needs them and kept until the renderer is destroyed.
+class SrSVGBatchRenderer {
+ public:
+  // Larger images are refused rather than allocated.
+  static constexpr uint32_t kMaxPixelSize = 16384;
+
+  // Zero workers uses one per hardware thread.
+  explicit SrSVGBatchRenderer(
+      SrSVGRasterTargetFactory factory, uint32_t max_workers = 0,
+      const parser::SrSVGBudgets& budgets = parser::SrSVGBudgets());
+  ~SrSVGBatchRenderer();
+
+  // The calling thread works on the batch too, with up to max_workers() - 1
+  // of the renderer's threads. Concurrent calls run one batch at a time.
+  std::vector<SrSVGRasterResult> Render(
+      const std::vector<SrSVGRasterJob>& jobs) const;
+  // Renders one job on the calling thread.
+  SrSVGRasterResult RenderJob(const SrSVGRasterJob& job) const;
+
+  uint32_t max_workers() const { return max_workers_; }
+
+ private:
+  class WorkerPool;
+
+  SrSVGRasterTargetFactory factory_;
+  uint32_t max_workers_;
+  parser::SrSVGBudgets budgets_;
+  std::unique_ptr<WorkerPool> pool_;
+};
+
+}  // namespace renderer
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_RENDERER_SRSVGBATCHRENDERER_H_
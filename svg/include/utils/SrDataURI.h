@@ -0,0 +1,31 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_UTILS_SRDATAURI_H_
+#define SVG_INCLUDE_UTILS_SRDATAURI_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace serval {
+namespace svg {
+
+struct SrDataURI {
+  std::string media_type;
+  std::vector<uint8_t> data;
+};
+
+// True if |uri| uses the data: scheme, which is matched case-insensitively.
+bool IsDataURI(const char* uri);
+
+// Decodes an RFC 2397 data: URI, base64 or percent-encoded. Whitespace in a
+// base64 payload is skipped, as editors wrap long attributes. Returns false
+// and leaves |out| untouched if the URI is malformed.
+bool DecodeDataURI(const char* uri, SrDataURI* out);
+
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_UTILS_SRDATAURI_H_
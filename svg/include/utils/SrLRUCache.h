@@ -0,0 +1,122 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef SVG_INCLUDE_UTILS_SRLRUCACHE_H_
+#define SVG_INCLUDE_UTILS_SRLRUCACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace serval {
+namespace svg {
+
+struct SrLRUCacheStats {
+  uint64_t hits{0};
+  uint64_t misses{0};
+  uint64_t evictions{0};
+  size_t entries{0};
+  size_t bytes{0};
+  size_t capacity_bytes{0};
+};
+
+// Size-bounded, thread-safe map from strings to |Value|, a pointer-like
+// type whose default is null. Entries are evicted least recently used first.
+// Callers build values without the lock between Find and Insert, so two
+// misses on one key may both build and the first insertion wins.
+template <typename Value>
+class SrLRUCache {
+ public:
+  explicit SrLRUCache(size_t capacity_bytes) {
+    stats_.capacity_bytes = capacity_bytes;
+  }
+  SrLRUCache(const SrLRUCache&) = delete;
+  SrLRUCache& operator=(const SrLRUCache&) = delete;
+
+  // Returns the value cached for |key|, or null, counting a hit or a miss.
+  Value Find(std::string_view key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++stats_.misses;
+      return Value();
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    ++stats_.hits;
+    return it->second->value;
+  }
+
+  // Caches |value| as |bytes| unless |key| was inserted since it missed, in
+  // which case the cached value is returned instead. A value larger than the
+  // whole cache is returned without being cached.
+  Value Insert(std::string_view key, Value value, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->value;
+    }
+    if (bytes <= stats_.capacity_bytes) {
+      EvictLocked(stats_.capacity_bytes - bytes);
+      entries_.push_front({std::string(key), value, bytes});
+      index_.emplace(entries_.front().key, entries_.begin());
+      stats_.bytes += bytes;
+      stats_.entries = entries_.size();
+    }
+    return value;
+  }
+
+  void SetCapacity(size_t capacity_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.capacity_bytes = capacity_bytes;
+    EvictLocked(capacity_bytes);
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    entries_.clear();
+    stats_.bytes = 0;
+    stats_.entries = 0;
+  }
+
+  SrLRUCacheStats stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    Value value;
+    size_t bytes;
+  };
+
+  void EvictLocked(size_t capacity_bytes) {
+    while (!entries_.empty() && stats_.bytes > capacity_bytes) {
+      Entry& entry = entries_.back();
+      index_.erase(entry.key);
+      stats_.bytes -= entry.bytes;
+      ++stats_.evictions;
+      entries_.pop_back();
+    }
+    stats_.entries = entries_.size();
+  }
+
+  mutable std::mutex mutex_;
+  std::list<Entry> entries_;
+  std::unordered_map<std::string_view, typename std::list<Entry>::iterator>
+      index_;
+  SrLRUCacheStats stats_;
+};
+
+}  // namespace svg
+}  // namespace serval
+
+#endif  // SVG_INCLUDE_UTILS_SRLRUCACHE_H_
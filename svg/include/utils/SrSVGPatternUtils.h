@@ -11,6 +11,15 @@ bool IsIdentityTransform(const float* xform);
 bool InvertAffineTransform(const float* xform, float* inverse);
 void MapPoint(const float* xform, float x, float y, float* out_x, float* out_y);
 SrSVGBox MapBounds(const SrSVGBox& box, const float* xform);
+bool IsEmptyBounds(const SrSVGBox& box);
+SrSVGBox UnionBounds(const SrSVGBox& first, const SrSVGBox& second);
+SrSVGBox IntersectBounds(const SrSVGBox& first, const SrSVGBox& second);
+SrSVGBox OutsetBounds(const SrSVGBox& box, float dx, float dy);
+// Bounds of |n_points| x, y pairs; empty when there are none.
+SrSVGBox PointsBounds(const float* points, uint32_t n_points);
+// Extent of one device pixel in the user space |xform| maps to device space.
+// Returns false when |xform| is singular.
+bool DevicePixelSize(const float* xform, float* dx, float* dy);
 
 }  // namespace element
 }  // namespace svg
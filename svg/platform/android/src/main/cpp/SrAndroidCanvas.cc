@@ -167,6 +167,11 @@ void SrAndroidCanvas::Restore() {
   }
 }
 
+bool SrAndroidCanvas::GetTotalTransform(float (&xform)[6]) const {
+  CopyTransformArray(current_transform_, xform);
+  return true;
+}
+
 void SrAndroidCanvas::Translate(float x, float y) {
   JavaLocalRef<jclass> j_render_clazz = GetClass(jni_env_, j_render_);
   if (j_render_clazz.IsNull()) {
@@ -528,16 +533,8 @@ void SrAndroidCanvas::RenderPatternTiles(
     }
   }
 
-  float origin_x =
-      resolved_pattern.x + std::floor((pattern_area.left - resolved_pattern.x) /
-                                      resolved_pattern.width) *
-                               resolved_pattern.width;
-  float origin_y =
-      resolved_pattern.y + std::floor((pattern_area.top - resolved_pattern.y) /
-                                      resolved_pattern.height) *
-                               resolved_pattern.height;
-  float right = pattern_area.left + pattern_area.width;
-  float bottom = pattern_area.top + pattern_area.height;
+  const element::PatternTileGrid grid = element::LayoutPatternTiles(
+      resolved_pattern, pattern_area, *current_render_context_);
   const bool has_resolved_view_box =
       resolved_pattern.has_view_box &&
       FloatsLarger(resolved_pattern.view_box.width, 0.f) &&
@@ -548,10 +545,10 @@ void SrAndroidCanvas::RenderPatternTiles(
   SrSVGRenderContext base_tile_context = *current_render_context_;
 
   // TODO: optimize this tile loop further.
-  for (float step_y = origin_y; step_y < bottom;
-       step_y += resolved_pattern.height) {
-    for (float step_x = origin_x; step_x < right;
-         step_x += resolved_pattern.width) {
+  for (uint32_t row = 0; row < grid.rows; ++row) {
+    const float step_y = grid.origin_y + row * resolved_pattern.height;
+    for (uint32_t column = 0; column < grid.columns; ++column) {
+      const float step_x = grid.origin_x + column * resolved_pattern.width;
       Save();
       ClipRect(step_x, step_y, step_x + resolved_pattern.width,
                step_y + resolved_pattern.height);
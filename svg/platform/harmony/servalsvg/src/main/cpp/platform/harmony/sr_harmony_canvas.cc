@@ -201,6 +201,11 @@ void SrHarmonyCanvas::Restore() {
     }
 }
 
+bool SrHarmonyCanvas::GetTotalTransform(float (&xform)[6]) const {
+    CopyTransformArray(current_transform_, xform);
+    return true;
+}
+
 void SrHarmonyCanvas::DrawLine(const char *, float x1, float y1, float x2, float y2,
                                const SrSVGRenderState &render_state) {
     Save();
@@ -436,14 +441,8 @@ void SrHarmonyCanvas::RenderPatternTiles(const element::ResolvedPattern &resolve
         }
     }
 
-    float origin_x =
-        resolved_pattern.x +
-        std::floor((pattern_area.left - resolved_pattern.x) / resolved_pattern.width) * resolved_pattern.width;
-    float origin_y =
-        resolved_pattern.y +
-        std::floor((pattern_area.top - resolved_pattern.y) / resolved_pattern.height) * resolved_pattern.height;
-    float right = pattern_area.left + pattern_area.width;
-    float bottom = pattern_area.top + pattern_area.height;
+    const element::PatternTileGrid grid =
+        element::LayoutPatternTiles(resolved_pattern, pattern_area, *current_render_context_);
     const bool has_resolved_view_box = resolved_pattern.has_view_box &&
                                        FloatsLarger(resolved_pattern.view_box.width, 0.f) &&
                                        FloatsLarger(resolved_pattern.view_box.height, 0.f);
@@ -451,8 +450,10 @@ void SrHarmonyCanvas::RenderPatternTiles(const element::ResolvedPattern &resolve
         resolved_pattern.pattern_content_units == SR_SVG_OBB_UNIT_TYPE_OBJECT_BOUNDING_BOX;
     SrSVGRenderContext base_tile_context = *current_render_context_;
 
-    for (float step_y = origin_y; step_y < bottom; step_y += resolved_pattern.height) {
-        for (float step_x = origin_x; step_x < right; step_x += resolved_pattern.width) {
+    for (uint32_t row = 0; row < grid.rows; ++row) {
+        const float step_y = grid.origin_y + row * resolved_pattern.height;
+        for (uint32_t column = 0; column < grid.columns; ++column) {
+            const float step_x = grid.origin_x + column * resolved_pattern.width;
             Save();
             ClipRect(step_x, step_y, step_x + resolved_pattern.width, step_y + resolved_pattern.height);
 
@@ -695,7 +695,8 @@ SvgRenderResult harmony::SvgDrawable::Update(const std::string &content, float l
                                              float height, bool anti_alias, bool has_color, std::string color) {
     std::vector<parser::SrSVGDiagnostic> diagnostics;
     RetryFailedImages();
-    svg_dom_ = std::move(parser::SrSVGDOM::make(content.data(), content.size(), &diagnostics));
+    // List cells often show the same icon; identical content shares one parsed document.
+    svg_dom_ = parser::SrSVGDOMCache::Shared().Acquire(content.data(), content.size(), &diagnostics);
     left_ = left;
     top_ = top;
     width_ = width;
@@ -5,7 +5,7 @@
 #ifndef SVG_PLATFORM_HARMONY_SERVALSVG_SRC_MAIN_CPP_SVG_DRAWABLE_H_
 #define SVG_PLATFORM_HARMONY_SERVALSVG_SRC_MAIN_CPP_SVG_DRAWABLE_H_
 
-#include "parser/SrSVGDOM.h"
+#include "parser/SrSVGDOMCache.h"
 #include "platform/harmony/sr_harmony_canvas.h"
 #include "renderer/SrSVGAnimationState.h"
 
@@ -113,7 +113,7 @@ private:
     std::string color_;
     SvgRenderResult last_result_{};
     std::unique_ptr<SrHarmonyCanvas> sr_canvas_{nullptr};
-    std::unique_ptr<parser::SrSVGDOM> svg_dom_{nullptr};
+    std::unique_ptr<parser::SrSVGDOMInstance> svg_dom_{nullptr};
     renderer::SrSVGAnimationState animation_state_{};
     std::unordered_map<std::string, CachedImage> image_cache_{};
 };
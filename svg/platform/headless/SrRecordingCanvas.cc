@@ -0,0 +1,622 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "platform/headless/SrRecordingCanvas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "utils/SrSVGPatternUtils.h"
+
+namespace serval {
+namespace svg {
+namespace headless {
+
+namespace {
+
+// Stands in for decoded pixels; only the size is read from the stream.
+class SrRecordedImage : public canvas::SrDecodedImage {
+ public:
+  SrRecordedImage(float width, float height) : width_(width), height_(height) {}
+  float Width() const override { return width_; }
+  float Height() const override { return height_; }
+  size_t ByteSize() const override {
+    return static_cast<size_t>(width_) * static_cast<size_t>(height_) * 4;
+  }
+
+ private:
+  float width_;
+  float height_;
+};
+
+uint32_t ReadBigEndian32(const uint8_t* data) {
+  return (static_cast<uint32_t>(data[0]) << 24) |
+         (static_cast<uint32_t>(data[1]) << 16) |
+         (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+class BoundsAccumulator {
+ public:
+  void Add(float x, float y) {
+    if (!has_point_) {
+      min_x_ = max_x_ = x;
+      min_y_ = max_y_ = y;
+      has_point_ = true;
+      return;
+    }
+    min_x_ = std::min(min_x_, x);
+    max_x_ = std::max(max_x_, x);
+    min_y_ = std::min(min_y_, y);
+    max_y_ = std::max(max_y_, y);
+  }
+  SrSVGBox Box() const {
+    if (!has_point_) {
+      return SrSVGBox{0.f, 0.f, 0.f, 0.f};
+    }
+    return SrSVGBox{min_x_, min_y_, max_x_ - min_x_, max_y_ - min_y_};
+  }
+
+ private:
+  bool has_point_{false};
+  float min_x_{0.f};
+  float max_x_{0.f};
+  float min_y_{0.f};
+  float max_y_{0.f};
+};
+
+}  // namespace
+
+const char* SrRecordedOpName(SrRecordedOp op) {
+  switch (op) {
+    case SrRecordedOp::kSetViewBox:
+      return "view_box";
+    case SrRecordedOp::kDrawRect:
+      return "rect";
+    case SrRecordedOp::kDrawCircle:
+      return "circle";
+    case SrRecordedOp::kDrawEllipse:
+      return "ellipse";
+    case SrRecordedOp::kDrawLine:
+      return "line";
+    case SrRecordedOp::kDrawPolygon:
+      return "polygon";
+    case SrRecordedOp::kDrawPolyline:
+      return "polyline";
+    case SrRecordedOp::kDrawPath:
+      return "path";
+    case SrRecordedOp::kDrawImage:
+      return "image";
+    case SrRecordedOp::kDrawUse:
+      return "use";
+    case SrRecordedOp::kDrawText:
+      return "text";
+    case SrRecordedOp::kUpdateGradient:
+      return "gradient";
+    case SrRecordedOp::kSave:
+      return "save";
+    case SrRecordedOp::kRestore:
+      return "restore";
+    case SrRecordedOp::kTransform:
+      return "transform";
+    case SrRecordedOp::kClipPath:
+      return "clip";
+    case SrRecordedOp::kOpacityLayer:
+      return "opacity_layer";
+    case SrRecordedOp::kFilterLayer:
+      return "filter_layer";
+    case SrRecordedOp::kMaskLayer:
+      return "mask_layer";
+    case SrRecordedOp::kSaveLayer:
+      return "save_layer";
+    case SrRecordedOp::kCreatePath:
+      return "create_path";
+    case SrRecordedOp::kPathOp:
+      return "path_op";
+    case SrRecordedOp::kStrokePath:
+      return "stroke_path";
+    case SrRecordedOp::kLoadImage:
+      return "load_image";
+    case SrRecordedOp::kDecodeImage:
+      return "decode_image";
+    case SrRecordedOp::kCount:
+      break;
+  }
+  return "unknown";
+}
+
+uint64_t SrRecordingStats::DrawCount() const {
+  uint64_t count = 0;
+  for (auto op = static_cast<size_t>(SrRecordedOp::kDrawRect);
+       op <= static_cast<size_t>(SrRecordedOp::kDrawText); ++op) {
+    count += ops[op];
+  }
+  return count;
+}
+
+uint64_t SrRecordingStats::Total() const {
+  uint64_t count = 0;
+  for (uint64_t value : ops) {
+    count += value;
+  }
+  return count;
+}
+
+// recording path
+
+SrSVGBox SrRecordingPath::GetBounds() const {
+  return bounds_;
+}
+
+void SrRecordingPath::Transform(const float (&xform)[6]) {
+  if (has_bounds_) {
+    bounds_ = element::MapBounds(bounds_, xform);
+  }
+}
+
+std::unique_ptr<canvas::Path> SrRecordingPath::CreateTransformCopy(
+    const float (&xform)[6]) const {
+  auto copy = std::make_unique<SrRecordingPath>(*this);
+  copy->Transform(xform);
+  return copy;
+}
+
+void SrRecordingPath::AddPath(canvas::Path* path) {
+  auto* recording_path = static_cast<SrRecordingPath*>(path);
+  if (recording_path && recording_path->has_bounds_) {
+    AddBounds(recording_path->bounds_);
+  }
+}
+
+void SrRecordingPath::AddBounds(const SrSVGBox& bounds) {
+  if (!has_bounds_) {
+    bounds_ = bounds;
+    has_bounds_ = true;
+    return;
+  }
+  const float left = std::min(bounds_.left, bounds.left);
+  const float top = std::min(bounds_.top, bounds.top);
+  const float right =
+      std::max(bounds_.left + bounds_.width, bounds.left + bounds.width);
+  const float bottom =
+      std::max(bounds_.top + bounds_.height, bounds.top + bounds.height);
+  bounds_ = SrSVGBox{left, top, right - left, bottom - top};
+}
+
+void SrRecordingPath::Reset(const SrSVGBox* bounds) {
+  bounds_ = bounds ? *bounds : SrSVGBox{0.f, 0.f, 0.f, 0.f};
+  has_bounds_ = bounds != nullptr;
+  fill_rule_ = SR_SVG_FILL;
+}
+
+// recording path factory
+
+std::unique_ptr<canvas::Path> SrRecordingPathFactory::Record(
+    SrRecordedOp op, const SrSVGBox& box) {
+  ++stats_->ops[static_cast<size_t>(op)];
+  return TakePath(&box);
+}
+
+std::unique_ptr<SrRecordingPath> SrRecordingPathFactory::TakePath(
+    const SrSVGBox* bounds) {
+  if (free_paths_.empty()) {
+    return bounds ? std::make_unique<SrRecordingPath>(*bounds)
+                  : std::make_unique<SrRecordingPath>();
+  }
+  auto path = std::move(free_paths_.back());
+  free_paths_.pop_back();
+  path->Reset(bounds);
+  return path;
+}
+
+void SrRecordingPathFactory::Recycle(std::unique_ptr<canvas::Path> path) {
+  if (path && free_paths_.size() < kMaxFreePaths) {
+    free_paths_.emplace_back(static_cast<SrRecordingPath*>(path.release()));
+  }
+}
+
+std::unique_ptr<canvas::Path> SrRecordingPathFactory::CreateCircle(float cx,
+                                                                   float cy,
+                                                                   float r) {
+  return Record(SrRecordedOp::kCreatePath,
+                SrSVGBox{cx - r, cy - r, r * 2.f, r * 2.f});
+}
+
+std::unique_ptr<canvas::Path> SrRecordingPathFactory::CreateRect(
+    float x, float y, float rx, float ry, float width, float height) {
+  return Record(SrRecordedOp::kCreatePath, SrSVGBox{x, y, width, height});
+}
+
+std::unique_ptr<canvas::Path> SrRecordingPathFactory::CreateLine(float start_x,
+                                                                 float start_y,
+                                                                 float end_x,
+                                                                 float end_y) {
+  const float points[4] = {start_x, start_y, end_x, end_y};
+  return Record(SrRecordedOp::kCreatePath, element::PointsBounds(points, 2));
+}
+
+std::unique_ptr<canvas::Path> SrRecordingPathFactory::CreateEllipse(
+    float center_x, float center_y, float radius_x, float radius_y) {
+  return Record(SrRecordedOp::kCreatePath,
+                SrSVGBox{center_x - radius_x, center_y - radius_y,
+                         radius_x * 2.f, radius_y * 2.f});
+}
+
+std::unique_ptr<canvas::Path> SrRecordingPathFactory::CreatePolygon(
+    float points[], uint32_t n_points) {
+  return Record(SrRecordedOp::kCreatePath,
+                element::PointsBounds(points, n_points));
+}
+
+std::unique_ptr<canvas::Path> SrRecordingPathFactory::CreatePolyline(
+    float points[], uint32_t n_points) {
+  return Record(SrRecordedOp::kCreatePath,
+                element::PointsBounds(points, n_points));
+}
+
+std::unique_ptr<canvas::Path> SrRecordingPathFactory::CreateMutable() {
+  ++stats_->ops[static_cast<size_t>(SrRecordedOp::kCreatePath)];
+  return TakePath(nullptr);
+}
+
+std::unique_ptr<canvas::Path> SrRecordingPathFactory::CreatePath(
+    uint8_t ops[], uint64_t n_ops, float args[], uint64_t n_args) {
+  return Record(SrRecordedOp::kCreatePath,
+                PathDataBounds(ops, n_ops, args, n_args));
+}
+
+void SrRecordingPathFactory::Op(canvas::Path* path1, canvas::Path* path2,
+                                canvas::OP type) {
+  ++stats_->ops[static_cast<size_t>(SrRecordedOp::kPathOp)];
+  auto* first = static_cast<SrRecordingPath*>(path1);
+  auto* second = static_cast<SrRecordingPath*>(path2);
+  if (!first || !second) {
+    return;
+  }
+  // Every op result is contained in the union of its operands.
+  if (type != canvas::DIFFERENCE && second->HasBounds()) {
+    first->AddBounds(second->GetBounds());
+  }
+}
+
+std::unique_ptr<canvas::Path> SrRecordingPathFactory::CreateStrokePath(
+    const canvas::Path* path, float width, SrSVGStrokeCap cap,
+    SrSVGStrokeJoin join, float miter_limit) {
+  if (!path || !(width > 0.f)) {
+    return nullptr;
+  }
+  float factor = 1.f;
+  if (join == SR_SVG_STROKE_JOIN_MITER) {
+    factor = std::max(factor, miter_limit);
+  }
+  if (cap == SR_SVG_STROKE_CAP_SQUARE) {
+    factor = std::max(factor, 1.4142135f);
+  }
+  const float outset = width * 0.5f * factor;
+  return Record(SrRecordedOp::kStrokePath,
+                element::OutsetBounds(path->GetBounds(), outset, outset));
+}
+
+SrSVGBox SrRecordingPathFactory::PathDataBounds(const uint8_t ops[],
+                                                uint64_t n_ops,
+                                                const float args[],
+                                                uint64_t n_args) {
+  BoundsAccumulator bounds;
+  uint64_t arg = 0;
+  float x = 0.f, y = 0.f;
+  auto has_args = [&](uint64_t count) { return arg + count <= n_args; };
+  for (uint64_t i = 0; i < n_ops; ++i) {
+    switch (ops[i]) {
+      case SPO_MOVE_TO:
+      case SPO_LINE_TO:
+        if (!has_args(2)) {
+          return bounds.Box();
+        }
+        x = args[arg++];
+        y = args[arg++];
+        bounds.Add(x, y);
+        break;
+      case SPO_CUBIC_BEZ:
+        if (!has_args(6)) {
+          return bounds.Box();
+        }
+        // The control polygon contains the curve.
+        for (int point = 0; point < 3; ++point) {
+          x = args[arg++];
+          y = args[arg++];
+          bounds.Add(x, y);
+        }
+        break;
+      case SPO_QUAD_ARC:
+        if (!has_args(4)) {
+          return bounds.Box();
+        }
+        for (int point = 0; point < 2; ++point) {
+          x = args[arg++];
+          y = args[arg++];
+          bounds.Add(x, y);
+        }
+        break;
+      case SPO_ELLIPTICAL_ARC: {
+        if (!has_args(9)) {
+          return bounds.Box();
+        }
+        const float start_x = args[arg++];
+        const float start_y = args[arg++];
+        const float rx = std::fabs(args[arg++]);
+        const float ry = std::fabs(args[arg++]);
+        arg += 3;  // angle, large-arc and sweep flags
+        x = args[arg++];
+        y = args[arg++];
+        // Radii are scaled up when too small to span the chord, so the arc is
+        // always within the larger of the radius and the chord length of the
+        // end points.
+        const float reach = std::max(
+            std::max(rx, ry), std::hypot(x - start_x, y - start_y));
+        bounds.Add(start_x - reach, start_y - reach);
+        bounds.Add(start_x + reach, start_y + reach);
+        bounds.Add(x, y);
+        break;
+      }
+      case SPO_CLOSE:
+      default:
+        break;
+    }
+  }
+  return bounds.Box();
+}
+
+// recording canvas
+
+SrRecordingCanvas::SrRecordingCanvas() : path_factory_(&stats_) {}
+
+void SrRecordingCanvas::ResetStats() {
+  stats_.Reset();
+  transform_ = {1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
+  clip_ = SrSVGBox{0.f, 0.f, 0.f, 0.f};
+  has_clip_ = false;
+  has_surface_ = false;
+  state_stack_.clear();
+}
+
+void SrRecordingCanvas::SetViewBox(float x, float y, float width,
+                                   float height) {
+  Record(SrRecordedOp::kSetViewBox);
+  view_box_ = SrSVGBox{x, y, width, height};
+  if (!has_surface_) {
+    surface_ = element::MapBounds(view_box_, transform_.data());
+    has_surface_ = true;
+  }
+}
+
+void SrRecordingCanvas::DrawRect(const char* id, float x, float y, float rx,
+                                 float ry, float width, float height,
+                                 const SrSVGRenderState& render_state) {
+  Record(SrRecordedOp::kDrawRect);
+}
+
+void SrRecordingCanvas::DrawCircle(const char* id, float cx, float cy, float r,
+                                   const SrSVGRenderState& render_state) {
+  Record(SrRecordedOp::kDrawCircle);
+}
+
+void SrRecordingCanvas::DrawPolygon(const char* id, float points[],
+                                    uint32_t n_points,
+                                    const SrSVGRenderState& render_state) {
+  Record(SrRecordedOp::kDrawPolygon);
+}
+
+void SrRecordingCanvas::DrawPolyline(const char* id, float points[],
+                                     uint32_t n_points,
+                                     const SrSVGRenderState& render_state) {
+  Record(SrRecordedOp::kDrawPolyline);
+}
+
+void SrRecordingCanvas::DrawLine(const char* id, float start_x, float start_y,
+                                 float end_x, float end_y,
+                                 const SrSVGRenderState& render_state) {
+  Record(SrRecordedOp::kDrawLine);
+}
+
+void SrRecordingCanvas::DrawPath(const char* id, uint8_t ops[], uint32_t n_ops,
+                                 float args[], uint32_t n_args,
+                                 const SrSVGRenderState& render_state) {
+  Record(SrRecordedOp::kDrawPath);
+}
+
+void SrRecordingCanvas::DrawEllipse(const char* id, float center_x,
+                                    float center_y, float radius_x,
+                                    float radius_y,
+                                    const SrSVGRenderState& render_state) {
+  Record(SrRecordedOp::kDrawEllipse);
+}
+
+void SrRecordingCanvas::UpdateLinearGradient(
+    const char* id, const float (&form)[6], GradientSpread spread, float x1,
+    float x2, float y1, float y2, const std::vector<SrStop>& stops,
+    SrSVGObjectBoundingBoxUnitType obb_type) {
+  Record(SrRecordedOp::kUpdateGradient);
+}
+
+void SrRecordingCanvas::UpdateRadialGradient(
+    const char* id, const float (&form)[6], GradientSpread spread, float cx,
+    float cy, float fr, float fx, float fy, const std::vector<SrStop>& stops,
+    SrSVGObjectBoundingBoxUnitType bounding_box_type) {
+  Record(SrRecordedOp::kUpdateGradient);
+}
+
+void SrRecordingCanvas::DrawUse(const char* href, float x, float y, float width,
+                                float height) {
+  Record(SrRecordedOp::kDrawUse);
+}
+
+void SrRecordingCanvas::DrawImage(
+    const char* url, float x, float y, float width, float height,
+    const SrSVGPreserveAspectRatio& preserve_aspect_radio, float opacity) {
+  Record(SrRecordedOp::kDrawImage);
+}
+
+std::shared_ptr<canvas::SrDecodedImage> SrRecordingCanvas::LoadImage(
+    const char* href) {
+  Record(SrRecordedOp::kLoadImage);
+  if (!href || !*href) {
+    return nullptr;
+  }
+  // External images are not fetched, a fixed size keeps the draw recorded.
+  return std::make_shared<SrRecordedImage>(1.f, 1.f);
+}
+
+std::shared_ptr<canvas::SrDecodedImage> SrRecordingCanvas::DecodeImage(
+    const uint8_t* data, size_t size) {
+  Record(SrRecordedOp::kDecodeImage);
+  // The size of a PNG is in its IHDR chunk, right after the signature.
+  static const uint8_t kPNGSignature[] = {0x89, 'P', 'N', 'G',
+                                          '\r', '\n', 0x1a, '\n'};
+  if (!data || size < 24 ||
+      !std::equal(std::begin(kPNGSignature), std::end(kPNGSignature), data)) {
+    return nullptr;
+  }
+  const uint32_t width = ReadBigEndian32(data + 16);
+  const uint32_t height = ReadBigEndian32(data + 20);
+  if (width == 0 || height == 0) {
+    return nullptr;
+  }
+  return std::make_shared<SrRecordedImage>(static_cast<float>(width),
+                                           static_cast<float>(height));
+}
+
+void SrRecordingCanvas::DrawDecodedImage(
+    const canvas::SrDecodedImage& image, float x, float y, float width,
+    float height, const SrSVGPreserveAspectRatio& preserve_aspect_radio,
+    float opacity) {
+  Record(SrRecordedOp::kDrawImage);
+}
+
+void SrRecordingCanvas::Translate(float x, float y) {
+  Record(SrRecordedOp::kTransform);
+  xform_pre_translate(transform_.data(), x, y);
+}
+
+void SrRecordingCanvas::Transform(const float (&form)[6]) {
+  Record(SrRecordedOp::kTransform);
+  xform_multiply(transform_.data(), form);
+}
+
+void SrRecordingCanvas::ClipPath(canvas::Path* path, SrSVGFillRule clip_rule) {
+  Record(SrRecordedOp::kClipPath);
+  auto* recording_path = static_cast<SrRecordingPath*>(path);
+  // Paths without bounds, such as text outlines, leave the clip unknown.
+  if (!recording_path || !recording_path->HasBounds()) {
+    return;
+  }
+  const SrSVGBox device_bounds =
+      element::MapBounds(recording_path->GetBounds(), transform_.data());
+  clip_ = has_clip_ ? element::IntersectBounds(clip_, device_bounds)
+                    : device_bounds;
+  has_clip_ = true;
+}
+
+void SrRecordingCanvas::Save() {
+  Record(SrRecordedOp::kSave);
+  PushState();
+}
+
+void SrRecordingCanvas::Restore() {
+  Record(SrRecordedOp::kRestore);
+  PopState();
+}
+
+bool SrRecordingCanvas::GetTotalTransform(float (&xform)[6]) const {
+  std::copy(transform_.begin(), transform_.end(), xform);
+  return true;
+}
+
+bool SrRecordingCanvas::GetLocalClipBounds(SrSVGBox* bounds) const {
+  if (!bounds || (!has_clip_ && !has_surface_)) {
+    return false;
+  }
+  SrSVGBox device_bounds = has_clip_ ? clip_ : surface_;
+  if (has_clip_ && has_surface_) {
+    device_bounds = element::IntersectBounds(device_bounds, surface_);
+  }
+  // One device pixel of slack covers antialiased edges.
+  device_bounds = element::OutsetBounds(device_bounds, 1.f, 1.f);
+  float inverse[6];
+  if (!element::InvertAffineTransform(transform_.data(), inverse)) {
+    return false;
+  }
+  *bounds = element::MapBounds(device_bounds, inverse);
+  return true;
+}
+
+bool SrRecordingCanvas::SupportsFilterModel(
+    const canvas::SrFilterModel& filter) const {
+  return canvas::SrSupportsLinearSourceGraphicFilterModel(filter);
+}
+
+void SrRecordingCanvas::SaveLayer(const SrSVGBox* bounds) {
+  RecordLayer(SrRecordedOp::kSaveLayer, bounds);
+}
+
+void SrRecordingCanvas::RestoreLayer() {
+  Record(SrRecordedOp::kRestore);
+  PopState();
+}
+
+void SrRecordingCanvas::BeginOpacityLayer(const SrSVGBox* bounds,
+                                          float opacity) {
+  RecordLayer(SrRecordedOp::kOpacityLayer, bounds);
+}
+
+void SrRecordingCanvas::BeginFilterLayer(const SrSVGBox* bounds,
+                                         const canvas::SrFilterModel& filter) {
+  float transform[6];
+  std::copy(transform_.begin(), transform_.end(), transform);
+  RecordLayer(SrRecordedOp::kFilterLayer, bounds,
+              canvas::SrFilterLayerResolutionScale(filter, transform));
+}
+
+void SrRecordingCanvas::BeginMaskLayer(const SrSVGBox* bounds,
+                                       bool is_luminance) {
+  RecordLayer(SrRecordedOp::kMaskLayer, bounds);
+}
+
+void SrRecordingCanvas::RecordLayer(SrRecordedOp op, const SrSVGBox* bounds,
+                                    float resolution_scale) {
+  Record(op);
+  const double area_scale =
+      static_cast<double>(resolution_scale) * resolution_scale;
+  if (bounds && bounds->width > 0.f && bounds->height > 0.f) {
+    const SrSVGBox device_bounds =
+        element::MapBounds(*bounds, transform_.data());
+    stats_.layer_area += static_cast<double>(device_bounds.width) *
+                         device_bounds.height * area_scale;
+  } else {
+    stats_.layer_area += static_cast<double>(view_box_.width) *
+                         view_box_.height * area_scale;
+  }
+  PushState();
+}
+
+void SrRecordingCanvas::PushState() {
+  state_stack_.push_back(State{transform_, clip_, has_clip_});
+  stats_.max_save_depth =
+      std::max(stats_.max_save_depth,
+               static_cast<uint32_t>(state_stack_.size()));
+}
+
+void SrRecordingCanvas::PopState() {
+  if (state_stack_.empty()) {
+    return;
+  }
+  const State& state = state_stack_.back();
+  transform_ = state.transform;
+  clip_ = state.clip;
+  has_clip_ = state.has_clip;
+  state_stack_.pop_back();
+}
+
+}  // namespace headless
+}  // namespace svg
+}  // namespace serval
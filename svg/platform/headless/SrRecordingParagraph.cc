@@ -0,0 +1,18 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "platform/headless/SrRecordingParagraph.h"
+
+namespace serval {
+namespace svg {
+namespace canvas {
+
+std::unique_ptr<canvas::ParagraphFactory> CreateParagraphFactoryFactory(
+    const SrCanvas* srCanvas) {
+  return std::make_unique<headless::SrRecordingParagraphFactory>();
+}
+
+}  // namespace canvas
+}  // namespace svg
+}  // namespace serval
@@ -581,16 +581,8 @@ void SrIOSCanvas::RenderPatternTiles(
     }
   }
 
-  float origin_x =
-      resolved_pattern.x + std::floor((pattern_area.left - resolved_pattern.x) /
-                                      resolved_pattern.width) *
-                               resolved_pattern.width;
-  float origin_y =
-      resolved_pattern.y + std::floor((pattern_area.top - resolved_pattern.y) /
-                                      resolved_pattern.height) *
-                               resolved_pattern.height;
-  float right = pattern_area.left + pattern_area.width;
-  float bottom = pattern_area.top + pattern_area.height;
+  const element::PatternTileGrid grid = element::LayoutPatternTiles(
+      resolved_pattern, pattern_area, *current_render_context_);
   const bool has_resolved_view_box =
       resolved_pattern.has_view_box &&
       FloatsLarger(resolved_pattern.view_box.width, 0.f) &&
@@ -600,10 +592,10 @@ void SrIOSCanvas::RenderPatternTiles(
       SR_SVG_OBB_UNIT_TYPE_OBJECT_BOUNDING_BOX;
   SrSVGRenderContext base_tile_context = *current_render_context_;
 
-  for (float step_y = origin_y; step_y < bottom;
-       step_y += resolved_pattern.height) {
-    for (float step_x = origin_x; step_x < right;
-         step_x += resolved_pattern.width) {
+  for (uint32_t row = 0; row < grid.rows; ++row) {
+    const float step_y = grid.origin_y + row * resolved_pattern.height;
+    for (uint32_t column = 0; column < grid.columns; ++column) {
+      const float step_x = grid.origin_x + column * resolved_pattern.width;
       Save();
       CGContextClipToRect(_context,
                           CGRectMake(step_x, step_y, resolved_pattern.width,
@@ -1195,11 +1187,10 @@ void SrIOSCanvas::ClipPath(canvas::Path* path, SrSVGFillRule clip_rule) {
 }
 
 void SrIOSCanvas::SaveLayer(const SrSVGBox* bounds) {
-  (void)bounds;
   // CGContextBeginTransparencyLayer creates an off-screen buffer for compositing.
   // All subsequent drawing is redirected to this buffer until RestoreLayer().
   // The transparency layer starts fully transparent by default.
-  CGContextBeginTransparencyLayer(_context, NULL);
+  BeginTransparencyLayer(bounds);
 }
 
 void SrIOSCanvas::RestoreLayer() {
@@ -1207,9 +1198,21 @@ void SrIOSCanvas::RestoreLayer() {
 }
 
 void SrIOSCanvas::BeginOpacityLayer(const SrSVGBox* bounds, float opacity) {
-  (void)bounds;
   CGContextSetAlpha(_context,
                     static_cast<CGFloat>(std::clamp(opacity, 0.f, 1.f)));
+  BeginTransparencyLayer(bounds);
+}
+
+void SrIOSCanvas::BeginTransparencyLayer(const SrSVGBox* bounds) {
+  if (bounds && bounds->width > 0.f && bounds->height > 0.f) {
+    // The rect is in user space; CoreGraphics maps it through the CTM and
+    // sizes the off-screen buffer to the covered device area.
+    CGContextBeginTransparencyLayerWithRect(
+        _context,
+        CGRectMake(bounds->left, bounds->top, bounds->width, bounds->height),
+        NULL);
+    return;
+  }
   CGContextBeginTransparencyLayer(_context, NULL);
 }
 
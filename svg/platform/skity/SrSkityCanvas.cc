@@ -304,23 +304,40 @@ void SrWinPath::SetFillType(SrSVGFillRule rule) {
 
 // skity path factory
 
+std::unique_ptr<SrWinPath> SrPathFactorySkity::TakePath() {
+  if (free_paths_.empty()) {
+    return std::make_unique<SrWinPath>();
+  }
+  auto path = std::move(free_paths_.back());
+  free_paths_.pop_back();
+  path->GetSkityPath()->Reset();
+  path->GetSkityPath()->SetFillType(::skity::Path::PathFillType::kWinding);
+  return path;
+}
+
+void SrPathFactorySkity::Recycle(std::unique_ptr<canvas::Path> path) {
+  if (path && free_paths_.size() < kMaxFreePaths) {
+    free_paths_.emplace_back(static_cast<SrWinPath*>(path.release()));
+  }
+}
+
 std::unique_ptr<canvas::Path> SrPathFactorySkity::CreateCircle(float cx,
                                                                float cy,
                                                                float r) {
-  auto path = std::make_unique<SrWinPath>();
+  auto path = TakePath();
   path->GetSkityPath()->AddCircle(cx, cy, r);
   return path;
 }
 
 std::unique_ptr<canvas::Path> SrPathFactorySkity::CreateMutable() {
-  return std::make_unique<SrWinPath>();
+  return TakePath();
 }
 
 std::unique_ptr<canvas::Path> SrPathFactorySkity::CreateRect(float x, float y,
                                                              float rx, float ry,
                                                              float width,
                                                              float height) {
-  auto path = std::make_unique<SrWinPath>();
+  auto path = TakePath();
   auto rect = ::skity::Rect(x, y, x + width, y + height);
   path->GetSkityPath()->AddRoundRect(rect, rx, ry);
   return path;
@@ -330,7 +347,7 @@ std::unique_ptr<canvas::Path> SrPathFactorySkity::CreateLine(float start_x,
                                                              float start_y,
                                                              float end_x,
                                                              float end_y) {
-  auto path = std::make_unique<SrWinPath>();
+  auto path = TakePath();
   path->GetSkityPath()->MoveTo(start_x, start_y);
   path->GetSkityPath()->LineTo(end_x, end_y);
   return path;
@@ -338,7 +355,7 @@ std::unique_ptr<canvas::Path> SrPathFactorySkity::CreateLine(float start_x,
 
 std::unique_ptr<canvas::Path> SrPathFactorySkity::CreateEllipse(
     float center_x, float center_y, float radius_x, float radius_y) {
-  auto path = std::make_unique<SrWinPath>();
+  auto path = TakePath();
   path->GetSkityPath()->AddCircle(0.f, 0.f, 1.f);
   const float xform[6] = {radius_x, 0.f, 0.f, radius_y, center_x, center_y};
   path->Transform(xform);
@@ -350,7 +367,7 @@ std::unique_ptr<canvas::Path> SrPathFactorySkity::CreatePolygon(
   if (!points || n_points < 2) {
     return nullptr;
   }
-  auto path = std::make_unique<SrWinPath>();
+  auto path = TakePath();
   path->GetSkityPath()->MoveTo(points[0], points[1]);
   for (uint32_t i = 1; i < n_points; ++i) {
     path->GetSkityPath()->LineTo(points[2 * i], points[2 * i + 1]);
@@ -364,7 +381,7 @@ std::unique_ptr<canvas::Path> SrPathFactorySkity::CreatePolyline(
   if (!points || n_points < 2) {
     return nullptr;
   }
-  auto path = std::make_unique<SrWinPath>();
+  auto path = TakePath();
   path->GetSkityPath()->MoveTo(points[0], points[1]);
   for (uint32_t i = 1; i < n_points; ++i) {
     path->GetSkityPath()->LineTo(points[2 * i], points[2 * i + 1]);
@@ -376,7 +393,7 @@ std::unique_ptr<canvas::Path> SrPathFactorySkity::CreatePath(uint8_t ops[],
                                                              uint64_t n_ops,
                                                              float args[],
                                                              uint64_t n_args) {
-  auto path = std::make_unique<SrWinPath>();
+  auto path = TakePath();
   uint64_t iArg = 0;
   float x = .0f, y = .0f;
   float cp1x = .0f, cp1y = .0f, cp2x = .0f, cp2y = .0f;
@@ -428,7 +445,7 @@ std::unique_ptr<canvas::Path> SrPathFactorySkity::CreatePath(uint8_t ops[],
         break;
     }
   }
-  return std::move(path);
+  return path;
 }
 
 void SrPathFactorySkity::Op(canvas::Path* path1, canvas::Path* path2,
@@ -502,6 +519,8 @@ std::unique_ptr<canvas::Path> SrPathFactorySkity::CreateStrokePath(
 SrSkityCanvas::SrSkityCanvas(::skity::Canvas* canvas, ImageCallback callback)
     : canvas_(canvas),
       image_callback_(std::move(callback)),
+      host_images_(std::make_shared<canvas::SrImageCache>(
+          canvas::SrImageCache::kDefaultCapacityBytes, true)),
       path_factory_(std::make_unique<SrPathFactorySkity>()) {}
 
 SrSkityCanvas::~SrSkityCanvas() {}
@@ -531,12 +550,52 @@ void SrSkityCanvas::Restore() {
   PopTransformState();
 }
 
-void SrSkityCanvas::SaveLayer(const SrSVGBox* bounds) {
-  ::skity::Rect layer_bounds = canvas_->GetLocalClipBounds();
-  if (bounds) {
-    layer_bounds = ::skity::Rect::MakeXYWH(bounds->left, bounds->top,
-                                           bounds->width, bounds->height);
+bool SrSkityCanvas::GetTotalTransform(float (&xform)[6]) const {
+  CopyTransformArray(current_transform_, xform);
+  return true;
+}
+
+bool SrSkityCanvas::GetLocalClipBounds(SrSVGBox* bounds) const {
+  if (!bounds) {
+    return false;
   }
+  const ::skity::Rect clip_bounds = canvas_->GetLocalClipBounds();
+  float xform[6];
+  CopyTransformArray(current_transform_, xform);
+  float dx = 0.f;
+  float dy = 0.f;
+  if (!element::DevicePixelSize(xform, &dx, &dy)) {
+    return false;
+  }
+  *bounds = element::OutsetBounds(
+      SrSVGBox{clip_bounds.Left(), clip_bounds.Top(), clip_bounds.Width(),
+               clip_bounds.Height()},
+      dx, dy);
+  return true;
+}
+
+// Content bounds reported by the renderer may extend past the current clip;
+// the off-screen layer never needs to be larger than their intersection.
+static ::skity::Rect ClippedLayerBounds(::skity::Canvas* canvas,
+                                        const SrSVGBox* bounds) {
+  ::skity::Rect clip_bounds = canvas->GetLocalClipBounds();
+  if (!bounds || bounds->width <= 0.f || bounds->height <= 0.f) {
+    return clip_bounds;
+  }
+  const float left = std::max(bounds->left, clip_bounds.Left());
+  const float top = std::max(bounds->top, clip_bounds.Top());
+  const float right =
+      std::min(bounds->left + bounds->width, clip_bounds.Right());
+  const float bottom =
+      std::min(bounds->top + bounds->height, clip_bounds.Bottom());
+  if (right <= left || bottom <= top) {
+    return ::skity::Rect::MakeXYWH(bounds->left, bounds->top, 0.f, 0.f);
+  }
+  return ::skity::Rect::MakeXYWH(left, top, right - left, bottom - top);
+}
+
+void SrSkityCanvas::SaveLayer(const SrSVGBox* bounds) {
+  ::skity::Rect layer_bounds = ClippedLayerBounds(canvas_, bounds);
   canvas_->SaveLayer(layer_bounds, ::skity::Paint());
   PushTransformState();
   canvas_->DrawColor(0, ::skity::BlendMode::kSrc);
@@ -548,11 +607,7 @@ void SrSkityCanvas::RestoreLayer() {
 }
 
 void SrSkityCanvas::BeginOpacityLayer(const SrSVGBox* bounds, float opacity) {
-  ::skity::Rect layer_bounds = canvas_->GetLocalClipBounds();
-  if (bounds) {
-    layer_bounds = ::skity::Rect::MakeXYWH(bounds->left, bounds->top,
-                                           bounds->width, bounds->height);
-  }
+  ::skity::Rect layer_bounds = ClippedLayerBounds(canvas_, bounds);
   ::skity::Paint paint;
   paint.SetAlpha(static_cast<uint8_t>(std::clamp(opacity, 0.f, 1.f) * 255.f));
   canvas_->SaveLayer(layer_bounds, paint);
@@ -572,16 +627,43 @@ bool SrSkityCanvas::SupportsFilterModel(
 void SrSkityCanvas::BeginFilterLayer(const SrSVGBox* bounds,
                                      const canvas::SrFilterModel& filter) {
   auto image_filter = BuildSkityImageFilter(filter);
-  ::skity::Paint paint;
-  if (image_filter) {
-    paint.SetImageFilter(image_filter);
-  }
-
   ::skity::Rect layer_bounds = canvas_->GetLocalClipBounds();
   if (bounds && bounds->width > 0.f && bounds->height > 0.f) {
     layer_bounds = ::skity::Rect::MakeXYWH(bounds->left, bounds->top,
                                            bounds->width, bounds->height);
   }
+
+  // The host's own canvas scale is not known here, so the scale chosen from
+  // the SVG transform alone errs towards full resolution.
+  float current[6];
+  CopyTransformArray(current_transform_, current);
+  const float scale =
+      image_filter && reduced_resolution_filters_
+          ? canvas::SrFilterLayerResolutionScale(filter, current)
+          : 1.f;
+  filter_layer_scales_.push_back(scale);
+  if (scale < 1.f) {
+    // Shrink the layer about its origin and let the filter chain scale the
+    // blurred result back up. The shrink goes through Transform() so that
+    // non-scaling strokes, clip bounds and nested layers see it.
+    const float left = layer_bounds.Left();
+    const float top = layer_bounds.Top();
+    const float grow = 1.f / scale;
+    Save();
+    const float shrink[6] = {scale, 0.f, 0.f, scale, left * (1.f - scale),
+                             top * (1.f - scale)};
+    Transform(shrink);
+    image_filter = ::skity::ImageFilters::Compose(
+        ::skity::ImageFilters::MatrixTransform(
+            ::skity::Matrix{grow, 0.f, left * (1.f - grow), 0.f, grow,
+                            top * (1.f - grow), 0.f, 0.f, 1.f}),
+        image_filter);
+  }
+
+  ::skity::Paint paint;
+  if (image_filter) {
+    paint.SetImageFilter(image_filter);
+  }
   canvas_->SaveLayer(layer_bounds, paint);
   PushTransformState();
   canvas_->DrawColor(0, ::skity::BlendMode::kSrc);
@@ -589,6 +671,12 @@ void SrSkityCanvas::BeginFilterLayer(const SrSVGBox* bounds,
 
 void SrSkityCanvas::EndFilterLayer() {
   RestoreLayer();
+  if (!filter_layer_scales_.empty()) {
+    if (filter_layer_scales_.back() < 1.f) {
+      Restore();
+    }
+    filter_layer_scales_.pop_back();
+  }
 }
 
 void SrSkityCanvas::BeginMaskLayer(const SrSVGBox* bounds, bool is_luminance) {
@@ -646,16 +734,8 @@ void SrSkityCanvas::RenderPatternTiles(
     }
   }
 
-  float origin_x =
-      resolved_pattern.x + std::floor((pattern_area.left - resolved_pattern.x) /
-                                      resolved_pattern.width) *
-                               resolved_pattern.width;
-  float origin_y =
-      resolved_pattern.y + std::floor((pattern_area.top - resolved_pattern.y) /
-                                      resolved_pattern.height) *
-                               resolved_pattern.height;
-  float right = pattern_area.left + pattern_area.width;
-  float bottom = pattern_area.top + pattern_area.height;
+  const element::PatternTileGrid grid = element::LayoutPatternTiles(
+      resolved_pattern, pattern_area, *current_render_context_);
   const bool has_resolved_view_box =
       resolved_pattern.has_view_box &&
       FloatsLarger(resolved_pattern.view_box.width, 0.f) &&
@@ -665,10 +745,10 @@ void SrSkityCanvas::RenderPatternTiles(
       SR_SVG_OBB_UNIT_TYPE_OBJECT_BOUNDING_BOX;
   SrSVGRenderContext base_tile_context = *current_render_context_;
 
-  for (float step_y = origin_y; step_y < bottom;
-       step_y += resolved_pattern.height) {
-    for (float step_x = origin_x; step_x < right;
-         step_x += resolved_pattern.width) {
+  for (uint32_t row = 0; row < grid.rows; ++row) {
+    const float step_y = grid.origin_y + row * resolved_pattern.height;
+    for (uint32_t column = 0; column < grid.columns; ++column) {
+      const float step_x = grid.origin_x + column * resolved_pattern.width;
       Save();
       canvas_->ClipRect(::skity::Rect::MakeXYWH(
           step_x, step_y, resolved_pattern.width, resolved_pattern.height));
@@ -915,9 +995,20 @@ void SrSkityCanvas::DrawPathWithRenderState(
   }
 }
 
+SrSkityCanvas::ScratchPath::ScratchPath(SrSkityCanvas* canvas)
+    : canvas_(canvas) {
+  auto& paths = canvas_->scratch_paths_;
+  if (canvas_->scratch_depth_ == paths.size()) {
+    paths.push_back(std::make_unique<::skity::Path>());
+  }
+  path_ = paths[canvas_->scratch_depth_++].get();
+  path_->Reset();
+}
+
 void SrSkityCanvas::DrawLine(const char*, float x1, float y1, float x2,
                              float y2, const SrSVGRenderState& render_state) {
-  ::skity::Path path;
+  ScratchPath scratch(this);
+  ::skity::Path& path = scratch.path();
   path.MoveTo(x1, y1);
   path.LineTo(x2, y2);
   DrawPathWithRenderState(path, render_state);
@@ -926,14 +1017,16 @@ void SrSkityCanvas::DrawLine(const char*, float x1, float y1, float x2,
 void SrSkityCanvas::DrawRect(const char* id, float x, float y, float rx,
                              float ry, float width, float height,
                              const SrSVGRenderState& render_state) {
-  ::skity::Path path;
+  ScratchPath scratch(this);
+  ::skity::Path& path = scratch.path();
   path.AddRoundRect({x, y, x + width, y + height}, rx, ry);
   DrawPathWithRenderState(path, render_state);
 }
 
 void SrSkityCanvas::DrawCircle(const char*, float cx, float cy, float r,
                                const SrSVGRenderState& render_state) {
-  ::skity::Path path;
+  ScratchPath scratch(this);
+  ::skity::Path& path = scratch.path();
   path.AddCircle(cx, cy, r);
   DrawPathWithRenderState(path, render_state);
 }
@@ -942,7 +1035,8 @@ void SrSkityCanvas::DrawPolygon(const char*, float* points, uint32_t n_points,
                                 const SrSVGRenderState& render_state) {
   if (n_points < 2)
     return;
-  ::skity::Path path;
+  ScratchPath scratch(this);
+  ::skity::Path& path = scratch.path();
   path.MoveTo(points[0], points[1]);
   for (uint32_t i = 1; i < n_points; ++i) {
     path.LineTo(points[2 * i], points[2 * i + 1]);
@@ -955,7 +1049,8 @@ void SrSkityCanvas::DrawPolyline(const char*, float* points, uint32_t n_points,
                                  const SrSVGRenderState& render_state) {
   if (n_points < 2)
     return;
-  ::skity::Path path;
+  ScratchPath scratch(this);
+  ::skity::Path& path = scratch.path();
   path.MoveTo(points[0], points[1]);
   for (uint32_t i = 1; i < n_points; ++i) {
     path.LineTo(points[2 * i], points[2 * i + 1]);
@@ -977,7 +1072,8 @@ void SrSkityCanvas::DrawPath(const char*, uint8_t* ops, uint32_t n_ops,
                              float* args, uint32_t n_args,
                              const SrSVGRenderState& render_state) {
   canvas_->Save();
-  ::skity::Path path;
+  ScratchPath scratch(this);
+  ::skity::Path& path = scratch.path();
   uint64_t iArg = 0;
   float x = 0.0f, y = 0.0f;
   float cp1x = 0.0f, cp1y = 0.0f, cp2x = 0.0f, cp2y = 0.0f;
@@ -1038,43 +1134,106 @@ void SrSkityCanvas::DrawUse(const char* href, float x, float y, float width,
 void SrSkityCanvas::DrawImage(
     const char* url, float x, float y, float width, float height,
     const SrSVGPreserveAspectRatio& preserve_aspect_radio, float opacity) {
-  if (url) {
-    std::string href(url);
-
-    if (image_callback_) {
-      auto image = image_callback_(href);
-      if (image) {
-        const float image_width = static_cast<float>(image->Width());
-        const float image_height = static_cast<float>(image->Height());
-        if (!FloatsLarger(image_width, 0.f) ||
-            !FloatsLarger(image_height, 0.f)) {
-          return;
-        }
-        if (!FloatsLarger(width, 0.f) || !FloatsLarger(height, 0.f)) {
-          return;
-        }
-        float form[6];
-        SrSVGBox view_port{x, y, width, height};
-        SrSVGBox view_box{0, 0, image_width, image_height};
-        calculate_view_box_transform(&view_port, &view_box,
-                                     preserve_aspect_radio, form);
-        canvas_->Save();
-        ::skity::Matrix box_transform{
-            form[0], form[2], form[4], form[1], form[3], form[5], 0, 0, 1};
-        canvas_->Concat(box_transform);
-        ::skity::Matrix flipY;
-        flipY.Scale(1, -1);
-        canvas_->Concat(flipY);
-        ::skity::SamplingOptions options{};
-        options.filter = ::skity::FilterMode::kLinear;
-        ::skity::Paint paint;
-        paint.SetAlpha(static_cast<uint8_t>(ClampUnitFloat(opacity) * 255.f));
-        canvas_->DrawImage(image, ::skity::Rect::MakeXYWH(x, y, width, height),
-                           options, &paint);
-        canvas_->Restore();
-      }
+  if (auto image = LoadImage(url)) {
+    DrawDecodedImage(*image, x, y, width, height, preserve_aspect_radio,
+                     opacity);
+  }
+}
+
+float SrSkityImage::Width() const {
+  return image_ ? static_cast<float>(image_->Width()) : 0.f;
+}
+
+float SrSkityImage::Height() const {
+  return image_ ? static_cast<float>(image_->Height()) : 0.f;
+}
+
+size_t SrSkityImage::ByteSize() const {
+  // Decoded as 32 bit pixels whether the image lives in memory or a texture.
+  return image_ ? static_cast<size_t>(image_->Width()) *
+                      static_cast<size_t>(image_->Height()) * 4
+                : 0;
+}
+
+canvas::SrImageCache& SrSkityCanvas::SharedImageCache() {
+  static canvas::SrImageCache* cache = new canvas::SrImageCache();
+  return *cache;
+}
+
+std::shared_ptr<canvas::SrDecodedImage> SrSkityCanvas::LoadImage(
+    const char* href) {
+  if (!href || !image_callback_) {
+    return nullptr;
+  }
+  const std::string key(href);
+  const auto load = [this, &key]() -> std::shared_ptr<canvas::SrDecodedImage> {
+    auto image = image_callback_(key);
+    if (!image) {
+      return nullptr;
     }
+    return std::make_shared<SrSkityImage>(std::move(image));
+  };
+  return host_images_ ? host_images_->Acquire(key, load) : load();
+}
+
+std::shared_ptr<canvas::SrDecodedImage> SrSkityCanvas::DecodeImage(
+    const uint8_t* data, size_t size) {
+  if (!data || size == 0) {
+    return nullptr;
+  }
+  auto encoded = ::skity::Data::MakeWithCopy(data, size);
+  auto codec = ::skity::Codec::MakeFromData(encoded);
+  if (!codec) {
+    return nullptr;
+  }
+  codec->SetData(encoded);
+  auto pixmap = codec->Decode();
+  if (!pixmap) {
+    return nullptr;
+  }
+  auto image = ::skity::Image::MakeImage(pixmap);
+  if (!image) {
+    return nullptr;
   }
+  return std::make_shared<SrSkityImage>(std::move(image));
+}
+
+void SrSkityCanvas::DrawDecodedImage(
+    const canvas::SrDecodedImage& decoded_image, float x, float y, float width,
+    float height, const SrSVGPreserveAspectRatio& preserve_aspect_radio,
+    float opacity) {
+  // Images reach this canvas only through LoadImage() and DecodeImage().
+  const auto& image = static_cast<const SrSkityImage&>(decoded_image).image();
+  if (!image) {
+    return;
+  }
+  const float image_width = static_cast<float>(image->Width());
+  const float image_height = static_cast<float>(image->Height());
+  if (!FloatsLarger(image_width, 0.f) || !FloatsLarger(image_height, 0.f)) {
+    return;
+  }
+  if (!FloatsLarger(width, 0.f) || !FloatsLarger(height, 0.f)) {
+    return;
+  }
+  float form[6];
+  SrSVGBox view_port{x, y, width, height};
+  SrSVGBox view_box{0, 0, image_width, image_height};
+  calculate_view_box_transform(&view_port, &view_box, preserve_aspect_radio,
+                               form);
+  canvas_->Save();
+  ::skity::Matrix box_transform{
+      form[0], form[2], form[4], form[1], form[3], form[5], 0, 0, 1};
+  canvas_->Concat(box_transform);
+  ::skity::Matrix flipY;
+  flipY.Scale(1, -1);
+  canvas_->Concat(flipY);
+  ::skity::SamplingOptions options{};
+  options.filter = ::skity::FilterMode::kLinear;
+  ::skity::Paint paint;
+  paint.SetAlpha(static_cast<uint8_t>(ClampUnitFloat(opacity) * 255.f));
+  canvas_->DrawImage(image, ::skity::Rect::MakeXYWH(x, y, width, height),
+                     options, &paint);
+  canvas_->Restore();
 }
 
 void SrSkityCanvas::SetViewBox(float x, float y, float width, float height) {
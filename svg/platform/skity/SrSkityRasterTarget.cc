@@ -0,0 +1,68 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "platform/skity/SrSkityRasterTarget.h"
+
+#include <cstring>
+#include <utility>
+
+namespace serval {
+namespace svg {
+namespace skity {
+
+std::unique_ptr<SrSkityRasterTarget> SrSkityRasterTarget::Make(
+    uint32_t width, uint32_t height, SrSkityCanvas::ImageCallback callback,
+    canvas::SrImageCache* image_cache,
+    std::shared_ptr<canvas::SrImageCache> host_images) {
+  std::unique_ptr<SrSkityRasterTarget> target(new SrSkityRasterTarget());
+  target->bitmap_ = std::make_unique<::skity::Bitmap>(
+      width, height, ::skity::AlphaType::kPremul_AlphaType);
+  target->canvas_ = ::skity::Canvas::MakeSoftwareCanvas(target->bitmap_.get());
+  if (!target->canvas_) {
+    return nullptr;
+  }
+  target->sr_canvas_ = std::make_unique<SrSkityCanvas>(target->canvas_.get(),
+                                                       std::move(callback));
+  target->sr_canvas_->SetImageCache(image_cache);
+  if (host_images) {
+    target->sr_canvas_->SetHostImageMemo(std::move(host_images));
+  }
+  return target;
+}
+
+renderer::SrSVGRasterTargetFactory SrSkityRasterTarget::Factory(
+    SrSkityCanvas::ImageCallback callback, canvas::SrImageCache* image_cache) {
+  auto host_images = std::make_shared<canvas::SrImageCache>(
+      canvas::SrImageCache::kDefaultCapacityBytes, true);
+  return [callback = std::move(callback), image_cache, host_images](
+             uint32_t width,
+             uint32_t height) -> std::unique_ptr<renderer::SrSVGRasterTarget> {
+    return Make(width, height, callback, image_cache, host_images);
+  };
+}
+
+bool SrSkityRasterTarget::ReadPixels(std::vector<uint8_t>* pixels) {
+  if (!pixels || !canvas_) {
+    return false;
+  }
+  canvas_->Flush();
+  auto pixmap = bitmap_->GetPixmap();
+  if (!pixmap || !pixmap->Addr() ||
+      pixmap->GetColorType() != ::skity::ColorType::kRGBA) {
+    return false;
+  }
+  const size_t row_bytes = static_cast<size_t>(pixmap->Width()) * 4;
+  const size_t height = pixmap->Height();
+  const auto* source = static_cast<const uint8_t*>(pixmap->Addr());
+  pixels->resize(row_bytes * height);
+  for (size_t row = 0; row < height; ++row) {
+    std::memcpy(pixels->data() + row * row_bytes,
+                source + row * pixmap->RowBytes(), row_bytes);
+  }
+  return true;
+}
+
+}  // namespace skity
+}  // namespace svg
+}  // namespace serval
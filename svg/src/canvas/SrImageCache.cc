@@ -0,0 +1,44 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "canvas/SrImageCache.h"
+
+#include <utility>
+
+namespace serval {
+namespace svg {
+namespace canvas {
+
+SrImageCache::SrImageCache(size_t capacity_bytes, bool cache_host_images)
+    : images_(capacity_bytes), cache_host_images_(cache_host_images) {}
+
+std::shared_ptr<SrDecodedImage> SrImageCache::Acquire(const std::string& href,
+                                                      const Loader& load) {
+  if (auto image = images_.Find(href)) {
+    return image;
+  }
+  // Load without holding the lock.
+  auto image = load ? load() : nullptr;
+  if (!image) {
+    return nullptr;
+  }
+  const size_t bytes = image->ByteSize() + href.size();
+  return images_.Insert(href, std::move(image), bytes);
+}
+
+void SrImageCache::SetCapacity(size_t capacity_bytes) {
+  images_.SetCapacity(capacity_bytes);
+}
+
+void SrImageCache::Clear() {
+  images_.Clear();
+}
+
+SrImageCacheStats SrImageCache::stats() const {
+  return images_.stats();
+}
+
+}  // namespace canvas
+}  // namespace svg
+}  // namespace serval
@@ -0,0 +1,283 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "element/SrSVGAnimatedAttributes.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+#include "element/SrSVGAnimation.h"
+#include "element/SrSVGNode.h"
+
+namespace serval {
+namespace svg {
+namespace element {
+
+namespace {
+
+bool ParseNumberWithSuffix(const std::string& value, double* number,
+                           std::string* suffix) {
+  if (!number || !suffix) {
+    return false;
+  }
+  char* end = nullptr;
+  const double parsed = std::strtod(value.c_str(), &end);
+  if (end == value.c_str()) {
+    return false;
+  }
+  *number = parsed;
+  *suffix = end ? end : "";
+  return true;
+}
+
+std::string AddAnimatedScalarValue(const std::string& base,
+                                   const std::string& addition) {
+  double base_number = 0.0;
+  double addition_number = 0.0;
+  std::string base_suffix;
+  std::string addition_suffix;
+  if (!ParseNumberWithSuffix(base, &base_number, &base_suffix) ||
+      !ParseNumberWithSuffix(addition, &addition_number, &addition_suffix) ||
+      base_suffix != addition_suffix) {
+    return "";
+  }
+  std::ostringstream stream;
+  stream << base_number + addition_number << base_suffix;
+  return stream.str();
+}
+
+}  // namespace
+
+SrSVGAnimatedValue::Kind SrSVGAnimatedField::Kind() const {
+  if (length || optional_length || number || optional_number) {
+    return SrSVGAnimatedValue::Kind::kNumber;
+  }
+  if (color || optional_color || paint) {
+    return SrSVGAnimatedValue::Kind::kColor;
+  }
+  return SrSVGAnimatedValue::Kind::kNone;
+}
+
+void SrSVGAnimatedAttributes::StoreBaseValue(const char* name,
+                                             const char* value) {
+  if (name && value) {
+    base_values_[name] = value;
+    slots_built_ = false;
+  }
+}
+
+void SrSVGAnimatedAttributes::AddAnimation(SrSVGAnimation* animation) {
+  if (animation && std::find(animations_.begin(), animations_.end(),
+                             animation) == animations_.end()) {
+    animations_.push_back(animation);
+    slots_built_ = false;
+  }
+}
+
+void SrSVGAnimatedAttributes::BuildSlots(SrSVGNodeBase* node) {
+  slots_.clear();
+  animation_slots_.assign(animations_.size(), -1);
+  // ParseStyle() may set any field, so a node whose style is animated keeps
+  // every attribute on the text path.
+  bool typed = true;
+  for (size_t i = 0; i < animations_.size(); ++i) {
+    if (!animations_[i]) {
+      continue;
+    }
+    const std::string name = animations_[i]->TargetAttributeName();
+    if (name.empty()) {
+      continue;
+    }
+    typed = typed && name != "style";
+    auto it = std::find_if(slots_.begin(), slots_.end(),
+                           [&name](const Slot& slot) {
+                             return slot.name == name;
+                           });
+    if (it == slots_.end()) {
+      Slot slot;
+      slot.name = name;
+      auto base_it = base_values_.find(name);
+      slot.base = base_it == base_values_.end() ? nullptr : &base_it->second;
+      it = slots_.insert(slots_.end(), std::move(slot));
+    }
+    animation_slots_[i] = static_cast<int32_t>(it - slots_.begin());
+  }
+
+  for (size_t index = 0; index < slots_.size() && typed; ++index) {
+    Slot& slot = slots_[index];
+    slot.field = node->AnimatedField(slot.name.c_str());
+    const SrSVGAnimatedValue::Kind kind = slot.field.Kind();
+    slot.typed = kind != SrSVGAnimatedValue::Kind::kNone &&
+                 (!slot.base ||
+                  (SrSVGAnimation::ParseAnimatedValue(*slot.base,
+                                                      &slot.base_value) &&
+                   slot.base_value.kind == kind));
+    for (size_t i = 0; i < animations_.size() && slot.typed; ++i) {
+      slot.typed = animation_slots_[i] != static_cast<int32_t>(index) ||
+                   animations_[i]->TypedKind() == kind;
+    }
+  }
+  slots_built_ = true;
+}
+
+void SrSVGAnimatedAttributes::Apply(SrSVGNodeBase* node, double seconds,
+                                    const IDMapper* id_mapper) {
+  if (!slots_built_) {
+    BuildSlots(node);
+  }
+  for (Slot& slot : slots_) {
+    if (slot.typed) {
+      slot.value = slot.base_value;
+    } else if (slot.base) {
+      slot.presentation.assign(*slot.base);
+    } else {
+      slot.presentation.clear();
+    }
+  }
+  for (size_t i = 0; i < animations_.size(); ++i) {
+    if (animation_slots_[i] < 0) {
+      continue;
+    }
+    Slot* slot = &slots_[animation_slots_[i]];
+    if (slot->typed) {
+      ApplyTyped(slot, *animations_[i], seconds, id_mapper);
+    } else {
+      ApplyText(node, slot, *animations_[i], seconds, id_mapper);
+    }
+  }
+}
+
+void SrSVGAnimatedAttributes::ApplyTyped(Slot* slot,
+                                         const SrSVGAnimation& animation,
+                                         double seconds,
+                                         const IDMapper* id_mapper) {
+  SrSVGAnimatedValue value;
+  bool additive = false;
+  if (!animation.EvaluateTyped(seconds, id_mapper, slot->value, &value,
+                               &additive)) {
+    return;
+  }
+  // Same rule as AddAnimatedScalarValue(): only numbers in one unit add up.
+  if (additive && value.kind == SrSVGAnimatedValue::Kind::kNumber &&
+      slot->value.kind == value.kind && slot->value.unit == value.unit) {
+    value.number += slot->value.number;
+  }
+  slot->value = value;
+  if (!slot->applied) {
+    SaveField(slot);
+    slot->applied = true;
+  }
+  WriteField(slot);
+}
+
+void SrSVGAnimatedAttributes::ApplyText(SrSVGNodeBase* node, Slot* slot,
+                                        const SrSVGAnimation& animation,
+                                        double seconds,
+                                        const IDMapper* id_mapper) {
+  SrSVGAnimation::Effect effect;
+  if (!animation.Evaluate(seconds, id_mapper, slot->presentation, &effect) ||
+      effect.attribute.empty()) {
+    return;
+  }
+  slot->applied = true;
+  std::string& presentation = slot->presentation;
+  if (effect.transform && effect.additive && !presentation.empty()) {
+    presentation.push_back(' ');
+    presentation.append(effect.value);
+  } else if (effect.additive && !presentation.empty()) {
+    const std::string added =
+        AddAnimatedScalarValue(presentation, effect.value);
+    presentation.assign(added.empty() ? effect.value : added);
+  } else {
+    presentation.assign(effect.value);
+  }
+  if (effect.path_data && slot->name == "d" &&
+      node->SetAnimatedPathData(effect.path_data)) {
+    return;
+  }
+  node->ParseAndSetAttribute(slot->name.c_str(), presentation.c_str());
+}
+
+void SrSVGAnimatedAttributes::Restore(SrSVGNodeBase* node) {
+  for (Slot& slot : slots_) {
+    if (!slot.applied) {
+      continue;
+    }
+    slot.applied = false;
+    if (slot.typed) {
+      RestoreField(&slot);
+    } else if (slot.base) {
+      node->ParseAndSetAttribute(slot.name.c_str(), slot.base->c_str());
+    } else {
+      node->ClearAnimatedAttribute(slot.name);
+    }
+  }
+}
+
+void SrSVGAnimatedAttributes::SaveField(Slot* slot) {
+  const SrSVGAnimatedField& field = slot->field;
+  if (field.length) {
+    slot->saved_length = *field.length;
+  } else if (field.optional_length) {
+    slot->saved_optional_length = *field.optional_length;
+  } else if (field.number) {
+    slot->saved_number = *field.number;
+  } else if (field.optional_number) {
+    slot->saved_optional_number = *field.optional_number;
+  } else if (field.color) {
+    slot->saved_color = *field.color;
+  } else if (field.optional_color) {
+    slot->saved_optional_color = *field.optional_color;
+  } else if (field.paint) {
+    slot->saved_paint = *field.paint;
+  }
+}
+
+void SrSVGAnimatedAttributes::WriteField(Slot* slot) {
+  const SrSVGAnimatedField& field = slot->field;
+  const SrSVGAnimatedValue& value = slot->value;
+  const SrSVGLength length{static_cast<float>(value.number), value.unit};
+  const SrSVGColor color{SERVAL_COLOR, value.color};
+  if (field.length) {
+    *field.length = length;
+  } else if (field.optional_length) {
+    *field.optional_length = length;
+  } else if (field.number) {
+    *field.number = static_cast<float>(value.number);
+  } else if (field.optional_number) {
+    *field.optional_number = static_cast<float>(value.number);
+  } else if (field.color) {
+    *field.color = color;
+  } else if (field.optional_color) {
+    *field.optional_color = color;
+  } else if (field.paint) {
+    slot->paint.type = SERVAL_PAINT_COLOR;
+    slot->paint.content.color = color;
+    *field.paint = &slot->paint;
+  }
+}
+
+void SrSVGAnimatedAttributes::RestoreField(Slot* slot) {
+  const SrSVGAnimatedField& field = slot->field;
+  if (field.length) {
+    *field.length = slot->saved_length;
+  } else if (field.optional_length) {
+    *field.optional_length = slot->saved_optional_length;
+  } else if (field.number) {
+    *field.number = slot->saved_number;
+  } else if (field.optional_number) {
+    *field.optional_number = slot->saved_optional_number;
+  } else if (field.color) {
+    *field.color = slot->saved_color;
+  } else if (field.optional_color) {
+    *field.optional_color = slot->saved_optional_color;
+  } else if (field.paint) {
+    *field.paint = slot->saved_paint;
+  }
+}
+
+}  // namespace element
+}  // namespace svg
+}  // namespace serval
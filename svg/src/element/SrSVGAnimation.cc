@@ -248,6 +248,29 @@ std::string InterpolateScalar(const std::string& from, const std::string& to,
          from_suffix;
 }
 
+// Typed InterpolateScalar(). Colors are rounded to bytes, as their text is.
+SrSVGAnimatedValue InterpolateAnimatedValue(const SrSVGAnimatedValue& from,
+                                            const SrSVGAnimatedValue& to,
+                                            double progress) {
+  using Kind = SrSVGAnimatedValue::Kind;
+  SrSVGAnimatedValue value = from;
+  if (from.kind == Kind::kColor && to.kind == Kind::kColor) {
+    auto channel = [&](int shift) {
+      const double a = static_cast<double>((from.color >> shift) & 0xff);
+      const double b = static_cast<double>((to.color >> shift) & 0xff);
+      return static_cast<uint32_t>(ClampByte(a + (b - a) * progress));
+    };
+    value.color = NSVG_RGBA(channel(16), channel(8), channel(0), channel(24));
+    return value;
+  }
+  if (from.kind == Kind::kNumber && to.kind == Kind::kNumber &&
+      from.unit == to.unit) {
+    value.number = from.number + (to.number - from.number) * progress;
+    return value;
+  }
+  return progress < 1.0 ? from : to;
+}
+
 std::vector<double> ParseNumberList(const std::string& value) {
   std::vector<double> numbers;
   std::string normalized = value;
@@ -487,6 +510,17 @@ double NumericDistance(const std::string& from, const std::string& to) {
   return 1.0;
 }
 
+// Key time |index| of BuildEvenKeyTimes(), without building the list.
+double EvenKeyTime(size_t index, size_t value_count, bool discrete_mode) {
+  if (!discrete_mode && index + 1 == value_count) {
+    return value_count > 1 ? 1.0 : 0.0;
+  }
+  const size_t divisor = discrete_mode ? value_count : value_count - 1;
+  return divisor == 0
+             ? 0.0
+             : static_cast<double>(index) / static_cast<double>(divisor);
+}
+
 std::vector<double> BuildEvenKeyTimes(size_t value_count, bool discrete_mode) {
   std::vector<double> times;
   if (value_count == 0) {
@@ -571,7 +605,7 @@ struct KeyedSegment {
 };
 
 KeyedSegment ResolveKeyedSegment(double progress, size_t value_count,
-                                 std::vector<double> key_times,
+                                 const std::vector<double>& key_times,
                                  const std::vector<double>& key_splines,
                                  const std::string& calc_mode) {
   KeyedSegment segment;
@@ -579,9 +613,11 @@ KeyedSegment ResolveKeyedSegment(double progress, size_t value_count,
     return segment;
   }
   const bool discrete = calc_mode == "discrete";
-  if (key_times.size() != value_count) {
-    key_times = BuildEvenKeyTimes(value_count, discrete);
-  }
+  // Key times that do not match the values are spread evenly instead.
+  const bool even = key_times.size() != value_count;
+  auto key_time = [&](size_t index) {
+    return even ? EvenKeyTime(index, value_count, discrete) : key_times[index];
+  };
   if (discrete) {
     if (progress >= 1.0) {
       segment.from_index = value_count - 1;
@@ -589,8 +625,8 @@ KeyedSegment ResolveKeyedSegment(double progress, size_t value_count,
       return segment;
     }
     for (size_t i = 0; i < value_count; ++i) {
-      const double start = i < key_times.size() ? key_times[i] : 0.0;
-      const double end = i + 1 < key_times.size() ? key_times[i + 1] : 1.0;
+      const double start = key_time(i);
+      const double end = i + 1 < value_count ? key_time(i + 1) : 1.0;
       if (progress >= start && progress < end) {
         segment.from_index = i;
         segment.to_index = i;
@@ -609,8 +645,8 @@ KeyedSegment ResolveKeyedSegment(double progress, size_t value_count,
     return segment;
   }
   for (size_t i = 0; i + 1 < value_count; ++i) {
-    const double start = key_times[i];
-    const double end = key_times[i + 1];
+    const double start = key_time(i);
+    const double end = key_time(i + 1);
     if (progress >= start && progress <= end) {
       segment.from_index = i;
       segment.to_index = i + 1;
@@ -1254,6 +1290,7 @@ void SrSVGAnimation::ResetPathDataCaches() const {
 void SrSVGAnimation::ResetCaches() const {
   ResetMotionPathCache();
   ResetPathDataCaches();
+  typed_keyframes_ = TypedKeyframes{};
 }
 
 bool SrSVGAnimation::EnsureMotionPathCacheForPathString(
@@ -1388,6 +1425,7 @@ const SrPathData* SrSVGAnimation::MakePathDataValue(
 
 bool SrSVGAnimation::ParseAndSetAttribute(const char* name, const char* value) {
   ResetCaches();
+  InvalidateTimeline();
   if (std::strcmp(name, "attributeName") == 0) {
     attribute_name_ = value;
   } else if (std::strcmp(name, "href") == 0 ||
@@ -1774,6 +1812,130 @@ std::string SrSVGAnimation::MakeValue(const ActiveState& state,
   return value;
 }
 
+bool SrSVGAnimation::ParseAnimatedValue(const std::string& text,
+                                        SrSVGAnimatedValue* value) {
+  // Elements parse the text as written, so anything InterpolateScalar()
+  // would trim, lowercase or treat as a keyword stays on the text path.
+  if (!value || text.empty() || text != Trim(text) || text == "none") {
+    return false;
+  }
+  ColorValue color;
+  if (ParseColorValue(text, &color)) {
+    uint32_t rgba = 0;
+    if (!parse_svg_color(text.c_str(), &rgba)) {
+      return false;
+    }
+    value->kind = SrSVGAnimatedValue::Kind::kColor;
+    value->color = rgba;
+    return true;
+  }
+  double number = 0.0;
+  std::string suffix;
+  if (!ParseNumberWithSuffix(text, &number, &suffix) ||
+      text.find_first_not_of("0123456789+-.eE") <
+          text.size() - suffix.size()) {
+    return false;
+  }
+  const SrSVGUnits unit = suffix.empty()
+                              ? SR_SVG_UNITS_NUMBER
+                              : make_serval_length_unit(suffix.c_str());
+  if (!suffix.empty() && unit == SR_SVG_UNITS_NUMBER) {
+    return false;
+  }
+  value->kind = SrSVGAnimatedValue::Kind::kNumber;
+  value->number = number;
+  value->unit = unit;
+  return true;
+}
+
+const SrSVGAnimation::TypedKeyframes& SrSVGAnimation::EnsureTypedKeyframes()
+    const {
+  TypedKeyframes& keyframes = typed_keyframes_;
+  if (keyframes.parsed) {
+    return keyframes;
+  }
+  keyframes.parsed = true;
+  if ((Tag() != SrSVGTag::kAnimate && Tag() != SrSVGTag::kAnimateColor) ||
+      attribute_name_.empty() || attribute_name_ == "d" ||
+      IsNumberListAttribute(attribute_name_) || accumulate_sum_) {
+    return keyframes;
+  }
+  // Same keyframes as MakeValue(), parsed once.
+  std::vector<std::string> candidates = values_;
+  if (candidates.empty()) {
+    if (!from_.empty() && !to_.empty()) {
+      candidates = {from_, to_};
+    } else if (!from_.empty() && !by_.empty()) {
+      const std::string to = AddNumericValue(from_, by_, 1.0);
+      if (!to.empty()) {
+        candidates = {from_, to};
+      }
+    } else if (!to_.empty()) {
+      candidates = {to_, to_};
+      keyframes.from_underlying = true;
+    } else if (!by_.empty()) {
+      const std::string zero = ZeroValueFor(by_);
+      if (!zero.empty()) {
+        candidates = {zero, by_};
+      }
+    } else if (!from_.empty()) {
+      candidates = {from_};
+    }
+  }
+  std::vector<SrSVGAnimatedValue> values(candidates.size());
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (!ParseAnimatedValue(candidates[i], &values[i]) ||
+        values[i].kind != values.front().kind) {
+      return keyframes;
+    }
+  }
+  keyframes.calc_mode = EffectiveCalcMode(Tag(), calc_mode_);
+  keyframes.key_times = keyframes.calc_mode == "paced"
+                            ? BuildPacedKeyTimes(candidates)
+                            : key_times_;
+  keyframes.additive = additive_sum_ || (!by_.empty() && from_.empty());
+  keyframes.values = std::move(values);
+  return keyframes;
+}
+
+SrSVGAnimatedValue::Kind SrSVGAnimation::TypedKind() const {
+  const TypedKeyframes& keyframes = EnsureTypedKeyframes();
+  return keyframes.values.empty() ? SrSVGAnimatedValue::Kind::kNone
+                                  : keyframes.values.front().kind;
+}
+
+bool SrSVGAnimation::EvaluateTyped(double seconds, const IDMapper* id_mapper,
+                                   const SrSVGAnimatedValue& underlying,
+                                   SrSVGAnimatedValue* value,
+                                   bool* additive) const {
+  const TypedKeyframes& keyframes = EnsureTypedKeyframes();
+  if (!value || keyframes.values.empty()) {
+    return false;
+  }
+  ActiveState state;
+  if (!ActiveStateAt(seconds, id_mapper, &state)) {
+    return false;
+  }
+  auto keyframe = [&](size_t index) -> const SrSVGAnimatedValue& {
+    return index == 0 && keyframes.from_underlying &&
+                   underlying.kind != SrSVGAnimatedValue::Kind::kNone
+               ? underlying
+               : keyframes.values[index];
+  };
+  const KeyedSegment segment = ResolveKeyedSegment(
+      state.progress, keyframes.values.size(), keyframes.key_times,
+      key_splines_, keyframes.calc_mode);
+  *value = segment.from_index == segment.to_index
+               ? keyframe(segment.from_index)
+               : InterpolateAnimatedValue(keyframe(segment.from_index),
+                                          keyframe(segment.to_index),
+                                          segment.local_progress);
+  if (additive) {
+    *additive = keyframes.additive;
+  }
+  return true;
+}
+
 std::vector<double> SrSVGAnimation::ResolvedTimeSpecSeconds(
     const std::vector<BeginSpec>& specs, const IDMapper* id_mapper,
     int depth) const {
@@ -1820,6 +1982,9 @@ std::vector<double> SrSVGAnimation::ResolvedTimeSpecSeconds(
 
 std::vector<double> SrSVGAnimation::ResolvedBeginSecondsList(
     const IDMapper* id_mapper, int depth) const {
+  if (timeline_.resolved) {
+    return timeline_.begins;
+  }
   if (depth > 8) {
     return {};
   }
@@ -1831,7 +1996,13 @@ std::vector<double> SrSVGAnimation::ResolvedBeginSecondsList(
 
 std::vector<double> SrSVGAnimation::ResolvedEndSecondsList(
     const IDMapper* id_mapper, int depth) const {
-  if (!has_end_ || depth > 8 || end_specs_.empty()) {
+  if (!has_end_ || end_specs_.empty()) {
+    return {};
+  }
+  if (timeline_.resolved) {
+    return timeline_.ends;
+  }
+  if (depth > 8) {
     return {};
   }
   return ResolvedTimeSpecSeconds(end_specs_, id_mapper, depth);
@@ -1895,9 +2066,91 @@ double SrSVGAnimation::ResolvedActiveDuration(const IDMapper* id_mapper,
 }
 
 double SrSVGAnimation::LastChangeSeconds(const IDMapper* id_mapper) const {
+  if (timeline_.resolved) {
+    return timeline_.last_change;
+  }
   return ResolvedLastChangeSeconds(id_mapper, 0);
 }
 
+void SrSVGAnimation::ResolveTimeline(const IDMapper* id_mapper) {
+  InvalidateTimeline();
+  ResolvedTimeline timeline;
+  timeline.begins = ResolvedBeginSecondsList(id_mapper, 0);
+  SortAndUniqueTimes(&timeline.begins);
+  timeline.ends = ResolvedEndSecondsList(id_mapper, 1);
+  timeline.resolved = true;
+  // Later lookups below read the lists resolved above.
+  timeline_ = std::move(timeline);
+
+  std::vector<AcceptedInterval> intervals;
+  if (dur_ > 0.0 && !dur_indefinite_) {
+    double accepted_end = -std::numeric_limits<double>::infinity();
+    constexpr double kEpsilon = 1e-9;
+    for (const double candidate_begin : timeline_.begins) {
+      const double candidate_duration =
+          ResolvedActiveDurationForBegin(candidate_begin, id_mapper, 0);
+      if (candidate_duration <= 0.0) {
+        continue;
+      }
+      if (restart_ == Restart::kNever && !intervals.empty()) {
+        break;
+      }
+      if (restart_ == Restart::kWhenNotActive && !intervals.empty() &&
+          candidate_begin < accepted_end - kEpsilon) {
+        continue;
+      }
+      accepted_end = std::isinf(candidate_duration)
+                         ? std::numeric_limits<double>::infinity()
+                         : candidate_begin + candidate_duration;
+      intervals.push_back({candidate_begin, candidate_duration});
+    }
+  }
+  timeline_.intervals = std::move(intervals);
+  timeline_.last_change = ResolvedLastChangeSeconds(id_mapper, 0);
+}
+
+void SrSVGAnimation::AppendSyncDependencies(
+    std::vector<std::string>* ids) const {
+  for (const auto& spec : begin_specs_) {
+    if (spec.type != BeginType::kStatic && !spec.sync_id.empty()) {
+      ids->push_back(spec.sync_id);
+    }
+  }
+  if (!has_end_) {
+    return;
+  }
+  for (const auto& spec : end_specs_) {
+    if (spec.type != BeginType::kStatic && !spec.sync_id.empty()) {
+      ids->push_back(spec.sync_id);
+    }
+  }
+}
+
+void SrSVGAnimation::AppendEffectIntervals(
+    std::vector<SrSVGAnimationInterval>* intervals) const {
+  constexpr double kInfinity = std::numeric_limits<double>::infinity();
+  if (Tag() == SrSVGTag::kMPath || timeline_.begins.empty()) {
+    return;
+  }
+  // Mirrors the cases of ActiveStateAt().
+  const double first_begin = timeline_.begins.front();
+  if (Tag() == SrSVGTag::kSet && dur_ <= 0.0 && !has_end_) {
+    intervals->push_back({first_begin, kInfinity});
+    return;
+  }
+  if (dur_indefinite_) {
+    if (Tag() == SrSVGTag::kSet) {
+      intervals->push_back({first_begin, kInfinity});
+    }
+    return;
+  }
+  for (const auto& interval : timeline_.intervals) {
+    intervals->push_back(
+        {interval.begin,
+         freeze_ ? kInfinity : interval.begin + interval.duration});
+  }
+}
+
 double SrSVGAnimation::ResolvedLastChangeSeconds(const IDMapper* id_mapper,
                                                  int depth) const {
   if (Tag() == SrSVGTag::kMPath || depth > 8) {
@@ -1957,11 +2210,16 @@ bool SrSVGAnimation::ActiveStateAt(double seconds, const IDMapper* id_mapper,
   if (!state) {
     return false;
   }
-  auto begins = ResolvedBeginSecondsList(id_mapper, 0);
+  std::vector<double> unresolved_begins;
+  if (!timeline_.resolved) {
+    unresolved_begins = ResolvedBeginSecondsList(id_mapper, 0);
+    SortAndUniqueTimes(&unresolved_begins);
+  }
+  const std::vector<double>& begins =
+      timeline_.resolved ? timeline_.begins : unresolved_begins;
   if (begins.empty()) {
     return false;
   }
-  SortAndUniqueTimes(&begins);
   if (Tag() == SrSVGTag::kSet && dur_ <= 0.0 && !has_end_) {
     const auto first_begin = begins.front();
     if (seconds < first_begin) {
@@ -1985,34 +2243,51 @@ bool SrSVGAnimation::ActiveStateAt(double seconds, const IDMapper* id_mapper,
   bool has_interval = false;
   double selected_begin = 0.0;
   double selected_duration = 0.0;
-  double accepted_end = -std::numeric_limits<double>::infinity();
-  bool accepted_once = false;
   constexpr double kEpsilon = 1e-9;
-  for (const double candidate_begin : begins) {
-    if (candidate_begin > seconds + kEpsilon) {
-      break;
+  if (timeline_.resolved) {
+    // The last accepted interval that has begun; restart rules only depend
+    // on earlier intervals, so the resolved list is valid for any time.
+    const auto& intervals = timeline_.intervals;
+    auto it = std::upper_bound(
+        intervals.begin(), intervals.end(), seconds + kEpsilon,
+        [](double time, const AcceptedInterval& interval) {
+          return time < interval.begin;
+        });
+    if (it != intervals.begin()) {
+      --it;
+      selected_begin = it->begin;
+      selected_duration = it->duration;
+      has_interval = true;
     }
-    const double candidate_duration =
-        ResolvedActiveDurationForBegin(candidate_begin, id_mapper, 0);
-    if (candidate_duration <= 0.0) {
-      continue;
-    }
-    if (restart_ == Restart::kNever && accepted_once) {
-      break;
-    }
-    if (restart_ == Restart::kWhenNotActive && accepted_once &&
-        candidate_begin < accepted_end - kEpsilon) {
-      continue;
-    }
-    accepted_once = true;
-    accepted_end = std::isinf(candidate_duration)
-                       ? std::numeric_limits<double>::infinity()
-                       : candidate_begin + candidate_duration;
-    selected_begin = candidate_begin;
-    selected_duration = candidate_duration;
-    has_interval = true;
-    if (restart_ == Restart::kNever) {
-      break;
+  } else {
+    double accepted_end = -std::numeric_limits<double>::infinity();
+    bool accepted_once = false;
+    for (const double candidate_begin : begins) {
+      if (candidate_begin > seconds + kEpsilon) {
+        break;
+      }
+      const double candidate_duration =
+          ResolvedActiveDurationForBegin(candidate_begin, id_mapper, 0);
+      if (candidate_duration <= 0.0) {
+        continue;
+      }
+      if (restart_ == Restart::kNever && accepted_once) {
+        break;
+      }
+      if (restart_ == Restart::kWhenNotActive && accepted_once &&
+          candidate_begin < accepted_end - kEpsilon) {
+        continue;
+      }
+      accepted_once = true;
+      accepted_end = std::isinf(candidate_duration)
+                         ? std::numeric_limits<double>::infinity()
+                         : candidate_begin + candidate_duration;
+      selected_begin = candidate_begin;
+      selected_duration = candidate_duration;
+      has_interval = true;
+      if (restart_ == Restart::kNever) {
+        break;
+      }
     }
   }
   if (!has_interval || seconds < selected_begin) {
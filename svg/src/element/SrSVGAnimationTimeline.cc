@@ -0,0 +1,200 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "element/SrSVGAnimationTimeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+namespace serval {
+namespace svg {
+namespace element {
+
+namespace {
+
+// Keeps the index a superset of what ActiveStateAt() accepts when interval
+// ends are rounded differently.
+constexpr double kEndSlack = 1e-6;
+
+bool IsTimedAnimationTag(SrSVGTag tag) {
+  return tag == SrSVGTag::kAnimate || tag == SrSVGTag::kAnimateColor ||
+         tag == SrSVGTag::kAnimateMotion ||
+         tag == SrSVGTag::kAnimateTransform || tag == SrSVGTag::kSet;
+}
+
+}  // namespace
+
+void SrSVGAnimationTimeline::Build(
+    const std::vector<SrSVGNodeBase*>& animated_nodes,
+    const std::list<SrSVGNodeBase*>& nodes, const IDMapper* id_mapper) {
+  Clear();
+  std::vector<SrSVGAnimation*> animations;
+  std::unordered_map<const SrSVGNodeBase*, uint32_t> animation_index;
+  for (auto* node : nodes) {
+    if (node && IsTimedAnimationTag(node->Tag())) {
+      animation_index.emplace(node, static_cast<uint32_t>(animations.size()));
+      animations.push_back(static_cast<SrSVGAnimation*>(node));
+    }
+  }
+
+  // Kahn's algorithm over syncbase references. Animations on a cycle never
+  // reach in-degree zero and are resolved last through the bounded recursive
+  // lookup, as before.
+  std::vector<std::vector<uint32_t>> dependents(animations.size());
+  std::vector<uint32_t> in_degree(animations.size(), 0);
+  std::vector<std::string> ids;
+  for (uint32_t i = 0; i < animations.size(); ++i) {
+    animations[i]->InvalidateTimeline();
+    ids.clear();
+    animations[i]->AppendSyncDependencies(&ids);
+    for (const auto& id : ids) {
+      if (!id_mapper) {
+        break;
+      }
+      const auto it = id_mapper->find(id);
+      if (it == id_mapper->end()) {
+        continue;
+      }
+      const auto dependency = animation_index.find(it->second);
+      if (dependency == animation_index.end()) {
+        continue;
+      }
+      dependents[dependency->second].push_back(i);
+      ++in_degree[i];
+    }
+  }
+  std::vector<uint32_t> ready;
+  for (uint32_t i = animations.size(); i > 0; --i) {
+    if (in_degree[i - 1] == 0) {
+      ready.push_back(i - 1);
+    }
+  }
+  std::vector<bool> resolved(animations.size(), false);
+  dependency_order_.reserve(animations.size());
+  while (!ready.empty()) {
+    const uint32_t index = ready.back();
+    ready.pop_back();
+    resolved[index] = true;
+    dependency_order_.push_back(animations[index]);
+    for (const uint32_t dependent : dependents[index]) {
+      if (--in_degree[dependent] == 0) {
+        ready.push_back(dependent);
+      }
+    }
+  }
+  for (uint32_t i = 0; i < animations.size(); ++i) {
+    if (!resolved[i]) {
+      dependency_order_.push_back(animations[i]);
+    }
+  }
+
+  for (auto* animation : dependency_order_) {
+    animation->ResolveTimeline(id_mapper);
+    const double last_change = animation->LastChangeSeconds(id_mapper);
+    end_seconds_ = std::max(end_seconds_, last_change);
+  }
+
+  std::vector<SrSVGAnimationInterval> intervals;
+  for (uint32_t node = 0; node < animated_nodes.size(); ++node) {
+    const auto* node_animations =
+        animated_nodes[node] ? animated_nodes[node]->Animations() : nullptr;
+    if (!node_animations) {
+      // Nodes that do not expose their animations are applied every frame.
+      entries_.push_back({-std::numeric_limits<double>::infinity(),
+                          std::numeric_limits<double>::infinity(), node});
+      continue;
+    }
+    for (const auto* animation : *node_animations) {
+      if (!animation) {
+        continue;
+      }
+      intervals.clear();
+      animation->AppendEffectIntervals(&intervals);
+      for (const auto& interval : intervals) {
+        entries_.push_back({interval.begin, interval.end + kEndSlack, node});
+      }
+    }
+  }
+  std::sort(entries_.begin(), entries_.end(),
+            [](const Entry& a, const Entry& b) { return a.begin < b.begin; });
+
+  // Bottom-up pass over the implicit tree that CollectActive() walks.
+  max_end_.assign(entries_.size(), 0.0);
+  struct Range {
+    size_t lo;
+    size_t hi;
+    bool children_done;
+  };
+  std::vector<Range> stack;
+  if (!entries_.empty()) {
+    stack.push_back({0, entries_.size(), false});
+  }
+  while (!stack.empty()) {
+    Range range = stack.back();
+    stack.pop_back();
+    const size_t mid = range.lo + (range.hi - range.lo) / 2;
+    if (!range.children_done) {
+      stack.push_back({range.lo, range.hi, true});
+      if (mid + 1 < range.hi) {
+        stack.push_back({mid + 1, range.hi, false});
+      }
+      if (range.lo < mid) {
+        stack.push_back({range.lo, mid, false});
+      }
+      continue;
+    }
+    double max_end = entries_[mid].end;
+    if (range.lo < mid) {
+      max_end = std::max(max_end, max_end_[range.lo + (mid - range.lo) / 2]);
+    }
+    if (mid + 1 < range.hi) {
+      max_end = std::max(
+          max_end, max_end_[mid + 1 + (range.hi - mid - 1) / 2]);
+    }
+    max_end_[mid] = max_end;
+  }
+}
+
+void SrSVGAnimationTimeline::Clear() {
+  dependency_order_.clear();
+  entries_.clear();
+  max_end_.clear();
+  end_seconds_ = 0.0;
+}
+
+void SrSVGAnimationTimeline::CollectActiveNodes(
+    double seconds, std::vector<uint32_t>* out) const {
+  out->clear();
+  CollectActive(0, entries_.size(), seconds, out);
+  std::sort(out->begin(), out->end());
+  out->erase(std::unique(out->begin(), out->end()), out->end());
+}
+
+void SrSVGAnimationTimeline::CollectActive(size_t lo, size_t hi,
+                                           double seconds,
+                                           std::vector<uint32_t>* out) const {
+  // Recursion depth is logarithmic in the number of intervals.
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (max_end_[mid] <= seconds) {
+      return;
+    }
+    CollectActive(lo, mid, seconds, out);
+    const Entry& entry = entries_[mid];
+    if (entry.begin > seconds) {
+      return;
+    }
+    if (entry.end > seconds) {
+      out->push_back(entry.node);
+    }
+    lo = mid + 1;
+  }
+}
+
+}  // namespace element
+}  // namespace svg
+}  // namespace serval
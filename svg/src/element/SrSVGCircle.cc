@@ -25,6 +25,17 @@ bool SrSVGCircle::ParseAndSetAttribute(const char* name, const char* value) {
   return SrSVGShape::ParseAndSetAttribute(name, value);
 }
 
+SrSVGAnimatedField SrSVGCircle::AnimatedField(const char* name) {
+  if (strcmp(name, "cx") == 0) {
+    return SrSVGAnimatedField{.length = &cx_};
+  } else if (strcmp(name, "cy") == 0) {
+    return SrSVGAnimatedField{.length = &cy_};
+  } else if (strcmp(name, "r") == 0) {
+    return SrSVGAnimatedField{.length = &r_};
+  }
+  return SrSVGShape::AnimatedField(name);
+}
+
 void SrSVGCircle::onDraw(canvas::SrCanvas* canvas,
                          SrSVGRenderContext& context) const {
   float center_x = convert_serval_length_to_float(
@@ -54,6 +65,22 @@ std::unique_ptr<canvas::Path> SrSVGCircle::AsPath(
   return path;
 }
 
+bool SrSVGCircle::GeometryBounds(SrSVGRenderContext* context,
+                                 SrSVGBox* bounds) const {
+  const float center_x = convert_serval_length_to_float(
+      &cx_, context, SR_SVG_LENGTH_TYPE_HORIZONTAL);
+  const float center_y = convert_serval_length_to_float(
+      &cy_, context, SR_SVG_LENGTH_TYPE_VERTICAL);
+  const float radius =
+      convert_serval_length_to_float(&r_, context, SR_SVG_LENGTH_TYPE_OTHER);
+  if (!(radius >= 0.f)) {
+    return false;
+  }
+  *bounds = SrSVGBox{center_x - radius, center_y - radius, radius * 2.f,
+                     radius * 2.f};
+  return true;
+}
+
 }  // namespace element
 }  // namespace svg
 }  // namespace serval
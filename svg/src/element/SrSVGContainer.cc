@@ -4,6 +4,8 @@
 
 #include "element/SrSVGContainer.h"
 
+#include "utils/SrSVGPatternUtils.h"
+
 namespace serval {
 namespace svg {
 namespace element {
@@ -27,8 +29,75 @@ bool IsContainerTag(SrSVGTag tag) {
   }
 }
 
+// Bounds of an unanimated subtree of shapes and groups depend only on the
+// state in ChildBoundsKey. Filters and masks are left out as their regions
+// live on other nodes, which animations may change.
+bool IsCacheableSubtree(const SrSVGNodeBase* node) {
+  if (!node) {
+    return true;
+  }
+  if (node->HasAnimations()) {
+    return false;
+  }
+  if (node->IsSVGNode()) {
+    auto* svg_node = static_cast<const SrSVGNode*>(node);
+    if (svg_node->filter_ || svg_node->mask_) {
+      return false;
+    }
+  }
+  switch (node->Tag()) {
+    case SrSVGTag::kCircle:
+    case SrSVGTag::kEllipse:
+    case SrSVGTag::kLine:
+    case SrSVGTag::kPath:
+    case SrSVGTag::kPolygon:
+    case SrSVGTag::kPolyline:
+    case SrSVGTag::kRect:
+      return true;
+    case SrSVGTag::kG:
+      for (const SrSVGNodeBase* child :
+           static_cast<const SrSVGContainer*>(node)->children()) {
+        if (!IsCacheableSubtree(child)) {
+          return false;
+        }
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool SameBox(const SrSVGBox& first, const SrSVGBox& second) {
+  return first.left == second.left && first.top == second.top &&
+         first.width == second.width && first.height == second.height;
+}
+
+bool SameLength(const std::optional<SrSVGLength>& first,
+                const std::optional<SrSVGLength>& second) {
+  if (!first || !second) {
+    return !first && !second;
+  }
+  return first->value == second->value && first->unit == second->unit;
+}
+
 }  // namespace
 
+bool SrSVGContainer::ChildBoundsKey::operator==(
+    const ChildBoundsKey& other) const {
+  return width == other.width && height == other.height &&
+         dpi == other.dpi && font_size == other.font_size &&
+         id_mapper == other.id_mapper &&
+         SameBox(view_port, other.view_port) &&
+         SameBox(view_box, other.view_box) && fill_paint == other.fill_paint &&
+         stroke_paint == other.stroke_paint &&
+         fill_paint_type == other.fill_paint_type &&
+         stroke_paint_type == other.stroke_paint_type && mask == other.mask &&
+         SameLength(stroke_width, other.stroke_width) &&
+         fill_opacity == other.fill_opacity &&
+         stroke_opacity == other.stroke_opacity &&
+         supports_filters == other.supports_filters;
+}
+
 bool SrSVGContainer::ParseAndSetAttribute(const char* name, const char* value) {
   if (strcmp(name, "transform") == 0) {
     ParseTransform(value, transform_);
@@ -49,19 +118,176 @@ void SrSVGContainer::OnRender(canvas::SrCanvas* canvas,
   }
   const bool has_opacity_layer = opacity_ && group_opacity < 1.f;
   if (has_opacity_layer) {
-    // TODO: Compute tight layer bounds for group opacity. Correctness requires
-    // whole-group composition; passing nullptr keeps the result correct but may
-    // allocate a larger offscreen layer than necessary.
-    canvas->BeginOpacityLayer(nullptr, group_opacity);
+    // Correctness requires whole-group composition, but the layer only has to
+    // cover what the children paint. Unbounded children fall back to nullptr.
+    SrSVGBox layer_bounds{0.f, 0.f, 0.f, 0.f};
+    const bool has_layer_bounds =
+        ComputeChildrenBounds(canvas, context, &layer_bounds) &&
+        !IsEmptyBounds(layer_bounds);
+    canvas->BeginOpacityLayer(has_layer_bounds ? &layer_bounds : nullptr,
+                              group_opacity);
   }
-  for (SrSVGNodeBase* child : children_) {
+  // Children that paint nothing, or nothing inside the clip, are skipped
+  // without preparing them. Their bounds are cached, and nothing below a
+  // group found to lie inside the clip is tested again.
+  const bool cull =
+      !children_inside_clip_ && UseChildBoundsCache(canvas, context);
+  SrSVGBox clip_bounds{0.f, 0.f, 0.f, 0.f};
+  const bool has_clip_bounds = cull && canvas->GetLocalClipBounds(&clip_bounds);
+  for (size_t i = 0; i < children_.size(); ++i) {
+    SrSVGNodeBase* child = children_[i];
+    bool inside_clip = children_inside_clip_;
+    if (cull && !IsChildVisible(canvas, context, i,
+                                has_clip_bounds ? &clip_bounds : nullptr,
+                                &inside_clip)) {
+      continue;
+    }
+    auto* group = inside_clip && child->Tag() == SrSVGTag::kG
+                      ? static_cast<SrSVGContainer*>(child)
+                      : nullptr;
+    if (group) {
+      group->children_inside_clip_ = true;
+    }
     RenderChild(canvas, context, child);
+    if (group) {
+      group->children_inside_clip_ = false;
+    }
   }
   if (has_opacity_layer) {
     canvas->EndOpacityLayer();
   }
 }
 
+bool SrSVGContainer::OnComputeRenderBounds(canvas::SrCanvas* canvas,
+                                           SrSVGRenderContext& context,
+                                           SrSVGBox* bounds) {
+  *bounds = SrSVGBox{0.f, 0.f, 0.f, 0.f};
+  if (opacity_ && SrSVGNode::ClampOpacity(opacity_.value_or(1.f)) <= 0.f) {
+    return true;
+  }
+  SrSVGBox children_bounds{0.f, 0.f, 0.f, 0.f};
+  if (!ComputeChildrenBounds(canvas, context, &children_bounds)) {
+    return false;
+  }
+  if (IsEmptyBounds(children_bounds)) {
+    return true;
+  }
+  float xform[6];
+  ResolvedTransform(xform, context, canvas->PathFactory());
+  *bounds = MapBounds(children_bounds, xform);
+  return true;
+}
+
+bool SrSVGContainer::ComputeChildrenBounds(canvas::SrCanvas* canvas,
+                                           SrSVGRenderContext& context,
+                                           SrSVGBox* bounds) {
+  *bounds = SrSVGBox{0.f, 0.f, 0.f, 0.f};
+  const bool use_cache = UseChildBoundsCache(canvas, context);
+  for (size_t i = 0; i < children_.size(); ++i) {
+    SrSVGBox child_bounds{0.f, 0.f, 0.f, 0.f};
+    if (!ChildRenderBounds(canvas, context, i, use_cache, &child_bounds)) {
+      return false;
+    }
+    *bounds = UnionBounds(*bounds, child_bounds);
+  }
+  return true;
+}
+
+bool SrSVGContainer::ChildRenderBounds(canvas::SrCanvas* canvas,
+                                       SrSVGRenderContext& context,
+                                       size_t index, bool use_cache,
+                                       SrSVGBox* bounds) {
+  ChildBounds* cached = use_cache && cacheable_children_[index]
+                            ? &child_bounds_[index]
+                            : nullptr;
+  if (cached && cached->state != ChildBoundsState::kUnknown) {
+    *bounds = cached->bounds;
+    return cached->state == ChildBoundsState::kBounded;
+  }
+  *bounds = SrSVGBox{0.f, 0.f, 0.f, 0.f};
+  SrSVGNodeBase* child = children_[index];
+  if (!PrepareChild(child)) {
+    return true;
+  }
+  const bool bounded = child->ComputeRenderBounds(canvas, context, bounds);
+  RestoreChild(child);
+  if (cached) {
+    cached->bounds = *bounds;
+    cached->state =
+        bounded ? ChildBoundsState::kBounded : ChildBoundsState::kUnbounded;
+  }
+  return bounded;
+}
+
+bool SrSVGContainer::IsChildVisible(canvas::SrCanvas* canvas,
+                                    SrSVGRenderContext& context, size_t index,
+                                    const SrSVGBox* clip_bounds,
+                                    bool* inside_clip) {
+  *inside_clip = false;
+  if (!cacheable_children_[index]) {
+    return true;
+  }
+  SrSVGBox bounds{0.f, 0.f, 0.f, 0.f};
+  if (!ChildRenderBounds(canvas, context, index, true, &bounds)) {
+    return true;
+  }
+  if (IsEmptyBounds(bounds)) {
+    return false;
+  }
+  if (!clip_bounds) {
+    return true;
+  }
+  const SrSVGBox visible = IntersectBounds(bounds, *clip_bounds);
+  *inside_clip = SameBox(visible, bounds);
+  return !IsEmptyBounds(visible);
+}
+
+bool SrSVGContainer::UseChildBoundsCache(canvas::SrCanvas* canvas,
+                                         const SrSVGRenderContext& context) {
+  if (!cacheable_children_built_) {
+    cacheable_children_.reserve(children_.size());
+    for (const SrSVGNodeBase* child : children_) {
+      cacheable_children_.push_back(IsCacheableSubtree(child) ? 1 : 0);
+    }
+    cacheable_children_built_ = true;
+  }
+  const ChildBoundsKey key = MakeChildBoundsKey(canvas, context);
+  if (key.mask) {
+    return false;
+  }
+  if (!child_bounds_key_ || !(*child_bounds_key_ == key)) {
+    child_bounds_key_ = key;
+    child_bounds_.assign(children_.size(), ChildBounds{});
+  }
+  return true;
+}
+
+SrSVGContainer::ChildBoundsKey SrSVGContainer::MakeChildBoundsKey(
+    canvas::SrCanvas* canvas, const SrSVGRenderContext& context) const {
+  ChildBoundsKey key;
+  key.width = context.width;
+  key.height = context.height;
+  key.dpi = context.dpi;
+  key.font_size = context.font_size;
+  key.id_mapper = context.id_mapper;
+  key.view_port = context.view_port;
+  key.view_box = context.view_box;
+  key.fill_paint = fill_ ? fill_ : inherit_fill_paint_;
+  key.stroke_paint = stroke_ ? stroke_ : inherit_stroke_paint_;
+  // Paints replaced by animations may reuse an address with another type.
+  key.fill_paint_type =
+      key.fill_paint ? key.fill_paint->type : SERVAL_PAINT_NONE;
+  key.stroke_paint_type =
+      key.stroke_paint ? key.stroke_paint->type : SERVAL_PAINT_NONE;
+  key.mask = mask_ ? mask_ : inherit_mask_;
+  key.stroke_width = stroke_width_ ? stroke_width_ : inherit_stroke_width_;
+  key.fill_opacity = fill_opacity_ ? fill_opacity_ : inherit_fill_opacity_;
+  key.stroke_opacity =
+      stroke_opacity_ ? stroke_opacity_ : inherit_stroke_opacity_;
+  key.supports_filters = canvas->SupportsFilters();
+  return key;
+}
+
 void SrSVGContainer::RenderChild(canvas::SrCanvas* canvas,
                                  SrSVGRenderContext& context,
                                  SrSVGNodeBase* child) {
@@ -229,6 +455,7 @@ std::unique_ptr<canvas::Path> SrSVGContainer::AsPath(
       auto child_path = child->AsPath(path_factory, context);
       if (child_path) {
         path_factory->Op(path.get(), child_path.get(), canvas::OP::UNION);
+        path_factory->Recycle(std::move(child_path));
       }
     }
   }
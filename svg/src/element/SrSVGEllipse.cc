@@ -45,6 +45,24 @@ std::unique_ptr<canvas::Path> SrSVGEllipse::AsPath(
   return path;
 };
 
+bool SrSVGEllipse::GeometryBounds(SrSVGRenderContext* context,
+                                  SrSVGBox* bounds) const {
+  const float center_x = convert_serval_length_to_float(
+      &cx_, context, SR_SVG_LENGTH_TYPE_HORIZONTAL);
+  const float center_y = convert_serval_length_to_float(
+      &cy_, context, SR_SVG_LENGTH_TYPE_VERTICAL);
+  const float radius_x = convert_serval_length_to_float(
+      &rx_, context, SR_SVG_LENGTH_TYPE_HORIZONTAL);
+  const float radius_y = convert_serval_length_to_float(
+      &ry_, context, SR_SVG_LENGTH_TYPE_VERTICAL);
+  if (!(radius_x >= 0.f) || !(radius_y >= 0.f)) {
+    return false;
+  }
+  *bounds = SrSVGBox{center_x - radius_x, center_y - radius_y, radius_x * 2.f,
+                     radius_y * 2.f};
+  return true;
+}
+
 bool SrSVGEllipse::ParseAndSetAttribute(const char* name, const char* value) {
   if (strcmp(name, "cx") == 0) {
     cx_ = make_serval_length(value);
@@ -62,6 +80,19 @@ bool SrSVGEllipse::ParseAndSetAttribute(const char* name, const char* value) {
   return SrSVGShape::ParseAndSetAttribute(name, value);
 }
 
+SrSVGAnimatedField SrSVGEllipse::AnimatedField(const char* name) {
+  if (strcmp(name, "cx") == 0) {
+    return SrSVGAnimatedField{.length = &cx_};
+  } else if (strcmp(name, "cy") == 0) {
+    return SrSVGAnimatedField{.length = &cy_};
+  } else if (strcmp(name, "rx") == 0) {
+    return SrSVGAnimatedField{.length = &rx_};
+  } else if (strcmp(name, "ry") == 0) {
+    return SrSVGAnimatedField{.length = &ry_};
+  }
+  return SrSVGShape::AnimatedField(name);
+}
+
 }  // namespace element
 }  // namespace svg
 }  // namespace serval
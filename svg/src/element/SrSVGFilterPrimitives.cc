@@ -89,7 +89,14 @@ bool SrSVGFeColorMatrix::ParseAndSetAttribute(const char* name,
       if (!*ptr)
         break;
 
-      ptr = SrSVGNode::ParseNumber(ptr, it, 64);
+      const char* next = SrSVGNode::ParseNumber(ptr, it, 64);
+      if (next == ptr) {
+        // Skip a character that cannot start a number, or the loop would
+        // never advance.
+        ++ptr;
+        continue;
+      }
+      ptr = next;
       values_.push_back(Atof(it));
     }
   } else {
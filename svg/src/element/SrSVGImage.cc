@@ -5,6 +5,7 @@
 #include "element/SrSVGImage.h"
 
 #include "canvas/SrCanvas.h"
+#include "utils/SrDataURI.h"
 #include "utils/SrFloatComparison.h"
 
 #ifdef __ANDROID__
@@ -30,6 +31,9 @@ float ResolveImageLength(const SrSVGLength& length, SrSVGRenderContext* context,
 bool SrSVGImage::ParseAndSetAttribute(const char* name, const char* value) {
   if (strcmp(name, "href") == 0 || strcmp(name, "xlink:href") == 0) {
     href_ = value;
+    image_.reset();
+    image_cache_ = nullptr;
+    image_decode_failed_ = false;
     return true;
   } else if (strcmp(name, "x") == 0) {
     x_ = make_serval_length(value);
@@ -66,8 +70,51 @@ void SrSVGImage::onDraw(canvas::SrCanvas* canvas,
     return;
   }
 
-  canvas->DrawImage(href_.c_str(), x, y, width, height, preserve_aspect_radio_,
-                    render_state_.opacity);
+  auto* image_cache = canvas->ImageCache();
+  if (!image_cache) {
+    canvas->DrawImage(href_.c_str(), x, y, width, height,
+                      preserve_aspect_radio_, render_state_.opacity);
+    return;
+  }
+  if (auto image = AcquireImage(canvas, image_cache)) {
+    canvas->DrawDecodedImage(*image, x, y, width, height,
+                             preserve_aspect_radio_, render_state_.opacity);
+  }
+}
+
+std::shared_ptr<canvas::SrDecodedImage> SrSVGImage::AcquireImage(
+    canvas::SrCanvas* canvas, canvas::SrImageCache* image_cache) const {
+  if (href_.empty()) {
+    return nullptr;
+  }
+  const bool data_uri = IsDataURI(href_.c_str());
+  if (!data_uri && !image_cache->cache_host_images()) {
+    // The href means whatever the host behind this canvas makes of it.
+    return canvas->LoadImage(href_.c_str());
+  }
+  if (image_cache_ == image_cache) {
+    if (auto image = image_.lock()) {
+      return image;
+    }
+    if (image_decode_failed_) {
+      return nullptr;
+    }
+  }
+  auto image = image_cache->Acquire(
+      href_, [&]() -> std::shared_ptr<canvas::SrDecodedImage> {
+        if (!data_uri) {
+          return canvas->LoadImage(href_.c_str());
+        }
+        SrDataURI decoded;
+        if (!DecodeDataURI(href_.c_str(), &decoded) || decoded.data.empty()) {
+          return nullptr;
+        }
+        return canvas->DecodeImage(decoded.data.data(), decoded.data.size());
+      });
+  image_ = image;
+  image_cache_ = image_cache;
+  image_decode_failed_ = data_uri && !image;
+  return image;
 }
 
 std::unique_ptr<canvas::Path> SrSVGImage::AsPath(
@@ -7,6 +7,7 @@
 #include "canvas/SrCanvas.h"
 #include "element/SrSVGShape.h"
 #include "element/SrSVGTypes.h"
+#include "utils/SrSVGPatternUtils.h"
 
 namespace serval {
 namespace svg {
@@ -44,6 +45,19 @@ bool SrSVGLine::ParseAndSetAttribute(const char* name, const char* value) {
   return SrSVGShape::ParseAndSetAttribute(name, value);
 }
 
+SrSVGAnimatedField SrSVGLine::AnimatedField(const char* name) {
+  if (strcmp(name, "x1") == 0) {
+    return SrSVGAnimatedField{.length = &x1_};
+  } else if (strcmp(name, "y1") == 0) {
+    return SrSVGAnimatedField{.length = &y1_};
+  } else if (strcmp(name, "x2") == 0) {
+    return SrSVGAnimatedField{.length = &x2_};
+  } else if (strcmp(name, "y2") == 0) {
+    return SrSVGAnimatedField{.length = &y2_};
+  }
+  return SrSVGShape::AnimatedField(name);
+}
+
 std::unique_ptr<canvas::Path> SrSVGLine::AsPath(
     canvas::PathFactory* path_factory, SrSVGRenderContext* context,
     bool include_transform) const {
@@ -64,6 +78,21 @@ std::unique_ptr<canvas::Path> SrSVGLine::AsPath(
   return path;
 };
 
+bool SrSVGLine::GeometryBounds(SrSVGRenderContext* context,
+                               SrSVGBox* bounds) const {
+  const float points[4] = {
+      convert_serval_length_to_float(&x1_, context,
+                                     SR_SVG_LENGTH_TYPE_HORIZONTAL),
+      convert_serval_length_to_float(&y1_, context,
+                                     SR_SVG_LENGTH_TYPE_VERTICAL),
+      convert_serval_length_to_float(&x2_, context,
+                                     SR_SVG_LENGTH_TYPE_HORIZONTAL),
+      convert_serval_length_to_float(&y2_, context,
+                                     SR_SVG_LENGTH_TYPE_VERTICAL)};
+  *bounds = PointsBounds(points, 2);
+  return true;
+}
+
 }  // namespace element
 }  // namespace svg
 }  // namespace serval
@@ -43,6 +43,25 @@ bool SrSVGLinearGradient::ParseAndSetAttribute(const char* name,
   return SrSVGNode::ParseAndSetAttribute(name, value);
 }
 
+const char* SrSVGLinearGradient::DefaultAttributeValue(const char* name) const {
+  if (strcmp(name, "x1") == 0) {
+    return "0";
+  }
+  if (strcmp(name, "y1") == 0) {
+    return "0";
+  }
+  if (strcmp(name, "x2") == 0) {
+    return "1";
+  }
+  if (strcmp(name, "y2") == 0) {
+    return "0";
+  }
+  if (strcmp(name, "gradientTransform") == 0) {
+    return "matrix(1 0 0 1 0 0)";
+  }
+  return SrSVGContainer::DefaultAttributeValue(name);
+}
+
 void SrSVGLinearGradient::OnRender(canvas::SrCanvas* canvas,
                                    SrSVGRenderContext& context) {
   std::vector<SrStop> stops;
@@ -14,6 +14,7 @@
 #include <cstring>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "canvas/SrCanvas.h"
@@ -23,7 +24,9 @@
 #include "element/SrSVGFilterPrimitives.h"
 #include "element/SrSVGMask.h"
 #include "element/SrSVGTypes.h"
+#include "parser/SrSVGTraversalState.h"
 #include "utils/SrFloatComparison.h"
+#include "utils/SrSVGPatternUtils.h"
 
 namespace serval {
 namespace svg {
@@ -123,46 +126,199 @@ void PrepareIRIResource(canvas::SrCanvas* canvas, SrSVGRenderContext& context,
   }
 }
 
-bool ParseNumberWithSuffix(const std::string& value, double* number,
-                           std::string* suffix) {
-  if (!number || !suffix) {
-    return false;
+bool HasZeroDefaultAnimatedAttribute(const std::string& name) {
+  return name == "x" || name == "y" || name == "x1" || name == "y1" ||
+         name == "x2" || name == "y2" || name == "cx" || name == "cy" ||
+         name == "r" || name == "rx" || name == "ry" || name == "width" ||
+         name == "height" || name == "dx" || name == "dy" ||
+         name == "stdDeviation" || name == "offset";
+}
+
+SrSVGNodeBase* FindReferencedNode(const SrSVGPaint* paint,
+                                  const SrSVGRenderContext& context,
+                                  SrSVGTag tag) {
+  if (!paint || paint->type != SERVAL_PAINT_IRI || !paint->content.iri ||
+      paint->content.iri[0] == '\0' || !context.id_mapper) {
+    return nullptr;
+  }
+  IDMapper* nodes = static_cast<IDMapper*>(context.id_mapper);
+  auto it = nodes->find(std::string(paint->content.iri + 1));
+  if (it == nodes->end() || !it->second || it->second->Tag() != tag) {
+    return nullptr;
   }
-  char* end = nullptr;
-  const double parsed = std::strtod(value.c_str(), &end);
-  if (end == value.c_str()) {
+  return it->second;
+}
+
+SrSVGFilter* FindFilterNode(const SrSVGNode& node,
+                            const SrSVGRenderContext& context) {
+  return static_cast<SrSVGFilter*>(
+      FindReferencedNode(node.filter_, context, SrSVGTag::kFilter));
+}
+
+SrSVGMask* FindMaskNode(const SrSVGNode& node,
+                        const SrSVGRenderContext& context) {
+  SrSVGPaint* mask = node.mask_ != nullptr ? node.mask_ : node.inherit_mask_;
+  return static_cast<SrSVGMask*>(
+      FindReferencedNode(mask, context, SrSVGTag::kMask));
+}
+
+// Object bounding box used to resolve filter regions. It includes the stroke
+// so that outlines are not clipped by objectBoundingBox-relative regions.
+bool ResolveFilterObjectBounds(const SrSVGNode& svg_node,
+                               canvas::PathFactory* path_factory,
+                               SrSVGRenderContext& context, SrSVGBox* bounds) {
+  auto path = svg_node.AsPath(path_factory, &context);
+  if (!path) {
     return false;
   }
-  *number = parsed;
-  *suffix = end ? end : "";
-  return true;
+  *bounds = path->GetBounds();
+  const bool has_bounds = bounds->width > 0.f && bounds->height > 0.f;
+
+  // Expand bounds by stroke width
+  float stroke_w = 0.f;
+  if (svg_node.stroke_width_.has_value()) {
+    stroke_w = convert_serval_length_to_float(
+        &*svg_node.stroke_width_, &context, SR_SVG_LENGTH_TYPE_OTHER);
+  } else if (svg_node.inherit_stroke_width_.has_value()) {
+    stroke_w = convert_serval_length_to_float(
+        &*svg_node.inherit_stroke_width_, &context, SR_SVG_LENGTH_TYPE_OTHER);
+  }
+
+  // Check if stroke is actually drawn
+  bool has_stroke = false;
+  if (svg_node.stroke_ && svg_node.stroke_->type != SERVAL_PAINT_NONE) {
+    has_stroke = true;
+  } else if (svg_node.inherit_stroke_paint_ &&
+             svg_node.inherit_stroke_paint_->type != SERVAL_PAINT_NONE) {
+    // If not overridden locally
+    if (!svg_node.stroke_)
+      has_stroke = true;
+  }
+
+  if (has_stroke) {
+    // Default stroke width is 1.0 if not specified but stroke is present?
+    // Logic in Render usually handles defaults. Here we just want to be safe.
+    if (stroke_w <= 0.f && (!svg_node.stroke_width_.has_value() &&
+                            !svg_node.inherit_stroke_width_.has_value())) {
+      stroke_w = 1.f;
+    }
+
+    if (stroke_w > 0.f) {
+      float half_w = stroke_w * 0.5f;
+      bounds->left -= half_w;
+      bounds->top -= half_w;
+      bounds->width += stroke_w;
+      bounds->height += stroke_w;
+    }
+  }
+  return has_bounds;
 }
 
-std::string AddAnimatedScalarValue(const std::string& base,
-                                   const std::string& addition) {
-  double base_number = 0.0;
-  double addition_number = 0.0;
-  std::string base_suffix;
-  std::string addition_suffix;
-  if (!ParseNumberWithSuffix(base, &base_number, &base_suffix) ||
-      !ParseNumberWithSuffix(addition, &addition_number, &addition_suffix) ||
-      base_suffix != addition_suffix) {
-    return "";
+// Region the mask output is confined to. Returns false when the region cannot
+// be resolved (objectBoundingBox units without geometry); |empty| is set when
+// the resolved region has no area and the element must not be painted.
+bool ResolveMaskOutputRegion(const SrSVGNode& svg_node,
+                             const SrSVGMask& mask_node,
+                             canvas::PathFactory* path_factory,
+                             SrSVGRenderContext& context,
+                             SrSVGBox* object_bounds, bool* has_object_bounds,
+                             SrSVGBox* region, bool* empty) {
+  *has_object_bounds = false;
+  *empty = false;
+  if (auto path = svg_node.AsPath(path_factory, &context)) {
+    *object_bounds = path->GetBounds();
+    *has_object_bounds = true;
   }
-  std::ostringstream stream;
-  stream << base_number + addition_number << base_suffix;
-  return stream.str();
+  const bool can_resolve_mask_region =
+      *has_object_bounds ||
+      mask_node.mask_units() == SR_SVG_OBB_UNIT_TYPE_USER_SPACE_ON_USE;
+  if (!can_resolve_mask_region) {
+    return false;
+  }
+  *region = mask_node.ResolveMaskRegion(
+      *has_object_bounds ? *object_bounds : context.view_port, context);
+  *empty = !(region->width > 0.f && region->height > 0.f);
+  return !*empty;
 }
 
-bool HasZeroDefaultAnimatedAttribute(const std::string& name) {
-  return name == "x" || name == "y" || name == "x1" || name == "y1" ||
-         name == "x2" || name == "y2" || name == "cx" || name == "cy" ||
-         name == "r" || name == "rx" || name == "ry" || name == "width" ||
-         name == "height" || name == "dx" || name == "dy" ||
-         name == "stdDeviation" || name == "offset";
+// Charges a filter or mask layer to the render's layer area budget, in
+// device pixels where the canvas reports its transform. Unbounded layers are
+// charged the viewport.
+bool ChargeLayerArea(canvas::SrCanvas* canvas, SrSVGRenderContext& context,
+                     const SrSVGBox* bounds, const std::string& subject) {
+  auto* state =
+      static_cast<parser::SrSVGTraversalState*>(context.traversal_state);
+  if (!state || !state->budgets) {
+    return true;
+  }
+  double area = static_cast<double>(context.view_port.width) *
+                context.view_port.height;
+  if (bounds && !IsEmptyBounds(*bounds)) {
+    SrSVGBox device_bounds = *bounds;
+    float xform[6];
+    if (canvas->GetTotalTransform(xform)) {
+      device_bounds = MapBounds(device_bounds, xform);
+    }
+    area = static_cast<double>(device_bounds.width) * device_bounds.height;
+  }
+  return state->Charge<double>(
+      &state->layer_area, area, state->budgets->max_layer_area,
+      SR_SVG_DIAGNOSTIC_LAYER_BUDGET_EXCEEDED,
+      "Skipped a filter or mask layer past the layer area budget.",
+      subject.c_str());
 }
 
 }  // namespace
+
+bool SrSVGNodeBase::ComputeRenderBounds(canvas::SrCanvas* canvas,
+                                        SrSVGRenderContext& context,
+                                        SrSVGBox* bounds) {
+  if (!canvas || !bounds) {
+    return false;
+  }
+  SrSVGBox content{0.f, 0.f, 0.f, 0.f};
+  if (!OnComputeRenderBounds(canvas, context, &content)) {
+    return false;
+  }
+  if (IsSVGNode() && Tag() != SrSVGTag::kMask && Tag() != SrSVGTag::kFilter) {
+    auto* svg_node = static_cast<SrSVGNode*>(this);
+    SrSVGFilter* filter_node =
+        canvas->SupportsFilters() ? FindFilterNode(*svg_node, context)
+                                  : nullptr;
+    if (filter_node) {
+      SrSVGBox object_bounds{0.f, 0.f, 0.f, 0.f};
+      const bool has_object_bounds = ResolveFilterObjectBounds(
+          *svg_node, canvas->PathFactory(), context, &object_bounds);
+      canvas::SrFilterModel filter_model;
+      if (filter_node->BuildFilterModel(object_bounds, has_object_bounds,
+                                        context, &filter_model)) {
+        if (IsEmptyBounds(filter_model.region)) {
+          content = SrSVGBox{0.f, 0.f, 0.f, 0.f};
+        } else if (canvas->SupportsFilterModel(filter_model)) {
+          content = IntersectBounds(
+              filter_model.region,
+              canvas::SrFilterModelOutputBounds(filter_model, content));
+        }
+      }
+    }
+    if (SrSVGMask* mask_node = FindMaskNode(*svg_node, context)) {
+      SrSVGBox object_bounds{0.f, 0.f, 0.f, 0.f};
+      SrSVGBox mask_region{0.f, 0.f, 0.f, 0.f};
+      bool has_object_bounds = false;
+      bool empty_mask_region = false;
+      if (ResolveMaskOutputRegion(*svg_node, *mask_node, canvas->PathFactory(),
+                                  context, &object_bounds, &has_object_bounds,
+                                  &mask_region, &empty_mask_region)) {
+        content = IntersectBounds(content, mask_region);
+      } else if (empty_mask_region) {
+        content = SrSVGBox{0.f, 0.f, 0.f, 0.f};
+      }
+    }
+  }
+  *bounds = content;
+  return true;
+}
+
 void SrSVGNodeBase::Render(canvas::SrCanvas* const canvas,
                            SrSVGRenderContext& context) {
   canvas->Save();
@@ -176,89 +332,61 @@ void SrSVGNodeBase::Render(canvas::SrCanvas* const canvas,
         box.left, box.top, 0.f, 0.f, box.width, box.height);
     if (clip_path) {
       canvas->ClipPath(clip_path.get(), SR_SVG_FILL);
+      canvas->PathFactory()->Recycle(std::move(clip_path));
+    }
+  };
+  // Layers are sized to the content they receive rather than the whole
+  // effect region, so small elements do not allocate large offscreens.
+  bool content_bounds_resolved = false;
+  bool has_content_bounds = false;
+  SrSVGBox content_bounds{0.f, 0.f, 0.f, 0.f};
+  auto resolve_content_bounds = [&]() {
+    if (!content_bounds_resolved) {
+      content_bounds_resolved = true;
+      has_content_bounds =
+          OnComputeRenderBounds(canvas, context, &content_bounds);
     }
+    return has_content_bounds;
   };
   if (canvas->SupportsFilters() && IsSVGNode() && Tag() != SrSVGTag::kMask &&
       Tag() != SrSVGTag::kFilter) {
     auto* svg_node = static_cast<SrSVGNode*>(this);
-    if (svg_node->filter_ && svg_node->filter_->type == SERVAL_PAINT_IRI) {
+    SrSVGFilter* filter_node = FindFilterNode(*svg_node, context);
+    if (filter_node) {
       SrSVGBox bounds{0.f, 0.f, 0.f, 0.f};
-      bool has_bounds = false;
-      if (auto path = svg_node->AsPath(canvas->PathFactory(), &context)) {
-        bounds = path->GetBounds();
-        has_bounds = bounds.width > 0.f && bounds.height > 0.f;
-
-        // Expand bounds by stroke width
-        float stroke_w = 0.f;
-        if (svg_node->stroke_width_.has_value()) {
-          stroke_w = convert_serval_length_to_float(
-              &*svg_node->stroke_width_, &context, SR_SVG_LENGTH_TYPE_OTHER);
-        } else if (svg_node->inherit_stroke_width_.has_value()) {
-          stroke_w = convert_serval_length_to_float(
-              &*svg_node->inherit_stroke_width_, &context,
-              SR_SVG_LENGTH_TYPE_OTHER);
-        }
-
-        // Check if stroke is actually drawn
-        bool has_stroke = false;
-        if (svg_node->stroke_ && svg_node->stroke_->type != SERVAL_PAINT_NONE) {
-          has_stroke = true;
-        } else if (svg_node->inherit_stroke_paint_ &&
-                   svg_node->inherit_stroke_paint_->type != SERVAL_PAINT_NONE) {
-          // If not overridden locally
-          if (!svg_node->stroke_)
-            has_stroke = true;
-        }
-
-        if (has_stroke) {
-          // Default stroke width is 1.0 if not specified but stroke is present?
-          // Logic in Render usually handles defaults. Here we just want to be safe.
-          if (stroke_w <= 0.f &&
-              (!svg_node->stroke_width_.has_value() &&
-               !svg_node->inherit_stroke_width_.has_value())) {
-            stroke_w = 1.f;
-          }
-
-          if (stroke_w > 0.f) {
-            float half_w = stroke_w * 0.5f;
-            bounds.left -= half_w;
-            bounds.top -= half_w;
-            bounds.width += stroke_w;
-            bounds.height += stroke_w;
-          }
-        }
-      }
-
-      SrSVGFilter* filter_node = nullptr;
-      if (context.id_mapper) {
-        IDMapper* nodes = static_cast<IDMapper*>(context.id_mapper);
-        std::string id(svg_node->filter_->content.iri + 1);
-        auto it = nodes->find(id);
-        if (it != nodes->end()) {
-          if (it->second && it->second->Tag() == SrSVGTag::kFilter) {
-            filter_node = static_cast<SrSVGFilter*>(it->second);
-          }
-        }
-      }
+      const bool has_bounds = ResolveFilterObjectBounds(
+          *svg_node, canvas->PathFactory(), context, &bounds);
 
       canvas::SrFilterModel filter_model;
-      if (filter_node) {
-        if (filter_node->BuildFilterModel(bounds, has_bounds, context,
-                                          &filter_model)) {
-          if (filter_model.region.width <= 0.f ||
-              filter_model.region.height <= 0.f) {
-            filter_output_empty = true;
-          } else if (canvas->SupportsFilterModel(filter_model)) {
-            canvas->BeginFilterLayer(&filter_model.region, filter_model);
+      if (filter_node->BuildFilterModel(bounds, has_bounds, context,
+                                        &filter_model)) {
+        if (filter_model.region.width <= 0.f ||
+            filter_model.region.height <= 0.f) {
+          filter_output_empty = true;
+        } else if (canvas->SupportsFilterModel(filter_model)) {
+          SrSVGBox layer_bounds = filter_model.region;
+          if (resolve_content_bounds()) {
+            const SrSVGBox tight_bounds = IntersectBounds(
+                filter_model.region,
+                UnionBounds(content_bounds,
+                            canvas::SrFilterModelOutputBounds(filter_model,
+                                                              content_bounds)));
+            if (!IsEmptyBounds(tight_bounds)) {
+              layer_bounds = tight_bounds;
+            }
+          }
+          if (ChargeLayerArea(canvas, context, &layer_bounds,
+                              svg_node->Id())) {
+            canvas->BeginFilterLayer(&layer_bounds, filter_model);
             filter_layer_active = true;
             canvas->Save();
             clip_to_box(filter_model.region);
             filter_clipped = true;
           }
-          // Unsupported filter graphs fall back to rendering the source
-          // element without the filter. Only an explicitly empty filter region
-          // should suppress the source output.
         }
+        // Unsupported filter graphs, and filters past the layer area budget,
+        // fall back to rendering the source element without the filter. Only
+        // an explicitly empty filter region should suppress the source output.
       }
     }
   }
@@ -268,70 +396,58 @@ void SrSVGNodeBase::Render(canvas::SrCanvas* const canvas,
   bool masked = false;
   if (IsSVGNode() && Tag() != SrSVGTag::kMask) {
     auto* svg_node = static_cast<SrSVGNode*>(this);
-    SrSVGPaint* local_mask =
-        svg_node->mask_ != nullptr ? svg_node->mask_ : svg_node->inherit_mask_;
-    if (local_mask && local_mask->type == SERVAL_PAINT_IRI) {
-      IDMapper* nodes = static_cast<IDMapper*>(context.id_mapper);
-      if (nodes) {
-        std::string id(local_mask->content.iri + 1);
-        auto it = nodes->find(id);
-        if (it != nodes->end() && it->second &&
-            it->second->Tag() == SrSVGTag::kMask) {
-          auto* mask_node = static_cast<SrSVGMask*>(it->second);
-          SrSVGBox bounds{0.f, 0.f, 0.f, 0.f};
-          bool has_bounds = false;
-          if (auto path = svg_node->AsPath(canvas->PathFactory(), &context)) {
-            bounds = path->GetBounds();
-            has_bounds = true;
-          }
-
-          SrSVGBox mask_region{0.f, 0.f, 0.f, 0.f};
-          bool has_mask_region = false;
-          bool has_empty_mask_region = false;
-          const bool can_resolve_mask_region =
-              has_bounds ||
-              mask_node->mask_units() == SR_SVG_OBB_UNIT_TYPE_USER_SPACE_ON_USE;
-          if (can_resolve_mask_region) {
-            const SrSVGBox object_bounds =
-                has_bounds ? bounds : context.view_port;
-            mask_region = mask_node->ResolveMaskRegion(object_bounds, context);
-            has_mask_region =
-                mask_region.width > 0.f && mask_region.height > 0.f;
-            if (!has_mask_region) {
-              masked = true;
-              has_empty_mask_region = true;
-            }
+    if (SrSVGMask* mask_node = FindMaskNode(*svg_node, context)) {
+      SrSVGBox bounds{0.f, 0.f, 0.f, 0.f};
+      SrSVGBox mask_region{0.f, 0.f, 0.f, 0.f};
+      bool has_bounds = false;
+      bool has_empty_mask_region = false;
+      const bool has_mask_region = ResolveMaskOutputRegion(
+          *svg_node, *mask_node, canvas->PathFactory(), context, &bounds,
+          &has_bounds, &mask_region, &has_empty_mask_region);
+      if (has_empty_mask_region) {
+        masked = true;
+      } else {
+        // The masked output never exceeds the source content, so the layer
+        // only needs to cover the content inside the mask region.
+        const SrSVGBox* layer_bounds = has_mask_region ? &mask_region : nullptr;
+        SrSVGBox tight_bounds{0.f, 0.f, 0.f, 0.f};
+        if (resolve_content_bounds()) {
+          tight_bounds = has_mask_region
+                             ? IntersectBounds(mask_region, content_bounds)
+                             : content_bounds;
+          if (!IsEmptyBounds(tight_bounds)) {
+            layer_bounds = &tight_bounds;
           }
-
-          if (!has_empty_mask_region) {
-            canvas->BeginMaskLayer(has_mask_region ? &mask_region : nullptr,
-                                   mask_node->mask_is_luminance());
-            if (has_mask_region) {
-              canvas->Save();
-              clip_to_box(mask_region);
-              OnRender(canvas, context);
-              canvas->Restore();
-            } else {
-              OnRender(canvas, context);
-            }
-            canvas->BeginMaskContentLayer();
+        }
+        // Past the layer area budget the masked element is dropped rather
+        // than drawn unmasked.
+        if (ChargeLayerArea(canvas, context, layer_bounds, svg_node->Id())) {
+          canvas->BeginMaskLayer(layer_bounds, mask_node->mask_is_luminance());
+          if (has_mask_region) {
             canvas->Save();
-            if (has_mask_region) {
-              clip_to_box(mask_region);
-            }
-            if (has_bounds && mask_node->mask_content_units() ==
-                                  SR_SVG_OBB_UNIT_TYPE_OBJECT_BOUNDING_BOX) {
-              float xform[6] = {bounds.width,  0.f,         0.f,
-                                bounds.height, bounds.left, bounds.top};
-              canvas->Transform(xform);
-            }
-            mask_node->Render(canvas, context);
+            clip_to_box(mask_region);
+            OnRender(canvas, context);
             canvas->Restore();
-            canvas->EndMaskContentLayer();
-            canvas->EndMaskLayer();
-            masked = true;
+          } else {
+            OnRender(canvas, context);
           }
+          canvas->BeginMaskContentLayer();
+          canvas->Save();
+          if (has_mask_region) {
+            clip_to_box(mask_region);
+          }
+          if (has_bounds && mask_node->mask_content_units() ==
+                                SR_SVG_OBB_UNIT_TYPE_OBJECT_BOUNDING_BOX) {
+            float xform[6] = {bounds.width,  0.f,         0.f,
+                              bounds.height, bounds.left, bounds.top};
+            canvas->Transform(xform);
+          }
+          mask_node->Render(canvas, context);
+          canvas->Restore();
+          canvas->EndMaskContentLayer();
+          canvas->EndMaskLayer();
         }
+        masked = true;
       }
     }
   }
@@ -405,98 +521,43 @@ bool SrSVGNode::ParseAndSetAttribute(const char* name, const char* value) {
 }
 
 void SrSVGNode::StoreAttribute(const char* name, const char* value) {
-  if (name && value) {
-    base_attributes_[name] = value;
-  }
+  animated_attributes_.StoreBaseValue(name, value);
 }
 
 void SrSVGNode::AddAnimation(SrSVGAnimation* animation) {
-  if (animation && std::find(animations_.begin(), animations_.end(),
-                             animation) == animations_.end()) {
-    animations_.push_back(animation);
-  }
+  animated_attributes_.AddAnimation(animation);
 }
 
 void SrSVGNode::ApplyAnimations(double seconds, const IDMapper* id_mapper) {
-  std::unordered_map<std::string, std::string> presentation_values;
-  for (auto* animation : animations_) {
-    if (!animation) {
-      continue;
-    }
-    const std::string target_attribute = animation->TargetAttributeName();
-    if (target_attribute.empty()) {
-      continue;
-    }
-    auto presentation_it = presentation_values.find(target_attribute);
-    if (presentation_it == presentation_values.end()) {
-      auto base_it = base_attributes_.find(target_attribute);
-      presentation_it =
-          presentation_values
-              .emplace(target_attribute,
-                       base_it == base_attributes_.end() ? "" : base_it->second)
-              .first;
-    }
-
-    SrSVGAnimation::Effect effect;
-    if (!animation->Evaluate(seconds, id_mapper, presentation_it->second,
-                             &effect) ||
-        effect.attribute.empty()) {
-      continue;
-    }
-    if (presentation_values.find(effect.attribute) ==
-        presentation_values.end()) {
-      auto base_it = base_attributes_.find(effect.attribute);
-      presentation_values.emplace(
-          effect.attribute,
-          base_it == base_attributes_.end() ? "" : base_it->second);
-    }
-    if (animated_attributes_.find(effect.attribute) ==
-        animated_attributes_.end()) {
-      auto base_it = base_attributes_.find(effect.attribute);
-      animated_attributes_[effect.attribute] =
-          base_it == base_attributes_.end()
-              ? std::optional<std::string>{}
-              : std::optional<std::string>{base_it->second};
-    }
-    std::string value = effect.value;
-    if (effect.transform && effect.additive) {
-      auto& presentation = presentation_values[effect.attribute];
-      if (!presentation.empty()) {
-        value = presentation + " " + value;
-      }
-    } else if (effect.additive) {
-      auto& presentation = presentation_values[effect.attribute];
-      if (!presentation.empty()) {
-        const std::string added =
-            AddAnimatedScalarValue(presentation, effect.value);
-        if (!added.empty()) {
-          value = added;
-        }
-      }
-    }
-    presentation_values[effect.attribute] = value;
-    if (effect.path_data && effect.attribute == "d" &&
-        SetAnimatedPathData(effect.path_data)) {
-      continue;
-    }
-    ParseAndSetAttribute(effect.attribute.c_str(), value.c_str());
-  }
+  animated_attributes_.Apply(this, seconds, id_mapper);
 }
 
 void SrSVGNode::RestoreAnimatedAttributes() {
-  for (const auto& entry : animated_attributes_) {
-    RestoreAnimatedAttribute(entry.first, entry.second);
-  }
-  animated_attributes_.clear();
+  animated_attributes_.Restore(this);
 }
 
-void SrSVGNode::RestoreAnimatedAttribute(
-    const std::string& name, const std::optional<std::string>& base_value) {
-  if (base_value.has_value()) {
-    ParseAndSetAttribute(name.c_str(), base_value->c_str());
-    return;
+SrSVGAnimatedField SrSVGNode::AnimatedField(const char* name) {
+  SrSVGAnimatedField field;
+  if (strcmp(name, "fill") == 0) {
+    field.paint = &fill_;
+  } else if (strcmp(name, "stroke") == 0) {
+    field.paint = &stroke_;
+  } else if (strcmp(name, "opacity") == 0) {
+    field.optional_number = &opacity_;
+  } else if (strcmp(name, "fill-opacity") == 0) {
+    field.optional_number = &fill_opacity_;
+  } else if (strcmp(name, "stroke-opacity") == 0) {
+    field.optional_number = &stroke_opacity_;
+  } else if (strcmp(name, "stroke-width") == 0) {
+    field.optional_length = &stroke_width_;
+  } else if (strcmp(name, "stroke-dashoffset") == 0) {
+    field.number = &stroke_dash_offset_;
+  } else if (strcmp(name, "stroke-miterlimit") == 0) {
+    field.number = &stoke_miter_limit_;
+  } else if (strcmp(name, "color") == 0) {
+    field.optional_color = &color_;
   }
-  ClearAnimatedAttribute(name);
+  return field;
 }
 
 void SrSVGNode::ClearAnimatedAttribute(const std::string& name) {
@@ -559,6 +620,8 @@ void SrSVGNode::ClearAnimatedAttribute(const std::string& name) {
 }
 
 SrSVGNode::~SrSVGNode() {
+  // Animated paints are owned by their slots until restored.
+  animated_attributes_.Restore(this);
   release_serval_paint(fill_);
   release_serval_paint(stroke_);
   release_serval_paint(clip_path_);
@@ -605,11 +668,15 @@ bool SrSVGNode::OnPrepareToRender(canvas::SrCanvas* canvas,
               SrSVGBox svg_box = node_path->GetBounds();
               float xform[6] = {svg_box.width, 0,          0, svg_box.height,
                                 svg_box.left,  svg_box.top};
-              path = path->CreateTransformCopy(xform);
+              auto unit_path = path->CreateTransformCopy(xform);
+              canvas->PathFactory()->Recycle(std::move(node_path));
+              canvas->PathFactory()->Recycle(std::move(path));
+              path = std::move(unit_path);
             }
           }
           if (path) {
             canvas->ClipPath(path.get(), clip_path_node->clip_rule());
+            canvas->PathFactory()->Recycle(std::move(path));
           }
         }
       }
@@ -771,7 +838,14 @@ void SrSVGNode::ParseStrokeDashArray(const char* value) {
       break;
     }
 
-    ptr = ParseNumber(ptr, token, sizeof(token));
+    const char* next = ParseNumber(ptr, token, sizeof(token));
+    if (next == ptr) {
+      // Units and other stray characters are skipped; without this the
+      // parser would stop advancing.
+      ++ptr;
+      continue;
+    }
+    ptr = next;
     if (token[0] != '\0') {
       stroke_dash_array_.push_back(static_cast<float>(Atof(token)));
     }
@@ -852,8 +926,14 @@ bool SrSVGNode::ResolveTransformOrigin(
     reference_box = context.view_port;
   }
 
-  if (path_factory && transform_box_ != SrSVGTransformBox::kViewBox) {
-    SrSVGRenderContext mutable_context = context;
+  SrSVGRenderContext mutable_context = context;
+  SrSVGBox fill_box{0.f, 0.f, 0.f, 0.f};
+  if (transform_box_ == SrSVGTransformBox::kFillBox &&
+      GeometryBounds(&mutable_context, &fill_box)) {
+    if (fill_box.width > 0.f || fill_box.height > 0.f) {
+      reference_box = fill_box;
+    }
+  } else if (path_factory && transform_box_ != SrSVGTransformBox::kViewBox) {
     auto path = AsPath(path_factory, &mutable_context, false);
     if (path) {
       if (transform_box_ == SrSVGTransformBox::kStrokeBox) {
@@ -879,6 +959,7 @@ bool SrSVGNode::ResolveTransformOrigin(
       if (bounds.width > 0.f || bounds.height > 0.f) {
         reference_box = bounds;
       }
+      path_factory->Recycle(std::move(path));
     }
   }
 
@@ -909,6 +990,38 @@ void SrSVGNode::ResolvedTransform(float (&xform)[6],
   std::memcpy(xform, centered, sizeof(float) * 6);
 }
 
+float SrSVGNode::StrokeOutset(SrSVGRenderContext& context) const {
+  const SrSVGPaint* stroke = stroke_ ? stroke_ : inherit_stroke_paint_;
+  if (!stroke || stroke->type == SERVAL_PAINT_NONE) {
+    return 0.f;
+  }
+  float stroke_width = 0.f;
+  if (stroke_width_) {
+    stroke_width = convert_serval_length_to_float(&(*stroke_width_), &context,
+                                                  SR_SVG_LENGTH_TYPE_OTHER);
+  } else if (inherit_stroke_width_) {
+    stroke_width = convert_serval_length_to_float(
+        &(*inherit_stroke_width_), &context, SR_SVG_LENGTH_TYPE_OTHER);
+  } else {
+    SrSVGLength default_width{.value = 1.0f, .unit = SR_SVG_UNITS_PX};
+    stroke_width = convert_serval_length_to_float(&default_width, &context,
+                                                  SR_SVG_LENGTH_TYPE_OTHER);
+  }
+  if (!(stroke_width > 0.f)) {
+    return 0.f;
+  }
+  // A miter spike reaches at most miter-limit half widths from the vertex and
+  // a square cap reaches sqrt(2) half widths from the end point.
+  float factor = 1.f;
+  if (stroke_join_ == SR_SVG_STROKE_JOIN_MITER) {
+    factor = std::max(factor, stoke_miter_limit_);
+  }
+  if (stroke_cap_ == SR_SVG_STROKE_CAP_SQUARE) {
+    factor = std::max(factor, static_cast<float>(M_SQRT2));
+  }
+  return stroke_width * 0.5f * factor;
+}
+
 static int IsSpace(char c) {
   if (c == 0)
     return 0;
@@ -4,6 +4,7 @@
 
 #include "element/SrSVGPath.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -106,6 +107,57 @@ std::unique_ptr<canvas::Path> SrSVGPath::AsPath(
   return path;
 }
 
+bool SrSVGPath::GeometryBounds(SrSVGRenderContext* context,
+                               SrSVGBox* bounds) const {
+  if (!path_) {
+    return false;
+  }
+  // Backend paths report the bounds of their control points. Arcs are turned
+  // into curves differently by each backend, so those are left to them.
+  float min_x = 0.f, min_y = 0.f, max_x = 0.f, max_y = 0.f;
+  bool has_point = false;
+  uint64_t arg = 0;
+  for (uint64_t i = 0; i < path_->n_ops; ++i) {
+    uint64_t n_points = 0;
+    switch (path_->ops[i]) {
+      case SPO_MOVE_TO:
+      case SPO_LINE_TO:
+        n_points = 1;
+        break;
+      case SPO_CUBIC_BEZ:
+        n_points = 3;
+        break;
+      case SPO_QUAD_ARC:
+        n_points = 2;
+        break;
+      case SPO_ELLIPTICAL_ARC:
+        return false;
+      default:
+        break;
+    }
+    if (arg + n_points * 2 > path_->n_args) {
+      break;
+    }
+    for (uint64_t point = 0; point < n_points; ++point, arg += 2) {
+      const float x = path_->args[arg];
+      const float y = path_->args[arg + 1];
+      if (!has_point) {
+        min_x = max_x = x;
+        min_y = max_y = y;
+        has_point = true;
+      }
+      min_x = std::min(min_x, x);
+      max_x = std::max(max_x, x);
+      min_y = std::min(min_y, y);
+      max_y = std::max(max_y, y);
+    }
+  }
+  *bounds = has_point
+                ? SrSVGBox{min_x, min_y, max_x - min_x, max_y - min_y}
+                : SrSVGBox{0.f, 0.f, 0.f, 0.f};
+  return true;
+}
+
 SrSVGPath::~SrSVGPath() {
   release_serval_path(path_);
 }
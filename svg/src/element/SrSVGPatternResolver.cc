@@ -1,11 +1,14 @@
 #include "element/SrSVGPatternResolver.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <optional>
 
 #include "element/SrSVGContainer.h"
 #include "element/SrSVGNode.h"
 #include "element/SrSVGUse.h"
+#include "parser/SrSVGTraversalState.h"
 
 namespace serval {
 namespace svg {
@@ -261,6 +264,53 @@ bool ResolvePatternFromIri(const char* iri, const SrSVGRenderContext& context,
   return true;
 }
 
+PatternTileGrid LayoutPatternTiles(const ResolvedPattern& resolved_pattern,
+                                   const SrSVGBox& pattern_area,
+                                   const SrSVGRenderContext& context) {
+  PatternTileGrid grid;
+  const float width = resolved_pattern.width;
+  const float height = resolved_pattern.height;
+  if (!(width > 0.f) || !(height > 0.f)) {
+    return grid;
+  }
+  const float origin_x =
+      resolved_pattern.x +
+      std::floor((pattern_area.left - resolved_pattern.x) / width) * width;
+  const float origin_y =
+      resolved_pattern.y +
+      std::floor((pattern_area.top - resolved_pattern.y) / height) * height;
+  // Counted in doubles, a tiny tile over a large area overflows integers and
+  // stepping a float by it may never reach the far edge.
+  const double columns = std::ceil(
+      (static_cast<double>(pattern_area.left) + pattern_area.width - origin_x) /
+      width);
+  const double rows = std::ceil(
+      (static_cast<double>(pattern_area.top) + pattern_area.height - origin_y) /
+      height);
+  if (!(columns > 0.0) || !(rows > 0.0)) {
+    return grid;
+  }
+  constexpr double kMaxCount = std::numeric_limits<uint32_t>::max();
+  auto* state =
+      static_cast<parser::SrSVGTraversalState*>(context.traversal_state);
+  if (state && state->budgets) {
+    const double tiles = std::min(columns * rows, kMaxCount);
+    if (!state->Charge<uint64_t>(&state->pattern_tiles,
+                                 static_cast<uint64_t>(tiles),
+                                 state->budgets->max_pattern_tiles,
+                                 SR_SVG_DIAGNOSTIC_PATTERN_BUDGET_EXCEEDED,
+                                 "Skipped pattern tiles past the tile budget.",
+                                 resolved_pattern.id.c_str())) {
+      return grid;
+    }
+  }
+  grid.origin_x = origin_x;
+  grid.origin_y = origin_y;
+  grid.columns = static_cast<uint32_t>(std::min(columns, kMaxCount));
+  grid.rows = static_cast<uint32_t>(std::min(rows, kMaxCount));
+  return grid;
+}
+
 }  // namespace element
 }  // namespace svg
 }  // namespace serval
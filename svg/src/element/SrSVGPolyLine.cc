@@ -5,6 +5,7 @@
 #include "element/SrSVGPolyLine.h"
 
 #include "canvas/SrCanvas.h"
+#include "utils/SrSVGPatternUtils.h"
 
 namespace serval {
 namespace svg {
@@ -38,12 +39,21 @@ std::unique_ptr<canvas::Path> SrSVGPolyLine::AsPath(
       float xform[6];
       ResolvedTransform(xform, *context, path_factory);
       path->Transform(xform);
-      return path;
     }
+    return path;
   }
   return nullptr;
 };
 
+bool SrSVGPolyLine::GeometryBounds(SrSVGRenderContext* context,
+                                   SrSVGBox* bounds) const {
+  if (!polygon_ || polygon_->n_points < 2) {
+    return false;
+  }
+  *bounds = PointsBounds(polygon_->points, polygon_->n_points);
+  return true;
+}
+
 SrSVGPolyLine::~SrSVGPolyLine() {
   if (polygon_) {
     release_serval_polygon_path(polygon_);
@@ -6,6 +6,7 @@
 
 #include "canvas/SrCanvas.h"
 #include "element/SrSVGTypes.h"
+#include "utils/SrSVGPatternUtils.h"
 
 namespace serval {
 namespace svg {
@@ -44,6 +45,15 @@ std::unique_ptr<canvas::Path> SrSVGPolygon::AsPath(
   return nullptr;
 };
 
+bool SrSVGPolygon::GeometryBounds(SrSVGRenderContext* context,
+                                  SrSVGBox* bounds) const {
+  if (!polygon_ || polygon_->n_points < 2) {
+    return false;
+  }
+  *bounds = PointsBounds(polygon_->points, polygon_->n_points);
+  return true;
+}
+
 SrSVGPolygon::~SrSVGPolygon() {
   if (polygon_) {
     release_serval_polygon_path(polygon_);
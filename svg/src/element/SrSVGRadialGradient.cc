@@ -47,6 +47,22 @@ bool SrSVGRadialGradient::ParseAndSetAttribute(const char* name,
   return SrSVGNode::ParseAndSetAttribute(name, value);
 }
 
+const char* SrSVGRadialGradient::DefaultAttributeValue(const char* name) const {
+  if (strcmp(name, "cx") == 0) {
+    return "0.5";
+  }
+  if (strcmp(name, "cy") == 0) {
+    return "0.5";
+  }
+  if (strcmp(name, "r") == 0) {
+    return "0.5";
+  }
+  if (strcmp(name, "gradientTransform") == 0) {
+    return "matrix(1 0 0 1 0 0)";
+  }
+  return SrSVGContainer::DefaultAttributeValue(name);
+}
+
 void SrSVGRadialGradient::OnRender(canvas::SrCanvas* canvas,
                                    SrSVGRenderContext& context) {
   std::vector<SrStop> stops;
@@ -54,6 +54,23 @@ bool SrSVGRect::ParseAndSetAttribute(const char* name, const char* value) {
   return SrSVGShape::ParseAndSetAttribute(name, value);
 }
 
+SrSVGAnimatedField SrSVGRect::AnimatedField(const char* name) {
+  if (strcmp(name, "x") == 0) {
+    return SrSVGAnimatedField{.length = &x_};
+  } else if (strcmp(name, "y") == 0) {
+    return SrSVGAnimatedField{.length = &y_};
+  } else if (strcmp(name, "rx") == 0) {
+    return SrSVGAnimatedField{.length = &rx_};
+  } else if (strcmp(name, "ry") == 0) {
+    return SrSVGAnimatedField{.length = &ry_};
+  } else if (strcmp(name, "width") == 0) {
+    return SrSVGAnimatedField{.length = &width_};
+  } else if (strcmp(name, "height") == 0) {
+    return SrSVGAnimatedField{.length = &height_};
+  }
+  return SrSVGShape::AnimatedField(name);
+}
+
 void SrSVGRect::onDraw(canvas::SrCanvas* const canvas,
                        SrSVGRenderContext& context) const {
   // convert to platform pixel
@@ -100,6 +117,24 @@ std::unique_ptr<canvas::Path> SrSVGRect::AsPath(
   return path;
 }
 
+bool SrSVGRect::GeometryBounds(SrSVGRenderContext* context,
+                               SrSVGBox* bounds) const {
+  const float xf = convert_serval_length_to_float(
+      &x_, context, SR_SVG_LENGTH_TYPE_HORIZONTAL);
+  const float yf =
+      convert_serval_length_to_float(&y_, context, SR_SVG_LENGTH_TYPE_VERTICAL);
+  const float wf = convert_serval_length_to_float(
+      &width_, context, SR_SVG_LENGTH_TYPE_HORIZONTAL);
+  const float hf = convert_serval_length_to_float(&height_, context,
+                                                  SR_SVG_LENGTH_TYPE_VERTICAL);
+  if (!(wf >= 0.f) || !(hf >= 0.f)) {
+    return false;
+  }
+  // Rounded corners stay inside the rectangle.
+  *bounds = SrSVGBox{xf, yf, wf, hf};
+  return true;
+}
+
 }  // namespace element
 }  // namespace svg
 }  // namespace serval
@@ -105,6 +105,14 @@ void SrSVGSVG::OnRender(canvas::SrCanvas* canvas, SrSVGRenderContext& context) {
   SrSVGContainer::OnRender(canvas, context);
 }
 
+bool SrSVGSVG::OnComputeRenderBounds(canvas::SrCanvas* canvas,
+                                     SrSVGRenderContext& context,
+                                     SrSVGBox* bounds) {
+  // An <svg> establishes its own viewport and view box transform while it is
+  // being prepared, so its content cannot be bounded from the parent space.
+  return false;
+}
+
 bool SrSVGSVG::RenderChildAt(canvas::SrCanvas* canvas,
                              SrSVGRenderContext& context, size_t index) {
   canvas->Save();
@@ -9,6 +9,7 @@
 
 #include "canvas/SrCanvas.h"
 #include "element/SrSVGTypes.h"
+#include "utils/SrSVGPatternUtils.h"
 
 namespace serval {
 namespace svg {
@@ -137,6 +138,58 @@ bool SrSVGShape::ParseAndSetAttribute(const char* name, const char* value) {
   return SrSVGNode::ParseAndSetAttribute(name, value);
 }
 
+bool SrSVGShape::OnComputeRenderBounds(canvas::SrCanvas* canvas,
+                                       SrSVGRenderContext& context,
+                                       SrSVGBox* bounds) {
+  *bounds = SrSVGBox{0.f, 0.f, 0.f, 0.f};
+  const float stroke_outset = StrokeOutset(context);
+  if (!PaintsAnything(stroke_outset)) {
+    return true;
+  }
+  if (stroke_outset > 0.f &&
+      vector_effect_ == SR_SVG_VECTOR_EFFECT_NON_SCALING_STROKE) {
+    // The stroke width is defined in device space and cannot be bounded here.
+    return false;
+  }
+  SrSVGBox geometry{0.f, 0.f, 0.f, 0.f};
+  if (!GeometryBounds(&context, &geometry)) {
+    auto path = AsPath(canvas->PathFactory(), &context, false);
+    if (!path) {
+      return true;
+    }
+    geometry = path->GetBounds();
+    canvas->PathFactory()->Recycle(std::move(path));
+  }
+  if (stroke_outset > 0.f) {
+    geometry = OutsetBounds(geometry, stroke_outset, stroke_outset);
+  }
+  if (IsEmptyBounds(geometry)) {
+    return true;
+  }
+  float xform[6];
+  ResolvedTransform(xform, context, canvas->PathFactory());
+  *bounds = MapBounds(geometry, xform);
+  return true;
+}
+
+bool SrSVGShape::PaintsAnything(float stroke_outset) const {
+  const float opacity = opacity_ ? SrSVGNode::ClampOpacity(*opacity_) : 1.f;
+  if (!(opacity > 0.f)) {
+    return false;
+  }
+  const SrSVGPaint* fill = fill_ ? fill_ : inherit_fill_paint_;
+  const std::optional<float>& fill_opacity =
+      fill_opacity_ ? fill_opacity_ : inherit_fill_opacity_;
+  if ((!fill || fill->type != SERVAL_PAINT_NONE) &&
+      (!fill_opacity || SrSVGNode::ClampOpacity(*fill_opacity) > 0.f)) {
+    return true;
+  }
+  const std::optional<float>& stroke_opacity =
+      stroke_opacity_ ? stroke_opacity_ : inherit_stroke_opacity_;
+  return stroke_outset > 0.f &&
+         (!stroke_opacity || SrSVGNode::ClampOpacity(*stroke_opacity) > 0.f);
+}
+
 std::unique_ptr<canvas::Path> SrSVGShape::AsPath(
     canvas::PathFactory* path_factory, SrSVGRenderContext* context,
     bool include_transform) const {
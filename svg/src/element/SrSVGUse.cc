@@ -8,6 +8,7 @@
 
 #include "canvas/SrCanvas.h"
 #include "parser/SrSVGTraversalState.h"
+#include "utils/SrSVGPatternUtils.h"
 #ifdef __ANDROID__
 #include <android/log.h>
 #endif  // __ANDROID__
@@ -34,12 +35,39 @@ bool TryEnterUseReference(parser::SrSVGTraversalState* state,
   return state && !href.empty() && state->active_use_ids.insert(href).second;
 }
 
+// Charges an entered reference to the render's <use> depth and expansion
+// budgets. A refused reference is left again and expands to nothing.
+bool TryChargeUseBudgets(parser::SrSVGTraversalState* state,
+                         const std::string& href) {
+  const auto* budgets = state->budgets;
+  if (!budgets) {
+    return true;
+  }
+  if (state->Charge<uint64_t>(&state->use_depth, 1, budgets->max_use_depth,
+                              SR_SVG_DIAGNOSTIC_USE_BUDGET_EXCEEDED,
+                              "Skipped <use> nested past the depth budget.",
+                              href.c_str())) {
+    if (state->Charge<uint64_t>(
+            &state->use_expansions, 1, budgets->max_use_expansions,
+            SR_SVG_DIAGNOSTIC_USE_BUDGET_EXCEEDED,
+            "Skipped <use> past the expansion budget.", href.c_str())) {
+      return true;
+    }
+    --state->use_depth;
+  }
+  state->active_use_ids.erase(href);
+  return false;
+}
+
 void LeaveUseReference(parser::SrSVGTraversalState* state,
                        const std::string& href) {
   if (!state || href.empty()) {
     return;
   }
   state->active_use_ids.erase(href);
+  if (state->budgets) {
+    --state->use_depth;
+  }
 }
 
 void ReportUseCycle(parser::SrSVGTraversalState* state, const std::string& href,
@@ -127,6 +155,9 @@ void SrSVGUse::OnRender(canvas::SrCanvas* canvas, SrSVGRenderContext& context) {
                    "Skipped recursive <use> reference.");
     return;
   }
+  if (!TryChargeUseBudgets(traversal_state, href_)) {
+    return;
+  }
 
   auto it = id_mapper->find(href_);
   if (it != id_mapper->end() && it->second) {
@@ -151,6 +182,9 @@ std::unique_ptr<canvas::Path> SrSVGUse::AsPath(
                    "Skipped recursive <use> path expansion.");
     return nullptr;
   }
+  if (!TryChargeUseBudgets(traversal_state, href_)) {
+    return nullptr;
+  }
 
   auto it = id_mapper->find(href_);
   if (it != id_mapper->end() && it->second) {
@@ -180,28 +214,21 @@ std::unique_ptr<canvas::Path> SrSVGUse::AsPath(
   return nullptr;
 }
 
-void SrSVGUse::renderRealNode(SrSVGNodeBase* nodeBase, canvas::SrCanvas* canvas,
-                              SrSVGRenderContext& context) {
-  if (!nodeBase || !nodeBase->IsSVGNode()) {
-    return;
-  }
-  if (nodeBase->Tag() == SrSVGTag::kSvg) {
-    return;
-  }
-  SrSVGNode* node = static_cast<SrSVGNode*>(nodeBase);
-  SrSVGPaint* local_fill_paint = node->inherit_fill_paint_;
-  SrSVGPaint* local_stroke_paint = node->inherit_stroke_paint_;
-  SrSVGPaint* local_clip_path = node->inherit_clip_path_;
-  SrSVGPaint* local_mask = node->inherit_mask_;
-  std::optional<SrSVGLength> local_stroke_width = node->inherit_stroke_width_;
-  std::optional<float> local_fill_opacity = node->inherit_fill_opacity_;
-  std::optional<float> local_stroke_opacity = node->inherit_stroke_opacity_;
-  std::optional<SrSVGColor> local_color = node->inherit_color_;
-  SrSVGStrokeCap local_stroke_cap = node->stroke_cap_;
-  SrSVGStrokeJoin local_stroke_join = node->stroke_join_;
-  float local_stroke_miter_limit = node->stoke_miter_limit_;
-  float local_stroke_dash_offset = node->stroke_dash_offset_;
-  std::vector<float> local_stroke_dash_array = node->stroke_dash_array_;
+void SrSVGUse::ApplyToReferencedNode(SrSVGNode* node,
+                                     ReferencedNodeState* saved) const {
+  saved->fill_paint = node->inherit_fill_paint_;
+  saved->stroke_paint = node->inherit_stroke_paint_;
+  saved->clip_path = node->inherit_clip_path_;
+  saved->mask = node->inherit_mask_;
+  saved->stroke_width = node->inherit_stroke_width_;
+  saved->fill_opacity = node->inherit_fill_opacity_;
+  saved->stroke_opacity = node->inherit_stroke_opacity_;
+  saved->color = node->inherit_color_;
+  saved->stroke_cap = node->stroke_cap_;
+  saved->stroke_join = node->stroke_join_;
+  saved->stroke_miter_limit = node->stoke_miter_limit_;
+  saved->stroke_dash_offset = node->stroke_dash_offset_;
+  saved->stroke_dash_array = node->stroke_dash_array_;
 
   if (node->fill_) {
     node->inherit_fill_paint_ = node->fill_;
@@ -259,13 +286,6 @@ void SrSVGUse::renderRealNode(SrSVGNodeBase* nodeBase, canvas::SrCanvas* canvas,
     node->inherit_stroke_opacity_ = inherit_stroke_opacity_;
   }
 
-  float x = ResolveUseLength(x_, &context, SR_SVG_LENGTH_TYPE_HORIZONTAL);
-  float y = ResolveUseLength(y_, &context, SR_SVG_LENGTH_TYPE_VERTICAL);
-  float xform[6];
-  ResolvedTransform(xform, context, canvas->PathFactory());
-  canvas->Transform(xform);
-  canvas->Translate(x, y);
-
   if (node->color_) {
     node->inherit_color_ = node->color_;
   } else if (color_) {
@@ -274,27 +294,6 @@ void SrSVGUse::renderRealNode(SrSVGNodeBase* nodeBase, canvas::SrCanvas* canvas,
     node->inherit_color_ = inherit_color_;
   }
 
-  const float use_opacity =
-      opacity_ ? SrSVGNode::ClampOpacity(opacity_.value_or(1.f)) : 1.f;
-  if (opacity_ && use_opacity <= 0.f) {
-    node->inherit_fill_paint_ = local_fill_paint;
-    node->inherit_stroke_paint_ = local_stroke_paint;
-    node->inherit_fill_opacity_ = local_fill_opacity;
-    node->inherit_stroke_opacity_ = local_stroke_opacity;
-    node->inherit_stroke_width_ = local_stroke_width;
-    node->inherit_clip_path_ = local_clip_path;
-    node->inherit_mask_ = local_mask;
-    node->inherit_color_ = local_color;
-    return;
-  }
-  const bool has_opacity_layer = opacity_ && use_opacity < 1.f;
-  if (has_opacity_layer) {
-    // TODO: Compute tight layer bounds for use opacity. Correctness requires
-    // whole-use composition; passing nullptr keeps the result correct but may
-    // allocate a larger offscreen layer than necessary.
-    canvas->BeginOpacityLayer(nullptr, use_opacity);
-  }
-
   if (has_stroke_cap_) {
     node->stroke_cap_ = stroke_cap_;
   }
@@ -310,6 +309,107 @@ void SrSVGUse::renderRealNode(SrSVGNodeBase* nodeBase, canvas::SrCanvas* canvas,
   if (has_stroke_dash_array_) {
     node->stroke_dash_array_ = stroke_dash_array_;
   }
+}
+
+void SrSVGUse::RestoreReferencedNode(SrSVGNode* node,
+                                     const ReferencedNodeState& saved) {
+  node->inherit_fill_paint_ = saved.fill_paint;
+  node->inherit_stroke_paint_ = saved.stroke_paint;
+  node->inherit_fill_opacity_ = saved.fill_opacity;
+  node->inherit_stroke_opacity_ = saved.stroke_opacity;
+  node->inherit_stroke_width_ = saved.stroke_width;
+  node->inherit_clip_path_ = saved.clip_path;
+  node->inherit_mask_ = saved.mask;
+  node->inherit_color_ = saved.color;
+  node->stroke_cap_ = saved.stroke_cap;
+  node->stroke_join_ = saved.stroke_join;
+  node->stoke_miter_limit_ = saved.stroke_miter_limit;
+  node->stroke_dash_offset_ = saved.stroke_dash_offset;
+  node->stroke_dash_array_ = saved.stroke_dash_array;
+}
+
+bool SrSVGUse::OnComputeRenderBounds(canvas::SrCanvas* canvas,
+                                     SrSVGRenderContext& context,
+                                     SrSVGBox* bounds) {
+  *bounds = SrSVGBox{0.f, 0.f, 0.f, 0.f};
+  IDMapper* id_mapper = static_cast<IDMapper*>(context.id_mapper);
+  auto* traversal_state = GetTraversalState(context);
+  if (!id_mapper || href_.empty() || !traversal_state) {
+    return true;
+  }
+  if (opacity_ && SrSVGNode::ClampOpacity(opacity_.value_or(1.f)) <= 0.f) {
+    return true;
+  }
+  auto it = id_mapper->find(href_);
+  if (it == id_mapper->end() || !it->second || !it->second->IsSVGNode() ||
+      it->second->Tag() == SrSVGTag::kSvg) {
+    return true;
+  }
+  // Recursive references are reported when rendering; refusing to bound them
+  // here keeps the enclosing layer unbounded, which is always correct.
+  if (!TryEnterUseReference(traversal_state, href_) ||
+      !TryChargeUseBudgets(traversal_state, href_)) {
+    return false;
+  }
+  auto* node = static_cast<SrSVGNode*>(it->second);
+  ReferencedNodeState saved;
+  ApplyToReferencedNode(node, &saved);
+  SrSVGBox node_bounds{0.f, 0.f, 0.f, 0.f};
+  const bool bounded = node->ComputeRenderBounds(canvas, context, &node_bounds);
+  RestoreReferencedNode(node, saved);
+  LeaveUseReference(traversal_state, href_);
+  if (!bounded) {
+    return false;
+  }
+  if (IsEmptyBounds(node_bounds)) {
+    return true;
+  }
+  const float x = ResolveUseLength(x_, &context, SR_SVG_LENGTH_TYPE_HORIZONTAL);
+  const float y = ResolveUseLength(y_, &context, SR_SVG_LENGTH_TYPE_VERTICAL);
+  float resolved_transform[6];
+  ResolvedTransform(resolved_transform, context, canvas->PathFactory());
+  float use_transform[6];
+  BuildUseTransform(x, y, resolved_transform, use_transform);
+  *bounds = MapBounds(node_bounds, use_transform);
+  return true;
+}
+
+void SrSVGUse::renderRealNode(SrSVGNodeBase* nodeBase, canvas::SrCanvas* canvas,
+                              SrSVGRenderContext& context) {
+  if (!nodeBase || !nodeBase->IsSVGNode()) {
+    return;
+  }
+  if (nodeBase->Tag() == SrSVGTag::kSvg) {
+    return;
+  }
+  SrSVGNode* node = static_cast<SrSVGNode*>(nodeBase);
+  const float use_opacity =
+      opacity_ ? SrSVGNode::ClampOpacity(opacity_.value_or(1.f)) : 1.f;
+  if (opacity_ && use_opacity <= 0.f) {
+    return;
+  }
+
+  ReferencedNodeState saved;
+  ApplyToReferencedNode(node, &saved);
+
+  float x = ResolveUseLength(x_, &context, SR_SVG_LENGTH_TYPE_HORIZONTAL);
+  float y = ResolveUseLength(y_, &context, SR_SVG_LENGTH_TYPE_VERTICAL);
+  float xform[6];
+  ResolvedTransform(xform, context, canvas->PathFactory());
+  canvas->Transform(xform);
+  canvas->Translate(x, y);
+
+  const bool has_opacity_layer = opacity_ && use_opacity < 1.f;
+  if (has_opacity_layer) {
+    // Correctness requires whole-use composition; the layer only has to cover
+    // what the referenced node paints in the translated use space.
+    SrSVGBox layer_bounds{0.f, 0.f, 0.f, 0.f};
+    const bool has_layer_bounds =
+        node->ComputeRenderBounds(canvas, context, &layer_bounds) &&
+        !IsEmptyBounds(layer_bounds);
+    canvas->BeginOpacityLayer(has_layer_bounds ? &layer_bounds : nullptr,
+                              use_opacity);
+  }
 
   // render the real node
   node->Render(canvas, context);
@@ -318,19 +418,7 @@ void SrSVGUse::renderRealNode(SrSVGNodeBase* nodeBase, canvas::SrCanvas* canvas,
     canvas->EndOpacityLayer();
   }
 
-  node->inherit_fill_paint_ = local_fill_paint;
-  node->inherit_stroke_paint_ = local_stroke_paint;
-  node->inherit_fill_opacity_ = local_fill_opacity;
-  node->inherit_stroke_opacity_ = local_stroke_opacity;
-  node->inherit_stroke_width_ = local_stroke_width;
-  node->inherit_clip_path_ = local_clip_path;
-  node->inherit_mask_ = local_mask;
-  node->inherit_color_ = local_color;
-  node->stroke_cap_ = local_stroke_cap;
-  node->stroke_join_ = local_stroke_join;
-  node->stoke_miter_limit_ = local_stroke_miter_limit;
-  node->stroke_dash_offset_ = local_stroke_dash_offset;
-  node->stroke_dash_array_ = local_stroke_dash_array;
+  RestoreReferencedNode(node, saved);
 }
 
 bool SrSVGUse::HasChildren() const {
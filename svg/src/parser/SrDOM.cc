@@ -16,7 +16,9 @@ SrDOM::SrDOM() : fRoot(nullptr) {}
 static void Destroy_node(SrDOMNode* node);
 
 SrDOM::~SrDOM() {
-  Destroy_node(fRoot);
+  if (!fStorage) {
+    Destroy_node(fRoot);
+  }
 }
 
 const SrDOM::Node* SrDOM::GetRootNode() const {
@@ -149,19 +151,32 @@ const SrDOM::Node* SrDOM::Copy(const SrDOM& dom, const SrDOM::Node* node) {
   return fRoot;
 }
 
-SrXMLParser* SrDOM::BeginParsing() {
-  fParser = std::make_unique<SrDOMParser>();
+const SrDOM::Node* SrDOM::Adopt(std::unique_ptr<SrDOMStorage> storage,
+                                Node* root) {
+  if (!fStorage) {
+    Destroy_node(fRoot);
+  }
+  fStorage = std::move(storage);
+  fRoot = fStorage ? root : nullptr;
+  return fRoot;
+}
+
+SrXMLParser* SrDOM::BeginParsing(const SrSVGDiagnosticSink* diagnostic_sink) {
+  fParser = std::make_unique<SrDOMParser>(diagnostic_sink);
 
   return fParser.get();
 }
 
-const SrDOM::Node* SrDOM::FinishParsing() {
-  if (!fParser->Finish()) {
-    fRoot = nullptr;
-    fParser.reset();
+const SrDOM::Node* SrDOM::FinishParsing(SrXMLParserError* error) {
+  if (!fParser) {
     return nullptr;
   }
-  fRoot = fParser->releaseRoot();
+  const bool ok = (!fParser->hasChunks() || fParser->finishChunks()) &&
+                  fParser->Finish();
+  if (error) {
+    *error = fParser->fParserError;
+  }
+  fRoot = ok ? fParser->releaseRoot() : nullptr;
   fParser.reset();
 
   return fRoot;
@@ -0,0 +1,413 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "parser/SrDOMBinary.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace serval {
+namespace svg {
+namespace parser {
+
+namespace {
+
+constexpr size_t kHeaderSize = 4 + 2 + 2 + 4 * 5;
+constexpr size_t kNodeRecordSize = 1 + 4 + 2 + 4;
+constexpr size_t kAttrRecordSize = 4 + 4;
+constexpr size_t kPathRecordSize = 4 + 4 + 4;
+constexpr size_t kDiagnosticRecordSize = 4 + 1 + 4 + 4;
+
+class Writer {
+ public:
+  explicit Writer(std::vector<uint8_t>* out) : out_(out) {}
+
+  void U8(uint8_t value) { out_->push_back(value); }
+  void U16(uint16_t value) {
+    U8(static_cast<uint8_t>(value));
+    U8(static_cast<uint8_t>(value >> 8));
+  }
+  void U32(uint32_t value) {
+    U16(static_cast<uint16_t>(value));
+    U16(static_cast<uint16_t>(value >> 16));
+  }
+  void F32(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    U32(bits);
+  }
+  void Bytes(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    out_->insert(out_->end(), bytes, bytes + size);
+  }
+
+ private:
+  std::vector<uint8_t>* out_;
+};
+
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t len) : data_(data), len_(len) {}
+
+  bool Has(size_t size) const { return size <= len_ - pos_; }
+  bool U8(uint8_t* value) {
+    if (!Has(1)) {
+      return false;
+    }
+    *value = data_[pos_++];
+    return true;
+  }
+  bool U16(uint16_t* value) {
+    if (!Has(2)) {
+      return false;
+    }
+    *value = static_cast<uint16_t>(data_[pos_] | (data_[pos_ + 1] << 8));
+    pos_ += 2;
+    return true;
+  }
+  bool U32(uint32_t* value) {
+    if (!Has(4)) {
+      return false;
+    }
+    *value = static_cast<uint32_t>(data_[pos_]) |
+             (static_cast<uint32_t>(data_[pos_ + 1]) << 8) |
+             (static_cast<uint32_t>(data_[pos_ + 2]) << 16) |
+             (static_cast<uint32_t>(data_[pos_ + 3]) << 24);
+    pos_ += 4;
+    return true;
+  }
+  bool F32(float* value) {
+    uint32_t bits;
+    if (!U32(&bits)) {
+      return false;
+    }
+    std::memcpy(value, &bits, sizeof(bits));
+    return true;
+  }
+  const uint8_t* Bytes(size_t size) {
+    if (!Has(size)) {
+      return nullptr;
+    }
+    const uint8_t* bytes = data_ + pos_;
+    pos_ += size;
+    return bytes;
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t len_;
+  size_t pos_{0};
+};
+
+// Keys view the interned strings, which must outlive the table.
+class StringTable {
+ public:
+  uint32_t Intern(const char* value) {
+    std::string_view key(value ? value : "");
+    auto it = offsets_.find(key);
+    if (it != offsets_.end()) {
+      return it->second;
+    }
+    const auto offset = static_cast<uint32_t>(bytes_.size());
+    bytes_.append(key.data(), key.size());
+    bytes_.push_back('\0');
+    offsets_.emplace(key, offset);
+    return offset;
+  }
+  const std::string& bytes() const { return bytes_; }
+
+ private:
+  std::string bytes_;
+  std::unordered_map<std::string_view, uint32_t> offsets_;
+};
+
+struct PathRecord {
+  uint32_t attr_index;
+  SrPathData* path;
+};
+
+bool IsPathDataAttribute(const char* element, const char* attribute) {
+  return element && attribute && std::strcmp(element, "path") == 0 &&
+         std::strcmp(attribute, "d") == 0;
+}
+
+}  // namespace
+
+bool EncodeDOMBinary(const SrDOM& dom,
+                     const std::vector<SrSVGDiagnostic>& diagnostics,
+                     uint16_t version, std::vector<uint8_t>* out) {
+  const SrDOM::Node* root = dom.GetRootNode();
+  if (!root || !out) {
+    return false;
+  }
+  StringTable strings;
+  std::vector<uint8_t> nodes;
+  Writer node_writer(&nodes);
+  std::vector<PathRecord> paths;
+  uint32_t node_count = 0;
+  uint32_t attr_count = 0;
+
+  // Iterative pre-order walk; documents can nest deeper than the stack allows.
+  std::vector<const SrDOM::Node*> stack{root};
+  while (!stack.empty()) {
+    const SrDOM::Node* node = stack.back();
+    stack.pop_back();
+    ++node_count;
+    uint32_t child_count = 0;
+    for (auto* child = dom.GetFirstChild(node, nullptr); child;
+         child = dom.GetNextSibling(child)) {
+      ++child_count;
+    }
+    node_writer.U8(node->fType);
+    node_writer.U32(strings.Intern(node->fName));
+    node_writer.U16(node->fAttrCount);
+    node_writer.U32(child_count);
+    for (uint16_t i = 0; i < node->fAttrCount; ++i) {
+      const SrDOMAttr& attr = node->attrs()[i];
+      node_writer.U32(strings.Intern(attr.fName));
+      node_writer.U32(strings.Intern(attr.fValue));
+      if (IsPathDataAttribute(node->fName, attr.fName) && attr.fValue &&
+          attr.fValue[0]) {
+        paths.push_back({attr_count, make_serval_path(attr.fValue, nullptr)});
+      }
+      ++attr_count;
+    }
+    const size_t first_child = stack.size();
+    for (auto* child = dom.GetFirstChild(node, nullptr); child;
+         child = dom.GetNextSibling(child)) {
+      stack.push_back(child);
+    }
+    // Children were pushed in document order; pop them in the same order.
+    std::reverse(stack.begin() + first_child, stack.end());
+  }
+
+  std::vector<uint32_t> diagnostic_strings;
+  diagnostic_strings.reserve(diagnostics.size() * 2);
+  for (const auto& diagnostic : diagnostics) {
+    diagnostic_strings.push_back(strings.Intern(diagnostic.message.c_str()));
+    diagnostic_strings.push_back(strings.Intern(diagnostic.subject.c_str()));
+  }
+
+  out->clear();
+  Writer writer(out);
+  writer.Bytes(kSrDOMBinaryMagic, sizeof(kSrDOMBinaryMagic));
+  writer.U16(version);
+  writer.U16(0);
+  writer.U32(static_cast<uint32_t>(strings.bytes().size()));
+  writer.U32(node_count);
+  writer.U32(attr_count);
+  writer.U32(static_cast<uint32_t>(paths.size()));
+  writer.U32(static_cast<uint32_t>(diagnostics.size()));
+  writer.Bytes(strings.bytes().data(), strings.bytes().size());
+  writer.Bytes(nodes.data(), nodes.size());
+  for (auto& record : paths) {
+    SrPathData* path = record.path;
+    writer.U32(record.attr_index);
+    writer.U32(path ? path->n_ops : 0);
+    writer.U32(path ? path->n_args : 0);
+    if (path) {
+      writer.Bytes(path->ops, path->n_ops);
+      for (uint32_t i = 0; i < path->n_args; ++i) {
+        writer.F32(path->args[i]);
+      }
+      release_serval_path(path);
+    }
+  }
+  for (size_t i = 0; i < diagnostics.size(); ++i) {
+    writer.U32(static_cast<uint32_t>(diagnostics[i].code));
+    writer.U8(diagnostics[i].fatal ? 1 : 0);
+    writer.U32(diagnostic_strings[i * 2]);
+    writer.U32(diagnostic_strings[i * 2 + 1]);
+  }
+  return true;
+}
+
+bool DecodeDOMBinary(const uint8_t* data, size_t len, uint16_t version,
+                     SrDOMBinaryContent* out) {
+  if (!data || !out) {
+    return false;
+  }
+  Reader reader(data, len);
+  const uint8_t* magic = reader.Bytes(sizeof(kSrDOMBinaryMagic));
+  uint16_t blob_version = 0;
+  uint16_t reserved = 0;
+  uint32_t string_bytes = 0, node_count = 0, attr_count = 0, path_count = 0,
+           diagnostic_count = 0;
+  if (!magic ||
+      std::memcmp(magic, kSrDOMBinaryMagic, sizeof(kSrDOMBinaryMagic)) != 0 ||
+      !reader.U16(&blob_version) || blob_version != version ||
+      !reader.U16(&reserved) || !reader.U32(&string_bytes) ||
+      !reader.U32(&node_count) || !reader.U32(&attr_count) ||
+      !reader.U32(&path_count) || !reader.U32(&diagnostic_count)) {
+    return false;
+  }
+  // Reject counts the remaining bytes cannot hold before allocating for them.
+  const size_t remaining = len - kHeaderSize;
+  if (node_count == 0 || string_bytes > remaining ||
+      node_count > remaining / kNodeRecordSize ||
+      attr_count > remaining / kAttrRecordSize ||
+      path_count > remaining / kPathRecordSize ||
+      diagnostic_count > remaining / kDiagnosticRecordSize) {
+    return false;
+  }
+
+  auto storage = std::make_unique<SrDOMStorage>();
+  const uint8_t* string_data = reader.Bytes(string_bytes);
+  if (!string_data || (string_bytes > 0 && string_data[string_bytes - 1])) {
+    return false;
+  }
+  storage->strings.assign(string_data, string_data + string_bytes);
+  auto string_at = [&](uint32_t offset, const char** value) {
+    if (offset >= storage->strings.size()) {
+      return false;
+    }
+    *value = storage->strings.data() + offset;
+    return true;
+  };
+
+  storage->nodes.resize(node_count);
+  storage->attrs.resize(attr_count);
+  struct Pending {
+    SrDOMNode* node;
+    uint32_t remaining_children;
+    SrDOMNode* last_child;
+  };
+  std::vector<Pending> parents;
+  uint32_t next_attr = 0;
+  for (uint32_t index = 0; index < node_count; ++index) {
+    SrDOMNode& node = storage->nodes[index];
+    uint8_t type = 0;
+    uint32_t name = 0, child_count = 0;
+    uint16_t node_attr_count = 0;
+    if (!reader.U8(&type) || !reader.U32(&name) ||
+        !reader.U16(&node_attr_count) || !reader.U32(&child_count) ||
+        type > SrDOM::kText_Type || !string_at(name, &node.fName) ||
+        node_attr_count > attr_count - next_attr) {
+      return false;
+    }
+    node.fType = type;
+    node.fPad = 0;
+    node.fFirstChild = nullptr;
+    node.fNextSibling = nullptr;
+    node.fAttrCount = node_attr_count;
+    node.fAttrs = node_attr_count ? &storage->attrs[next_attr] : nullptr;
+    for (uint16_t i = 0; i < node_attr_count; ++i, ++next_attr) {
+      uint32_t attr_name = 0, attr_value = 0;
+      SrDOMAttr& attr = storage->attrs[next_attr];
+      if (!reader.U32(&attr_name) || !reader.U32(&attr_value) ||
+          !string_at(attr_name, &attr.fName) ||
+          !string_at(attr_value, &attr.fValue)) {
+        return false;
+      }
+    }
+
+    if (index > 0) {
+      if (parents.empty()) {
+        // More than one root.
+        return false;
+      }
+      Pending& parent = parents.back();
+      if (parent.last_child) {
+        parent.last_child->fNextSibling = &node;
+      } else {
+        parent.node->fFirstChild = &node;
+      }
+      parent.last_child = &node;
+      --parent.remaining_children;
+    }
+    if (child_count > node_count - index - 1) {
+      return false;
+    }
+    if (child_count > 0) {
+      parents.push_back({&node, child_count, nullptr});
+    }
+    while (!parents.empty() && parents.back().remaining_children == 0) {
+      parents.pop_back();
+    }
+  }
+  if (!parents.empty() || next_attr != attr_count) {
+    return false;
+  }
+
+  struct PathRange {
+    uint32_t attr_index;
+    uint32_t ops_offset;
+    uint32_t n_ops;
+    uint32_t args_offset;
+    uint32_t n_args;
+  };
+  std::vector<PathRange> ranges;
+  ranges.reserve(path_count);
+  out->path_ops.clear();
+  out->path_args.clear();
+  for (uint32_t i = 0; i < path_count; ++i) {
+    PathRange range{};
+    if (!reader.U32(&range.attr_index) || !reader.U32(&range.n_ops) ||
+        !reader.U32(&range.n_args) || range.attr_index >= attr_count) {
+      return false;
+    }
+    const uint8_t* ops = reader.Bytes(range.n_ops);
+    if (!ops || !reader.Has(static_cast<size_t>(range.n_args) * 4)) {
+      return false;
+    }
+    range.ops_offset = static_cast<uint32_t>(out->path_ops.size());
+    range.args_offset = static_cast<uint32_t>(out->path_args.size());
+    out->path_ops.insert(out->path_ops.end(), ops, ops + range.n_ops);
+    for (uint32_t arg = 0; arg < range.n_args; ++arg) {
+      float value = 0.f;
+      reader.F32(&value);
+      out->path_args.push_back(value);
+    }
+    ranges.push_back(range);
+  }
+
+  out->diagnostics.clear();
+  out->diagnostics.reserve(diagnostic_count);
+  for (uint32_t i = 0; i < diagnostic_count; ++i) {
+    uint32_t code = 0, message = 0, subject = 0;
+    uint8_t fatal = 0;
+    const char* message_value = nullptr;
+    const char* subject_value = nullptr;
+    if (!reader.U32(&code) || !reader.U8(&fatal) || !reader.U32(&message) ||
+        !reader.U32(&subject) || !string_at(message, &message_value) ||
+        !string_at(subject, &subject_value)) {
+      return false;
+    }
+    SrSVGDiagnostic diagnostic;
+    diagnostic.code = static_cast<SrSVGDiagnosticCode>(code);
+    diagnostic.message = message_value;
+    diagnostic.subject = subject_value;
+    diagnostic.fatal = fatal != 0;
+    out->diagnostics.push_back(std::move(diagnostic));
+  }
+
+  // Pointers into the path arrays are taken once they no longer grow.
+  out->path_data.assign(ranges.size(), SrPathData{});
+  out->paths.clear();
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const PathRange& range = ranges[i];
+    SrPathData& path = out->path_data[i];
+    path.ops = range.n_ops ? out->path_ops.data() + range.ops_offset : nullptr;
+    path.n_ops = range.n_ops;
+    path.c_ops = range.n_ops;
+    path.args =
+        range.n_args ? out->path_args.data() + range.args_offset : nullptr;
+    path.n_args = range.n_args;
+    path.c_args = range.n_args;
+    out->paths[storage->attrs[range.attr_index].fValue] = &path;
+  }
+
+  SrDOMNode* root = &storage->nodes[0];
+  out->dom = std::make_shared<SrDOM>();
+  out->dom->Adopt(std::move(storage), root);
+  return true;
+}
+
+}  // namespace parser
+}  // namespace svg
+}  // namespace serval
@@ -34,7 +34,9 @@
 #include "element/SrSVGText.h"
 #include "element/SrSVGUse.h"
 #include "parser/SrDOM.h"
+#include "parser/SrDOMBinary.h"
 #include "parser/SrSVGTraversalState.h"
+#include "parser/SrXMLParser.h"
 #include "parser/SrXMLParserError.h"
 #include "utils/SrFloatComparison.h"
 #include "utils/SrSVGLog.h"
@@ -80,6 +82,17 @@ SrSVGDiagnosticSink MakeDiagnosticSink(SrSVGTraversalState* state) {
   return sink;
 }
 
+bool ContainsDiagnostic(const std::vector<SrSVGDiagnostic>& diagnostics,
+                        const SrSVGDiagnostic& diagnostic) {
+  return std::any_of(diagnostics.begin(), diagnostics.end(),
+                     [&diagnostic](const SrSVGDiagnostic& other) {
+                       return other.code == diagnostic.code &&
+                              other.message == diagnostic.message &&
+                              other.subject == diagnostic.subject &&
+                              other.fatal == diagnostic.fatal;
+                     });
+}
+
 void ApplyAnimations(const std::vector<element::SrSVGNodeBase*>& nodes,
                      const element::IDMapper* id_mapper, double seconds) {
   for (auto* node : nodes) {
@@ -148,6 +161,46 @@ void BindTargetAnimationsInNodes(
   }
 }
 
+// Base values are only kept for attributes an animation targets, once every
+// animation is bound, instead of copying every attribute of every node.
+void StoreAnimatedBaseAttributes(
+    const std::list<element::SrSVGNodeBase*>& nodes,
+    const std::vector<const SrDOM::Node*>& sources) {
+  auto source_it = sources.begin();
+  for (auto* node : nodes) {
+    if (source_it == sources.end()) {
+      return;
+    }
+    const SrDOM::Node* xml_node = *source_it++;
+    if (!node || !node->HasAnimations()) {
+      continue;
+    }
+    for (auto* animation : *node->Animations()) {
+      if (!animation) {
+        continue;
+      }
+      const std::string target_attribute = animation->TargetAttributeName();
+      if (target_attribute.empty()) {
+        continue;
+      }
+      const char* base_value = nullptr;
+      const char *name, *value;
+      SrDOM::AttrIter attr_iter(xml_node);
+      while ((name = attr_iter.Next(&value))) {
+        if (target_attribute == name) {
+          base_value = value;
+        }
+      }
+      if (!base_value) {
+        base_value = node->DefaultAttributeValue(target_attribute.c_str());
+      }
+      if (base_value) {
+        node->StoreAttribute(target_attribute.c_str(), base_value);
+      }
+    }
+  }
+}
+
 }  // namespace
 
 static bool gEnableDumpDom = false;
@@ -239,21 +292,54 @@ bool set_string_attribute(element::SrSVGNodeBase* node, const char* name,
   return node->ParseAndSetAttribute(name, value);
 }
 
+// Drops the path data of |node| once the document has used up its path op
+// budget, so later paths render empty instead of growing the work.
+void charge_path_ops(element::SrSVGNodeBase* node,
+                     SrSVGTraversalState* build_state) {
+  if (!build_state || !build_state->budgets ||
+      node->Tag() != element::SrSVGTag::kPath) {
+    return;
+  }
+  auto* path = static_cast<element::SrSVGPath*>(node);
+  const SrPathData* path_data = path->path_data();
+  if (!path_data || path_data->n_ops == 0) {
+    return;
+  }
+  if (!build_state->Charge<uint64_t>(
+          &build_state->path_ops, path_data->n_ops,
+          build_state->budgets->max_path_ops,
+          SR_SVG_DIAGNOSTIC_PATH_BUDGET_EXCEEDED,
+          "Dropped path data over the document path op budget.",
+          path->Id().c_str())) {
+    path->SetAnimatedPathData(nullptr);
+  }
+}
+
 void parse_node_attribute(const SrDOM& dom, const SrDOM::Node* xmlNode,
                           element::SrSVGNodeBase* svgNode,
                           element::IDMapper* id_mapper,
-                          const SrSVGDiagnosticSink* diagnostic_sink) {
+                          const SrSVGDiagnosticSink* diagnostic_sink,
+                          SrSVGTraversalState* build_state,
+                          const SrPreparsedPaths* preparsed_paths) {
   svgNode->SetDiagnosticSink(diagnostic_sink);
   const char *name, *value;
   SrDOM::AttrIter attr_iter(xmlNode);
   while ((name = attr_iter.Next(&value))) {
-    svgNode->StoreAttribute(name, value);
     if (!std::strcmp(name, "id")) {
       std::string key{value};
       (*id_mapper)[key] = svgNode;
     }
+    if (preparsed_paths && svgNode->Tag() == element::SrSVGTag::kPath &&
+        !std::strcmp(name, "d")) {
+      auto it = preparsed_paths->find(value);
+      if (it != preparsed_paths->end()) {
+        svgNode->SetAnimatedPathData(it->second);
+        continue;
+      }
+    }
     set_string_attribute(svgNode, name, value);
   }
+  charge_path_ops(svgNode, build_state);
 }
 
 void pre_parse_inherit_attribute(const element::SrSVGNode* parent_node,
@@ -293,14 +379,26 @@ element::SrSVGNodeBase* construct_svg_node(
     const SrDOM& dom, const element::SrSVGNodeBase* parentNode,
     const SrDOM::Node* curNode, element::IDMapper* id_mapper,
     std::list<element::SrSVGNodeBase*>& holder,
-    const SrSVGDiagnosticSink* diagnostic_sink) {
+    std::vector<const SrDOM::Node*>& sources,
+    const SrSVGDiagnosticSink* diagnostic_sink,
+    SrSVGTraversalState* build_state,
+    const SrPreparsedPaths* preparsed_paths = nullptr) {
   const char* el = dom.GetName(curNode);
   const auto type = dom.GetType(curNode);
+  // Elements past the node budget are dropped with their subtrees.
+  if (build_state && build_state->budgets &&
+      !build_state->Charge<uint64_t>(
+          &build_state->nodes, 1, build_state->budgets->max_nodes,
+          SR_SVG_DIAGNOSTIC_NODE_BUDGET_EXCEEDED,
+          "Dropped elements over the document node budget.", el)) {
+    return nullptr;
+  }
 
   if (type == SrDOM::Type::kText_Type) {
     auto* text_el = element::SrSVGRawText::Make();
     text_el->SetText(el);
     holder.push_back(text_el);
+    sources.push_back(curNode);
     return text_el;
   }
 
@@ -375,7 +473,16 @@ element::SrSVGNodeBase* construct_svg_node(
   if (!node) {
     return nullptr;
   }
+  if (IsAnimationTag(node->Tag()) && build_state && build_state->budgets &&
+      !build_state->Charge<uint64_t>(
+          &build_state->animations, 1, build_state->budgets->max_animations,
+          SR_SVG_DIAGNOSTIC_ANIMATION_BUDGET_EXCEEDED,
+          "Dropped animations over the document animation budget.", el)) {
+    delete node;
+    return nullptr;
+  }
   holder.push_back(node);
+  sources.push_back(curNode);
   if (parentNode) {
     if (parentNode->IsSVGNode() && node->IsSVGNode()) {
       pre_parse_inherit_attribute(
@@ -384,11 +491,13 @@ element::SrSVGNodeBase* construct_svg_node(
     }
     pre_parse_inherit_color(parentNode, node);
   }
-  parse_node_attribute(dom, curNode, node, id_mapper, diagnostic_sink);
+  parse_node_attribute(dom, curNode, node, id_mapper, diagnostic_sink,
+                       build_state, preparsed_paths);
   for (auto* child = dom.GetFirstChild(curNode, nullptr); child;
        child = dom.GetNextSibling(child)) {
-    element::SrSVGNodeBase* childNode = construct_svg_node(
-        dom, node, child, id_mapper, holder, diagnostic_sink);
+    element::SrSVGNodeBase* childNode =
+        construct_svg_node(dom, node, child, id_mapper, holder, sources,
+                           diagnostic_sink, build_state, preparsed_paths);
     if (childNode && IsAnimationTag(childNode->Tag())) {
       BindAnimation(node, static_cast<element::SrSVGAnimation*>(childNode),
                     id_mapper);
@@ -402,48 +511,93 @@ element::SrSVGNodeBase* construct_svg_node(
 
 std::unique_ptr<SrSVGDOM> SrSVGDOM::make(
     const char* doc, size_t len, std::vector<SrSVGDiagnostic>* diagnostics) {
+  return make(doc, len, diagnostics, SrSVGBudgets());
+}
+
+std::unique_ptr<SrSVGDOM> SrSVGDOM::make(
+    const char* doc, size_t len, std::vector<SrSVGDiagnostic>* diagnostics,
+    const SrSVGBudgets& budgets) {
   SrSVGTraversalState build_state;
   SrSVGDiagnosticSink build_sink = MakeDiagnosticSink(&build_state);
   auto xml_dom = std::make_shared<SrDOM>();
   SrXMLParserError parser_error;
-  if (!xml_dom->build(doc, len, &parser_error, &build_sink)) {
+  const bool parsed = xml_dom->build(doc, len, &parser_error, &build_sink);
+  return MakeFromParse(std::move(xml_dom), parsed, parser_error, &build_state,
+                       budgets, diagnostics);
+}
+
+std::unique_ptr<SrSVGDOM> SrSVGDOM::MakeFromParse(
+    std::shared_ptr<SrDOM> xml_dom, bool parsed,
+    const SrXMLParserError& parser_error, SrSVGTraversalState* build_state,
+    const SrSVGBudgets& budgets, std::vector<SrSVGDiagnostic>* diagnostics) {
+  if (!parsed) {
     if (diagnostics && parser_error.HasError()) {
       diagnostics->push_back(MakeParserDiagnostic(parser_error));
     }
     return nullptr;
   }
   if (parser_error.HasError()) {
-    build_state.diagnostics.push_back(MakeParserDiagnostic(parser_error));
+    build_state->diagnostics.push_back(MakeParserDiagnostic(parser_error));
   }
   if (gEnableDumpDom) {
     DumpDomTree(*xml_dom, xml_dom->GetRootNode(), 0);
   }
+  return MakeFromXMLDOM(std::move(xml_dom), nullptr, budgets,
+                        std::move(build_state->diagnostics), diagnostics);
+}
+
+std::unique_ptr<SrSVGDOM> SrSVGDOM::makeFromBinary(
+    const uint8_t* data, size_t len,
+    std::vector<SrSVGDiagnostic>* diagnostics) {
+  return makeFromBinary(data, len, diagnostics, SrSVGBudgets());
+}
+
+std::unique_ptr<SrSVGDOM> SrSVGDOM::makeFromBinary(
+    const uint8_t* data, size_t len, std::vector<SrSVGDiagnostic>* diagnostics,
+    const SrSVGBudgets& budgets) {
+  SrDOMBinaryContent content;
+  if (!DecodeDOMBinary(data, len, kBinaryFormatVersion, &content)) {
+    return nullptr;
+  }
+  return MakeFromXMLDOM(std::move(content.dom), &content.paths, budgets,
+                        std::move(content.diagnostics), diagnostics);
+}
+
+std::unique_ptr<SrSVGDOM> SrSVGDOM::MakeFromXMLDOM(
+    std::shared_ptr<SrDOM> xml_dom, const SrPreparsedPaths* preparsed_paths,
+    const SrSVGBudgets& budgets,
+    std::vector<SrSVGDiagnostic> build_diagnostics,
+    std::vector<SrSVGDiagnostic>* diagnostics) {
   auto id_mapper = std::make_unique<element::IDMapper>();
   std::list<element::SrSVGNodeBase*> holder;
+  std::vector<const SrDOM::Node*> sources;
   auto* root_node = xml_dom->GetRootNode();
   if (!root_node) {
-    if (diagnostics && !build_state.diagnostics.empty()) {
-      *diagnostics = build_state.diagnostics;
+    if (diagnostics && !build_diagnostics.empty()) {
+      *diagnostics = std::move(build_diagnostics);
     }
     return nullptr;
   }
-  auto* root = construct_svg_node(*xml_dom, nullptr, root_node, id_mapper.get(),
-                                  holder, &build_sink);
-  if (!root) {
-    for (auto* node : holder) {
-      delete node;
-    }
-    if (diagnostics && !build_state.diagnostics.empty()) {
-      *diagnostics = build_state.diagnostics;
+  SrSVGTraversalState build_state;
+  build_state.budgets = &budgets;
+  SrSVGDiagnosticSink build_sink = MakeDiagnosticSink(&build_state);
+  auto* root =
+      construct_svg_node(*xml_dom, nullptr, root_node, id_mapper.get(), holder,
+                         sources, &build_sink, &build_state, preparsed_paths);
+  // A blob already stores what its source build reported.
+  for (auto& diagnostic : build_state.diagnostics) {
+    if (!ContainsDiagnostic(build_diagnostics, diagnostic)) {
+      build_diagnostics.push_back(std::move(diagnostic));
     }
-    return nullptr;
   }
-  if (root->Tag() == element::SrSVGTag::kSvg) {
+  if (root && root->Tag() == element::SrSVGTag::kSvg) {
     auto svg_dom = std::make_unique<SrSVGDOM>(
         static_cast<element::SrSVGSVG*>(root), id_mapper.release(),
-        std::move(holder), xml_dom);
+        std::move(holder), std::move(xml_dom));
+    svg_dom->budgets_ = budgets;
     svg_dom->BindTargetAnimations();
-    svg_dom->SetBuildDiagnostics(std::move(build_state.diagnostics));
+    StoreAnimatedBaseAttributes(svg_dom->nodes_, sources);
+    svg_dom->SetBuildDiagnostics(std::move(build_diagnostics));
     if (diagnostics) {
       *diagnostics = svg_dom->diagnostics();
     }
@@ -452,12 +606,51 @@ std::unique_ptr<SrSVGDOM> SrSVGDOM::make(
   for (auto* node : holder) {
     delete node;
   }
-  if (diagnostics && !build_state.diagnostics.empty()) {
-    *diagnostics = build_state.diagnostics;
+  if (diagnostics && !build_diagnostics.empty()) {
+    *diagnostics = std::move(build_diagnostics);
   }
   return nullptr;
 }
 
+bool SrSVGDOM::Serialize(std::vector<uint8_t>* out) const {
+  if (!out || !xml_dom_ || !xml_dom_->GetRootNode()) {
+    return false;
+  }
+  const auto count = std::min(static_diagnostic_count_, diagnostics_.size());
+  std::vector<SrSVGDiagnostic> build_diagnostics(
+      diagnostics_.begin(), diagnostics_.begin() + count);
+  return EncodeDOMBinary(*xml_dom_, build_diagnostics, kBinaryFormatVersion,
+                         out);
+}
+
+size_t SrSVGDOM::ApproximateMemoryBytes() const {
+  // Element sizes vary by tag; the node base is a close enough average.
+  size_t bytes = sizeof(*this) + nodes_.size() * sizeof(element::SrSVGNode);
+  if (id_mapper_) {
+    bytes += id_mapper_->size() * (sizeof(std::string) + sizeof(void*) * 2);
+  }
+  const SrDOM::Node* root = xml_dom_ ? xml_dom_->GetRootNode() : nullptr;
+  std::vector<const SrDOM::Node*> stack;
+  if (root) {
+    stack.push_back(root);
+  }
+  while (!stack.empty()) {
+    const SrDOM::Node* node = stack.back();
+    stack.pop_back();
+    bytes += sizeof(SrDOMNode) + std::strlen(node->fName) + 1;
+    for (uint16_t i = 0; i < node->fAttrCount; ++i) {
+      const SrDOMAttr& attr = node->attrs()[i];
+      bytes += sizeof(SrDOMAttr) + std::strlen(attr.fName) + 1 +
+               (attr.fValue ? std::strlen(attr.fValue) + 1 : 0);
+    }
+    for (auto* child = xml_dom_->GetFirstChild(node, nullptr); child;
+         child = xml_dom_->GetNextSibling(child)) {
+      stack.push_back(child);
+    }
+  }
+  return bytes;
+}
+
 void SrSVGDOM::SetDefaultColor(uint32_t color) {
   default_color_ = color;
 }
@@ -471,6 +664,7 @@ void SrSVGDOM::Render(canvas::SrCanvas* canvas) const {
     SrSVGBox view_box = root_->viewBox();
     float local_dpi = FloatsLarger(dpi_, 0.f) ? dpi_ : 96.f;
     SrSVGTraversalState render_state;
+    render_state.budgets = &budgets_;
     SrSVGRenderContext context{
         .width = view_box.width,
         .height = view_box.height,
@@ -493,6 +687,7 @@ void SrSVGDOM::Render(canvas::SrCanvas* canvas, SrSVGBox view_port) const {
     SrSVGBox view_box = root_->viewBox();
     float local_dpi = FloatsLarger(dpi_, 0.f) ? dpi_ : 96.f;
     SrSVGTraversalState render_state;
+    render_state.budgets = &budgets_;
     SrSVGRenderContext context{
         .width = view_port.width,
         .height = view_port.height,
@@ -511,18 +706,18 @@ void SrSVGDOM::Render(canvas::SrCanvas* canvas, SrSVGBox view_port) const {
 }
 
 void SrSVGDOM::RenderAtTime(canvas::SrCanvas* canvas, double seconds) const {
-  const auto& animated_nodes = AnimatedNodes();
-  ApplyAnimations(animated_nodes, id_mapper_, seconds);
+  const auto& active_nodes = ActiveNodesAt(seconds);
+  ApplyAnimations(active_nodes, id_mapper_, seconds);
   Render(canvas);
-  RestoreAnimations(animated_nodes);
+  RestoreAnimations(active_nodes);
 }
 
 void SrSVGDOM::RenderAtTime(canvas::SrCanvas* canvas, SrSVGBox view_port,
                             double seconds) const {
-  const auto& animated_nodes = AnimatedNodes();
-  ApplyAnimations(animated_nodes, id_mapper_, seconds);
+  const auto& active_nodes = ActiveNodesAt(seconds);
+  ApplyAnimations(active_nodes, id_mapper_, seconds);
   Render(canvas, view_port);
-  RestoreAnimations(animated_nodes);
+  RestoreAnimations(active_nodes);
 }
 
 bool SrSVGDOM::HasAnimations() const {
@@ -530,19 +725,7 @@ bool SrSVGDOM::HasAnimations() const {
 }
 
 double SrSVGDOM::AnimationTimelineEndSeconds() const {
-  double timeline_end = 0.0;
-  for (auto* node : nodes_) {
-    if (!node || !IsAnimationTag(node->Tag())) {
-      continue;
-    }
-    const auto* animation = static_cast<const element::SrSVGAnimation*>(node);
-    const double animation_end = animation->LastChangeSeconds(id_mapper_);
-    if (std::isinf(animation_end)) {
-      return std::numeric_limits<double>::infinity();
-    }
-    timeline_end = std::max(timeline_end, animation_end);
-  }
-  return timeline_end;
+  return timeline_.EndSeconds();
 }
 
 const SrSVGDiagnostic* SrSVGDOM::last_diagnostic() const {
@@ -565,6 +748,7 @@ void SrSVGDOM::ReplaceRuntimeDiagnostics(
 void SrSVGDOM::BindTargetAnimations() {
   BindTargetAnimationsInNodes(nodes_, id_mapper_);
   InvalidateAnimationCache();
+  timeline_.Build(AnimatedNodes(), nodes_, id_mapper_);
 }
 
 const std::vector<element::SrSVGNodeBase*>& SrSVGDOM::AnimatedNodes() const {
@@ -580,11 +764,48 @@ const std::vector<element::SrSVGNodeBase*>& SrSVGDOM::AnimatedNodes() const {
   return animated_nodes_;
 }
 
+const std::vector<element::SrSVGNodeBase*>& SrSVGDOM::ActiveNodesAt(
+    double seconds) const {
+  const auto& animated_nodes = AnimatedNodes();
+  timeline_.CollectActiveNodes(seconds, &active_node_indices_);
+  active_nodes_.clear();
+  for (const uint32_t index : active_node_indices_) {
+    active_nodes_.push_back(animated_nodes[index]);
+  }
+  return active_nodes_;
+}
+
 void SrSVGDOM::InvalidateAnimationCache() const {
   animated_nodes_.clear();
   animated_nodes_valid_ = false;
 }
 
+SrSVGDOMStream::SrSVGDOMStream(const SrSVGBudgets& budgets)
+    : budgets_(budgets),
+      build_state_(std::make_unique<SrSVGTraversalState>()),
+      xml_dom_(std::make_shared<SrDOM>()) {
+  build_sink_ = MakeDiagnosticSink(build_state_.get());
+  parser_ = xml_dom_->BeginParsing(&build_sink_);
+}
+
+SrSVGDOMStream::~SrSVGDOMStream() = default;
+
+bool SrSVGDOMStream::Append(const char* data, size_t len) {
+  return parser_ && parser_->parseChunk(data, len);
+}
+
+std::unique_ptr<SrSVGDOM> SrSVGDOMStream::Finish(
+    std::vector<SrSVGDiagnostic>* diagnostics) {
+  if (!parser_) {
+    return nullptr;
+  }
+  parser_ = nullptr;
+  SrXMLParserError parser_error;
+  const bool parsed = xml_dom_->FinishParsing(&parser_error) != nullptr;
+  return SrSVGDOM::MakeFromParse(std::move(xml_dom_), parsed, parser_error,
+                                 build_state_.get(), budgets_, diagnostics);
+}
+
 // Id mapper should only ref to an svg node, but should never copy or delete
 // them. They will be released within the svg dom deconstruction process while
 // svg node delete their children iteratively
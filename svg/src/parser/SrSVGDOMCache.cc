@@ -0,0 +1,117 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "parser/SrSVGDOMCache.h"
+
+#include <string_view>
+#include <utility>
+
+namespace serval {
+namespace svg {
+namespace parser {
+
+SrSVGDOMInstance::SrSVGDOMInstance(std::shared_ptr<SrSVGSharedDOM> document)
+    : document_(std::move(document)) {
+  if (document_) {
+    diagnostics_ = document_->build_diagnostics;
+  }
+}
+
+void SrSVGDOMInstance::SetDefaultColor(uint32_t color) {
+  default_color_ = color;
+}
+
+void SrSVGDOMInstance::ResetDefaultColor() {
+  default_color_.reset();
+}
+
+void SrSVGDOMInstance::Render(canvas::SrCanvas* canvas, SrSVGBox view_port) {
+  RenderLocked(canvas, view_port, nullptr);
+}
+
+void SrSVGDOMInstance::RenderAtTime(canvas::SrCanvas* canvas,
+                                    SrSVGBox view_port, double seconds) {
+  RenderLocked(canvas, view_port, &seconds);
+}
+
+bool SrSVGDOMInstance::HasAnimations() const {
+  return document_ && document_->has_animations;
+}
+
+double SrSVGDOMInstance::AnimationTimelineEndSeconds() const {
+  return document_ ? document_->animation_timeline_end_seconds : 0.0;
+}
+
+void SrSVGDOMInstance::RenderLocked(canvas::SrCanvas* canvas,
+                                    SrSVGBox view_port, const double* seconds) {
+  if (!document_ || !document_->dom) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(document_->render_mutex);
+  SrSVGDOM* dom = document_->dom.get();
+  // The shared document carries no instance state between renders.
+  dom->default_color_ = default_color_;
+  dom->dpi_ = dpi_;
+  if (seconds) {
+    dom->RenderAtTime(canvas, view_port, *seconds);
+  } else {
+    dom->Render(canvas, view_port);
+  }
+  diagnostics_ = dom->diagnostics();
+  dom->default_color_.reset();
+  dom->dpi_ = 0.f;
+}
+
+SrSVGDOMCache& SrSVGDOMCache::Shared() {
+  static SrSVGDOMCache* cache = new SrSVGDOMCache();
+  return *cache;
+}
+
+SrSVGDOMCache::SrSVGDOMCache(size_t capacity_bytes)
+    : documents_(capacity_bytes) {}
+
+std::unique_ptr<SrSVGDOMInstance> SrSVGDOMCache::Acquire(
+    const char* doc, size_t len, std::vector<SrSVGDiagnostic>* diagnostics) {
+  if (!doc) {
+    return nullptr;
+  }
+  const std::string_view content(doc, len);
+  if (auto document = documents_.Find(content)) {
+    if (diagnostics) {
+      *diagnostics = document->build_diagnostics;
+    }
+    return std::make_unique<SrSVGDOMInstance>(std::move(document));
+  }
+
+  // Parse without holding the lock.
+  auto dom = SrSVGDOM::make(doc, len, diagnostics);
+  if (!dom) {
+    return nullptr;
+  }
+  auto document = std::make_shared<SrSVGSharedDOM>();
+  document->build_diagnostics = dom->diagnostics();
+  document->has_animations = dom->HasAnimations();
+  document->animation_timeline_end_seconds = dom->AnimationTimelineEndSeconds();
+  document->memory_bytes = dom->ApproximateMemoryBytes();
+  document->dom = std::move(dom);
+  const size_t bytes = document->memory_bytes + len;
+  return std::make_unique<SrSVGDOMInstance>(
+      documents_.Insert(content, std::move(document), bytes));
+}
+
+void SrSVGDOMCache::SetCapacity(size_t capacity_bytes) {
+  documents_.SetCapacity(capacity_bytes);
+}
+
+void SrSVGDOMCache::Clear() {
+  documents_.Clear();
+}
+
+SrSVGDOMCacheStats SrSVGDOMCache::stats() const {
+  return documents_.stats();
+}
+
+}  // namespace parser
+}  // namespace svg
+}  // namespace serval
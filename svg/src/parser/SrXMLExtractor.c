@@ -182,20 +182,28 @@ bool SrXMLParseElement(const char* s, size_t len,
                                    context) == SR_XML_PARSE_RESULT_STOP;
 }
 
-bool SrXMLParseXML(const char* input, size_t len,
-                   SrSVGStartElementCb startElement,
-                   SrSVGEndElementCb endElement, SrSVGContentCb content,
-                   void* context) {
-  const char* cursor = input;
+void SrXMLScannerInit(SrXMLScanner* scanner) {
+  scanner->state = SR_XML_PARSING_STATE_CONTENT;
+  scanner->quote = '\0';
+  scanner->cursor = 0;
+}
+
+bool SrXMLScanChunk(SrXMLScanner* scanner, const char* input, size_t len,
+                    SrSVGStartElementCb startElement,
+                    SrSVGEndElementCb endElement, SrSVGContentCb content,
+                    void* context, size_t* consumed) {
+  const char* cursor = input + scanner->cursor;
   const char* mark = input;
   const char* end = input + len;
-  int state = SR_XML_PARSING_STATE_CONTENT;
-  char quote = '\0';
+  int state = scanner->state;
+  char quote = scanner->quote;
+  bool ok = true;
 
   while (cursor < end) {
     if (*cursor == '<' && state == SR_XML_PARSING_STATE_CONTENT) {
       if (SrXMLParseContent(mark, (size_t)(cursor - mark), content, context)) {
-        return false;
+        ok = false;
+        break;
       }
       cursor++;
       mark = cursor;
@@ -219,7 +227,8 @@ bool SrXMLParseXML(const char* input, size_t len,
       SrXMLParseResult result = SrXMLParseElementInternal(
           mark, (size_t)(cursor - mark), startElement, endElement, context);
       if (result != SR_XML_PARSE_RESULT_CONTINUE) {
-        return false;
+        ok = false;
+        break;
       }
       cursor++;
       mark = cursor;
@@ -231,9 +240,32 @@ bool SrXMLParseXML(const char* input, size_t len,
     cursor++;
   }
 
-  if (state == SR_XML_PARSING_STATE_CONTENT) {
-    return !SrXMLParseContent(mark, (size_t)(end - mark), content, context);
-  }
+  scanner->state = state;
+  scanner->quote = quote;
+  scanner->cursor = (size_t)(cursor - mark);
+  *consumed = (size_t)(mark - input);
+  return ok;
+}
 
+bool SrXMLScanFinish(SrXMLScanner* scanner, const char* input, size_t len,
+                     SrSVGContentCb content, void* context) {
+  if (scanner->state == SR_XML_PARSING_STATE_CONTENT) {
+    return !SrXMLParseContent(input, len, content, context);
+  }
   return false;
 }
+
+bool SrXMLParseXML(const char* input, size_t len,
+                   SrSVGStartElementCb startElement,
+                   SrSVGEndElementCb endElement, SrSVGContentCb content,
+                   void* context) {
+  SrXMLScanner scanner;
+  size_t consumed = 0;
+  SrXMLScannerInit(&scanner);
+  if (!SrXMLScanChunk(&scanner, input, len, startElement, endElement, content,
+                      context, &consumed)) {
+    return false;
+  }
+  return SrXMLScanFinish(&scanner, input + consumed, len - consumed, content,
+                         context);
+}
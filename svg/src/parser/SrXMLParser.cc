@@ -78,6 +78,19 @@ bool text_handler(void* data, const char* txt, size_t len) {
   return false;
 }
 
+struct SrXMLParser::ChunkState {
+  explicit ChunkState(SrXMLParser* parser) : context(parser) {
+    SrXMLScannerInit(&scanner);
+  }
+
+  ParsingContext context;
+  SrXMLScanner scanner;
+  // The unfinished tag or text run at the end of the chunks so far.
+  std::vector<char> pending;
+  size_t received{0};
+  bool failed{false};
+};
+
 SrXMLParser::SrXMLParser(SrXMLParserError* parserError)
     : fParser(nullptr), fError(parserError) {}
 
@@ -85,21 +98,89 @@ SrXMLParser::~SrXMLParser() = default;
 
 bool SrXMLParser::parse(const char doc[], size_t len) {
   if (!doc || len == 0) {
-    if (fError) {
-      fError->SetCode(SrXMLParserError::kEmptyFile);
-      fError->SetNoun("");
-    }
+    ReportEmptyFile();
     return false;
   }
 
   ParsingContext ctx(this);
   const bool ok = SrXMLParseXML(doc, len, start_element_handler,
                                 end_element_handler, text_handler, &ctx);
-  if (!ok && fError && !fError->HasError()) {
+  if (!ok) {
+    ReportMalformedXML();
+  }
+  return ok;
+}
+
+bool SrXMLParser::parseChunk(const char chunk[], size_t len) {
+  if (!fChunks) {
+    fChunks = std::make_unique<ChunkState>(this);
+  }
+  ChunkState& state = *fChunks;
+  if (state.failed) {
+    return false;
+  }
+  if (!chunk || len == 0) {
+    return true;
+  }
+  state.received += len;
+
+  // Without a pending tail the chunk is scanned in place, so only the bytes
+  // of its last, unfinished token are copied.
+  const bool buffered = !state.pending.empty();
+  if (buffered) {
+    state.pending.insert(state.pending.end(), chunk, chunk + len);
+  }
+  const char* input = buffered ? state.pending.data() : chunk;
+  const size_t input_len = buffered ? state.pending.size() : len;
+  size_t consumed = 0;
+  if (!SrXMLScanChunk(&state.scanner, input, input_len, start_element_handler,
+                      end_element_handler, text_handler, &state.context,
+                      &consumed)) {
+    state.failed = true;
+    state.pending.clear();
+    ReportMalformedXML();
+    return false;
+  }
+  if (buffered) {
+    state.pending.erase(state.pending.begin(),
+                        state.pending.begin() + consumed);
+  } else {
+    state.pending.assign(chunk + consumed, chunk + len);
+  }
+  return true;
+}
+
+bool SrXMLParser::finishChunks() {
+  if (!fChunks || fChunks->received == 0) {
+    ReportEmptyFile();
+    return false;
+  }
+  ChunkState& state = *fChunks;
+  if (state.failed) {
+    return false;
+  }
+  state.failed = !SrXMLScanFinish(&state.scanner, state.pending.data(),
+                                  state.pending.size(), text_handler,
+                                  &state.context);
+  state.pending.clear();
+  if (state.failed) {
+    ReportMalformedXML();
+  }
+  return !state.failed;
+}
+
+void SrXMLParser::ReportEmptyFile() {
+  if (fError) {
+    fError->SetCode(SrXMLParserError::kEmptyFile);
+    fError->SetNoun("");
+  }
+}
+
+void SrXMLParser::ReportMalformedXML() {
+  if (fError && !fError->HasError()) {
     fError->SetCode(SrXMLParserError::kUnknownError);
     fError->SetNoun("malformed xml");
   }
-  return ok;
 }
 
 void SrXMLParser::GetNativeErrorString(int error, std::string* str) {}
@@ -0,0 +1,197 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "renderer/SrSVGBatchRenderer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace serval {
+namespace svg {
+namespace renderer {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MicrosSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+      .count();
+}
+
+// Rounds |size| * |scale| up to whole pixels; zero if out of range.
+uint32_t PixelSize(float size, float scale) {
+  const double pixels = std::ceil(static_cast<double>(size) * scale);
+  if (!(pixels >= 1.0) ||
+      pixels > static_cast<double>(SrSVGBatchRenderer::kMaxPixelSize)) {
+    return 0;
+  }
+  return static_cast<uint32_t>(pixels);
+}
+
+}  // namespace
+
+// Threads that wait for batches. Each batch runs one function on the calling
+// thread and on up to a given number of pool threads, each taking at most one
+// share of it.
+class SrSVGBatchRenderer::WorkerPool {
+ public:
+  WorkerPool() = default;
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // Returns once |work| has returned on the calling thread and on every
+  // helper that took a share.
+  void Run(size_t helpers, const std::function<void()>& work) {
+    std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      work_ = &work;
+      open_shares_ = helpers;
+      running_ = helpers;
+      ++batch_;
+    }
+    while (threads_.size() < helpers) {
+      threads_.emplace_back(&WorkerPool::Loop, this);
+    }
+    wake_.notify_all();
+    work();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return running_ == 0; });
+    work_ = nullptr;
+  }
+
+ private:
+  void Loop() {
+    uint64_t last_batch = 0;
+    while (true) {
+      const std::function<void()>* work = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this, last_batch]() {
+          return stopping_ || (batch_ != last_batch && open_shares_ > 0);
+        });
+        if (stopping_) {
+          return;
+        }
+        last_batch = batch_;
+        --open_shares_;
+        work = work_;
+      }
+      (*work)();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--running_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+
+  // Held for the whole of a batch.
+  std::mutex batch_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void()>* work_{nullptr};
+  uint64_t batch_{0};
+  size_t open_shares_{0};
+  size_t running_{0};
+  bool stopping_{false};
+  std::vector<std::thread> threads_;
+};
+
+SrSVGBatchRenderer::SrSVGBatchRenderer(SrSVGRasterTargetFactory factory,
+                                       uint32_t max_workers,
+                                       const parser::SrSVGBudgets& budgets)
+    : factory_(std::move(factory)),
+      max_workers_(max_workers > 0
+                       ? max_workers
+                       : std::max(1u, std::thread::hardware_concurrency())),
+      budgets_(budgets),
+      pool_(std::make_unique<WorkerPool>()) {}
+
+SrSVGBatchRenderer::~SrSVGBatchRenderer() = default;
+
+std::vector<SrSVGRasterResult> SrSVGBatchRenderer::Render(
+    const std::vector<SrSVGRasterJob>& jobs) const {
+  std::vector<SrSVGRasterResult> results(jobs.size());
+  std::atomic<size_t> next_job{0};
+  const std::function<void()> work = [this, &jobs, &results, &next_job]() {
+    for (size_t index = next_job++; index < jobs.size();
+         index = next_job++) {
+      results[index] = RenderJob(jobs[index]);
+    }
+  };
+  const size_t workers = std::min<size_t>(max_workers_, jobs.size());
+  if (workers > 1) {
+    pool_->Run(workers - 1, work);
+  } else {
+    work();
+  }
+  return results;
+}
+
+SrSVGRasterResult SrSVGBatchRenderer::RenderJob(
+    const SrSVGRasterJob& job) const {
+  SrSVGRasterResult result;
+  if (!factory_ || !(job.scale > 0.f)) {
+    return result;
+  }
+  result.pixel_width = PixelSize(job.width, job.scale);
+  result.pixel_height = PixelSize(job.height, job.scale);
+  if (result.pixel_width == 0 || result.pixel_height == 0) {
+    return result;
+  }
+
+  const auto parse_start = Clock::now();
+  auto dom = parser::SrSVGDOM::make(job.content, job.length,
+                                    &result.diagnostics, budgets_);
+  result.parse_micros = MicrosSince(parse_start);
+  if (!dom) {
+    return result;
+  }
+
+  const auto render_start = Clock::now();
+  auto target = factory_(result.pixel_width, result.pixel_height);
+  canvas::SrCanvas* canvas = target ? target->Canvas() : nullptr;
+  if (canvas) {
+    if (job.default_color.has_value()) {
+      dom->SetDefaultColor(*job.default_color);
+    }
+    if (job.scale != 1.f) {
+      const float scale[6] = {job.scale, 0.f, 0.f, job.scale, 0.f, 0.f};
+      canvas->Transform(scale);
+    }
+    const SrSVGBox view_port{0.f, 0.f, job.width, job.height};
+    if (dom->HasAnimations()) {
+      dom->RenderAtTime(canvas, view_port, job.seconds);
+    } else {
+      dom->Render(canvas, view_port);
+    }
+    result.ok = target->ReadPixels(&result.pixels);
+    result.diagnostics = dom->diagnostics();
+  }
+  result.render_micros = MicrosSince(render_start);
+  return result;
+}
+
+}  // namespace renderer
+}  // namespace svg
+}  // namespace serval
@@ -0,0 +1,174 @@
+// Copyright 2026 The Lynx Authors. All rights reserved.
+// Licensed under the Apache License Version 2.0 that can be found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "utils/SrDataURI.h"
+
+#include <cstring>
+#include <utility>
+
+namespace serval {
+namespace svg {
+
+namespace {
+
+char ToLower(char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool StartsWithIgnoreCase(const char* str, const char* end,
+                          const char* prefix) {
+  for (; *prefix; ++str, ++prefix) {
+    if (str == end || ToLower(*str) != *prefix) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int Base64Value(char c) {
+  if (c >= 'A' && c <= 'Z') {
+    return c - 'A';
+  }
+  if (c >= 'a' && c <= 'z') {
+    return c - 'a' + 26;
+  }
+  if (c >= '0' && c <= '9') {
+    return c - '0' + 52;
+  }
+  if (c == '+' || c == '-') {
+    return 62;
+  }
+  if (c == '/' || c == '_') {
+    return 63;
+  }
+  return -1;
+}
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  c = ToLower(c);
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+bool DecodeBase64(const char* begin, const char* end,
+                  std::vector<uint8_t>* out) {
+  out->reserve(static_cast<size_t>(end - begin) / 4 * 3);
+  uint32_t bits = 0;
+  int bit_count = 0;
+  bool padding = false;
+  for (const char* it = begin; it != end; ++it) {
+    if (IsSpace(*it)) {
+      continue;
+    }
+    if (*it == '=') {
+      padding = true;
+      continue;
+    }
+    const int value = Base64Value(*it);
+    if (value < 0 || padding) {
+      return false;
+    }
+    bits = (bits << 6) | static_cast<uint32_t>(value);
+    bit_count += 6;
+    if (bit_count >= 8) {
+      bit_count -= 8;
+      out->push_back(static_cast<uint8_t>((bits >> bit_count) & 0xff));
+    }
+  }
+  // A single leftover sextet cannot encode a byte.
+  return bit_count < 6;
+}
+
+bool DecodePercent(const char* begin, const char* end,
+                   std::vector<uint8_t>* out) {
+  out->reserve(static_cast<size_t>(end - begin));
+  for (const char* it = begin; it != end; ++it) {
+    if (*it != '%') {
+      out->push_back(static_cast<uint8_t>(*it));
+      continue;
+    }
+    if (end - it < 3) {
+      return false;
+    }
+    const int high = HexValue(it[1]);
+    const int low = HexValue(it[2]);
+    if (high < 0 || low < 0) {
+      return false;
+    }
+    out->push_back(static_cast<uint8_t>(high * 16 + low));
+    it += 2;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool IsDataURI(const char* uri) {
+  if (!uri) {
+    return false;
+  }
+  while (IsSpace(*uri)) {
+    ++uri;
+  }
+  return StartsWithIgnoreCase(uri, uri + std::strlen(uri), "data:");
+}
+
+bool DecodeDataURI(const char* uri, SrDataURI* out) {
+  if (!IsDataURI(uri) || !out) {
+    return false;
+  }
+  while (IsSpace(*uri)) {
+    ++uri;
+  }
+  const char* end = uri + std::strlen(uri);
+  const char* header = uri + std::strlen("data:");
+  const char* comma =
+      static_cast<const char*>(std::memchr(header, ',', end - header));
+  if (!comma) {
+    return false;
+  }
+  // The base64 flag is the last parameter of the header.
+  const char* header_end = comma;
+  bool base64 = false;
+  static const char kBase64[] = ";base64";
+  const size_t base64_length = sizeof(kBase64) - 1;
+  if (static_cast<size_t>(header_end - header) >= base64_length &&
+      StartsWithIgnoreCase(header_end - base64_length, header_end, kBase64)) {
+    base64 = true;
+    header_end -= base64_length;
+  }
+  const char* media_end =
+      static_cast<const char*>(std::memchr(header, ';', header_end - header));
+  if (!media_end) {
+    media_end = header_end;
+  }
+
+  SrDataURI result;
+  result.media_type.reserve(media_end - header);
+  for (const char* it = header; it != media_end; ++it) {
+    result.media_type.push_back(ToLower(*it));
+  }
+  if (result.media_type.empty()) {
+    result.media_type = "text/plain";
+  }
+  const bool decoded = base64 ? DecodeBase64(comma + 1, end, &result.data)
+                              : DecodePercent(comma + 1, end, &result.data);
+  if (!decoded) {
+    return false;
+  }
+  *out = std::move(result);
+  return true;
+}
+
+}  // namespace svg
+}  // namespace serval
@@ -55,6 +55,71 @@ SrSVGBox MapBounds(const SrSVGBox& box, const float* xform) {
   return {min_x, min_y, max_x - min_x, max_y - min_y};
 }
 
+bool IsEmptyBounds(const SrSVGBox& box) {
+  return !(box.width > 0.f) || !(box.height > 0.f);
+}
+
+SrSVGBox UnionBounds(const SrSVGBox& first, const SrSVGBox& second) {
+  if (IsEmptyBounds(first)) {
+    return second;
+  }
+  if (IsEmptyBounds(second)) {
+    return first;
+  }
+  const float left = std::min(first.left, second.left);
+  const float top = std::min(first.top, second.top);
+  const float right =
+      std::max(first.left + first.width, second.left + second.width);
+  const float bottom =
+      std::max(first.top + first.height, second.top + second.height);
+  return {left, top, right - left, bottom - top};
+}
+
+SrSVGBox IntersectBounds(const SrSVGBox& first, const SrSVGBox& second) {
+  const float left = std::max(first.left, second.left);
+  const float top = std::max(first.top, second.top);
+  const float right =
+      std::min(first.left + first.width, second.left + second.width);
+  const float bottom =
+      std::min(first.top + first.height, second.top + second.height);
+  if (right <= left || bottom <= top) {
+    return {0.f, 0.f, 0.f, 0.f};
+  }
+  return {left, top, right - left, bottom - top};
+}
+
+SrSVGBox OutsetBounds(const SrSVGBox& box, float dx, float dy) {
+  return {box.left - dx, box.top - dy, box.width + dx * 2.f,
+          box.height + dy * 2.f};
+}
+
+SrSVGBox PointsBounds(const float* points, uint32_t n_points) {
+  if (!points || n_points == 0) {
+    return {0.f, 0.f, 0.f, 0.f};
+  }
+  float min_x = points[0];
+  float max_x = points[0];
+  float min_y = points[1];
+  float max_y = points[1];
+  for (uint32_t i = 1; i < n_points; ++i) {
+    min_x = std::min(min_x, points[2 * i]);
+    max_x = std::max(max_x, points[2 * i]);
+    min_y = std::min(min_y, points[2 * i + 1]);
+    max_y = std::max(max_y, points[2 * i + 1]);
+  }
+  return {min_x, min_y, max_x - min_x, max_y - min_y};
+}
+
+bool DevicePixelSize(const float* xform, float* dx, float* dy) {
+  float inverse[6];
+  if (!InvertAffineTransform(xform, inverse)) {
+    return false;
+  }
+  *dx = std::fabs(inverse[0]) + std::fabs(inverse[2]);
+  *dy = std::fabs(inverse[1]) + std::fabs(inverse[3]);
+  return true;
+}
+
 }  // namespace element
 }  // namespace svg
 }  // namespace serval